@@ -303,6 +303,20 @@ namespace soft_body
         m_engine.params().set_adaptive_halving_tolerance( adaptive_halving_tolerance );
         m_engine.params().set_adaptive_doubling_count( adaptive_doubling_count );
 
+        size_t const newton_max_iterations     = util::to_value<size_t>( m_config_file.get_value("newton_max_iterations", "10")           );
+        float const newton_tolerance           = util::to_value<float>( m_config_file.get_value("newton_tolerance", "0.0001")             );
+
+        m_engine.params().set_newton_max_iterations( newton_max_iterations );
+        m_engine.params().set_newton_tolerance( newton_tolerance );
+
+        bool  const use_contact_forces         = util::to_value<bool>(  m_config_file.get_value("use_contact_forces", "false")       );
+        float const contact_stiffness          = util::to_value<float>( m_config_file.get_value("contact_stiffness", "1000.0")       );
+        float const contact_damping            = util::to_value<float>( m_config_file.get_value("contact_damping", "1.0")            );
+
+        m_engine.params().set_use_contact_forces( use_contact_forces );
+        m_engine.params().set_contact_stiffness( contact_stiffness );
+        m_engine.params().set_contact_damping( contact_damping );
+
         float const tetgen_quality_ratio       = util::to_value<float>( m_config_file.get_value("tetgen_quality_ratio", "2.0")       );
         float const tetgen_maximum_volume      = util::to_value<float>( m_config_file.get_value("tetgen_maximum_volume", "0.1")      );
         bool  const tetgen_quiet_output        = util::to_value<bool>(  m_config_file.get_value("tetgen_quiet_output", "true")       );
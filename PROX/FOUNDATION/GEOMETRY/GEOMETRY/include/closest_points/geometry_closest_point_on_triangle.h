@@ -0,0 +1,93 @@
+#ifndef GEOMETRY_CLOSEST_POINT_ON_TRIANGLE_H
+#define GEOMETRY_CLOSEST_POINT_ON_TRIANGLE_H
+
+#include <types/geometry_triangle.h>
+
+#include <tiny_is_finite.h>
+#include <tiny_is_number.h>
+
+#include <cassert>
+
+namespace geometry
+{
+
+  /**
+   * Closest point on a triangle.
+   * The Voronoi regions of the vertices and edges of the triangle are
+   * tested in turn, if the point is in none of them then it projects onto
+   * the interior of the triangle.
+   *
+   * @param p    The point.
+   * @param tri  The triangle.
+   *
+   * @return     The point on the triangle that is closest to p.
+   */
+  template<typename V>
+  inline V closest_point_on_triangle(V const & p, Triangle<V> const & tri)
+  {
+    typedef typename V::real_type    T;
+    typedef typename V::value_traits VT;
+
+    V const & a = tri.p(0);
+    V const & b = tri.p(1);
+    V const & c = tri.p(2);
+
+    V const ab = b - a;
+    V const ac = c - a;
+    V const ap = p - a;
+
+    T const d1 = inner_prod( ab, ap );
+    T const d2 = inner_prod( ac, ap );
+
+    if( d1 <= VT::zero() && d2 <= VT::zero() )
+      return a;
+
+    V const bp = p - b;
+
+    T const d3 = inner_prod( ab, bp );
+    T const d4 = inner_prod( ac, bp );
+
+    if( d3 >= VT::zero() && d4 <= d3 )
+      return b;
+
+    T const vc = d1*d4 - d3*d2;
+
+    if( vc <= VT::zero() && d1 >= VT::zero() && d3 <= VT::zero() )
+      return a + ab * ( d1 / (d1 - d3) );
+
+    V const cp = p - c;
+
+    T const d5 = inner_prod( ab, cp );
+    T const d6 = inner_prod( ac, cp );
+
+    if( d6 >= VT::zero() && d5 <= d6 )
+      return c;
+
+    T const vb = d5*d2 - d1*d6;
+
+    if( vb <= VT::zero() && d2 >= VT::zero() && d6 <= VT::zero() )
+      return a + ac * ( d2 / (d2 - d6) );
+
+    T const va = d3*d6 - d5*d4;
+
+    if( va <= VT::zero() && (d4 - d3) >= VT::zero() && (d5 - d6) >= VT::zero() )
+      return b + (c - b) * ( (d4 - d3) / ( (d4 - d3) + (d5 - d6) ) );
+
+    T const denom = VT::one() / (va + vb + vc);
+
+    V const q = a + ab * (vb * denom) + ac * (vc * denom);
+
+    assert( is_number(q(0)) || !"closest_point_on_triangle(): NaN encountered");
+    assert( is_finite(q(0)) || !"closest_point_on_triangle(): Inf encountered");
+    assert( is_number(q(1)) || !"closest_point_on_triangle(): NaN encountered");
+    assert( is_finite(q(1)) || !"closest_point_on_triangle(): Inf encountered");
+    assert( is_number(q(2)) || !"closest_point_on_triangle(): NaN encountered");
+    assert( is_finite(q(2)) || !"closest_point_on_triangle(): Inf encountered");
+
+    return q;
+  }
+
+}// namespace geometry
+
+// GEOMETRY_CLOSEST_POINT_ON_TRIANGLE_H
+#endif
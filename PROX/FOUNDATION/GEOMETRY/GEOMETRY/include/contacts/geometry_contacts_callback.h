@@ -1,6 +1,8 @@
 #ifndef GEOMETRY_CONTACTS_CALLBACK_H
 #define GEOMETRY_CONTACTS_CALLBACK_H
 
+#include <cstddef> // needed for size_t
+
 namespace geometry
 {
   
@@ -21,6 +23,22 @@ namespace geometry
                                  , V const & normal
                                 , typename V::real_type const & distance
                                  ) = 0;
+
+        /**
+         * Callback interface for reporting the features that subsequently
+         * reported contact points originate from. Collision handlers invoke
+         * this before testing a pair of features (shapes, tetrahedra, etc.)
+         * such that contact points can be traced back to the features that
+         * generated them. By default the information is ignored.
+         *
+         * @param feature_a  The index of the feature on object A.
+         * @param feature_b  The index of the feature on object B.
+         */
+        virtual void set_features(
+                                  size_t const & /*feature_a*/
+                                  , size_t const & /*feature_b*/
+                                  )
+        {}
     };
   
 }//namespace geometry
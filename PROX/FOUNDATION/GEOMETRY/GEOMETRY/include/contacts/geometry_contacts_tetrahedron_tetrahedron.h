@@ -292,12 +292,12 @@ namespace geometry
      * This is just an overloaded version of pick_sat_normal that makes it
      * convenient to pass surface information arguments as dummy data.
      */
-    template< typename V>
+    template< typename V, typename S>
     inline bool pick_sat_normal(
                                 Tetrahedron<V> const & tetA
                                 , Tetrahedron<V> const & tetB
-                                , std::vector<bool> const & surface_A
-                                , std::vector<bool> const & surface_B
+                                , S const & surface_A
+                                , S const & surface_B
                                 , V & n
                                 )
     {
@@ -309,12 +309,12 @@ namespace geometry
      * under the restricted that only separation axes generated from
      * surface information are considered valid.
      */
-    template< typename V>
+    template< typename V, typename S>
     inline bool pick_restricted_sat_normal(
                             Tetrahedron<V> const & tetA
                             , Tetrahedron<V> const & tetB
-                            , std::vector<bool> const & surface_A
-                            , std::vector<bool> const & surface_B
+                            , S const & surface_A
+                            , S const & surface_B
                             , V & n
                             )
     {
@@ -463,12 +463,12 @@ namespace geometry
      * This method determines the contact normal to be the normal-direction 
      * that are defined by the two most opposing surfaces.
      */
-    template< typename V>
+    template< typename V, typename S>
     inline bool pick_most_opposing_surface_normal(
                             Tetrahedron<V> const & tetA
                             , Tetrahedron<V> const & tetB
-                            , std::vector<bool> const & surface_A
-                            , std::vector<bool> const & surface_B
+                            , S const & surface_A
+                            , S const & surface_B
                             , V & n
                             )
     {
@@ -692,13 +692,13 @@ namespace geometry
   struct RESTRICTED_SAT {};
   struct MOST_OPPOSING_SURFACES {};
 
-  template< typename V>
+  template< typename V, typename S>
   inline bool contacts_tetrahedron_tetrahedron(
                                                Tetrahedron<V> const & A
                                                , Tetrahedron<V> const & B
                                                , ContactsCallback<V> & callback
-                                               , std::vector<bool> const & surface_A
-                                               , std::vector<bool> const & surface_B
+                                               , S const & surface_A
+                                               , S const & surface_B
                                                , TRIANGLE_INTERSECTION const & /*algorithm_tag*/
   )
   {
@@ -980,13 +980,13 @@ namespace geometry
     return count > 0u;
   }
 
-  template< typename V>
+  template< typename V, typename S>
   inline bool contacts_tetrahedron_tetrahedron(
                                                Tetrahedron<V> const & A
                                                , Tetrahedron<V> const & B
                                                , ContactsCallback<V> & callback
-                                               , std::vector<bool> const & surface_A
-                                               , std::vector<bool> const & surface_B
+                                               , S const & surface_A
+                                               , S const & surface_B
                                                , VERTEX_ONLY_INTERSECTION const & /*algorithm_tag*/
   )
   {
@@ -1088,13 +1088,13 @@ namespace geometry
     return count > 0u;
   }
 
-  template< typename V>
+  template< typename V, typename S>
   inline bool contacts_tetrahedron_tetrahedron(
                                                Tetrahedron<V> const & A
                                                , Tetrahedron<V> const & B
                                                , ContactsCallback<V> & callback
-                                               , std::vector<bool> const & surface_A
-                                               , std::vector<bool> const & surface_B
+                                               , S const & surface_A
+                                               , S const & surface_B
                                                , CONSISTENT_VERTEX const & /*algorithm_tag*/
   )
   {
@@ -1242,13 +1242,13 @@ namespace geometry
     return count > 0u;
   }
 
-  template< typename V>
+  template< typename V, typename S>
   inline bool contacts_tetrahedron_tetrahedron(
                                                Tetrahedron<V> const & A
                                                , Tetrahedron<V> const & B
                                                , ContactsCallback<V> & callback
-                                               , std::vector<bool> const & surface_A
-                                               , std::vector<bool> const & surface_B
+                                               , S const & surface_A
+                                               , S const & surface_B
                                                , SAT const & /*algorithm_tag*/
                                                )
   {
@@ -1275,13 +1275,13 @@ namespace geometry
     return details::generate_contacts_from_intersection(A, B, callback, n);
   }
 
-  template< typename V>
+  template< typename V, typename S>
   inline bool contacts_tetrahedron_tetrahedron(
                                                Tetrahedron<V> const & A
                                                , Tetrahedron<V> const & B
                                                , ContactsCallback<V> & callback
-                                               , std::vector<bool> const & surface_A
-                                               , std::vector<bool> const & surface_B
+                                               , S const & surface_A
+                                               , S const & surface_B
                                                , RESTRICTED_SAT const & /*algorithm_tag*/
   )
   {
@@ -1308,13 +1308,13 @@ namespace geometry
   }
 
 
-  template< typename V>
+  template< typename V, typename S>
   inline bool contacts_tetrahedron_tetrahedron(
                                                Tetrahedron<V> const & A
                                                , Tetrahedron<V> const & B
                                                , ContactsCallback<V> & callback
-                                               , std::vector<bool> const & surface_A
-                                               , std::vector<bool> const & surface_B
+                                               , S const & surface_A
+                                               , S const & surface_B
                                                , MOST_OPPOSING_SURFACES const & /*algorithm_tag*/
   )
   {
@@ -15,13 +15,13 @@ namespace geometry
   struct CLOSEST_POINTS {};
 
 
-  template< typename V>
+  template< typename V, typename S>
   inline bool contacts_tetrahedron_tetrahedron(
                                                Tetrahedron<V> const & A
                                                , Tetrahedron<V> const & B
                                                , ContactsCallback<V> & callback
-                                               , std::vector<bool> const & surface_A
-                                               , std::vector<bool> const & surface_B
+                                               , S const & surface_A
+                                               , S const & surface_B
                                                , CLOSEST_POINTS const & /*algorithm_tag*/
   )
   {
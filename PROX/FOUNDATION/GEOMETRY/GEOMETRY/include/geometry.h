@@ -46,6 +46,7 @@
 
 #include <closest_points/geometry_closest_point_on_line.h>
 #include <closest_points/geometry_closest_point_on_plane.h>
+#include <closest_points/geometry_closest_point_on_triangle.h>
 #include <closest_points/geometry_closest_points_line_line.h>
 #include <closest_points/geometry_closest_points_tetrahedron_tetrahedron.h>
 
@@ -6,6 +6,14 @@
 
 #include <cmath>
 
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
 namespace geometry
 {
   
@@ -22,8 +30,105 @@ namespace geometry
     }
     return true;
   }
-  
+
+  /**
+   * Test one kDOP against two other kDOPs.
+   *
+   * @return   Bit 0 is set if A overlaps B0 and bit 1 is set if A
+   *           overlaps B1.
+   */
+  template<typename T, size_t K>
+  inline unsigned int overlap_dop_dops( DOP<T,K> const & A, DOP<T,K> const & B0, DOP<T,K> const & B1)
+  {
+    return ( overlap_dop_dop(A, B0) ? 1u : 0u ) | ( overlap_dop_dop(A, B1) ? 2u : 0u );
+  }
+
+#if defined(__SSE__)
+
+  namespace details
+  {
+
+    /**
+     * Returns a non-zero lane for every slab of two float 8-DOPs that
+     * separates them. Each 8-DOP is loaded as two registers holding
+     * (lower, upper, lower, upper), the shuffles gather the four lower
+     * and the four upper values such that all slabs are compared at once.
+     */
+    inline __m128 separating_slabs( DOP<float,8> const & A, DOP<float,8> const & B )
+    {
+      __m128 const a01 = _mm_loadu_ps( A.data()      );
+      __m128 const a23 = _mm_loadu_ps( A.data() + 4u );
+      __m128 const b01 = _mm_loadu_ps( B.data()      );
+      __m128 const b23 = _mm_loadu_ps( B.data() + 4u );
+
+      __m128 const a_lower = _mm_shuffle_ps( a01, a23, _MM_SHUFFLE(2,0,2,0) );
+      __m128 const a_upper = _mm_shuffle_ps( a01, a23, _MM_SHUFFLE(3,1,3,1) );
+      __m128 const b_lower = _mm_shuffle_ps( b01, b23, _MM_SHUFFLE(2,0,2,0) );
+      __m128 const b_upper = _mm_shuffle_ps( b01, b23, _MM_SHUFFLE(3,1,3,1) );
+
+      return _mm_or_ps( _mm_cmplt_ps( a_upper, b_lower ), _mm_cmplt_ps( b_upper, a_lower ) );
+    }
+
+  }// namespace details
+
+  inline bool overlap_dop_dop( DOP<float,8> const & A, DOP<float,8> const & B)
+  {
+    return _mm_movemask_ps( details::separating_slabs(A, B) ) == 0;
+  }
+
+  inline unsigned int overlap_dop_dops( DOP<float,8> const & A, DOP<float,8> const & B0, DOP<float,8> const & B1)
+  {
+    int const separated_0 = _mm_movemask_ps( details::separating_slabs(A, B0) );
+    int const separated_1 = _mm_movemask_ps( details::separating_slabs(A, B1) );
+
+    return ( separated_0 == 0 ? 1u : 0u ) | ( separated_1 == 0 ? 2u : 0u );
+  }
+
+#endif // defined(__SSE__)
+
+#if defined(__AVX__)
+
+  namespace details
+  {
+
+    /**
+     * Double precision version of separating_slabs, the unpack
+     * instructions give the slabs in the order 0, 2, 1, 3 which does not
+     * matter as all slabs are tested.
+     */
+    inline __m256d separating_slabs( DOP<double,8> const & A, DOP<double,8> const & B )
+    {
+      __m256d const a01 = _mm256_loadu_pd( A.data()      );
+      __m256d const a23 = _mm256_loadu_pd( A.data() + 4u );
+      __m256d const b01 = _mm256_loadu_pd( B.data()      );
+      __m256d const b23 = _mm256_loadu_pd( B.data() + 4u );
+
+      __m256d const a_lower = _mm256_unpacklo_pd( a01, a23 );
+      __m256d const a_upper = _mm256_unpackhi_pd( a01, a23 );
+      __m256d const b_lower = _mm256_unpacklo_pd( b01, b23 );
+      __m256d const b_upper = _mm256_unpackhi_pd( b01, b23 );
+
+      return _mm256_or_pd( _mm256_cmp_pd( a_upper, b_lower, _CMP_LT_OQ ), _mm256_cmp_pd( b_upper, a_lower, _CMP_LT_OQ ) );
+    }
+
+  }// namespace details
+
+  inline bool overlap_dop_dop( DOP<double,8> const & A, DOP<double,8> const & B)
+  {
+    return _mm256_movemask_pd( details::separating_slabs(A, B) ) == 0;
+  }
+
+  inline unsigned int overlap_dop_dops( DOP<double,8> const & A, DOP<double,8> const & B0, DOP<double,8> const & B1)
+  {
+    int const separated_0 = _mm256_movemask_pd( details::separating_slabs(A, B0) );
+    int const separated_1 = _mm256_movemask_pd( details::separating_slabs(A, B1) );
+
+    return ( separated_0 == 0 ? 1u : 0u ) | ( separated_1 == 0 ? 2u : 0u );
+  }
+
+#endif // defined(__AVX__)
+
 }// namespace geometry
 
 // GEOMETRY_OVERLAP_DOP_DOP_H
-#endif
\ No newline at end of file
+#endif
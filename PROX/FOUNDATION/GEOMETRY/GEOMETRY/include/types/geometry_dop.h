@@ -38,6 +38,13 @@ namespace geometry
     
     size_t size() const { return K; }
 
+    /**
+     * Raw access to the slab values. The values are stored as K
+     * consecutive numbers, lower and upper value of the first slab, then
+     * lower and upper value of the second slab and so on.
+     */
+    T const * data() const { return &(this->m_slabs[0].lower()); }
+
   public:
     
     DOP()
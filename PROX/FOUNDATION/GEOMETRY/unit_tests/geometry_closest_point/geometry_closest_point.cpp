@@ -54,4 +54,51 @@ BOOST_AUTO_TEST_CASE(closest_point_test)
   }
 }
 
+BOOST_AUTO_TEST_CASE(closest_point_on_triangle_test)
+{
+  typedef tiny::MathTypes<float> MT;
+  typedef MT::vector3_type       V;
+
+  geometry::Triangle<V> const tri = geometry::make_triangle( V::make(0,0,0), V::make(2,0,0), V::make(0,2,0) );
+
+  {
+    V const q = geometry::closest_point_on_triangle( V::make(0.5f,0.5f,3.0f), tri );  // interior
+
+    BOOST_CHECK_CLOSE( q(0), 0.5f, 0.01f );
+    BOOST_CHECK_CLOSE( q(1), 0.5f, 0.01f );
+    BOOST_CHECK_SMALL( q(2), 1e-6f );
+  }
+  {
+    V const q = geometry::closest_point_on_triangle( V::make(-1.0f,-1.0f,1.0f), tri );  // vertex a
+
+    BOOST_CHECK_SMALL( q(0), 1e-6f );
+    BOOST_CHECK_SMALL( q(1), 1e-6f );
+    BOOST_CHECK_SMALL( q(2), 1e-6f );
+  }
+  {
+    V const q = geometry::closest_point_on_triangle( V::make(3.0f,-1.0f,0.0f), tri );  // vertex b
+
+    BOOST_CHECK_CLOSE( q(0), 2.0f, 0.01f );
+    BOOST_CHECK_SMALL( q(1), 1e-6f );
+  }
+  {
+    V const q = geometry::closest_point_on_triangle( V::make(1.0f,-2.0f,0.0f), tri );  // edge ab
+
+    BOOST_CHECK_CLOSE( q(0), 1.0f, 0.01f );
+    BOOST_CHECK_SMALL( q(1), 1e-6f );
+  }
+  {
+    V const q = geometry::closest_point_on_triangle( V::make(-2.0f,1.0f,0.0f), tri );  // edge ac
+
+    BOOST_CHECK_SMALL( q(0), 1e-6f );
+    BOOST_CHECK_CLOSE( q(1), 1.0f, 0.01f );
+  }
+  {
+    V const q = geometry::closest_point_on_triangle( V::make(2.0f,2.0f,0.0f), tri );  // edge bc
+
+    BOOST_CHECK_CLOSE( q(0), 1.0f, 0.01f );
+    BOOST_CHECK_CLOSE( q(1), 1.0f, 0.01f );
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -8,10 +8,79 @@
 #include <boost/test/test_tools.hpp>
 
 #include <vector>
+#include <cstdlib>
 
+/**
+ * Reference slab by slab overlap test.
+ */
+template<typename T, size_t K>
+bool reference_overlap(geometry::DOP<T,K> const & A, geometry::DOP<T,K> const & B)
+{
+  for(size_t k = 0u; k < K/2; ++k)
+  {
+    if( A(k).upper() < B(k).lower() || B(k).upper() < A(k).lower() )
+      return false;
+  }
+  return true;
+}
+
+template<typename T>
+geometry::DOP<T,8> make_random_dop()
+{
+  geometry::DOP<T,8> dop;
+
+  for(size_t k = 0u; k < 4u; ++k)
+  {
+    T const center = T( std::rand() % 21 ) - T(10);   // Integer values give touching slabs
+    T const width  = T( std::rand() % 6 );
+
+    dop(k).lower() = center - width;
+    dop(k).upper() = center + width;
+  }
+
+  return dop;
+}
+
+template<typename T>
+void check_random_overlaps()
+{
+  std::srand(7);
+
+  for(size_t i = 0u; i < 2000u; ++i)
+  {
+    geometry::DOP<T,8> const A  = make_random_dop<T>();
+    geometry::DOP<T,8> const B0 = make_random_dop<T>();
+    geometry::DOP<T,8> const B1 = make_random_dop<T>();
+
+    bool const overlap_0 = reference_overlap(A, B0);
+    bool const overlap_1 = reference_overlap(A, B1);
+
+    BOOST_CHECK_EQUAL( geometry::overlap_dop_dop(A, B0), overlap_0 );
+    BOOST_CHECK_EQUAL( geometry::overlap_dop_dop(B0, A), overlap_0 );
+    BOOST_CHECK_EQUAL( geometry::overlap_dop_dops(A, B0, B1), (overlap_0 ? 1u : 0u) | (overlap_1 ? 2u : 0u) );
+  }
+
+  // An empty kDOP does not overlap anything
+  geometry::DOP<T,8> const empty;
+  geometry::DOP<T,8> const A = make_random_dop<T>();
+
+  BOOST_CHECK( !geometry::overlap_dop_dop(A, empty) );
+  BOOST_CHECK( !geometry::overlap_dop_dop(empty, A) );
+  BOOST_CHECK_EQUAL( geometry::overlap_dop_dops(A, empty, A), 2u );
+}
 
 BOOST_AUTO_TEST_SUITE(geometry);
 
+BOOST_AUTO_TEST_CASE(overlap_dop8_float)
+{
+  check_random_overlaps<float>();
+}
+
+BOOST_AUTO_TEST_CASE(overlap_dop8_double)
+{
+  check_random_overlaps<double>();
+}
+
 BOOST_AUTO_TEST_CASE(make_dops)
 {
   typedef tiny::MathTypes<float> MT;
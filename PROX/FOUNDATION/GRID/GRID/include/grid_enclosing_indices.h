@@ -7,6 +7,12 @@
 
 namespace grid
 {
+
+  /**
+   * Find the indices of the grid cell that encloses a point.
+   * Points outside the grid get the indices of the nearest boundary
+   * cell, so the returned indices are always valid node indices.
+   */
   template <typename D, typename T>
   inline void enclosing_indices(
                                 Grid<D,T> const & grid
@@ -22,14 +28,22 @@ namespace grid
                                 )
   {
     using std::floor;
+    using std::min;
+    using std::max;
+
+    typedef typename Grid<D,T>::VT VT;
 
     T const diff_x = ( x - grid.min_x() ) / grid.dx();
-    T const diff_y = ( y - grid.min_x() ) / grid.dy();
-    T const diff_z = ( z - grid.min_x() ) / grid.dz();
+    T const diff_y = ( y - grid.min_y() ) / grid.dy();
+    T const diff_z = ( z - grid.min_z() ) / grid.dz();
+
+    T const max_i = static_cast<T>( grid.I() - 2u );
+    T const max_j = static_cast<T>( grid.J() - 2u );
+    T const max_k = static_cast<T>( grid.K() - 2u );
 
-    i0 = static_cast<size_t>( floor( diff_x ) );
-    j0 = static_cast<size_t>( floor( diff_y ) );
-    k0 = static_cast<size_t>( floor( diff_z ) );
+    i0 = static_cast<size_t>( min( max( floor( diff_x ), VT::zero() ), max_i ) );
+    j0 = static_cast<size_t>( min( max( floor( diff_y ), VT::zero() ), max_j ) );
+    k0 = static_cast<size_t>( min( max( floor( diff_z ), VT::zero() ), max_k ) );
 
     i1 = ( i0 + 1 );
     j1 = ( j0 + 1 );
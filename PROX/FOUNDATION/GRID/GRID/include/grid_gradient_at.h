@@ -0,0 +1,89 @@
+#ifndef GRID_GRADIENT_AT_H
+#define GRID_GRADIENT_AT_H
+
+#include <grid_enclosing_indices.h>
+
+#include <tiny_is_number.h>
+#include <tiny_is_finite.h>
+
+#include <cmath>
+#include <cassert>
+
+namespace grid
+{
+
+  /**
+   * Gradient of the trilinear interpolation of the grid values.
+   * The gradient is the exact derivative of the interpolant used by
+   * value_at, points outside the grid are clamped to the grid boundary.
+   *
+   * @param grid   The grid.
+   * @param x      The x coordinate of the point.
+   * @param y      The y coordinate of the point.
+   * @param z      The z coordinate of the point.
+   * @param gx     Upon return holds the x component of the gradient.
+   * @param gy     Upon return holds the y component of the gradient.
+   * @param gz     Upon return holds the z component of the gradient.
+   */
+  template<typename D,typename T>
+  inline void gradient_at(
+                          Grid<D,T> const & grid
+                          , T const & x
+                          , T const & y
+                          , T const & z
+                          , D & gx
+                          , D & gy
+                          , D & gz
+                          )
+  {
+    assert( is_number(x) || !"gradient_at(): x was not a number");
+    assert( is_finite(x) || !"gradient_at(): x was not finite"  );
+    assert( is_number(y) || !"gradient_at(): y was not a number");
+    assert( is_finite(y) || !"gradient_at(): y was not finite"  );
+    assert( is_number(z) || !"gradient_at(): z was not a number");
+    assert( is_finite(z) || !"gradient_at(): z was not finite"  );
+
+    using std::min;
+    using std::max;
+
+    typedef typename Grid<D,T>::VT VT;
+
+    T const safe_x = max( grid.min_x(), min( x, grid.max_x()) );
+    T const safe_y = max( grid.min_y(), min( y, grid.max_y()) );
+    T const safe_z = max( grid.min_z(), min( z, grid.max_z()) );
+
+    size_t i0, j0, k0, i1, j1, k1;
+
+    enclosing_indices( grid, safe_x, safe_y, safe_z, i0, j0, k0, i1, j1, k1 );
+
+    D const d000 = grid( i0, j0, k0 );
+    D const d001 = grid( i1, j0, k0 );
+    D const d010 = grid( i0, j1, k0 );
+    D const d011 = grid( i1, j1, k0 );
+    D const d100 = grid( i0, j0, k1 );
+    D const d101 = grid( i1, j0, k1 );
+    D const d110 = grid( i0, j1, k1 );
+    D const d111 = grid( i1, j1, k1 );
+
+    T const s = ( safe_x - ( i0*grid.dx() + grid.min_x() ) ) / grid.dx();
+    T const t = ( safe_y - ( j0*grid.dy() + grid.min_y() ) ) / grid.dy();
+    T const u = ( safe_z - ( k0*grid.dz() + grid.min_z() ) ) / grid.dz();
+
+    T const ms = VT::one() - s;
+    T const mt = VT::one() - t;
+    T const mu = VT::one() - u;
+
+    // Derivatives of the interpolant with respect to the local cell coordinates
+    D const ds = ( ( d001 - d000 )*mt*mu + ( d011 - d010 )*t*mu + ( d101 - d100 )*mt*u + ( d111 - d110 )*t*u );
+    D const dt = ( ( d010 - d000 )*ms*mu + ( d011 - d001 )*s*mu + ( d110 - d100 )*ms*u + ( d111 - d101 )*s*u );
+    D const du = ( ( d100 - d000 )*ms*mt + ( d101 - d001 )*s*mt + ( d110 - d010 )*ms*t + ( d111 - d011 )*s*t );
+
+    gx = ds / grid.dx();
+    gy = dt / grid.dy();
+    gz = du / grid.dz();
+  }
+
+} // namespace grid
+
+// GRID_GRADIENT_AT_H
+#endif
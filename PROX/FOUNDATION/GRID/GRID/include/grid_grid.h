@@ -4,6 +4,7 @@
 #include <tiny_value_traits.h>
 
 #include <vector>
+#include <cassert>
 
 namespace grid
 {
@@ -62,14 +63,14 @@ namespace grid
     , m_data( )
     {}
 
-    Grid(Grid<D,T,I> const & G)
+    Grid(Grid<D,T> const & G)
     {
       *this = G;
     }
 
     ~Grid(){}
 
-    Grid<D,T,I> & operator=(Grid<D,T,I> const & grid)
+    Grid<D,T> & operator=(Grid<D,T> const & grid)
     {
       if( this != &grid)
       {
@@ -107,9 +108,9 @@ namespace grid
       assert( max_x > min_x || !"create(): max_x was less than equal min_x");
       assert( max_y > min_y || !"create(): max_y was less than equal min_y");
       assert( max_z > min_z || !"create(): max_z was less than equal min_z");
-      assert( I>0           || !"create(): I must be positive");
-      assert( J>0           || !"create(): J must be positive");
-      assert( K>0           || !"create(): K must be positive");
+      assert( I>1           || !"create(): I must be larger than one");
+      assert( J>1           || !"create(): J must be larger than one");
+      assert( K>1           || !"create(): K must be larger than one");
 
       this->m_min_x = min_x;
       this->m_min_y = min_y;
@@ -167,8 +168,8 @@ namespace grid
     size_t const & J() const { return this->m_J; }
     size_t const & K() const { return this->m_K; }
 
-    D       * data_ptr()       { return this->m_data[0]; }
-    D const * data_ptr() const { return this->m_data[0]; }
+    D       * data_ptr()       { return &(this->m_data[0]); }
+    D const * data_ptr() const { return &(this->m_data[0]); }
 
   };
 
@@ -3,17 +3,22 @@
 
 #include <grid_enclosing_indices.h>
 
-#include <tiny_trillinear.h>
+#include <tiny_trilinear.h>
 #include <tiny_is_number.h>
 #include <tiny_is_finite.h>
 
 #include <cmath>
+#include <cassert>
 
 namespace grid
 {
 
+  /**
+   * Trilinear interpolation of the grid values.
+   * Points outside the grid are clamped to the grid boundary.
+   */
   template<typename D,typename T>
-  inline typename D value_at(Grid<D,T> const & grid, T const & x,  T const & y, T const & z )
+  inline D value_at(Grid<D,T> const & grid, T const & x,  T const & y, T const & z )
   {
     assert( is_number(x) || !"value_at(): x was not a number");
     assert( is_finite(x) || !"value_at(): x was not finite"  );
@@ -31,7 +36,7 @@ namespace grid
 
     size_t i0, j0, k0, i1, j1, k1;
 
-    enclosing_indices( grid, x, y, z, i0, j0, k0, i1, j1, k1 );
+    enclosing_indices( grid, safe_x, safe_y, safe_z, i0, j0, k0, i1, j1, k1 );
 
     D const d000 = grid( i0, j0, k0 );
     D const d001 = grid( i1, j0, k0 );
@@ -42,11 +47,11 @@ namespace grid
     D const d110 = grid( i0, j1, k1 );
     D const d111 = grid( i1, j1, k1 );
 
-    T const s = ( x - ( i0*grid.dx() + grid.min_x() ) ) / grid.dx();
-    T const t = ( y - ( j0*grid.dy() + grid.min_y() ) ) / grid.dy();
-    T const u = ( z - ( k0*grid.dz() + grid.min_z() ) ) / grid.dz();
+    T const s = ( safe_x - ( i0*grid.dx() + grid.min_x() ) ) / grid.dx();
+    T const t = ( safe_y - ( j0*grid.dy() + grid.min_y() ) ) / grid.dy();
+    T const u = ( safe_z - ( k0*grid.dz() + grid.min_z() ) ) / grid.dz();
 
-    return tiny::trillinear( d000, d001, d010, d011, d100, d101, d110, d111, s, t, u );
+    return tiny::trilinear( d000, d001, d010, d011, d100, d101, d110, d111, s, t, u );
   }
 
 } // namespace grid
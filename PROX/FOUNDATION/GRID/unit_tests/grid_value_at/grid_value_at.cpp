@@ -0,0 +1,79 @@
+#include <grid_grid.h>
+#include <grid_node_position.h>
+#include <grid_value_at.h>
+#include <grid_gradient_at.h>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/test_tools.hpp>
+
+BOOST_AUTO_TEST_SUITE(GRID);
+
+BOOST_AUTO_TEST_CASE(enclosing_indices_test)
+{
+  typedef grid::Grid<float,float> grid_type;
+
+  grid_type G;
+
+  G.create( -1.0f, 0.0f, 1.0f, 1.0f, 4.0f, 2.0f, 3u, 5u, 3u );
+
+  size_t i0, j0, k0, i1, j1, k1;
+
+  grid::enclosing_indices( G, 0.5f, 2.5f, 1.25f, i0, j0, k0, i1, j1, k1 );
+
+  BOOST_CHECK_EQUAL( i0, 1u );
+  BOOST_CHECK_EQUAL( j0, 2u );
+  BOOST_CHECK_EQUAL( k0, 0u );
+  BOOST_CHECK_EQUAL( i1, 2u );
+  BOOST_CHECK_EQUAL( j1, 3u );
+  BOOST_CHECK_EQUAL( k1, 1u );
+
+  // Points on or outside the boundary must give valid cells
+  grid::enclosing_indices( G, 1.0f, 10.0f, -3.0f, i0, j0, k0, i1, j1, k1 );
+
+  BOOST_CHECK_EQUAL( i0, 1u );
+  BOOST_CHECK_EQUAL( j0, 3u );
+  BOOST_CHECK_EQUAL( k0, 0u );
+  BOOST_CHECK_EQUAL( i1, 2u );
+  BOOST_CHECK_EQUAL( j1, 4u );
+  BOOST_CHECK_EQUAL( k1, 1u );
+}
+
+BOOST_AUTO_TEST_CASE(value_at_test)
+{
+  typedef grid::Grid<float,float> grid_type;
+
+  grid_type G;
+
+  G.create( -1.0f, -2.0f, 0.0f, 1.0f, 2.0f, 3.0f, 5u, 9u, 4u );
+
+  // Fill grid with a linear function, trilinear interpolation must reproduce it
+  for(size_t k = 0u; k < G.K(); ++k)
+    for(size_t j = 0u; j < G.J(); ++j)
+      for(size_t i = 0u; i < G.I(); ++i)
+      {
+        float x, y, z;
+        grid::node_position( G, i, j, k, x, y, z );
+        G(i,j,k) = 2.0f*x - y + 0.5f*z + 1.0f;
+      }
+
+  float const x = 0.3f;
+  float const y = -1.1f;
+  float const z = 2.2f;
+
+  BOOST_CHECK_CLOSE( grid::value_at( G, x, y, z ), 2.0f*x - y + 0.5f*z + 1.0f, 0.01f );
+
+  float gx, gy, gz;
+  grid::gradient_at( G, x, y, z, gx, gy, gz );
+
+  BOOST_CHECK_CLOSE( gx,  2.0f, 0.01f );
+  BOOST_CHECK_CLOSE( gy, -1.0f, 0.01f );
+  BOOST_CHECK_CLOSE( gz,  0.5f, 0.01f );
+
+  // Outside points are clamped to the boundary
+  BOOST_CHECK_CLOSE( grid::value_at( G, 5.0f, 2.0f, 3.0f ), 2.0f - 2.0f + 1.5f + 1.0f, 0.01f );
+}
+
+BOOST_AUTO_TEST_SUITE_END();
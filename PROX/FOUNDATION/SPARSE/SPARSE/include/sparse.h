@@ -16,6 +16,7 @@
 #include <sparse_column_prod_blas2.h>
 #include <sparse_sum.h>
 #include <sparse_transpose.h>
+#include <sparse_convert.h>
 #include <sparse_diag_of_prod.h>
 #include <sparse_swap.h>
 #include <sparse_inverse.h>
@@ -5,6 +5,9 @@
 
 #include <cstring>  // for memset
 #include <cassert>
+#include <algorithm>
+#include <iterator>
+#include <vector>
 
 namespace sparse
 {
@@ -74,6 +77,94 @@ namespace sparse
       prod( lhs(row, column), rhs, res(row) ); // 2010-05-30 mrtn: This lookup is very expensive - optimize if possible
     }
   }
+
+  /**
+   * Precompute where the blocks used by column_prod are stored in lhs.
+   *
+   * Let the pth stored block of lhsT be at row k and column i, then
+   * index[p] is the position of block (i,k) in the block storage of lhs.
+   * If lhs has no block at (i,k), index[p] is the number of stored blocks
+   * of lhs. The index stays valid as long as neither matrix is changed,
+   * and lets column_prod skip the binary search for every block.
+   */
+  template <typename B1, typename B2>
+  inline void column_prod_index(
+                                CompressedRowMatrix<B1> const& lhs
+                                , CompressedRowMatrix<B2> const& lhsT
+                                , std::vector<size_t> & index
+                                )
+  {
+    assert( ( (lhs.ncols() == lhsT.nrows()) && (lhs.nrows() == lhsT.ncols()) ) || !"lhsT must have the same form as lhs transposed");
+
+    typedef typename CompressedRowMatrix<B1>::accessor A1;
+    typedef typename CompressedRowMatrix<B2>::accessor A2;
+
+    typename A1::row_ptrs_container_type const & lhs_row_ptrs  = A1::row_ptrs(lhs);
+    typename A1::cols_container_type     const & lhs_cols      = A1::cols(lhs);
+    typename A2::row_ptrs_container_type const & lhsT_row_ptrs = A2::row_ptrs(lhsT);
+    typename A2::cols_container_type     const & lhsT_cols     = A2::cols(lhsT);
+
+    size_t const none = lhs_cols.size();
+
+    index.resize( lhsT_cols.size() );
+
+    for (size_t k = 0u; k + 1u < lhsT_row_ptrs.size(); ++k)
+    {
+      for (size_t p = lhsT_row_ptrs[k]; p < lhsT_row_ptrs[k+1u]; ++p)
+      {
+        size_t const i = lhsT_cols[p];
+
+        index[p] = none;
+
+        if (i + 1u < lhs_row_ptrs.size())
+        {
+          typename A1::cols_container_type::const_iterator first = lhs_cols.begin() + lhs_row_ptrs[i];
+          typename A1::cols_container_type::const_iterator last  = lhs_cols.begin() + lhs_row_ptrs[i+1u];
+          typename A1::cols_container_type::const_iterator iter  = std::lower_bound(first, last, k);
+
+          if (iter != last && *iter == k)
+            index[p] = std::distance(lhs_cols.begin(), iter);
+        }
+      }
+    }
+  }
+
+  /**
+   * Column product between the ith column of lhs with the rhs block, using
+   * an index computed by column_prod_index to find the blocks of lhs
+   * without searching.
+   * res += lhs_column * rhs
+   */
+  template <typename B1, typename B2, typename B3, typename B4>
+  inline void column_prod(
+                     CompressedRowMatrix<B1> const& lhs
+                   , CompressedRowMatrix<B2> const& lhsT
+                   , std::vector<size_t> const& index
+                   , B3 const& rhs
+                   , Vector<B4>& res
+                   , size_t const column
+                   )
+  {
+    typedef typename CompressedRowMatrix<B1>::accessor A1;
+    typedef typename CompressedRowMatrix<B2>::accessor A2;
+
+    typename A1::data_container_type     const & lhs_data      = A1::data(lhs);
+    typename A2::row_ptrs_container_type const & lhsT_row_ptrs = A2::row_ptrs(lhsT);
+    typename A2::cols_container_type     const & lhsT_cols     = A2::cols(lhsT);
+
+    assert( index.size() == lhsT_cols.size() || !"index was not computed for lhsT");
+
+    if (column + 1u >= lhsT_row_ptrs.size())
+      return;
+
+    for (size_t p = lhsT_row_ptrs[column]; p < lhsT_row_ptrs[column+1u]; ++p)
+    {
+      size_t const idx = index[p];
+
+      if (idx < lhs_data.size())
+        prod( lhs_data[idx], rhs, res(lhsT_cols[p]) );
+    }
+  }
 } // namespace sparse
 
 // SPARSE_COLUMN_PROD_BLAS2_H
@@ -24,7 +24,7 @@ namespace sparse
   // 2015-03-09 Kenny code review: Valute traits should be used to set contact values etc internally in the methods to avoid problems of type conversion.
 
   template<size_t N, typename T>
-  inline void conjugate_gradient(
+  inline bool conjugate_gradient(
                                    CompressedRowMatrix<Block<N,N,T> > const & A
                                  , Vector<Block<N,1,T> >                    & x
                                  , Vector<Block<N,1,T> >              const & b
@@ -34,7 +34,7 @@ namespace sparse
 
     make_identity_preconditioner(P);
 
-    preconditioned_conjugate_gradient(P,A,x,b);
+    return preconditioned_conjugate_gradient(P,A,x,b);
   }
 
   /**
@@ -45,10 +45,14 @@ namespace sparse
    * @param x    Upon  return holds the approximate solution to A x = b.
    * @param b    The right hand side vector
    *
+   * @return     If false then a search direction d with d^T A d <= 0 was
+   *             met. A is then not positive definite and the iterations
+   *             were stopped, x holds the iterate reached so far.
+   *
    * 2014-XX-XX Taus comment: Only tested with unit preconditioner
    */
   template<size_t N, typename T>
-  inline void preconditioned_conjugate_gradient(
+  inline bool preconditioned_conjugate_gradient(
                                                   CompressedRowMatrix<Block<N,N,T> > const & P
                                                 , CompressedRowMatrix<Block<N,N,T> > const & A
                                                 , Vector<Block<N,1,T> >                    & x
@@ -101,6 +105,17 @@ namespace sparse
       // alpha <- <r,z>/<y,p>
       T yd;
       inner_prod(y,d, yd);
+
+      // The step length is only well defined along directions of positive curvature
+      if( yd <= T(0) )
+      {
+        util::Log logging;
+
+        logging << "preconditioned_conjugate_gradient(): matrix is not positive definite, stopped after " << i << " iterations" << util::Log::newline();
+
+        return false;
+      }
+
       T alpha = rz / yd;
 
       // x <- x + alpha * p
@@ -137,6 +152,8 @@ namespace sparse
     util::Log logging;
 
     logging << "finished in " << i << " iterations, with a residual of " << rz << util::Log::newline();
+
+    return true;
   }
 
 }// end namespace sparse
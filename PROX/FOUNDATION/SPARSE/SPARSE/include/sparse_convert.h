@@ -0,0 +1,70 @@
+#ifndef SPARSE_CONVERT_H
+#define SPARSE_CONVERT_H
+
+#include <sparsefwd.h>
+
+#include <cassert>
+
+namespace sparse
+{
+
+  /**
+   * Convert the entries of a block to another value type.
+   */
+  template <size_t M, size_t N, typename T1, typename T2>
+  inline void convert(Block<M,N,T1> const & A, Block<M,N,T2> & B)
+  {
+    for (size_t i = 0; i < M*N; ++i)
+    {
+      B[i] = static_cast<T2>( A[i] );
+    }
+  }
+
+  /**
+   * Convert the blocks of a vector to another value type.
+   */
+  template <typename B1, typename B2>
+  inline void convert(Vector<B1> const & a, Vector<B2> & b)
+  {
+    size_t const N = a.size();
+
+    b.resize(N);
+
+    for (size_t i = 0; i < N; ++i)
+    {
+      convert(a(i), b(i));
+    }
+  }
+
+  /**
+   * Convert the blocks of a compressed row matrix to another value type.
+   * The sparsity pattern of B becomes that of A.
+   */
+  template <typename B1, typename B2>
+  inline void convert(CompressedRowMatrix<B1> const & A, CompressedRowMatrix<B2> & B)
+  {
+    typedef CompressedRowMatrix<B1>   A_type;
+    typedef CompressedRowMatrix<B2>   B_type;
+    typedef typename A_type::accessor A_A;
+    typedef typename B_type::accessor B_A;
+
+    typename A_A::data_container_type const & A_data = A_A::data(A);
+    typename B_A::data_container_type       & B_data = B_A::data(B);
+
+    B_A::nrows(B)    = A.nrows();
+    B_A::ncols(B)    = A.ncols();
+    B_A::row_ptrs(B) = A_A::row_ptrs(A);
+    B_A::cols(B)     = A_A::cols(A);
+
+    B_data.resize(A_data.size());
+
+    for (size_t i = 0; i < A_data.size(); ++i)
+    {
+      convert(A_data[i], B_data[i]);
+    }
+  }
+
+} // namespace sparse
+
+// SPARSE_CONVERT_H
+#endif
@@ -130,4 +130,60 @@ BOOST_AUTO_TEST_CASE(col_prod_with_transpose)
   BOOST_CHECK( f_w(1) == result );
   BOOST_CHECK( f_w(2) == result );
 }
+BOOST_AUTO_TEST_CASE(col_prod_with_index)
+{
+  typedef sparse::Block<6,4,float> block6x4_type;
+  typedef sparse::Block<4,6,float> block4x6_type;
+  typedef sparse::Block<4,1,float> block4x1_type;
+  typedef sparse::Block<6,1,float> block6x1_type;
+  typedef sparse::CompressedRowMatrix<block6x4_type> matrix6x4_type;
+  typedef sparse::CompressedRowMatrix<block4x6_type> matrix4x6_type;
+  typedef sparse::Vector<block6x1_type> vector_type;
+
+  matrix6x4_type JT(4,3,6);
+  sparse::fill(JT(0,0), 1.0f);
+  sparse::fill(JT(1,1), 2.0f);
+  sparse::fill(JT(1,2), 3.0f);
+  sparse::fill(JT(2,0), 4.0f);
+  sparse::fill(JT(2,2), 5.0f);
+  sparse::fill(JT(3,1), 6.0f);
+
+  matrix4x6_type J;
+  sparse::transpose(JT, J);
+
+  // The block (1,1) of JT is kept in J but dropped from WJT, as happens
+  // when W is zero for a body
+  matrix6x4_type WJT(4,3,5);
+  sparse::fill(WJT(0,0), 1.0f);
+  sparse::fill(WJT(1,2), 3.0f);
+  sparse::fill(WJT(2,0), 4.0f);
+  sparse::fill(WJT(2,2), 5.0f);
+  sparse::fill(WJT(3,1), 6.0f);
+
+  std::vector<size_t> index;
+  sparse::column_prod_index( WJT, J, index );
+
+  BOOST_CHECK_EQUAL( index.size(), 6u );
+
+  vector_type w_search(4);
+  vector_type w_index(4);
+  for (size_t i = 0; i < 4; ++i)
+  {
+    sparse::fill(w_search(i));
+    w_index(i) = w_search(i);
+  }
+
+  block4x1_type delta_x(0);
+  sparse::fill(delta_x);
+
+  for (size_t k = 0; k < 3; ++k)
+  {
+    column_prod( WJT, J, delta_x, w_search, k);
+    column_prod( WJT, J, index, delta_x, w_index, k);
+  }
+
+  for (size_t i = 0; i < 4; ++i)
+    BOOST_CHECK( w_index(i) == w_search(i) );
+}
+
 BOOST_AUTO_TEST_SUITE_END();
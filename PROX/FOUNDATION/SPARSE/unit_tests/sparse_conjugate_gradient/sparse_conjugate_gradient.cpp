@@ -185,4 +185,42 @@ BOOST_AUTO_TEST_CASE(sparse_conjugate_gradient_test)
   }
 }
 
+BOOST_AUTO_TEST_CASE(sparse_conjugate_gradient_indefinite_test)
+{
+  typedef sparse::Block<3,3,float>                    block3x3_type;
+  typedef sparse::Block<3,1,float>                    block3x1_type;
+  typedef sparse::Vector<block3x1_type>               block3Vector_type;
+  typedef sparse::CompressedRowMatrix<block3x3_type>  compressed3x3_type;
+
+  compressed3x3_type A;
+  block3Vector_type x;
+  block3Vector_type b;
+
+  A.resize(4,4,4);
+  x.resize(4);
+  b.resize(4);
+
+  for(int i = 0; i < 4; ++i)
+  {
+    A(i,i) = block3x3_type::identity();
+    sparse::mul(2.0f,A(i,i));
+    b(i)= 1;
+  }
+  //positive definite matrices are solved
+  BOOST_CHECK( conjugate_gradient(A,x,b) );
+
+  //negative definite matrices are reported, CG never takes a step
+  for(int i = 0; i < 4; ++i)
+  {
+    sparse::mul(-1.0f,A(i,i));
+  }
+  x.clear_data();
+
+  BOOST_CHECK( !conjugate_gradient(A,x,b) );
+  for(size_t i = 0; i < x.size(); ++i)
+  {
+    BOOST_CHECK(x(i) == block3x1_type(0.0f));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,122 @@
+#include <sparse.h>
+
+#include <sparse_fill.h>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/test_tools.hpp>
+
+BOOST_AUTO_TEST_SUITE(SPARSE);
+
+BOOST_AUTO_TEST_CASE(convert_block_test)
+{
+  sparse::Block<4,6,double> A;
+  sparse::Block<4,6,float>  B;
+
+  sparse::fill(A);
+
+  A(1,2) = 0.1;
+
+  sparse::convert(A, B);
+
+  for (size_t i = 0; i < 4; ++i)
+    for (size_t j = 0; j < 6; ++j)
+      BOOST_CHECK( B(i,j) == static_cast<float>( A(i,j) ) );
+}
+
+BOOST_AUTO_TEST_CASE(convert_vector_test)
+{
+  typedef sparse::Vector< sparse::Block<4,1,double> > double_vector_type;
+  typedef sparse::Vector< sparse::Block<4,1,float> >  float_vector_type;
+
+  double_vector_type a;
+  float_vector_type  b;
+  double_vector_type c;
+
+  a.resize(3);
+  sparse::fill(a);
+
+  sparse::convert(a, b);
+  sparse::convert(b, c);
+
+  BOOST_CHECK( b.size() == a.size() );
+  BOOST_CHECK( c.size() == a.size() );
+
+  for (size_t k = 0; k < a.size(); ++k)
+    for (size_t i = 0; i < 4; ++i)
+    {
+      BOOST_CHECK( b(k)(i) == static_cast<float>( a(k)(i) ) );
+      BOOST_CHECK( c(k)(i) == a(k)(i) );
+    }
+
+  // Converting an empty vector must clear out old blocks
+  a.clear();
+  sparse::convert(a, b);
+
+  BOOST_CHECK( b.size() == 0u );
+}
+
+BOOST_AUTO_TEST_CASE(convert_crm_test)
+{
+  typedef sparse::CompressedRowMatrix< sparse::Block<4,6,double> > double_matrix_type;
+  typedef sparse::CompressedRowMatrix< sparse::Block<4,6,float> >  float_matrix_type;
+
+  double_matrix_type A;
+  float_matrix_type  B;
+
+  A.resize(5,5,8);
+  sparse::fill(A(0,0));
+  sparse::fill(A(0,4));
+  sparse::fill(A(1,1));
+  sparse::fill(A(1,2));
+  sparse::fill(A(2,3));
+  sparse::fill(A(2,4));
+  sparse::fill(A(4,2));
+  sparse::fill(A(4,4));
+
+  // B is given a different pattern up front, it must be replaced by that of A
+  B.resize(2,2,1);
+  sparse::fill(B(1,1));
+
+  sparse::convert(A, B);
+
+  BOOST_CHECK( B.size()  == A.size()  );
+  BOOST_CHECK( B.nrows() == A.nrows() );
+  BOOST_CHECK( B.ncols() == A.ncols() );
+
+  for (size_t r = 0; r <= A.nrows(); ++r)
+    BOOST_CHECK( B.row_idx(r) == A.row_idx(r) );
+
+  for (size_t k = 0; k < A.size(); ++k)
+  {
+    BOOST_CHECK( B.col_of_idx(k) == A.col_of_idx(k) );
+
+    for (size_t i = 0; i < 4; ++i)
+      for (size_t j = 0; j < 6; ++j)
+        BOOST_CHECK( B[k](i,j) == static_cast<float>( A[k](i,j) ) );
+  }
+
+  // Products with the converted matrix agree with the original
+  sparse::Vector< sparse::Block<6,1,double> > x;
+  sparse::Vector< sparse::Block<6,1,float> >  xf;
+  sparse::Vector< sparse::Block<4,1,double> > y;
+  sparse::Vector< sparse::Block<4,1,float> >  yf;
+
+  x.resize(5);
+  sparse::fill(x);
+  sparse::convert(x, xf);
+
+  y.resize(5);
+  yf.resize(5);
+
+  sparse::prod(A, x, y);
+  sparse::prod(B, xf, yf);
+
+  for (size_t k = 0; k < 5; ++k)
+    for (size_t i = 0; i < 4; ++i)
+      BOOST_CHECK_CLOSE( static_cast<double>( yf(k)(i) ), y(k)(i), 0.01 );
+}
+
+BOOST_AUTO_TEST_SUITE_END();
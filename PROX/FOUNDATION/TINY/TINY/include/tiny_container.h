@@ -67,20 +67,20 @@ namespace tiny
         
       private:
         
-        typedef union 
-          {
-            real_type real[stride];
-            op_type op;
-          } Converter;
-        
+        // The elements are only ever accessed through m_data with their
+        // own type. Casting m_data to a union or to op_type pointers breaks
+        // strict aliasing and GCC miscompiles inlined kernels when it does.
+        // The ScalarTraits are the only traits in use and have op_type equal
+        // to real_type. The SSETraits are disabled, and would have to go
+        // through their load_op_type and store_op_type instead.
         op_type get_op_type ( size_t const & i , size_t const & j ) const 
         {
-          return reinterpret_cast<Converter const *>( m_data + i*J_padded + j )->op;
+          return m_data[ i*J_padded + j ];
         }
         
         op_type & get_op_type ( size_t const & i , size_t const & j ) 
         {
-          return reinterpret_cast<Converter*>( m_data + i*J_padded + j )->op;
+          return m_data[ i*J_padded + j ];
         }
         
       public:
@@ -27,6 +27,7 @@ namespace tiny
       *
       *
       * @return     If the decompostion is succesfull then the return value is true otherwise it is false.
+      *             Upon failure R is set to the identity and S to A, such that A = R S still holds.
       */
       template<typename matrix3x3_type>
       inline bool polar_decomposition_eigen(matrix3x3_type const & A,matrix3x3_type & R,matrix3x3_type & S)
@@ -62,7 +63,11 @@ namespace tiny
 
         //--- Test if all eigenvalues are positive
         if( d(0) <= value_traits::zero() || d(1) <= value_traits::zero() || d(2) <= value_traits::zero() )
+        {
+          R = matrix3x3_type::identity();
+          S = A;
           return false;
+        }
 
         vector3_type v0 = vector3_type::make( V(0,0), V(1,0), V(2,0) );
         vector3_type v1 = vector3_type::make( V(0,1), V(1,1), V(2,1) );
@@ -222,4 +222,34 @@ BOOST_AUTO_TEST_CASE(float4x1_test)
   BOOST_CHECK_CLOSE( C(3,0), 4.0f, 0.01f );
 }
 
+BOOST_AUTO_TEST_CASE(accessor_cast_test)
+{
+  typedef tiny::ScalarTraits<double>                  double_traits;
+  typedef tiny::detail::Container<3,3,double_traits>  container3x3;
+  typedef container3x3::accessor                      accessor3x3;
+
+  container3x3 C;
+  for (size_t i = 0; i<3 ; ++i)
+    for (size_t j = 0 ; j<3 ; ++j)
+      accessor3x3::cast(C,i,j) = 3.0*i + j;
+
+  // Values written through the accessor must be seen through m_data and
+  // through the const accessor, also when all of it is inlined together.
+  container3x3 const & D = C;
+  for (size_t i = 0; i<3 ; ++i)
+    for (size_t j = 0 ; j<3 ; ++j)
+    {
+      BOOST_CHECK_EQUAL( C.m_data[3*i + j], 3.0*i + j );
+      BOOST_CHECK_EQUAL( accessor3x3::cast(D,i,j), 3.0*i + j );
+    }
+
+  for (size_t i = 0; i<3 ; ++i)
+    for (size_t j = 0 ; j<3 ; ++j)
+      accessor3x3::cast(C,i,j) += C.m_data[3*i + j];
+
+  for (size_t i = 0; i<3 ; ++i)
+    for (size_t j = 0 ; j<3 ; ++j)
+      BOOST_CHECK_EQUAL( C(i,j), 2.0*(3.0*i + j) );
+}
+
 BOOST_AUTO_TEST_SUITE_END();
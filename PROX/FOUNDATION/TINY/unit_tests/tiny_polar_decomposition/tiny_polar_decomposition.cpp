@@ -48,4 +48,29 @@ BOOST_AUTO_TEST_SUITE(tiny_polar_decomposition);
     }
   }
 
+  BOOST_AUTO_TEST_CASE(eigen_method_singular)
+  {
+    typedef tiny::MathTypes<double>                   math_types;
+    typedef math_types::matrix3x3_type                matrix3x3_type;
+    typedef math_types::real_type                     real_type;
+
+    matrix3x3_type A = matrix3x3_type::make_diag(1.0);
+    A(2,2) = 0.0;
+
+    matrix3x3_type R(2.0);
+    matrix3x3_type S(2.0);
+
+    bool success = tiny::polar_decomposition_eigen(A,R,S);
+    BOOST_CHECK( !success );
+
+    // Upon failure R is the identity and S is A
+    for(size_t i=0;i<3;++i)
+      for(size_t j=0;j<3;++j)
+      {
+        real_type const delta = (i==j) ? 1.0 : 0.0;
+        BOOST_CHECK_EQUAL( R(i,j), delta );
+        BOOST_CHECK_EQUAL( S(i,j), A(i,j) );
+      }
+  }
+
 BOOST_AUTO_TEST_SUITE_END();
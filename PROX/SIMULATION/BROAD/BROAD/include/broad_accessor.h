@@ -14,6 +14,10 @@ namespace broad
         
         static typename System<T>::grid_type & get_grid(System<T> & sys ){ return sys.m_grid; }
         
+        static typename System<T>::sweep_and_prune_type & get_sweep_and_prune(System<T> & sys ){ return sys.m_sweep_and_prune; }
+
+        static typename System<T>::parallel_grid_type & get_parallel_grid(System<T> & sys ){ return sys.m_parallel_grid; }
+
         static typename System<T>::object_ptr_container & get_objects( System<T>  & S ){ return S.m_object_ptrs; }
         
       };
@@ -5,6 +5,8 @@
 #include "broad_object.h"
 #include "broad_accessor.h"
 #include "broad_grid.h"
+#include "broad_sweep_and_prune.h"
+#include "broad_parallel_grid.h"
 
 #include <util_log.h>
 
@@ -21,6 +23,8 @@ namespace broad
    */
   struct grid_algorithm {};
   struct all_pair_algorithm {};
+  struct sweep_and_prune_algorithm {};
+  struct parallel_grid_algorithm {};
     
   namespace detail
   {
@@ -134,6 +138,13 @@ namespace broad
 
   /**
    * This function implements a simple grid based algorithm for broad phase collision detection.
+   * The objects are kept in the grid cells from one query to the next and
+   * only the objects whose range of cells has changed are moved. The grid
+   * is rebuilt from scratch whenever objects have been connected to or
+   * disconnected from the system, or when the cell spacing has changed.
+   *
+   * A pair of objects sharing several cells is only reported by the cell at
+   * the minimum corner of the intersection of their cell ranges.
    *
    * @param efficiency    Upon return this argument gives the ratio of number of found
    *                      overlaps divided by the actual overlap tests done. A ratio of
@@ -147,188 +158,87 @@ namespace broad
                             , grid_algorithm const & /*tag*/
                             )
   {
+    using std::max;
+
     typedef detail::Accessor<T>                                accessor;
-    typedef Object<T>                                          object_type;
     typedef typename System<T>::object_ptr_container           object_ptr_container;
-    typedef typename object_ptr_container::iterator            object_ptr_iterator;
     
     typedef detail::Grid<T>                    grid_type;
     typedef detail::Cell<T>                    cell_type;
-    typedef typename grid_type::cell_iterator  cell_iterator;
     
     // Clean up any potential old left over information
     overlaps.clear();
     
-    // Prepare grid for new collision query
-    grid_type & grid = accessor::get_grid( sys );
-    grid.clear();
-    
-    // Reset touched time stamp on all grid cells so we can guard against hash
-    // collisions in the grid
+    object_ptr_container & objects = accessor::get_objects( sys );
+    grid_type            & grid    = accessor::get_grid( sys );
+
+    // Bring the objects stored in the grid cells up to date
+    bool const rebuild = !grid.is_valid( sys.version() );
+
+    if( rebuild )
+      grid.rebuild( objects, sys.version() );
+    else
+      grid.update( objects );
+
+    if( grid.oversized() > 0u )
     {
-      cell_iterator cell       = grid.begin();
-      cell_iterator cell_end   = grid.end();
-      for( ; cell != cell_end; ++cell)
-        cell->touched() = 0u;
+      util::Log logging;
+
+      logging << "broad::find_overlaps(grid_algorithm): WARNING object spans more cells than grid size" << util::Log::newline();
+      logging << "broad::find_overlaps(grid_algorithm): WARNING this suggests bad ratio of object sizes" << util::Log::newline();
+      logging << "broad::find_overlaps(grid_algorithm): WARNING or too few cells in grid" << util::Log::newline();
     }
-    
-    // Next we iterate over all objects and map each object into the cells
-    // of grids. If a cell already contains any objects then we report overlaps
-    // between the already added objects and the newly added object.
-    object_ptr_container & objects = accessor::get_objects( sys );
-    object_ptr_iterator end   = objects.end();
-    object_ptr_iterator iter  = objects.begin();
-  
-    size_t touched_time        = 0u;
-    
+
+    size_t const N = objects.size();
+
     size_t cnt_tests           = 0u;   // Total number of pair wise object tests done
-    size_t cnt_hash_collisions = 0u;   // Total number of times we encountered a cell hash collision
     size_t cnt_skipped_tests   = 0u;   // Total number of times we skipped a redundant pair-wise test
 
-    for(; iter!=end; ++iter)
+    for(size_t a = 0u; a < N; ++a)
     {
-      ++touched_time;
-      
-      object_type * A = *iter;
-      
-      // Get axis aligned bounding box of object A
-      T min_x_A;
-      T min_y_A;
-      T min_z_A;
-      T max_x_A;
-      T max_y_A;
-      T max_z_A;
-      A->get_box( min_x_A, min_y_A, min_z_A, max_x_A, max_y_A, max_z_A);
-
-      assert(is_number(max_x_A) || !"broad::find_overlaps(): Nan");
-      assert(is_number(max_y_A) || !"broad::find_overlaps(): Nan");
-      assert(is_number(max_z_A) || !"broad::find_overlaps(): Nan");
-      assert(is_number(min_x_A) || !"broad::find_overlaps(): Nan");
-      assert(is_number(min_y_A) || !"broad::find_overlaps(): Nan");
-      assert(is_number(min_z_A) || !"broad::find_overlaps(): Nan");
-
-      assert(is_finite(max_x_A) || !"broad::find_overlaps(): Inf");
-      assert(is_finite(max_y_A) || !"broad::find_overlaps(): Inf");
-      assert(is_finite(max_z_A) || !"broad::find_overlaps(): Inf");
-      assert(is_finite(min_x_A) || !"broad::find_overlaps(): Inf");
-      assert(is_finite(min_y_A) || !"broad::find_overlaps(): Inf");
-      assert(is_finite(min_z_A) || !"broad::find_overlaps(): Inf");
-
-      // Get span of cell indices of all cells that overlap with bounding box of object A
-      int min_i;
-      int min_j;
-      int min_k;
-      int max_i;
-      int max_j;
-      int max_k;
-      grid.get_cell_indices( min_x_A, min_y_A, min_z_A, min_i, min_j, min_k );
-      grid.get_cell_indices( max_x_A, max_y_A, max_z_A, max_i, max_j, max_k );
-
-
-      int const number_of_cells_to_touch = (max_i-min_i+1)*(max_j-min_j+1)*(max_k-min_k+1);
-
-      if(number_of_cells_to_touch > grid.size())
-      {
-        util::Log logging;
-
-        logging << "broad::find_overlaps(grid_algorithm): WARNING object spans more cells than grid size" << util::Log::newline();
-        logging << "broad::find_overlaps(grid_algorithm): WARNING this suggests bad ratio of object sizes" << util::Log::newline();
-        logging << "broad::find_overlaps(grid_algorithm): WARNING or too few cells in grid" << util::Log::newline();
-      }
+      int const * range_a = grid.get_range( a );
 
       // Iterate over all grid cells spanned by the bounding box of object A
-      for ( int i = min_i; i <= max_i; ++i)
-        for ( int j = min_j; j <= max_j; ++j)
-          for ( int k = min_k; k <= max_k; ++k)
+      for ( int i = range_a[0]; i <= range_a[3]; ++i)
+        for ( int j = range_a[1]; j <= range_a[4]; ++j)
+          for ( int k = range_a[2]; k <= range_a[5]; ++k)
           {
-            cell_type & cell = grid.get_cell(i,j,k);
+            cell_type const & cell = grid.get_cell(i,j,k);
 
-            // guard against hash collisions
-            if(cell.touched() == touched_time)
-            {
-              ++cnt_hash_collisions;
-              continue;
-            }
-            
-            // Iterate over all objects already stored in the grid cell
             size_t const number_of_objs = cell.size( grid.get_time() );
-//            {
-//              util::Log logging;
-//              logging << "broad DEBUG "
-//                      << number_of_objs
-//                      << " objects in cell("
-//                      << i << ","
-//                      << j << ","
-//                      << k << ")"
-//                      << util::Log::newline();
-//            }
 
             for( size_t idx=0u; idx < number_of_objs; ++idx)
-            {              
-              object_type * B = cell.get_object_ptr( idx );
+            {
+              size_t const b = cell.get_object_index( idx );
+
+              // Every pair is tested from the object with the smallest index
+              if( b <= a )
+                continue;
+
+              int const * range_b = grid.get_range( b );
 
-              // Test if we have already seen B versus A in this query
-              if( B->m_seen_by == A )
+              // Only the cell at the minimum corner of the shared cell range
+              // reports the pair, this also rejects objects stored in the
+              // cell because of hash collisions
+              if( max( range_a[0], range_b[0] ) != i || max( range_a[1], range_b[1] ) != j || max( range_a[2], range_b[2] ) != k )
               {
                 ++cnt_skipped_tests;
                 continue;
               }
 
-              B->m_seen_by = A;   // Make sure we remember that we have seen (A,B)
-               
-              // Get axis aligned bounding box of object B
-              T min_x_B;
-              T min_y_B;
-              T min_z_B;
-              T max_x_B;
-              T max_y_B;
-              T max_z_B;
-              B->get_box( min_x_B, min_y_B, min_z_B, max_x_B, max_y_B, max_z_B);
-
-              assert(is_number(max_x_B) || !"broad::find_overlaps(): Nan");
-              assert(is_number(max_y_B) || !"broad::find_overlaps(): Nan");
-              assert(is_number(max_z_B) || !"broad::find_overlaps(): Nan");
-              assert(is_number(min_x_B) || !"broad::find_overlaps(): Nan");
-              assert(is_number(min_y_B) || !"broad::find_overlaps(): Nan");
-              assert(is_number(min_z_B) || !"broad::find_overlaps(): Nan");
-
-              assert(is_finite(max_x_B) || !"broad::find_overlaps(): Inf");
-              assert(is_finite(max_y_B) || !"broad::find_overlaps(): Inf");
-              assert(is_finite(max_z_B) || !"broad::find_overlaps(): Inf");
-              assert(is_finite(min_x_B) || !"broad::find_overlaps(): Inf");
-              assert(is_finite(min_y_B) || !"broad::find_overlaps(): Inf");
-              assert(is_finite(min_z_B) || !"broad::find_overlaps(): Inf");
-
               ++cnt_tests;
-              
-              // Test if bounding boxes of A and B are overlapping
-              if(max_x_B  < min_x_A) continue;
-              if(max_x_A  < min_x_B) continue;
-              
-              if(max_y_B  < min_y_A) continue;
-              if(max_y_A  < min_y_B) continue;
-              
-              if(max_z_B  < min_z_A) continue;
-              if(max_z_A  < min_z_B) continue;
-              
+
               // Report that we have found an overlap between the bounding boxes of object A and B.
-              overlaps.push_back( detail::make_overlap(A, B) );
+              if( grid.overlap( a, b ) )
+                overlaps.push_back( detail::make_overlap( objects[a], objects[b] ) );
             }
-            
-            // Finally we mark the cell as touched by object A
-            cell.touched() = touched_time;
-            
-            // and add object A to the cell
-            cell.add( A, grid.get_time() );
-            
-            A->m_seen_by = 0; // Make sure that there are no left overs when we later query against A
           }
     }
     
     // Lexiographic storting of overlaps, this is to ensure deterministic behaviour
     std::sort( overlaps.begin(), overlaps.end() );
 
-    efficiency = 1.0f*overlaps.size() / cnt_tests;
+    efficiency = cnt_tests > 0u ? 1.0f*overlaps.size() / cnt_tests : 1.0f;
 
     {
       size_t cnt_obj     = objects.size();
@@ -342,12 +252,13 @@ namespace broad
       logging << "broad::find_overlaps(..., grid_algorithm): #overlaps        = " << overlaps.size()     << util::Log::newline();
       logging << "broad::find_overlaps(..., grid_algorithm): #tests           = " << cnt_tests           << util::Log::newline();
       logging << "broad::find_overlaps(..., grid_algorithm): #skipped tests   = " << cnt_skipped_tests   << util::Log::newline();
-      logging << "broad::find_overlaps(..., grid_algorithm): #hash collisions = " << cnt_hash_collisions << util::Log::newline();
+      logging << "broad::find_overlaps(..., grid_algorithm): #moved           = " << grid.moved()        << util::Log::newline();
+      logging << "broad::find_overlaps(..., grid_algorithm): rebuild          = " << rebuild             << util::Log::newline();
 
       //--- Raw data for making histogram
       //      logging << " H = [";
-      //      cell_iterator cell       = grid.begin();
-      //      cell_iterator cell_end   = grid.end();
+      //      typename grid_type::cell_iterator cell       = grid.begin();
+      //      typename grid_type::cell_iterator cell_end   = grid.end();
       //      for( ; cell != cell_end; ++cell)
       //        logging << cell->last_size() << ",";
       //      logging << "];"  << util::Log::newline();
@@ -357,6 +268,163 @@ namespace broad
     return (overlaps.size()>0);
   }
     
+  /**
+   * This function implements an incremental sweep and prune algorithm for
+   * broad phase collision detection. The sorted end points and the set of
+   * overlapping boxes are kept in the system from one query to the next, so
+   * when objects only move a little between queries the cost is close to
+   * linear in the number of objects. The data is rebuilt from scratch
+   * whenever objects have been connected to or disconnected from the system.
+   *
+   * @param efficiency    Upon return this argument gives the ratio of number of found
+   *                      overlaps divided by the actual overlap tests done. A ratio of
+   *                      close to 1 is optimal whereas a ratio close to zero is very bad.
+   */
+  template<typename T, typename overlap_container>
+  inline bool find_overlaps(
+                            System<T> & sys
+                            , overlap_container & overlaps
+                            , float & efficiency
+                            , sweep_and_prune_algorithm const & /*tag*/
+                            )
+  {
+    typedef detail::Accessor<T>                                 accessor;
+    typedef typename System<T>::object_ptr_container            object_ptr_container;
+    typedef detail::SweepAndPrune<T>                            sweep_and_prune_type;
+    typedef typename sweep_and_prune_type::pair_container       pair_container;
+    typedef typename pair_container::const_iterator             pair_iterator;
+
+    // Clean up any potential old left over information
+    overlaps.clear();
+
+    object_ptr_container & objects = accessor::get_objects( sys );
+    sweep_and_prune_type & sap     = accessor::get_sweep_and_prune( sys );
+
+    bool const rebuild = !sap.is_valid( sys.version() );
+
+    if( rebuild )
+      sap.rebuild( objects, sys.version() );
+    else
+      sap.update( objects );
+
+    pair_container const & pairs = sap.pairs();
+
+    for(pair_iterator pair = pairs.begin(); pair != pairs.end(); ++pair)
+    {
+      // Report that we have found an overlap between the bounding boxes of the two objects.
+      overlaps.push_back( detail::make_overlap( objects[pair->first], objects[pair->second] ) );
+    }
+
+    // Lexiographic storting of overlaps, this is to ensure deterministic behaviour
+    std::sort( overlaps.begin(), overlaps.end() );
+
+    size_t const cnt_tests = sap.tests();
+
+    efficiency = cnt_tests > 0u ? 1.0f*overlaps.size() / cnt_tests : 1.0f;
+
+    {
+      size_t cnt_obj     = objects.size();
+      size_t upper_bound = (cnt_obj*(cnt_obj - 1u))/ 2;
+
+      util::Log logging;
+
+      logging << "broad::find_overlaps(..., sweep_and_prune_algorithm): efficiency       = " << efficiency          << util::Log::newline();
+      logging << "broad::find_overlaps(..., sweep_and_prune_algorithm): #objects         = " << objects.size()      << util::Log::newline();
+      logging << "broad::find_overlaps(..., sweep_and_prune_algorithm): #bound           = " << upper_bound         << util::Log::newline();
+      logging << "broad::find_overlaps(..., sweep_and_prune_algorithm): #overlaps        = " << overlaps.size()     << util::Log::newline();
+      logging << "broad::find_overlaps(..., sweep_and_prune_algorithm): #tests           = " << cnt_tests           << util::Log::newline();
+      logging << "broad::find_overlaps(..., sweep_and_prune_algorithm): #swaps           = " << sap.swaps()         << util::Log::newline();
+      logging << "broad::find_overlaps(..., sweep_and_prune_algorithm): rebuild          = " << rebuild             << util::Log::newline();
+    }
+
+    // Return a status flag indicating whether we have seen an overlap or not
+    return (overlaps.size()>0);
+  }
+
+  /**
+   * This function implements a multithreaded grid based algorithm for broad
+   * phase collision detection. Objects are binned into the cells of a uniform
+   * grid by sorting (cell, object) entries, after which all cells are
+   * processed in parallel. Duplicate pairs are rejected by only reporting a
+   * pair in the first cell shared by both objects, so no marker is written
+   * on the objects.
+   *
+   * The grid uses the cell spacing of the system, see System::update().
+   *
+   * @param efficiency    Upon return this argument gives the ratio of number of found
+   *                      overlaps divided by the actual overlap tests done. A ratio of
+   *                      close to 1 is optimal whereas a ratio close to zero is very bad.
+   */
+  template<typename T, typename overlap_container>
+  inline bool find_overlaps(
+                            System<T> & sys
+                            , overlap_container & overlaps
+                            , float & efficiency
+                            , parallel_grid_algorithm const & /*tag*/
+                            )
+  {
+    typedef detail::Accessor<T>                                 accessor;
+    typedef typename System<T>::object_ptr_container            object_ptr_container;
+    typedef detail::ParallelGrid<T>                             parallel_grid_type;
+    typedef typename parallel_grid_type::pair_container         pair_container;
+
+    // Clean up any potential old left over information
+    overlaps.clear();
+
+    object_ptr_container & objects = accessor::get_objects( sys );
+    parallel_grid_type   & grid    = accessor::get_parallel_grid( sys );
+
+    // Objects spanning more cells than the hash grid has are oversized in both grids
+    if( ! grid.build( objects, accessor::get_grid( sys ).get_spacing(), accessor::get_grid( sys ).size() ) )
+    {
+      util::Log logging;
+
+      logging << "broad::find_overlaps(parallel_grid_algorithm): WARNING objects span too many cells" << util::Log::newline();
+      logging << "broad::find_overlaps(parallel_grid_algorithm): WARNING falling back to grid algorithm" << util::Log::newline();
+
+      return find_overlaps( sys, overlaps, efficiency, grid_algorithm() );
+    }
+
+    pair_container pairs;
+
+    grid.find_pairs( pairs );
+
+    overlaps.resize( pairs.size() );
+
+#pragma omp parallel for schedule(static)
+    for(long p = 0; p < static_cast<long>( pairs.size() ); ++p)
+    {
+      // Report that we have found an overlap between the bounding boxes of the two objects.
+      overlaps[p] = detail::make_overlap( objects[pairs[p].first], objects[pairs[p].second] );
+    }
+
+    // Lexiographic storting of overlaps, this is to ensure deterministic behaviour
+    detail::parallel_sort( overlaps );
+
+    size_t const cnt_tests = grid.tests();
+
+    efficiency = cnt_tests > 0u ? 1.0f*overlaps.size() / cnt_tests : 1.0f;
+
+    {
+      size_t cnt_obj     = objects.size();
+      size_t upper_bound = (cnt_obj*(cnt_obj - 1u))/ 2;
+
+      util::Log logging;
+
+      logging << "broad::find_overlaps(..., parallel_grid_algorithm): efficiency       = " << efficiency          << util::Log::newline();
+      logging << "broad::find_overlaps(..., parallel_grid_algorithm): #objects         = " << objects.size()      << util::Log::newline();
+      logging << "broad::find_overlaps(..., parallel_grid_algorithm): #bound           = " << upper_bound         << util::Log::newline();
+      logging << "broad::find_overlaps(..., parallel_grid_algorithm): #overlaps        = " << overlaps.size()     << util::Log::newline();
+      logging << "broad::find_overlaps(..., parallel_grid_algorithm): #tests           = " << cnt_tests           << util::Log::newline();
+      logging << "broad::find_overlaps(..., parallel_grid_algorithm): #entries         = " << grid.entries()      << util::Log::newline();
+      logging << "broad::find_overlaps(..., parallel_grid_algorithm): #cells           = " << grid.cells()        << util::Log::newline();
+      logging << "broad::find_overlaps(..., parallel_grid_algorithm): #oversized       = " << grid.oversized()    << util::Log::newline();
+    }
+
+    // Return a status flag indicating whether we have seen an overlap or not
+    return (overlaps.size()>0);
+  }
+
   /**
    * Default version of the find-overlaps function.
    *
@@ -6,7 +6,7 @@
 #include <tiny_is_finite.h>
 #include <tiny_is_number.h>
 
-#include <algorithm>   // needed for std::copy and std::max
+#include <algorithm>   // needed for std::copy, std::equal and std::max
 #include <vector>      // needed for std::vector
 #include <cassert>     // needed for assert
 #include <cmath>       // needed for std::pow and std::floor
@@ -22,25 +22,20 @@ namespace broad
       {
       public:
         
-        typedef Object<T>                               object_type;
-        typedef std::vector<object_type*>               object_ptr_container;
+        typedef std::vector<size_t>                     index_container;
         
       protected:
         
-        size_t                  m_time_stamp;     ///< Timestamp, used to mark last query when data were stored in the cell.
-        size_t                  m_touched_stamp;  ///< Timestamp, used to guard against hash-collisions.
+        size_t                  m_time_stamp;     ///< Timestamp, used to mark the grid time when data were stored in the cell.
         size_t                  m_size;           ///< The number of objects currently stored in the cell.
-        object_ptr_container    m_data;           ///< A reservoir of array entries that can be used for storing objects in the cell.
+        index_container         m_data;           ///< A reservoir of array entries that can be used for storing object indices in the cell.
         
       public:
         
-        size_t       & touched()       { return this->m_touched_stamp;    }
-        size_t const & touched() const { return this->m_touched_stamp;    }
-        
         /**
          * Get the number of objects currently stored in the cell.
          *
-         * @param time    The current grid time. This is basically just an unique number identifying the current query that is in progress.
+         * @param time    The current grid time. Data stored at any other time is invalid.
          */
         size_t size(size_t const & time) const 
         { 
@@ -56,7 +51,6 @@ namespace broad
         
         Cell()
         : m_time_stamp(0u)
-        , m_touched_stamp(0u)
         , m_size(0u)
         , m_data()
         {
@@ -70,7 +64,6 @@ namespace broad
           if( this != &cell)
           {
             this->m_time_stamp    = cell.m_time_stamp;
-            this->m_touched_stamp = cell.m_touched_stamp;
             this->m_size          = cell.m_size;
             this->m_data          = cell.m_data;
           }
@@ -80,16 +73,14 @@ namespace broad
       public:
         
         /**
-         * Add Object to Cell.
+         * Add object to cell. Several world cells may hash to the same cell,
+         * so an object that is already stored in the cell is not added again.
          *
-         * @param time    The current grid time. This is basically just an unique number identifying the current query that is in progress.
+         * @param idx     The index of the object.
+         * @param time    The current grid time. Data stored at any other time is invalid.
          */
-        void add( object_type * obj, size_t const & time )
+        void add( size_t const & idx, size_t const & time )
         {
-          using std::copy;
-          
-          assert( obj  || !"add(): object was null");
-          
           // First test if data stored in cell is valid or not
           if( this->m_time_stamp != time )
           {
@@ -97,53 +88,92 @@ namespace broad
             this->m_time_stamp = time;
           }
           
+          for(size_t e = 0u; e < this->m_size; ++e)
+            if( this->m_data[e] == idx )
+              return;
+          
           // Second test if we got enough space to add one more object otherwise re-allocate internal storage!
           if(this->m_size >= this->m_data.size())
-          {
-            object_ptr_container tmp;
-            
-            tmp = this->m_data;
             this->m_data.resize(2u*this->m_size);
-            copy(
-                 tmp.begin()
-                 , tmp.end()
-                 , this->m_data.begin()
-                 );
-          }
           
-          // Finally we can add a pointer to the object
-          this->m_data[this->m_size++] = obj;
+          // Finally we can add the object
+          this->m_data[this->m_size++] = idx;
+        }
+        
+        /**
+         * Remove object from cell. The last object of the cell takes its place.
+         *
+         * @param idx     The index of the object.
+         * @param time    The current grid time. Data stored at any other time is invalid.
+         */
+        void remove( size_t const & idx, size_t const & time )
+        {
+          if( this->m_time_stamp != time )
+            return;
+          
+          for(size_t e = 0u; e < this->m_size; ++e)
+          {
+            if( this->m_data[e] == idx )
+            {
+              this->m_data[e] = this->m_data[--(this->m_size)];
+              return;
+            }
+          }
         }
         
-        object_type * get_object_ptr( size_t const & idx )
+        size_t const & get_object_index( size_t const & idx ) const
         {
-          assert( idx >= 0u          || !"get_object_ptr(): invalid index");
-          assert( idx < this->m_size || !"get_object_ptr(): invalid index");
+          assert( idx < this->m_size || !"get_object_index(): invalid index");
           return this->m_data[idx];
         }
         
       };
     
+    /**
+     * Hash Grid.
+     * Objects are stored in the cells spanned by their bounding boxes, and
+     * they stay there from one query to the next. On a new query only the
+     * objects whose range of cells has changed are moved, so objects that
+     * are resting or moving slowly cost a single box fetch.
+     *
+     * The stored data is invalidated when the spacing or the number of
+     * cells change, or when the objects of the broad phase system change.
+     */
     template < typename T >
     class Grid
       {
       public:
         
+        typedef Object<T>                             object_type;
+        typedef std::vector<object_type*>             object_ptr_container;
         typedef Cell<T>                               cell_type;
         typedef typename std::vector< cell_type >     cell_storage;
         typedef typename cell_storage::iterator       cell_iterator;
         
       protected:
         
-        size_t                  m_time_stamp;       ///< Query time-stamp. The time stamp of the last valid query. If cells have older time stamps then their data is invalid and can be ignored.
+        size_t                  m_time_stamp;       ///< Grid time-stamp. If cells have older time stamps then their data is invalid and can be ignored.
         T                       m_cell_spacing;     ///< Grid cell spacing. 
         size_t                  m_N;                ///< Internal hash function variable, it mimicks the number of cells in a 3D cubic array of cells. The idea is that the number of objects stored is roughly equal to the number of cells needed. Thus O = N*N*N where O is number of objects and N is the number of cells along a side in the cubic cell array.
         cell_storage            m_cells;            ///< Hash table cells.
         
+        bool                    m_valid;            ///< If true then the cells hold the objects of the system version below.
+        size_t                  m_version;          ///< The version of the connections in the broad phase system the data was made for.
+        std::vector<T>          m_boxes;            ///< Boxes of all objects, six values per object (min x, min y, min z, max x, max y, max z).
+        std::vector<int>        m_ranges;           ///< Cell index ranges of all objects, six values per object (min i, min j, min k, max i, max j, max k).
+        size_t                  m_moved;            ///< The number of objects that were moved to other cells during the last query.
+        size_t                  m_oversized;        ///< The number of objects that spanned more cells than the grid size during the last query.
+        
       public:
         
         size_t const & get_time() const { return this->m_time_stamp;   }
         size_t const   size()     const { return this->m_cells.size(); }
+        size_t const & moved()    const { return this->m_moved;        }
+        size_t const & oversized() const { return this->m_oversized;   }
+
+        bool is_valid(size_t const & version) const { return this->m_valid && this->m_version == version; }
+
+        int const * get_range(size_t const & idx) const { return &(this->m_ranges[6u*idx]); }
 
         cell_iterator begin() { return m_cells.begin(); }
         cell_iterator end()   { return m_cells.end();   }
@@ -155,6 +185,10 @@ namespace broad
         : m_time_stamp(0u)
         , m_cell_spacing(5.0)
         , m_N(0)
+        , m_valid(false)
+        , m_version(0u)
+        , m_moved(0u)
+        , m_oversized(0u)
         {
           this->resize(1000u);
         }
@@ -200,6 +234,8 @@ namespace broad
             size_t const new_size = (this->m_N)*(this->m_N)*(this->m_N);
             
             this->m_cells.resize( new_size, cell_type() );        
+            
+            this->m_valid = false;
           }
         }
         
@@ -207,12 +243,20 @@ namespace broad
         {
           assert( value > 0 || !"set_spacing(): spacing must be a positive value");
 
+          if( value != this->m_cell_spacing )
+            this->m_valid = false;
+
           this->m_cell_spacing = value;
         }
         
         T get_spacing( ) const { return this->m_cell_spacing; }
         
-        cell_type & get_cell(int i, int j, int k)
+        cell_type & get_cell(int const & i, int const & j, int const & k)
+        {
+          return this->m_cells[ this->get_hash_key(i,j,k) ];
+        }
+
+        int get_hash_key(int i, int j, int k) const
         {
           // The model of the hash grid is a cubic cell grid of N*N*N cells
           int const N = this->m_N;
@@ -238,9 +282,7 @@ namespace broad
           // into a 1D index, assuming the N*N*N cell array are stored in a
           // traditional row-major fashion. Afterwards the 1D flat index is
           // taken modulo to the number of hash cells.
-          int hash_key = (  (k*N + j)*N + i ) % C;
-          
-          return this->m_cells[ hash_key ];
+          return (  (k*N + j)*N + i ) % C;
         }
         
         void get_cell_indices(T const & x, T const & y, T const & z, int & i,int & j,int & k) const
@@ -268,6 +310,137 @@ namespace broad
         void clear()
         {
           ++(this->m_time_stamp); /* Lazy deallocation */
+          this->m_valid = false;
+        }
+        
+        /**
+         * Test if the boxes of two objects overlap.
+         */
+        bool overlap(size_t const & a, size_t const & b) const
+        {
+          T const * A = &(this->m_boxes[6u*a]);
+          T const * B = &(this->m_boxes[6u*b]);
+          
+          if(B[3] < A[0]) return false;
+          if(A[3] < B[0]) return false;
+          if(B[4] < A[1]) return false;
+          if(A[4] < B[1]) return false;
+          if(B[5] < A[2]) return false;
+          if(A[5] < B[2]) return false;
+          
+          return true;
+        }
+        
+        /**
+         * Store all objects in the cells from scratch.
+         *
+         * @param objects    The objects of the broad phase system.
+         * @param version    The version of the connections in the broad phase system.
+         */
+        void rebuild(object_ptr_container const & objects, size_t const & version)
+        {
+          this->clear();
+          
+          size_t const N = objects.size();
+          
+          this->m_boxes.resize( 6u*N );
+          this->m_ranges.resize( 6u*N );
+          
+          this->m_oversized = 0u;
+          
+          for(size_t n = 0u; n < N; ++n)
+          {
+            this->fetch_box( objects[n], n );
+            this->compute_range( n, &(this->m_ranges[6u*n]) );
+            this->insert( n );
+          }
+          
+          this->m_moved   = N;
+          this->m_valid   = true;
+          this->m_version = version;
+        }
+        
+        /**
+         * Refresh the boxes of all objects and move the objects whose range
+         * of cells has changed since the last query.
+         *
+         * @param objects    The objects of the broad phase system.
+         */
+        void update(object_ptr_container const & objects)
+        {
+          size_t const N = objects.size();
+          
+          assert( 6u*N == this->m_ranges.size() || !"update(): objects changed without a rebuild");
+          
+          this->m_moved     = 0u;
+          this->m_oversized = 0u;
+          
+          for(size_t n = 0u; n < N; ++n)
+          {
+            this->fetch_box( objects[n], n );
+            
+            int range[6];
+            this->compute_range( n, range );
+            
+            int * old_range = &(this->m_ranges[6u*n]);
+            
+            if( std::equal( range, range + 6, old_range ) )
+              continue;
+            
+            this->remove( n );
+            std::copy( range, range + 6, old_range );
+            this->insert( n );
+            
+            ++(this->m_moved);
+          }
+        }
+        
+      protected:
+        
+        void fetch_box(object_type const * obj, size_t const & n)
+        {
+          T * box = &(this->m_boxes[6u*n]);
+          
+          obj->get_box( box[0], box[1], box[2], box[3], box[4], box[5] );
+          
+          for(size_t c = 0u; c < 6u; ++c)
+          {
+            assert(is_number(box[c]) || !"broad::Grid::fetch_box(): Nan");
+            assert(is_finite(box[c]) || !"broad::Grid::fetch_box(): Inf");
+          }
+        }
+        
+        void compute_range(size_t const & n, int range[6]) const
+        {
+          T const * box = &(this->m_boxes[6u*n]);
+          
+          this->get_cell_indices( box[0], box[1], box[2], range[0], range[1], range[2] );
+          this->get_cell_indices( box[3], box[4], box[5], range[3], range[4], range[5] );
+        }
+        
+        void insert(size_t const & n)
+        {
+          int const * range = &(this->m_ranges[6u*n]);
+          
+          double const count = (range[3] - range[0] + 1.0)*(range[4] - range[1] + 1.0)*(range[5] - range[2] + 1.0);
+          
+          if( count > this->m_cells.size() )
+            ++(this->m_oversized);
+          
+          for ( int i = range[0]; i <= range[3]; ++i)
+            for ( int j = range[1]; j <= range[4]; ++j)
+              for ( int k = range[2]; k <= range[5]; ++k)
+                this->get_cell(i,j,k).add( n, this->m_time_stamp );
+        }
+        
+        void remove(size_t const & n)
+        {
+          int const * range = &(this->m_ranges[6u*n]);
+          
+          for ( int i = range[0]; i <= range[3]; ++i)
+            for ( int j = range[1]; j <= range[4]; ++j)
+              for ( int k = range[2]; k <= range[5]; ++k)
+                this->get_cell(i,j,k).remove( n, this->m_time_stamp );
         }
         
       };
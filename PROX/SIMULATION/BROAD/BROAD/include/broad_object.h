@@ -17,7 +17,6 @@ namespace broad
     public:
       
       Object()
-      : m_seen_by(0)
       {}
       
       virtual ~Object(){}
@@ -36,17 +35,6 @@ namespace broad
        */
       virtual void get_box(T & mx,T & my,T & mz,T & Mx,T & My,T & Mz) const = 0;
       
-    public: // 2011-01-14 Kenny: code review, this should be protected scope and m_seen_by should be accessed through the accessor class. However, since this is a hacky way of guarding against multiple report the best resolution might be to leave it be for now.
-      
-      Object<T> * m_seen_by;   ///< Object pointer used to guard against multiple
-                               ///< reported overlap pairs in the grid based algorithm.
-                               ///< This is not the most pretty solution but it is very
-                               ///< efficient as it allows for a constant time test to guard
-                               ///< against multiple reported overlaps. On the downside it
-                               ///< increases the object memory footprint and the technique
-                               ///< itself is inherently sequential (thus not parallizable).
-                               
-       
     };
   
 } //namespace broad
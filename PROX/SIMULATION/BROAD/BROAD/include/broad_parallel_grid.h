@@ -0,0 +1,445 @@
+#ifndef BROAD_PARALLEL_GRID_H
+#define BROAD_PARALLEL_GRID_H
+
+#include <broad_object.h>
+
+#include <tiny_is_finite.h>
+#include <tiny_is_number.h>
+
+#include <algorithm>   // needed for std::sort, std::inplace_merge, std::min and std::max
+#include <utility>     // needed for std::pair
+#include <vector>      // needed for std::vector
+#include <cassert>     // needed for assert
+#include <cmath>       // needed for std::floor
+
+namespace broad
+{
+
+  namespace detail
+  {
+
+    /**
+     * Sort a vector using all threads.
+     * The vector is split into a fixed number of chunks that are sorted
+     * independently, afterwards neighbouring chunks are merged pairwise until
+     * a single sorted range remains. The chunk layout does not depend on the
+     * number of threads, so the result is the same as a sequential sort.
+     *
+     * @param values   The values to be sorted.
+     */
+    template<typename value_type>
+    inline void parallel_sort(std::vector<value_type> & values)
+    {
+      long const N      = static_cast<long>( values.size() );
+      long const grain  = 4096;
+      long const chunks = std::min( 64L, (N + grain - 1) / grain );
+
+      if( chunks <= 1 )
+      {
+        std::sort( values.begin(), values.end() );
+        return;
+      }
+
+      long const chunk_size = (N + chunks - 1) / chunks;
+
+#pragma omp parallel for schedule(static)
+      for(long c = 0; c < chunks; ++c)
+      {
+        long const begin = std::min( N, c*chunk_size );
+        long const end   = std::min( N, begin + chunk_size );
+
+        std::sort( values.begin() + begin, values.begin() + end );
+      }
+
+      for(long width = chunk_size; width < N; width *= 2)
+      {
+        long const merges = (N + 2*width - 1) / (2*width);
+
+#pragma omp parallel for schedule(static)
+        for(long m = 0; m < merges; ++m)
+        {
+          long const begin  = m*2*width;
+          long const middle = std::min( N, begin + width );
+          long const end    = std::min( N, begin + 2*width );
+
+          if( middle < end )
+            std::inplace_merge( values.begin() + begin, values.begin() + middle, values.begin() + end );
+        }
+      }
+    }
+
+    /**
+     * Parallel Grid Data.
+     * A uniform grid where objects are binned by sorting (cell key, object
+     * index) entries rather than by hashing into shared cells. Every cell
+     * then becomes a contiguous run of entries and the runs can be processed
+     * independently by different threads. A pair of objects sharing several
+     * cells is only reported by the cell at the minimum corner of the
+     * intersection of their cell ranges, so no shared marker on the objects
+     * is needed to reject duplicates.
+     *
+     * Objects spanning more cells than a given cap are not binned, as they
+     * would flood the entries. Like the oversized objects of the bounded hash
+     * grid they are instead tested against all other objects.
+     *
+     * The data is kept in the broad phase system so its memory is reused
+     * from one query to the next.
+     *
+     * @tparam T    The precision of the broad phase collision detection system.
+     */
+    template<typename T>
+    class ParallelGrid
+    {
+    public:
+
+      typedef Object<T>                                 object_type;
+      typedef std::vector<object_type*>                 object_ptr_container;
+      typedef unsigned long long                        key_type;
+      typedef std::pair<key_type, size_t>               entry_type;     ///< A (cell key, object index) entry.
+      typedef std::pair<size_t, size_t>                 pair_type;
+      typedef std::vector<pair_type>                    pair_container;
+
+    protected:
+
+      std::vector<T>               m_boxes;       ///< Boxes of all objects, six values per object (min x, min y, min z, max x, max y, max z).
+      std::vector<int>             m_ranges;      ///< Cell index ranges of all objects, six values per object (min i, min j, min k, max i, max j, max k).
+      std::vector<size_t>          m_offsets;     ///< Offsets of the first entry of each object, one extra value holds the total number of entries.
+      std::vector<entry_type>      m_entries;     ///< Sorted (cell key, object index) entries.
+      std::vector<size_t>          m_runs;        ///< Index of the first entry of each cell, one extra value holds the total number of entries.
+      std::vector<size_t>          m_oversized;   ///< Indices of the objects spanning more cells than the cap, these have no entries.
+      std::vector<pair_container>  m_blocks;      ///< Pairs of overlapping object indices found by each block of cells.
+      std::vector<size_t>          m_block_tests; ///< The number of box overlap tests done by each block of cells.
+
+      int                          m_min_i;       ///< The minimum cell index along x-axis of all objects.
+      int                          m_min_j;       ///< The minimum cell index along y-axis of all objects.
+      int                          m_min_k;       ///< The minimum cell index along z-axis of all objects.
+      key_type                     m_size_i;      ///< The number of cells along x-axis spanned by all objects.
+      key_type                     m_size_j;      ///< The number of cells along y-axis spanned by all objects.
+
+      size_t                       m_tests;       ///< The number of box overlap tests done during the last query.
+
+    public:
+
+      ParallelGrid()
+      : m_min_i(0)
+      , m_min_j(0)
+      , m_min_k(0)
+      , m_size_i(1u)
+      , m_size_j(1u)
+      , m_tests(0u)
+      {}
+
+    public:
+
+      size_t const & tests()     const { return this->m_tests;            }
+      size_t         entries()   const { return this->m_entries.size();   }
+      size_t         cells()     const { return this->m_runs.empty() ? 0u : this->m_runs.size() - 1u; }
+      size_t         oversized() const { return this->m_oversized.size(); }
+
+      void clear()
+      {
+        this->m_boxes.clear();
+        this->m_ranges.clear();
+        this->m_offsets.clear();
+        this->m_entries.clear();
+        this->m_runs.clear();
+        this->m_oversized.clear();
+        this->m_blocks.clear();
+        this->m_block_tests.clear();
+      }
+
+    protected:
+
+      key_type make_key(int const & i, int const & j, int const & k) const
+      {
+        key_type const di = static_cast<key_type>( i - this->m_min_i );
+        key_type const dj = static_cast<key_type>( j - this->m_min_j );
+        key_type const dk = static_cast<key_type>( k - this->m_min_k );
+
+        return (dk*this->m_size_j + dj)*this->m_size_i + di;
+      }
+
+      void get_cell(key_type const & key, int & i, int & j, int & k) const
+      {
+        i = static_cast<int>( key % this->m_size_i )                     + this->m_min_i;
+        j = static_cast<int>( (key / this->m_size_i) % this->m_size_j ) + this->m_min_j;
+        k = static_cast<int>( key / (this->m_size_i*this->m_size_j) )    + this->m_min_k;
+      }
+
+      bool is_oversized(size_t const & n) const
+      {
+        return this->m_offsets[n+1] == this->m_offsets[n];
+      }
+
+      bool overlap(size_t const & a, size_t const & b) const
+      {
+        T const * A = &(this->m_boxes[6u*a]);
+        T const * B = &(this->m_boxes[6u*b]);
+
+        if(B[3] < A[0]) return false;
+        if(A[3] < B[0]) return false;
+        if(B[4] < A[1]) return false;
+        if(A[4] < B[1]) return false;
+        if(B[5] < A[2]) return false;
+        if(A[5] < B[2]) return false;
+
+        return true;
+      }
+
+    public:
+
+      /**
+       * Bin all objects into the cells of a uniform grid.
+       *
+       * @param objects    The objects of the broad phase system.
+       * @param spacing    The cell spacing of the grid.
+       * @param max_cells  Objects spanning more cells than this are not binned.
+       *
+       * @return           If false then the cells spanned by the objects can
+       *                   not be given unique keys and the grid was not built.
+       */
+      bool build(object_ptr_container const & objects, T const & spacing, size_t const & max_cells)
+      {
+        using std::floor;
+        using std::min;
+        using std::max;
+
+        assert( spacing > 0 || !"build(): spacing must be a positive value");
+
+        long const N = static_cast<long>( objects.size() );
+
+        this->m_boxes.resize( 6u*N );
+        this->m_ranges.resize( 6u*N );
+        this->m_offsets.resize( N + 1u );
+
+        //--- Fetch boxes and compute the cell index ranges they span
+#pragma omp parallel for schedule(static)
+        for(long n = 0; n < N; ++n)
+        {
+          T   * box   = &(this->m_boxes[6u*n]);
+          int * range = &(this->m_ranges[6u*n]);
+
+          objects[n]->get_box( box[0], box[1], box[2], box[3], box[4], box[5] );
+
+          for(size_t c = 0u; c < 6u; ++c)
+          {
+            assert(is_number(box[c]) || !"broad::ParallelGrid::build(): Nan");
+            assert(is_finite(box[c]) || !"broad::ParallelGrid::build(): Inf");
+
+            range[c] = static_cast<int>( floor( box[c] / spacing ) );
+          }
+        }
+
+        //--- Count entries, one per cell spanned by each object that is not oversized
+        this->m_offsets[0] = 0u;
+        this->m_oversized.clear();
+
+        for(long n = 0; n < N; ++n)
+        {
+          int const * range = &(this->m_ranges[6u*n]);
+
+          double const count = (range[3] - range[0] + 1.0)*(range[4] - range[1] + 1.0)*(range[5] - range[2] + 1.0);
+
+          if( count > max_cells )
+          {
+            this->m_oversized.push_back( static_cast<size_t>(n) );
+            this->m_offsets[n+1] = this->m_offsets[n];
+            continue;
+          }
+
+          this->m_offsets[n+1] = this->m_offsets[n] + static_cast<size_t>( count );
+        }
+
+        //--- Determine the extent of the grid spanned by the binned objects
+        int max_i = 0;
+        int max_j = 0;
+        int max_k = 0;
+
+        this->m_min_i = 0;
+        this->m_min_j = 0;
+        this->m_min_k = 0;
+
+        bool first = true;
+
+        for(long n = 0; n < N; ++n)
+        {
+          if( this->is_oversized( n ) )
+            continue;
+
+          int const * range = &(this->m_ranges[6u*n]);
+
+          this->m_min_i = first ? range[0] : min( this->m_min_i, range[0] );
+          this->m_min_j = first ? range[1] : min( this->m_min_j, range[1] );
+          this->m_min_k = first ? range[2] : min( this->m_min_k, range[2] );
+          max_i         = first ? range[3] : max( max_i, range[3] );
+          max_j         = first ? range[4] : max( max_j, range[4] );
+          max_k         = first ? range[5] : max( max_k, range[5] );
+
+          first = false;
+        }
+
+        double const size_i = static_cast<double>( max_i ) - this->m_min_i + 1.0;
+        double const size_j = static_cast<double>( max_j ) - this->m_min_j + 1.0;
+        double const size_k = static_cast<double>( max_k ) - this->m_min_k + 1.0;
+
+        // Keys are flat indices into the dense grid, these must fit in the key type
+        if( size_i*size_j*size_k >= 1.8e19 )
+          return false;
+
+        this->m_size_i = static_cast<key_type>( size_i );
+        this->m_size_j = static_cast<key_type>( size_j );
+
+        this->m_entries.resize( this->m_offsets[N] );
+
+        //--- Write entries of each object into its own slots
+#pragma omp parallel for schedule(dynamic, 64)
+        for(long n = 0; n < N; ++n)
+        {
+          if( this->is_oversized( n ) )
+            continue;
+
+          int const * range = &(this->m_ranges[6u*n]);
+
+          size_t e = this->m_offsets[n];
+
+          for(int k = range[2]; k <= range[5]; ++k)
+            for(int j = range[1]; j <= range[4]; ++j)
+              for(int i = range[0]; i <= range[3]; ++i)
+                this->m_entries[e++] = entry_type( this->make_key(i,j,k), static_cast<size_t>(n) );
+        }
+
+        //--- Sort entries by cell key, objects are ordered by index inside each cell
+        parallel_sort( this->m_entries );
+
+        //--- Find the runs of entries that share the same cell
+        this->m_runs.clear();
+
+        for(size_t e = 0u; e < this->m_entries.size(); ++e)
+        {
+          if( e == 0u || this->m_entries[e].first != this->m_entries[e-1u].first )
+            this->m_runs.push_back( e );
+        }
+
+        this->m_runs.push_back( this->m_entries.size() );
+
+        return true;
+      }
+
+      /**
+       * Find all pairs of objects with overlapping boxes.
+       * Cells are split into a fixed number of blocks that are processed in
+       * parallel, each block writes to its own pair container. Blocks are
+       * concatenated in order so the result does not depend on the number of
+       * threads. Each oversized object makes one extra block, where it is
+       * tested against all other objects. A pair of two oversized objects is
+       * only tested by the block of the object with the smallest index.
+       *
+       * @param pairs    Upon return holds the pairs of indices of overlapping objects, smallest index first.
+       */
+      void find_pairs(pair_container & pairs)
+      {
+        using std::max;
+        using std::min;
+
+        long const N           = static_cast<long>( this->m_offsets.size() ) - 1;
+        long const cells       = static_cast<long>( this->cells() );
+        long const cell_blocks = min( 256L, max( 1L, cells / 16 ) );
+        long const blocks      = cell_blocks + static_cast<long>( this->m_oversized.size() );
+
+        this->m_blocks.resize( blocks );
+        this->m_block_tests.assign( blocks, 0u );
+
+#pragma omp parallel for schedule(dynamic, 1)
+        for(long b = 0; b < blocks; ++b)
+        {
+          pair_container & found = this->m_blocks[b];
+          size_t         & tests = this->m_block_tests[b];
+
+          found.clear();
+
+          if( b >= cell_blocks )
+          {
+            size_t const a = this->m_oversized[b - cell_blocks];
+
+            for(long n = 0; n < N; ++n)
+            {
+              size_t const c = static_cast<size_t>( n );
+
+              if( c == a || ( c < a && this->is_oversized( c ) ) )
+                continue;
+
+              ++tests;
+
+              if( this->overlap( a, c ) )
+                found.push_back( pair_type( min( a, c ), max( a, c ) ) );
+            }
+
+            continue;
+          }
+
+          long const cell_begin = (cells*b)     / cell_blocks;
+          long const cell_end   = (cells*(b+1)) / cell_blocks;
+
+          for(long c = cell_begin; c < cell_end; ++c)
+          {
+            size_t const begin = this->m_runs[c];
+            size_t const end   = this->m_runs[c+1];
+
+            if( end - begin < 2u )
+              continue;
+
+            int ci;
+            int cj;
+            int ck;
+            this->get_cell( this->m_entries[begin].first, ci, cj, ck );
+
+            for(size_t ea = begin; ea < end; ++ea)
+            {
+              size_t const a       = this->m_entries[ea].second;
+              int const *  range_a = &(this->m_ranges[6u*a]);
+
+              for(size_t eb = ea + 1u; eb < end; ++eb)
+              {
+                size_t const b       = this->m_entries[eb].second;
+                int const *  range_b = &(this->m_ranges[6u*b]);
+
+                // Only the cell at the minimum corner of the shared cell range reports the pair
+                if( max( range_a[0], range_b[0] ) != ci ) continue;
+                if( max( range_a[1], range_b[1] ) != cj ) continue;
+                if( max( range_a[2], range_b[2] ) != ck ) continue;
+
+                ++tests;
+
+                if( this->overlap( a, b ) )
+                  found.push_back( pair_type( a, b ) );
+              }
+            }
+          }
+        }
+
+        //--- Merge the pairs of all blocks
+        size_t total = 0u;
+
+        this->m_tests = 0u;
+
+        for(long b = 0; b < blocks; ++b)
+        {
+          total         += this->m_blocks[b].size();
+          this->m_tests += this->m_block_tests[b];
+        }
+
+        pairs.clear();
+        pairs.reserve( total );
+
+        for(long b = 0; b < blocks; ++b)
+          pairs.insert( pairs.end(), this->m_blocks[b].begin(), this->m_blocks[b].end() );
+      }
+
+    };
+
+  } // namespace detail
+
+} // namespace broad
+
+// BROAD_PARALLEL_GRID_H
+#endif
@@ -0,0 +1,290 @@
+#ifndef BROAD_SWEEP_AND_PRUNE_H
+#define BROAD_SWEEP_AND_PRUNE_H
+
+#include <broad_object.h>
+
+#include <tiny_is_finite.h>
+#include <tiny_is_number.h>
+
+#include <algorithm>   // needed for std::sort, std::swap and std::min and std::max
+#include <set>         // needed for std::set
+#include <utility>     // needed for std::pair
+#include <vector>      // needed for std::vector
+#include <cassert>     // needed for assert
+
+namespace broad
+{
+
+  namespace detail
+  {
+
+    /**
+     * Sweep and Prune Data.
+     * This class keeps sorted arrays of the box end points along each
+     * coordinate axis and the set of overlapping boxes from one query to the
+     * next. When objects move a little the arrays are almost sorted, so an
+     * insertion sort restores the order in close to linear time. Every time
+     * two end points swap place the pair of boxes either starts or stops
+     * overlapping along that axis, and the set of overlaps is updated
+     * accordingly.
+     *
+     * @tparam T    The precision of the broad phase collision detection system.
+     */
+    template<typename T>
+    class SweepAndPrune
+    {
+    public:
+
+      typedef Object<T>                                 object_type;
+      typedef std::vector<object_type*>                 object_ptr_container;
+      typedef std::pair<size_t, size_t>                 pair_type;
+      typedef std::set<pair_type>                       pair_container;
+
+    protected:
+
+      class EndPoint
+      {
+      public:
+
+        T      m_value;    ///< The coordinate value of the end point.
+        size_t m_idx;      ///< The index of the object the end point belongs to.
+        bool   m_is_max;   ///< If true then this is the maximum end point of the box, otherwise it is the minimum end point.
+
+      public:
+
+        /**
+         * End points with equal values are ordered with minimum end points
+         * first. This way touching boxes are seen as overlapping, exactly
+         * like the other broad phase algorithms do.
+         */
+        bool operator<(EndPoint const & point) const
+        {
+          if( this->m_value != point.m_value )
+            return this->m_value < point.m_value;
+
+          return !this->m_is_max && point.m_is_max;
+        }
+
+      };
+
+    protected:
+
+      bool                   m_valid;        ///< If true then the end points are valid for the objects of the system version below.
+      size_t                 m_version;      ///< The version of the connections in the broad phase system the data was made for.
+      std::vector<T>         m_boxes;        ///< Boxes of all objects, six values per object (min x, min y, min z, max x, max y, max z).
+      std::vector<EndPoint>  m_axis[3];      ///< Sorted end points along each coordinate axis.
+      pair_container         m_pairs;        ///< Pairs of object indices (smallest index first) with overlapping boxes.
+      size_t                 m_tests;        ///< The number of box overlap tests done during the last query.
+      size_t                 m_swaps;        ///< The number of end point swaps done during the last query.
+
+    public:
+
+      SweepAndPrune()
+      : m_valid(false)
+      , m_version(0u)
+      , m_boxes()
+      , m_pairs()
+      , m_tests(0u)
+      , m_swaps(0u)
+      {}
+
+    public:
+
+      bool                   is_valid(size_t const & version) const { return this->m_valid && this->m_version == version; }
+      pair_container const & pairs() const { return this->m_pairs; }
+      size_t const &         tests() const { return this->m_tests; }
+      size_t const &         swaps() const { return this->m_swaps; }
+
+      void clear()
+      {
+        this->m_valid = false;
+        this->m_boxes.clear();
+        this->m_axis[0].clear();
+        this->m_axis[1].clear();
+        this->m_axis[2].clear();
+        this->m_pairs.clear();
+      }
+
+    protected:
+
+      void fetch_boxes(object_ptr_container const & objects)
+      {
+        size_t const N = objects.size();
+
+        this->m_boxes.resize( 6u*N );
+
+        for(size_t i = 0u; i < N; ++i)
+        {
+          T * box = &(this->m_boxes[6u*i]);
+
+          objects[i]->get_box( box[0], box[1], box[2], box[3], box[4], box[5] );
+
+          for(size_t k = 0u; k < 6u; ++k)
+          {
+            assert(is_number(box[k]) || !"broad::SweepAndPrune(): Nan");
+            assert(is_finite(box[k]) || !"broad::SweepAndPrune(): Inf");
+          }
+        }
+      }
+
+      bool overlap(size_t const & a, size_t const & b)
+      {
+        T const * A = &(this->m_boxes[6u*a]);
+        T const * B = &(this->m_boxes[6u*b]);
+
+        ++(this->m_tests);
+
+        if(B[3] < A[0]) return false;
+        if(A[3] < B[0]) return false;
+        if(B[4] < A[1]) return false;
+        if(A[4] < B[1]) return false;
+        if(B[5] < A[2]) return false;
+        if(A[5] < B[2]) return false;
+
+        return true;
+      }
+
+      static pair_type make_pair(size_t const & a, size_t const & b)
+      {
+        return a < b ? pair_type(a, b) : pair_type(b, a);
+      }
+
+    public:
+
+      /**
+       * Rebuild the sorted end point arrays and the overlapping pairs from
+       * scratch. This is needed whenever objects have been connected to or
+       * disconnected from the broad phase system.
+       *
+       * @param objects    The objects of the broad phase system.
+       * @param version    The version of the connections of the broad phase system.
+       */
+      void rebuild(object_ptr_container const & objects, size_t const & version)
+      {
+        size_t const N = objects.size();
+
+        this->m_tests = 0u;
+        this->m_swaps = 0u;
+
+        this->fetch_boxes( objects );
+
+        for(size_t axis = 0u; axis < 3u; ++axis)
+        {
+          std::vector<EndPoint> & points = this->m_axis[axis];
+
+          points.resize( 2u*N );
+
+          for(size_t i = 0u; i < N; ++i)
+          {
+            points[2u*i].m_value     = this->m_boxes[6u*i + axis];
+            points[2u*i].m_idx       = i;
+            points[2u*i].m_is_max    = false;
+
+            points[2u*i+1u].m_value  = this->m_boxes[6u*i + axis + 3u];
+            points[2u*i+1u].m_idx    = i;
+            points[2u*i+1u].m_is_max = true;
+          }
+
+          std::sort( points.begin(), points.end() );
+        }
+
+        //--- Sweep along the x-axis and keep track of all open boxes
+        this->m_pairs.clear();
+
+        std::vector<size_t> active;
+        std::vector<size_t> position( N, 0u );   // position of object in active list
+
+        std::vector<EndPoint> const & points = this->m_axis[0];
+
+        for(size_t p = 0u; p < points.size(); ++p)
+        {
+          size_t const i = points[p].m_idx;
+
+          if( points[p].m_is_max )
+          {
+            // Remove i from the active list by moving the last entry into its place
+            size_t const last = active.back();
+            active[ position[i] ] = last;
+            position[ last ]      = position[i];
+            active.pop_back();
+            continue;
+          }
+
+          for(size_t a = 0u; a < active.size(); ++a)
+          {
+            if( this->overlap( i, active[a] ) )
+              this->m_pairs.insert( make_pair( i, active[a] ) );
+          }
+
+          position[i] = active.size();
+          active.push_back( i );
+        }
+
+        this->m_valid   = true;
+        this->m_version = version;
+      }
+
+      /**
+       * Update the sorted end point arrays and the overlapping pairs
+       * incrementally from the current boxes of the objects.
+       *
+       * @param objects    The objects of the broad phase system, these must
+       *                   be the same objects as used in the last rebuild.
+       */
+      void update(object_ptr_container const & objects)
+      {
+        assert( this->m_valid                         || !"update(): rebuild must be called first");
+        assert( 6u*objects.size() == this->m_boxes.size() || !"update(): objects were changed since last rebuild");
+
+        this->m_tests = 0u;
+        this->m_swaps = 0u;
+
+        this->fetch_boxes( objects );
+
+        for(size_t axis = 0u; axis < 3u; ++axis)
+        {
+          std::vector<EndPoint> & points = this->m_axis[axis];
+
+          size_t const P = points.size();
+
+          for(size_t p = 0u; p < P; ++p)
+            points[p].m_value = this->m_boxes[6u*points[p].m_idx + axis + (points[p].m_is_max ? 3u : 0u)];
+
+          //--- Insertion sort, swapping end points tells us when boxes start or stop overlapping
+          for(size_t p = 1u; p < P; ++p)
+          {
+            for(size_t q = p; q > 0u && points[q] < points[q-1u]; --q)
+            {
+              EndPoint const & moving = points[q];
+              EndPoint const & passed = points[q-1u];
+
+              ++(this->m_swaps);
+
+              if( !moving.m_is_max && passed.m_is_max )
+              {
+                // The minimum of one box moved below the maximum of another
+                // box, they now overlap along this axis.
+                if( this->overlap( moving.m_idx, passed.m_idx ) )
+                  this->m_pairs.insert( make_pair( moving.m_idx, passed.m_idx ) );
+              }
+              else if( moving.m_is_max && !passed.m_is_max )
+              {
+                // The maximum of one box moved below the minimum of another
+                // box, they no longer overlap along this axis.
+                this->m_pairs.erase( make_pair( moving.m_idx, passed.m_idx ) );
+              }
+
+              std::swap( points[q], points[q-1u] );
+            }
+          }
+        }
+      }
+
+    };
+
+  } // namespace detail
+
+} // namespace broad
+
+// BROAD_SWEEP_AND_PRUNE_H
+#endif
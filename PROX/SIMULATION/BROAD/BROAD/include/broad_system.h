@@ -4,11 +4,15 @@
 #include "broad_object.h"
 #include "broad_accessor.h"
 #include "broad_grid.h"
+#include "broad_sweep_and_prune.h"
+#include "broad_parallel_grid.h"
 
 #include <util_log.h>
 
 #include <vector>
 #include <algorithm>  // needed for std::find and std::pair and std::min and std::max
+#include <cassert>    // needed for assert
+#include <cmath>      // needed for std::fabs and std::ceil
 #include <limits>     // needed for std::numeric_limits
 
 namespace broad
@@ -29,15 +33,25 @@ namespace broad
     protected:
       
       typedef detail::Grid<T>                       grid_type;
+      typedef detail::SweepAndPrune<T>              sweep_and_prune_type;
+      typedef detail::ParallelGrid<T>               parallel_grid_type;
       
     protected:
       
       object_ptr_container      m_object_ptrs;
       grid_type                 m_grid;
+      sweep_and_prune_type      m_sweep_and_prune;
+      parallel_grid_type        m_parallel_grid;
       
       T m_min_span_x;        ///< Minimum span of object bounding boxes
       T m_min_span_y;
       T m_min_span_z;
+
+      bool   m_spacing_dirty;       ///< If true then objects were connected or disconnected since the cell spacing was last computed.
+      T      m_spacing_mean_span;   ///< The mean of the largest box spans when the cell spacing was last computed.
+      T      m_spacing_tolerance;   ///< Relative change of the mean span that is tolerated before the cell spacing is recomputed.
+
+      size_t m_version;             ///< Counts changes to the connected objects, used to detect when persistent data must be rebuilt.
             
     protected:
       
@@ -51,6 +65,10 @@ namespace broad
       , m_min_span_x( std::numeric_limits<T>::max()  )
       , m_min_span_y( std::numeric_limits<T>::max()  )
       , m_min_span_z( std::numeric_limits<T>::max()  )
+      , m_spacing_dirty( true )
+      , m_spacing_mean_span( 0 )
+      , m_spacing_tolerance( 0.25 )
+      , m_version( 0u )
       {}
       
       ~System()
@@ -80,8 +98,64 @@ namespace broad
         return values[N / 2];
       }
 
+      /**
+       * Compute the mean of the largest span of the object bounding boxes.
+       * This is a cheap linear time statistic used to detect when the sizes
+       * of the objects have changed so much that the cell spacing should be
+       * recomputed.
+       */
+      T compute_mean_span() const
+      {
+        using std::max;
+
+        size_t const N = this->m_object_ptrs.size();
+
+        if(N==0)
+          return T(0);
+
+        T sum = T(0);
+
+        typename std::vector<object_type*>::const_iterator obj_ptr = this->m_object_ptrs.begin();
+        typename std::vector<object_type*>::const_iterator end     = this->m_object_ptrs.end();
+
+        for(;obj_ptr!=end; ++obj_ptr)
+        {
+          T min_x;
+          T min_y;
+          T min_z;
+          T max_x;
+          T max_y;
+          T max_z;
+          (*obj_ptr)->get_box( min_x, min_y, min_z, max_x, max_y, max_z);
+
+          sum += max( max_x - min_x, max( max_y - min_y, max_z - min_z ) );
+        }
+
+        return sum / N;
+      }
+
     public:
 
+      size_t size() const { return this->m_object_ptrs.size(); }
+
+      /**
+       * Get version of connected objects.
+       * The version is changed every time objects are connected to or
+       * disconnected from the system.
+       *
+       * @return     The current version.
+       */
+      size_t const & version() const { return this->m_version; }
+
+      T const & spacing_tolerance() const { return this->m_spacing_tolerance; }
+
+      void set_spacing_tolerance(T const & value)
+      {
+        assert( value >= 0 || !"set_spacing_tolerance(): tolerance must be non-negative");
+
+        this->m_spacing_tolerance = value;
+      }
+
       /**
        * This method analyses the object sizes and tries to pick a
        * cell size that is the best compromise.
@@ -116,6 +190,8 @@ namespace broad
         span_y.resize(N);
         span_z.resize(N);
 
+        T mean_span = T(0);
+
         typename std::vector<object_type*>::const_iterator obj_ptr = this->m_object_ptrs.begin();
         typename std::vector<object_type*>::const_iterator end     = this->m_object_ptrs.end();
 
@@ -132,8 +208,12 @@ namespace broad
           span_x[i]  = max_x - min_x;
           span_y[i]  = max_y - min_y;
           span_z[i]  = max_z - min_z;
+
+          mean_span += max( span_x[i], max( span_y[i], span_z[i] ) );
         }
 
+        mean_span /= N;
+
         std::sort( span_x.begin(), span_x.end() );
         std::sort( span_y.begin(), span_y.end() );
         std::sort( span_z.begin(), span_z.end() );
@@ -151,6 +231,9 @@ namespace broad
 
         this->m_grid.set_spacing( optimal_spacing );
 
+        this->m_spacing_mean_span = mean_span;
+        this->m_spacing_dirty     = false;
+
         //--- Now make sure to allocate sufficiently many cells to cover the
         //--- whole scene
         T const width  = span_x[N-1u] - span_x[0u];
@@ -204,6 +287,9 @@ namespace broad
         
         this->m_object_ptrs.push_back( obj );
         this->m_grid.resize ( this->m_object_ptrs.size() );  // Remember to resize grid so it got space for the objects.
+
+        this->m_spacing_dirty = true;
+        ++(this->m_version);
       }
       
       void disconnect( object_type * obj )
@@ -211,12 +297,103 @@ namespace broad
         assert(obj || !"disconnect() obj was null");        
         assert( std::find( this->m_object_ptrs.begin(), this->m_object_ptrs.end(), obj) != this->m_object_ptrs.end() || !"disconnect() obj was not connected");
         
-        this->m_object_ptrs.remove( obj );
+        this->m_object_ptrs.erase( std::find( this->m_object_ptrs.begin(), this->m_object_ptrs.end(), obj) );
+
+        this->m_spacing_dirty = true;
+        ++(this->m_version);
       }
       
       void clear()
       {
         this->m_object_ptrs.clear();
+        this->m_sweep_and_prune.clear();
+        this->m_parallel_grid.clear();
+
+        this->m_spacing_dirty = true;
+        ++(this->m_version);
+      }
+
+      /**
+       * Synchronize the connected objects with a range of objects.
+       * Objects stay connected from one call to the next. Only the objects
+       * that differ from the ones already connected at the same position
+       * are changed, so calling this every time step costs a single linear
+       * pass when nothing was added or removed.
+       *
+       * @param begin    Iterator to the first object.
+       * @param end      Iterator to one past the last object.
+       *
+       * @return         If true then the set of connected objects was changed.
+       */
+      template<typename object_iterator>
+      bool synchronize(object_iterator begin, object_iterator end)
+      {
+        bool changed = false;
+
+        size_t i = 0u;
+
+        for(object_iterator obj = begin; obj != end; ++obj, ++i)
+        {
+          object_type * ptr = &(*obj);
+
+          if( i < this->m_object_ptrs.size() )
+          {
+            if( this->m_object_ptrs[i] != ptr )
+            {
+              this->m_object_ptrs[i] = ptr;
+              changed = true;
+            }
+          }
+          else
+          {
+            this->m_object_ptrs.push_back( ptr );
+            changed = true;
+          }
+        }
+
+        if( i < this->m_object_ptrs.size() )
+        {
+          this->m_object_ptrs.resize( i );
+          changed = true;
+        }
+
+        if( changed )
+        {
+          this->m_grid.resize( this->m_object_ptrs.size() );
+          this->m_spacing_dirty = true;
+          ++(this->m_version);
+        }
+
+        return changed;
+      }
+
+      /**
+       * Prepare the system for a new query.
+       * The cell spacing is only recomputed when objects have been connected
+       * or disconnected, or when the mean size of the object bounding boxes
+       * has drifted more than the spacing tolerance since the spacing was
+       * last computed.
+       *
+       * @return         If true then the cell spacing was recomputed.
+       */
+      bool update()
+      {
+        using std::fabs;
+
+        if( this->m_object_ptrs.empty() )
+          return false;
+
+        if( !this->m_spacing_dirty )
+        {
+          T const mean_span = compute_mean_span();
+
+          if( fabs( mean_span - this->m_spacing_mean_span ) <= this->m_spacing_tolerance*this->m_spacing_mean_span )
+            return false;
+        }
+
+        compute_optimal_cell_spacing();
+
+        return true;
       }
       
     };
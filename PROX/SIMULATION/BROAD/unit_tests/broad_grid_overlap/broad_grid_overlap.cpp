@@ -1,5 +1,8 @@
 #include <broad.h>
 
+#include <cstdlib>
+#include <vector>
+
 #define BOOST_AUTO_TEST_MAIN
 #include <boost/test/auto_unit_test.hpp>
 #include <boost/test/unit_test_suite.hpp>
@@ -281,4 +284,120 @@ BOOST_AUTO_TEST_CASE(inclusion_test)
   BOOST_CHECK( overlaps.size() == 1u );
 }
 
+BOOST_AUTO_TEST_CASE(synchronize_test)
+{
+  system_type S;
+
+  std::vector<object_type> objects(3u);
+
+  objects[0].set_box( -1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f);
+  objects[1].set_box(  0.5f, -1.0f, -1.0f, 2.5f, 1.0f, 1.0f);
+  objects[2].set_box(  5.0f, -1.0f, -1.0f, 7.0f, 1.0f, 1.0f);
+
+  BOOST_CHECK(  S.synchronize( objects.begin(), objects.end() ) );
+  BOOST_CHECK(  S.update() );
+  BOOST_CHECK_EQUAL( S.size(), 3u );
+
+  overlap_container overlaps;
+  float efficiency = 0.0f;
+  broad::find_overlaps( S, overlaps, efficiency, broad::grid_algorithm() );
+
+  BOOST_CHECK(  exist_unique_overlap( objects[0], objects[1], overlaps) );
+  BOOST_CHECK( overlaps.size() == 1u );
+
+  // Moving objects do not change the connections nor the cell spacing
+  objects[2].set_box(  2.0f, -1.0f, -1.0f, 4.0f, 1.0f, 1.0f);
+
+  BOOST_CHECK( !S.synchronize( objects.begin(), objects.end() ) );
+  BOOST_CHECK( !S.update() );
+
+  broad::find_overlaps( S, overlaps, efficiency, broad::grid_algorithm() );
+
+  BOOST_CHECK(  exist_unique_overlap( objects[0], objects[1], overlaps) );
+  BOOST_CHECK(  exist_unique_overlap( objects[1], objects[2], overlaps) );
+  BOOST_CHECK( overlaps.size() == 2u );
+
+  // Growing objects a lot makes the cell spacing be recomputed
+  objects[0].set_box( -4.0f, -4.0f, -4.0f, 4.0f, 4.0f, 4.0f);
+  objects[1].set_box( -4.0f, -4.0f, -4.0f, 4.0f, 4.0f, 4.0f);
+
+  BOOST_CHECK( !S.synchronize( objects.begin(), objects.end() ) );
+  BOOST_CHECK(  S.update() );
+
+  // Removing an object only drops its connection
+  objects.pop_back();
+
+  BOOST_CHECK(  S.synchronize( objects.begin(), objects.end() ) );
+  BOOST_CHECK_EQUAL( S.size(), 2u );
+  BOOST_CHECK(  S.update() );
+
+  broad::find_overlaps( S, overlaps, efficiency, broad::grid_algorithm() );
+
+  BOOST_CHECK(  exist_unique_overlap( objects[0], objects[1], overlaps) );
+  BOOST_CHECK( overlaps.size() == 1u );
+}
+
+BOOST_AUTO_TEST_CASE(moving_objects_test)
+{
+  typedef broad::detail::Accessor<float> accessor;
+
+  system_type S;
+
+  size_t const N = 50u;
+
+  std::vector<object_type> objects(N);
+  std::vector<float>       x(N);
+  std::vector<float>       v(N);
+
+  std::srand(42u);
+
+  for(size_t i = 0u; i < N; ++i)
+  {
+    x[i] = 20.0f * std::rand() / RAND_MAX;
+    v[i] = 0.5f * std::rand() / RAND_MAX - 0.25f;
+    objects[i].set_box( x[i], x[i]*0.5f, -1.0f, x[i] + 1.0f, x[i]*0.5f + 1.0f, 1.0f );
+  }
+
+  S.synchronize( objects.begin(), objects.end() );
+  S.update();
+
+  for(size_t step = 0u; step < 40u; ++step)
+  {
+    overlap_container expected;
+    overlap_container overlaps;
+    float efficiency = 0.0f;
+
+    broad::find_overlaps( S, expected, efficiency, broad::all_pair_algorithm() );
+    broad::find_overlaps( S, overlaps, efficiency, broad::grid_algorithm() );
+
+    BOOST_CHECK( overlaps == expected );
+
+    for(size_t i = 0u; i < N; ++i)
+    {
+      x[i] += v[i];
+      objects[i].set_box( x[i], x[i]*0.5f, -1.0f, x[i] + 1.0f, x[i]*0.5f + 1.0f, 1.0f );
+    }
+
+    // Changing connections must make the grid be rebuilt
+    if( step == 20u )
+    {
+      objects.pop_back();
+      x.pop_back();
+      v.pop_back();
+
+      BOOST_CHECK( S.synchronize( objects.begin(), objects.end() ) );
+      BOOST_CHECK( S.update() );
+    }
+  }
+
+  // Objects that did not move are not moved in the grid either
+  overlap_container overlaps;
+  float efficiency = 0.0f;
+
+  broad::find_overlaps( S, overlaps, efficiency, broad::grid_algorithm() );
+  broad::find_overlaps( S, overlaps, efficiency, broad::grid_algorithm() );
+
+  BOOST_CHECK_EQUAL( accessor::get_grid( S ).moved(), 0u );
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -8,6 +8,7 @@
 #include <hyper_make_dirichlet_conditions.h>
 #include <hyper_make_traction_conditions.h>
 #include <hyper_assemble_matrix.h>
+#include <hyper_assembly_cache.h>
 #include <hyper_material_parameters.h>
 #include <hyper_body.h>
 #include <hyper_math_policy.h>
@@ -21,9 +22,12 @@
 #include <hyper_compute_elastic_forces.h>
 #include <hyper_params.h>
 #include <hyper_compute_gravity_forces.h>
+#include <hyper_compute_contact_forces.h>
 #include <hyper_saint_vernant_kirchhoff.h>
 #include <hyper_compute_mass_matrix.h>
 #include <hyper_semi_implicit_time_step.h>
+#include <hyper_implicit_time_step.h>
+#include <hyper_compute_stiffness_matrix.h>
 #include <hyper_compute_traction_forces.h>
 #include <hyper_simulate.h>
 #include <hyper_constitutive_equation.h>
@@ -87,7 +87,7 @@ namespace hyper
   }
 
   template< typename MT >
-  inline void do_time_step(Body<MT> const & body, State<MT>  & state, typename MT::real_type const & dt )
+  inline void do_time_step(Body<MT> & body, State<MT>  & state, typename MT::real_type const & dt )
   {
     semi_implicit_time_step(
                             body.m_mesh
@@ -100,6 +100,7 @@ namespace hyper
                             , body.m_F
                             , body.m_model
                             , jacobi_precond
+                            , body.m_assembly_cache
                             );
   }
 
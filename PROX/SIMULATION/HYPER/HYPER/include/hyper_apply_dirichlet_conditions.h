@@ -48,7 +48,7 @@ namespace hyper
         dirichlet_values(idx) = MT::convert( value );
       }
 
-      vector_block3x1_type tmp;
+      vector_block3x1_type tmp( b.size() );
 
       sparse::prod(A, dirichlet_values, tmp, true);
       sparse::sub(tmp ,b);
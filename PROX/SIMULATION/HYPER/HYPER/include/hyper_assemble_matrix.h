@@ -66,110 +66,208 @@ namespace hyper
       }
     }
 
-  }// details
-
-  template<typename MT>
-  inline void assemble_matrix(
-                              mesh_array::T4Mesh  const & mesh
-                              , mesh_array::Neighborhoods const & neighbors
-                              , std::vector< typename MT::element_matrices_type > const & Ae
-                              , typename MT::compressed_block3x3_type & A
-                              )
+    /**
+     * Create the fill pattern of the assembled matrix.
+     * Upon return A holds a zero block for every pair of vertices that
+     * share a tetrahedron.
+     */
+    template<typename MT>
+    inline void make_matrix_pattern(
+                                    mesh_array::T4Mesh  const & mesh
+                                    , mesh_array::Neighborhoods const & neighbors
+                                    , typename MT::compressed_block3x3_type & A
+                                    )
     {
       typedef typename MT::matrix3x3_type            M;
-//      typedef typename MT::vector3_type              V;
-//      typedef typename MT::real_type                 T;
-//      typedef typename MT::value_traits              VT;
-
-//      typedef typename MT::vector_block3x1_type      vector_block3x1_type;
-//      typedef typename MT::diagonal_block3x3_type    diagonal_block3x3_type;
-//      typedef typename MT::compressed_block3x3_type  compressed_block3x3_type;
-      typedef typename MT::element_matrices_type     element_matrices_type;
 
       unsigned int const UNASSIGNED = 0xFFFFFFFF;
 
       unsigned int const N          = neighbors.m_offset.size() - 1;
 
-      assert(N == mesh.vertex_size() || !"assemble_diagonal(): mesh did not match neighborhood data");
+      assert(N == mesh.vertex_size() || !"make_matrix_pattern(): mesh did not match neighborhood data");
 
-      //--- Step 1: Compute how much space is needed  ----------------------------
-    std::vector<unsigned int> row_sizes;
-    row_sizes.resize( N );
+      //--- Step 1: Compute how much space is needed  --------------------------
+      std::vector<unsigned int> row_sizes;
+      row_sizes.resize( N );
 
-    for(size_t r = 0u; r < N; ++r)
-    {
-      unsigned int const Kupper = (neighbors.m_offset[r+1] - neighbors.m_offset[r])*4u;
+      for(size_t r = 0u; r < N; ++r)
+      {
+        unsigned int const Kupper = (neighbors.m_offset[r+1] - neighbors.m_offset[r])*4u;
 
-      std::vector<unsigned int> C;
-      C.resize(Kupper,UNASSIGNED);
+        std::vector<unsigned int> C;
+        C.resize(Kupper,UNASSIGNED);
 
-      unsigned int K = 0u;
+        unsigned int K = 0u;
 
-      for (unsigned int entry = neighbors.m_offset[r]; entry < neighbors.m_offset[r+1];++entry)
-      {
-        unsigned int            const   idx         = neighbors.m_V2T[ entry ].second;
-        mesh_array::Tetrahedron const & tetrahedron = mesh.tetrahedron(idx);
+        for (unsigned int entry = neighbors.m_offset[r]; entry < neighbors.m_offset[r+1];++entry)
+        {
+          unsigned int            const   idx         = neighbors.m_V2T[ entry ].second;
+          mesh_array::Tetrahedron const & tetrahedron = mesh.tetrahedron(idx);
+
+          unsigned int            const   global_i    = tetrahedron.i();
+          unsigned int            const   global_j    = tetrahedron.j();
+          unsigned int            const   global_k    = tetrahedron.k();
+          unsigned int            const   global_m    = tetrahedron.m();
+
+          add_unique_index_to_array(global_i, C, K);
+          add_unique_index_to_array(global_j, C, K);
+          add_unique_index_to_array(global_k, C, K);
+          add_unique_index_to_array(global_m, C, K);
+        }
 
-        unsigned int            const   global_i    = tetrahedron.i();
-        unsigned int            const   global_j    = tetrahedron.j();
-        unsigned int            const   global_k    = tetrahedron.k();
-        unsigned int            const   global_m    = tetrahedron.m();
+        row_sizes[r] = K;
+      }
 
-        details::add_unique_index_to_array(global_i, C, K);
-        details::add_unique_index_to_array(global_j, C, K);
-        details::add_unique_index_to_array(global_k, C, K);
-        details::add_unique_index_to_array(global_m, C, K);
+      //--- Step 2: Allocate space  --------------------------------------------
+      unsigned int nnz = 0u;
+
+      for(size_t i = 0; i < N; ++i)
+      {
+        nnz += row_sizes[i];
       }
 
-      row_sizes[r] = K;
-    }
+      A.resize(N,N,nnz,false);
+
+      //--- Step 3: Initialize indexing data and value data to zero  -----------
+      for(size_t r = 0u; r < N; ++r)
+      {
+        unsigned int const Kupper = (neighbors.m_offset[r+1] - neighbors.m_offset[r])*4u;
 
-    //--- Step 2: Allocate space  ----------------------------------------------
-    unsigned int nnz = 0u;
+        std::vector<unsigned int> C;
 
-    for(size_t i = 0; i < N; ++i)
-    {
-      nnz += row_sizes[i];
+        C.resize(Kupper,UNASSIGNED);
+
+        unsigned int K = 0u;
+
+        for (unsigned int entry = neighbors.m_offset[r]; entry < neighbors.m_offset[r+1];++entry)
+        {
+          unsigned int            const   idx         = neighbors.m_V2T[ entry ].second;
+          mesh_array::Tetrahedron const & tetrahedron = mesh.tetrahedron(idx);
+
+          unsigned int            const   global_i    = tetrahedron.i();
+          unsigned int            const   global_j    = tetrahedron.j();
+          unsigned int            const   global_k    = tetrahedron.k();
+          unsigned int            const   global_m    = tetrahedron.m();
+
+          add_unique_index_to_array(global_i, C, K);
+          add_unique_index_to_array(global_j, C, K);
+          add_unique_index_to_array(global_k, C, K);
+          add_unique_index_to_array(global_m, C, K);
+        }
+
+        for( unsigned int k = 0; k < K; ++k)
+        {
+          if (C[k] == UNASSIGNED)
+            break;
+
+          A(r,C[k]) = MT::convert( M::zero() );
+        }
+
+      }
     }
 
-    A.resize(N,N,nnz,false);
+  }// details
 
-    //--- Step 3: Initialize indexing data and value data to zero  -------------
-    for(size_t r = 0u; r < N; ++r)
+  /**
+   * Make Scatter Map.
+   * For every tetrahedron the scatter map holds the positions in the value
+   * array of A of the 16 blocks of the element matrix. Block (a,b) of
+   * tetrahedron e is found at entry 16*e + 4*b + a.
+   *
+   * @param mesh    The mesh.
+   * @param A       A matrix with the fill pattern of the mesh, see details::make_matrix_pattern.
+   * @param slots   Upon return holds the scatter map.
+   */
+  template<typename MT>
+  inline void make_scatter_map(
+                               mesh_array::T4Mesh  const & mesh
+                               , typename MT::compressed_block3x3_type & A
+                               , std::vector<size_t> & slots
+                               )
+  {
+    unsigned int const K = mesh.tetrahedron_size();
+
+    slots.resize(16u*K);
+
+    if (A.size() == 0u)
+      return;
+
+    typename MT::block3x3_type const * const first = &A[0];
+
+    for ( unsigned int idx = 0u; idx < K; ++idx)
     {
-      unsigned int const Kupper = (neighbors.m_offset[r+1] - neighbors.m_offset[r])*4u;
+      mesh_array::Tetrahedron const & tetrahedron = mesh.tetrahedron(idx);
 
-      std::vector<unsigned int> C;
+      size_t const global[4] = { tetrahedron.i(), tetrahedron.j(), tetrahedron.k(), tetrahedron.m() };
 
-      C.resize(Kupper,UNASSIGNED);
+      for (unsigned int b = 0u; b < 4u; ++b)
+        for (unsigned int a = 0u; a < 4u; ++a)
+          slots[16u*idx + 4u*b + a] = &A( global[a], global[b] ) - first;
+    }
+  }
 
-      unsigned int K = 0u;
+  /**
+   * Numeric assembly of element matrices into a matrix with a known fill
+   * pattern. No memory is allocated and no searching is done.
+   *
+   * @param Ae      The element matrices.
+   * @param slots   The scatter map of the fill pattern of A, see make_scatter_map.
+   * @param A       Upon return holds the sum of the element matrices.
+   */
+  template<typename MT>
+  inline void scatter_matrix(
+                             std::vector< typename MT::element_matrices_type > const & Ae
+                             , std::vector<size_t> const & slots
+                             , typename MT::compressed_block3x3_type & A
+                             )
+  {
+    typedef typename MT::matrix3x3_type            M;
+    typedef typename MT::element_matrices_type     element_matrices_type;
 
-      for (unsigned int entry = neighbors.m_offset[r]; entry < neighbors.m_offset[r+1];++entry)
-      {
-        unsigned int            const   idx         = neighbors.m_V2T[ entry ].second;
-        mesh_array::Tetrahedron const & tetrahedron = mesh.tetrahedron(idx);
+    assert( slots.size() == 16u*Ae.size() || !"scatter_matrix(): scatter map did not match element matrices");
 
-        unsigned int            const   global_i    = tetrahedron.i();
-        unsigned int            const   global_j    = tetrahedron.j();
-        unsigned int            const   global_k    = tetrahedron.k();
-        unsigned int            const   global_m    = tetrahedron.m();
+    for(size_t n = 0u; n < A.size(); ++n)
+      A[n] = MT::convert( M::zero() );
 
-        details::add_unique_index_to_array(global_i, C, K);
-        details::add_unique_index_to_array(global_j, C, K);
-        details::add_unique_index_to_array(global_k, C, K);
-        details::add_unique_index_to_array(global_m, C, K);
-      }
+    for(size_t idx = 0u; idx < Ae.size(); ++idx)
+    {
+      element_matrices_type const & E = Ae[idx];
 
-      for( unsigned int k = 0; k < K; ++k)
+      for (unsigned int b = 0u; b < 4u; ++b)
       {
-        if (C[k] == UNASSIGNED)
-          break;
+        for (unsigned int a = 0u; a < 4u; ++a)
+        {
+          size_t const slot = slots[16u*idx + 4u*b + a];
 
-        A(r,C[k]) = MT::convert( M::zero() );
+          A[slot] = MT::convert( MT::convert( A[slot] ) + E(a,b) );
+        }
       }
-
     }
+  }
+
+  template<typename MT>
+  inline void assemble_matrix(
+                              mesh_array::T4Mesh  const & mesh
+                              , mesh_array::Neighborhoods const & neighbors
+                              , std::vector< typename MT::element_matrices_type > const & Ae
+                              , typename MT::compressed_block3x3_type & A
+                              )
+  {
+    typedef typename MT::matrix3x3_type            M;
+//    typedef typename MT::vector3_type              V;
+//    typedef typename MT::real_type                 T;
+//    typedef typename MT::value_traits              VT;
+
+//    typedef typename MT::vector_block3x1_type      vector_block3x1_type;
+//    typedef typename MT::diagonal_block3x3_type    diagonal_block3x3_type;
+//    typedef typename MT::compressed_block3x3_type  compressed_block3x3_type;
+    typedef typename MT::element_matrices_type     element_matrices_type;
+
+    unsigned int const N = neighbors.m_offset.size() - 1;
+
+    assert(N == mesh.vertex_size() || !"assemble_matrix(): mesh did not match neighborhood data");
+
+    details::make_matrix_pattern<MT>(mesh, neighbors, A);
 
     //--- Step 4: Fill in data  ------------------------------------------------
     for(size_t r = 0u; r < N; ++r)
@@ -204,7 +302,7 @@ namespace hyper
       }
     }
   }
-  
+
 }// namespace hyper
 
 // HYPER_ASSEMBLE_MATRIX_H
@@ -0,0 +1,158 @@
+#ifndef HYPER_ASSEMBLY_CACHE_H
+#define HYPER_ASSEMBLY_CACHE_H
+
+#include <hyper_math_policy.h>
+#include <hyper_constitutive_equation.h>
+#include <hyper_compute_mass_matrix.h>
+#include <hyper_compute_damping_matrix.h>
+#include <hyper_assemble_matrix.h>
+
+#include <mesh_array.h>
+
+#include <vector>
+#include <cassert>
+
+namespace hyper
+{
+
+  /**
+   * Assembly Cache.
+   * The mass and damping element matrices only depend on the material
+   * coordinates and the material, and the fill pattern of the assembled
+   * matrices only depends on the mesh. The same holds for the smallest
+   * lumped node mass used to limit the time step of penalty contact
+   * forces. This class keeps all of them from
+   * one time step to the next, so assembling a matrix during a time step
+   * becomes a pure numeric scatter of element matrices.
+   *
+   * The cache is rebuilt automatically if the mesh size or the model is
+   * changed. If material parameters or material coordinates are changed in
+   * place then clear must be called.
+   *
+   * @tparam MT    Math types type binder.
+   */
+  template<typename MT>
+  class AssemblyCache
+  {
+  public:
+
+    typedef typename MT::vector_block3x1_type      vector_block3x1_type;
+    typedef typename MT::compressed_block3x3_type  compressed_block3x3_type;
+    typedef typename MT::element_matrices_type     element_matrices_type;
+    typedef typename MT::real_type                 real_type;
+    typedef typename MT::value_traits              value_traits;
+
+  protected:
+
+    bool                                 m_valid;          ///< If true then the cached data is up to date.
+    ConstitutiveEquation<MT> const     * m_model;          ///< The model the element matrices were computed for.
+    size_t                               m_vertices;       ///< The number of vertices of the mesh the data was computed for.
+    size_t                               m_tetrahedra;     ///< The number of tetrahedra of the mesh the data was computed for.
+    std::vector< element_matrices_type > m_Me;             ///< Mass element matrices.
+    std::vector< element_matrices_type > m_Ce;             ///< Damping element matrices.
+    real_type                            m_min_node_mass;  ///< The smallest lumped node mass, zero if no node has any mass.
+    std::vector<size_t>                  m_slots;          ///< Scatter map from element matrix blocks to positions in the values of m_A.
+    compressed_block3x3_type             m_A;              ///< Matrix with the fill pattern of the mesh, values are overwritten by every assembly.
+
+  public:
+
+    AssemblyCache()
+    : m_valid(false)
+    , m_model(0)
+    , m_vertices(0u)
+    , m_tetrahedra(0u)
+    , m_Me()
+    , m_Ce()
+    , m_min_node_mass( value_traits::zero() )
+    , m_slots()
+    , m_A()
+    {}
+
+  public:
+
+    std::vector< element_matrices_type > const & Me() const { return this->m_Me; }
+    std::vector< element_matrices_type > const & Ce() const { return this->m_Ce; }
+    real_type                            const & min_node_mass() const { return this->m_min_node_mass; }
+
+    void clear()
+    {
+      this->m_valid      = false;
+      this->m_model      = 0;
+      this->m_vertices   = 0u;
+      this->m_tetrahedra = 0u;
+      this->m_Me.clear();
+      this->m_Ce.clear();
+      this->m_min_node_mass = value_traits::zero();
+      this->m_slots.clear();
+      this->m_A.clear();
+    }
+
+    bool is_valid(
+                  mesh_array::T4Mesh  const & mesh
+                  , ConstitutiveEquation<MT> const * model
+                  ) const
+    {
+      return this->m_valid
+          && this->m_model      == model
+          && this->m_vertices   == mesh.vertex_size()
+          && this->m_tetrahedra == mesh.tetrahedron_size();
+    }
+
+    /**
+     * Make sure the cached data is up to date.
+     *
+     * @param mesh        The mesh.
+     * @param neighbors   The neighborhoods of the mesh.
+     * @param x0          The material coordinates.
+     * @param model       The constitutive model.
+     */
+    void update(
+                mesh_array::T4Mesh  const & mesh
+                , mesh_array::Neighborhoods const & neighbors
+                , vector_block3x1_type const & x0
+                , ConstitutiveEquation<MT> const * model
+                )
+    {
+      assert( model || !"AssemblyCache::update(): model was NULL");
+
+      if( this->is_valid(mesh, model) )
+        return;
+
+      compute_mass_matrix<MT>( mesh, x0, model, this->m_Me);
+      compute_damping_matrix<MT>( mesh, x0, model, this->m_Ce);
+
+      this->m_min_node_mass = compute_min_node_mass<MT>( mesh, x0, model->material().rho() );
+
+      details::make_matrix_pattern<MT>( mesh, neighbors, this->m_A );
+
+      make_scatter_map<MT>( mesh, this->m_A, this->m_slots );
+
+      this->m_valid      = true;
+      this->m_model      = model;
+      this->m_vertices   = mesh.vertex_size();
+      this->m_tetrahedra = mesh.tetrahedron_size();
+    }
+
+    /**
+     * Assemble element matrices into the cached fill pattern.
+     *
+     * @param Ae    The element matrices.
+     *
+     * @return      A reference to the assembled matrix, it stays valid
+     *              until the next call to assemble.
+     */
+    compressed_block3x3_type & assemble( std::vector< element_matrices_type > const & Ae )
+    {
+      assert( this->m_valid || !"AssemblyCache::assemble(): update must be called first");
+
+      scatter_matrix<MT>( Ae, this->m_slots, this->m_A );
+
+      return this->m_A;
+    }
+
+  };
+
+}// namespace hyper
+
+// HYPER_ASSEMBLY_CACHE_H
+#endif
@@ -6,6 +6,7 @@
 #include <hyper_dirichlet_info.h>
 #include <hyper_traction_info.h>
 #include <hyper_scripted_motion.h>
+#include <hyper_assembly_cache.h>
 
 #include <tiny.h>
 #include <mesh_array.h>
@@ -70,6 +71,8 @@ namespace hyper
 
     ConstitutiveEquation<MT>             * m_model;
 
+    AssemblyCache<MT>                      m_assembly_cache;   ///< Element matrices and matrix fill pattern reused by the time steppers.
+
   public:
 
     T            m_adaptive_dt;          ///< When using adaptive time-stepping
@@ -122,6 +125,7 @@ namespace hyper
       this->m_Fext                 = body.m_Fext;
       this->m_F                    = body.m_F;
       this->m_model                = body.m_model;
+      this->m_assembly_cache.clear();                           // Cached data is rebuilt on demand
       this->m_adaptive_dt          = body.m_adaptive_dt;
       this->m_adaptive_unchanged   = body.m_adaptive_unchanged;
       this->m_scripted_motion      = body.m_scripted_motion;
@@ -155,6 +159,7 @@ namespace hyper
     , m_Fext()
     , m_F()
     , m_model(0)
+    , m_assembly_cache()
     , m_adaptive_dt()
     , m_adaptive_unchanged()
     , m_scripted_motion(0)
@@ -193,6 +198,7 @@ namespace hyper
     , m_Fext()
     , m_F()
     , m_model(0)
+    , m_assembly_cache()
     , m_adaptive_dt()
     , m_adaptive_unchanged()
     , m_scripted_motion(0)
@@ -276,6 +282,8 @@ namespace hyper
 
       this->m_F.resize(this->m_x0.size() );
       this->m_F.clear_data();
+
+      this->m_assembly_cache.clear();
     }
 
     bool empty() const
@@ -316,6 +324,7 @@ namespace hyper
       this->m_Fext.clear();
       this->m_F.clear();
       this->m_model = 0;
+      this->m_assembly_cache.clear();
       this->m_scripted_motion = 0;
 
       this->m_adaptive_dt = VT::zero();
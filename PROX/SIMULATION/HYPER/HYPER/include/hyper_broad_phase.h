@@ -9,6 +9,7 @@
 #include <cassert>    // needed for assert
 
 #include <algorithm>  // needed for std::pair and std::sort
+#include <vector>
 
 namespace hyper
 {  
@@ -25,7 +26,95 @@ namespace hyper
       return std::make_pair( bodyA, bodyB );
     }
 
+  namespace details
+  {
+
+    /**
+     * Sweep and prune end point. Only the lower end points are sorted, the
+     * upper value is carried along so the sweep knows when a body stops
+     * being active.
+     */
+    template<typename MT>
+    class SweepEntry
+    {
+    public:
+
+      typename MT::real_type   m_lower;   ///< Lower value of the body kDOP along the sweep direction.
+      typename MT::real_type   m_upper;   ///< Upper value of the body kDOP along the sweep direction.
+      Body<MT> const         * m_body;    ///< The body.
+
+    public:
+
+      bool operator<(SweepEntry const & entry) const
+      {
+        return this->m_lower < entry.m_lower;
+      }
+
+    };
+
+    /**
+     * Select the kDOP slab along which the centers of the bodies are spread
+     * the most. Sweeping along this direction gives the fewest bodies that
+     * are active at the same time.
+     */
+    template<typename MT>
+    inline size_t select_sweep_slab( Engine<MT> const & engine )
+    {
+      typedef typename MT::real_type                      T;
+      typedef typename MT::value_traits                   VT;
+      typedef typename Engine<MT>::const_body_iterator    const_body_iterator;
+
+      size_t const K = 4u;  // Number of slabs of a 8-DOP
+
+      T sum[K];
+      T sum_squared[K];
+
+      for(size_t k = 0u; k < K; ++k)
+      {
+        sum[k]         = VT::zero();
+        sum_squared[k] = VT::zero();
+      }
+
+      for(const_body_iterator body = engine.body_begin(); body != engine.body_end(); ++body)
+      {
+        for(size_t k = 0u; k < K; ++k)
+        {
+          T const center = ( body->m_tree.m_root(k).lower() + body->m_tree.m_root(k).upper() ) / VT::two();
+
+          sum[k]         += center;
+          sum_squared[k] += center*center;
+        }
+      }
+
+      T const N = VT::numeric_cast( engine.body_end() - engine.body_begin() );
+
+      size_t best          = 0u;
+      T      best_variance = VT::lowest();
+
+      for(size_t k = 0u; k < K; ++k)
+      {
+        T const variance = sum_squared[k] - sum[k]*sum[k] / N;
+
+        if( variance > best_variance )
+        {
+          best          = k;
+          best_variance = variance;
+        }
+      }
+
+      return best;
+    }
+
+  }// namespace details
+
   /**
+   * Broad phase collision detection.
+   * Sweep and prune on the root kDOPs of the bodies. The bodies are sorted
+   * by the lower value of their kDOPs along the slab direction with the
+   * largest spread of body centers. A sweep over the sorted bodies keeps a
+   * list of active bodies, and only bodies that are active at the same time
+   * are tested for overlap of their full kDOPs. For scenes where bodies are
+   * spread out the cost grows like n log n rather than n squared.
    *
    * @param efficiency    Upon return this argument gives the ratio of number of found
    *                      overlaps divided by the actual overlap tests done. A ratio of
@@ -38,43 +127,82 @@ namespace hyper
                           , typename MT::real_type & efficiency
                           )
   {
+    typedef typename MT::value_traits                     VT;
+
     typedef          Engine<MT>                           engine_type;
-    typedef typename engine_type::body_type               body_type;
     typedef typename engine_type::const_body_iterator     const_body_iterator;
+    typedef          details::SweepEntry<MT>              entry_type;
 
     // Clean up any potential old left over information
     overlaps.clear();
-    
-    // Determine box overlaps
-    const_body_iterator end   = engine.body_end();
-    const_body_iterator iterA = engine.body_begin();
-    
+
+    efficiency = VT::zero();
+
+    if( engine.body_begin() == engine.body_end() )
+      return false;
+
+    size_t const axis = details::select_sweep_slab( engine );
+
+    // Sort bodies along the sweep direction
+    std::vector<entry_type> entries;
+    entries.reserve( engine.body_end() - engine.body_begin() );
+
+    for(const_body_iterator body = engine.body_begin(); body != engine.body_end(); ++body)
+    {
+      entry_type entry;
+
+      entry.m_lower = body->m_tree.m_root(axis).lower();
+      entry.m_upper = body->m_tree.m_root(axis).upper();
+      entry.m_body  = &(*body);
+
+      // Bodies without any tetrahedra have empty kDOPs and can not overlap anything
+      if( entry.m_lower > entry.m_upper )
+        continue;
+
+      entries.push_back( entry );
+    }
+
+    std::sort( entries.begin(), entries.end() );
+
+    // Sweep and keep track of bodies whose interval is still open
+    std::vector<entry_type> active;
+
     size_t tests = 0u;
-    
-    for(;iterA!=end;)
-    {     
-      body_type const & A = (*iterA);
 
-      const_body_iterator iterB = ++iterA;
-      for(;iterB!=end;++iterB)
+    for(size_t e = 0u; e < entries.size(); ++e)
+    {
+      entry_type const & B = entries[e];
+
+      size_t kept = 0u;
+
+      for(size_t a = 0u; a < active.size(); ++a)
       {
-        body_type const & B = (*iterB);
+        entry_type const & A = active[a];
+
+        if( A.m_upper < B.m_lower )
+          continue;   // A can never overlap any of the remaining bodies
+
+        active[kept++] = A;
 
         tests++;
 
-        if( ! geometry::overlap_dop_dop( A.m_tree.m_root, B.m_tree.m_root ) )
+        if( ! geometry::overlap_dop_dop( A.m_body->m_tree.m_root, B.m_body->m_tree.m_root ) )
           continue;
 
         // Report that we have found an overlap between the bounding boxes of object A and B.
-        overlaps.push_back( make_overlap(&A, &B) );
+        overlaps.push_back( make_overlap(A.m_body, B.m_body) );
       }
+
+      active.resize( kept );
+      active.push_back( B );
     }
 
     // Lexiographic storting of overlaps
     std::sort( overlaps.begin(), overlaps.end() );
 
-    efficiency = 1.0f*overlaps.size() / tests;
-    
+    if( tests > 0u )
+      efficiency = 1.0f*overlaps.size() / tests;
+
     // Return a status flag indicating whether we have seen an overlap or not
     return (overlaps.size()>0);
   }    
@@ -71,7 +71,7 @@ namespace hyper
       // use regular updating of KDOP BVHs if DIKUCL is not available or should not be used
       update_kdop_bvh(
                       engine
-                      , kdop::sequential()
+                      , kdop::parallel()
                       );
 
 #ifdef HAS_DIKUCL
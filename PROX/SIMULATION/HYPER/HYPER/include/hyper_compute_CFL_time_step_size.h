@@ -3,11 +3,14 @@
 
 #include <hyper_engine.h>
 #include <hyper_math_policy.h>
+#include <hyper_compute_mass_matrix.h>
 
 #include <mesh_array.h>
 #include <tiny_is_finite.h>
 #include <tiny_is_number.h>
 
+#include <cmath>
+#include <vector>
 #include <cassert>
 
 namespace hyper
@@ -97,10 +100,66 @@ namespace hyper
 
 
 
+  /**
+   * Compute the largest time-step size for which penalty contact forces
+   * are stable. A penalty contact acts as a spring of the given stiffness
+   * between two nodes, and an explicit step of such a spring is stable as
+   * long as dt < sqrt(2 m / k), where m is the smaller of the node masses.
+   * The lightest lumped node mass of the mesh is used and a safety factor
+   * of sqrt(2) is applied, as the contact force is spread over several
+   * nodes.
+   *
+   * @tparam MT               Math types type binder.
+   *
+   * @param min_node_mass     The smallest lumped node mass of the mesh, see compute_min_node_mass.
+   */
+  template<typename MT>
+  inline typename MT::real_type compute_contact_time_step_size(
+                                                               typename MT::real_type const & min_node_mass
+                                                               , typename MT::real_type const & stiffness
+                                                               , typename MT::real_type const & dt_wanted
+                                                               )
+  {
+    using std::min;
+    using std::sqrt;
+
+    typedef typename MT::value_traits            VT;
+
+    if( stiffness <= VT::zero() || min_node_mass <= VT::zero() )
+      return dt_wanted;
+
+    return min( dt_wanted, sqrt( min_node_mass / stiffness ) );
+  }
+
+  /**
+   * Compute the largest time-step size for which penalty contact forces
+   * are stable, with the lumped node masses computed from the material
+   * coordinates and the mass density.
+   *
+   * @tparam MT    Math types type binder.
+   */
+  template<typename MT>
+  inline typename MT::real_type compute_contact_time_step_size(
+                                                               mesh_array::T4Mesh  const & mesh
+                                                               , typename MT::vector_block3x1_type const & x0
+                                                               , typename MT::real_type const & rho
+                                                               , typename MT::real_type const & stiffness
+                                                               , typename MT::real_type const & dt_wanted
+                                                               )
+  {
+    typedef typename MT::value_traits            VT;
+
+    if( stiffness <= VT::zero() )
+      return dt_wanted;
+
+    return compute_contact_time_step_size<MT>( compute_min_node_mass<MT>( mesh, x0, rho ), stiffness, dt_wanted );
+  }
+
   /**
    * Use a CFL condition to find a "safe" time step that
    * will not cause immediate degenerate tetrahedra
-   * in the mesh.
+   * in the mesh. When penalty contact forces are used the time step
+   * is further limited such that the contact forces are stable.
    */
   template<typename MT>
   inline typename MT::real_type compute_CFL_time_step_size(
@@ -111,12 +170,15 @@ namespace hyper
     using std::min;
 
     typedef typename MT::real_type       T;
+    typedef typename MT::value_traits    VT;
 
     typedef          Engine<MT>                            engine_type;
     typedef typename engine_type::body_iterator            body_iterator;
 
     T time_safe = time_wanted;
 
+    T const stiffness = engine.params().use_contact_forces() ? engine.params().contact_stiffness() : VT::zero();
+
     for (body_iterator body = engine.body_begin();body != engine.body_end(); ++body)
     {
       T const time_cfl = compute_CFL_time_step_size<MT>(
@@ -127,6 +189,24 @@ namespace hyper
                                                );
 
       time_safe = min ( time_safe, time_cfl);
+
+      if( body->m_scripted_motion || !body->m_model )
+        continue;
+
+      if( stiffness <= VT::zero() )
+        continue;
+
+      // The lumped node masses only depend on the material coordinates, so
+      // the smallest one is kept in the assembly cache of the body
+      body->m_assembly_cache.update( body->m_mesh, body->m_neighbors, body->m_x0, body->m_model );
+
+      T const time_contact = compute_contact_time_step_size<MT>(
+                                                                body->m_assembly_cache.min_node_mass()
+                                                                , stiffness
+                                                                , time_wanted
+                                                                );
+
+      time_safe = min ( time_safe, time_contact);
     }
 
     return time_safe;
@@ -0,0 +1,170 @@
+#ifndef HYPER_COMPUTE_CONTACT_FORCES_H
+#define HYPER_COMPUTE_CONTACT_FORCES_H
+
+#include <hyper_body.h>
+#include <hyper_contact_point.h>
+#include <hyper_math_policy.h>
+
+#include <barycentric/geometry_barycentric.h>
+
+#include <mesh_array.h>
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <cassert>
+
+namespace hyper
+{
+
+  namespace details
+  {
+
+    /**
+     * Compute interpolation weights of a point with respect to the nodes of
+     * a tetrahedron. Contact points may lie slightly outside the
+     * tetrahedron that generated them, so the barycentric coordinates are
+     * clamped to be non-negative and renormalized.
+     *
+     * @param body      The body.
+     * @param idx       The tetrahedron index.
+     * @param p         The point.
+     * @param nodes     Upon return holds the node indices of the tetrahedron.
+     * @param w         Upon return holds the weights of the nodes, they sum to one.
+     */
+    template<typename MT>
+    inline void compute_contact_weights(
+                                        Body<MT> const & body
+                                        , size_t const & idx
+                                        , typename MT::vector3_type const & p
+                                        , unsigned int nodes[4]
+                                        , typename MT::real_type w[4]
+                                        )
+    {
+      using std::max;
+
+      typedef typename MT::real_type    T;
+      typedef typename MT::vector3_type V;
+      typedef typename MT::value_traits VT;
+
+      mesh_array::Tetrahedron const & tetrahedron = body.m_mesh.tetrahedron(idx);
+
+      nodes[0] = tetrahedron.i();
+      nodes[1] = tetrahedron.j();
+      nodes[2] = tetrahedron.k();
+      nodes[3] = tetrahedron.m();
+
+      V const x0 = MT::convert( body.m_x[ nodes[0] ] );
+      V const x1 = MT::convert( body.m_x[ nodes[1] ] );
+      V const x2 = MT::convert( body.m_x[ nodes[2] ] );
+      V const x3 = MT::convert( body.m_x[ nodes[3] ] );
+
+      geometry::barycentric( x0, x1, x2, x3, p, w[0], w[1], w[2], w[3] );
+
+      T sum = VT::zero();
+
+      for(unsigned int a = 0u; a < 4u; ++a)
+      {
+        w[a] = max( w[a], VT::zero() );
+        sum += w[a];
+      }
+
+      for(unsigned int a = 0u; a < 4u; ++a)
+        w[a] = (sum > VT::zero()) ? w[a] / sum : VT::one() / VT::four();
+    }
+
+  }// end namespace details
+
+  /**
+   * Compute penalty contact forces.
+   *
+   * Contact normals point from body i towards body j and the depth is
+   * negative when the bodies overlap. For each overlapping contact the
+   * force magnitude is
+   *
+   *   lambda = max( 0,  - stiffness * depth - damping * (v_j - v_i) . n )
+   *
+   * where v_i and v_j are the velocities of the contact point interpolated
+   * from the nodes of the tetrahedra that generated the contact. The force
+   * lambda n is added to the nodes of the tetrahedron on body j and -lambda n
+   * to the nodes of the tetrahedron on body i, distributed by the
+   * barycentric weights of the contact point.
+   *
+   * @param contacts    The contact points found by the collision detection.
+   * @param stiffness   The penalty stiffness.
+   * @param damping     The penalty damping, only acts on approaching velocities.
+   *
+   * Forces are accumulated into the m_F vector of the bodies, so that must
+   * hold the external forces of the bodies already.
+   */
+  template<typename MT>
+  inline void compute_contact_forces(
+                                     std::vector< ContactPoint<MT> > & contacts
+                                     , typename MT::real_type const & stiffness
+                                     , typename MT::real_type const & damping
+                                     )
+  {
+    using std::max;
+
+    typedef typename MT::real_type    T;
+    typedef typename MT::vector3_type V;
+    typedef typename MT::value_traits VT;
+
+    typedef typename std::vector< ContactPoint<MT> >::iterator contact_iterator;
+
+    assert( stiffness >= VT::zero() || !"compute_contact_forces(): stiffness must be non-negative");
+    assert( damping   >= VT::zero() || !"compute_contact_forces(): damping must be non-negative");
+
+    for(contact_iterator contact = contacts.begin(); contact != contacts.end(); ++contact)
+    {
+      if( contact->get_depth() >= VT::zero() )
+        continue;
+
+      Body<MT> * body_i = contact->get_body_i();
+      Body<MT> * body_j = contact->get_body_j();
+
+      assert( body_i || !"compute_contact_forces(): body i was null");
+      assert( body_j || !"compute_contact_forces(): body j was null");
+
+      unsigned int nodes_i[4];
+      unsigned int nodes_j[4];
+      T            w_i[4];
+      T            w_j[4];
+
+      details::compute_contact_weights<MT>( *body_i, contact->get_tetrahedron_i(), contact->get_position(), nodes_i, w_i );
+      details::compute_contact_weights<MT>( *body_j, contact->get_tetrahedron_j(), contact->get_position(), nodes_j, w_j );
+
+      V v_i = V::zero();
+      V v_j = V::zero();
+
+      for(unsigned int a = 0u; a < 4u; ++a)
+      {
+        v_i += MT::convert( body_i->m_v[ nodes_i[a] ] ) * w_i[a];
+        v_j += MT::convert( body_j->m_v[ nodes_j[a] ] ) * w_j[a];
+      }
+
+      V const & n      = contact->get_normal();
+      T const   v_n    = inner_prod( v_j - v_i, n );
+      T const   lambda = max( VT::zero(), - stiffness * contact->get_depth() - damping * v_n );
+
+      if( lambda <= VT::zero() )
+        continue;
+
+      V const f = n * lambda;
+
+      //--- Scripted bodies are not driven by forces, they only push others
+      for(unsigned int a = 0u; a < 4u; ++a)
+      {
+        if( ! body_i->m_scripted_motion )
+          body_i->m_F[ nodes_i[a] ] = MT::convert( MT::convert( body_i->m_F[ nodes_i[a] ] ) - f * w_i[a] );
+
+        if( ! body_j->m_scripted_motion )
+          body_j->m_F[ nodes_j[a] ] = MT::convert( MT::convert( body_j->m_F[ nodes_j[a] ] ) + f * w_j[a] );
+      }
+    }
+  }
+
+}// namespace hyper
+
+// HYPER_COMPUTE_CONTACT_FORCES_H
+#endif
@@ -2,6 +2,9 @@
 #define HYPER_COMPUTE_ELASTIC_FORCES_H
 
 #include <hyper_constitutive_equation.h>
+#include <hyper_saint_vernant_kirchhoff.h>
+#include <hyper_corotational_elasticity.h>
+#include <hyper_neo_hookean.h>
 
 #include <hyper_strain_tensors.h>
 
@@ -12,14 +15,295 @@
 #include <tiny_is_number.h>
 
 #include <vector>
+#include <typeinfo>
+#include <algorithm>  // needed for std::min
 #include <cassert>
 
 namespace hyper
 {
 
+  namespace details
+  {
+
+    /**
+     * Evaluate the Cauchy stress of a concrete constitutive model. The call
+     * is qualified so it is bound statically and can be inlined into the
+     * element force kernel.
+     */
+    template<typename model_type>
+    inline typename model_type::M element_stress(
+                                                 model_type const & model
+                                                 , typename model_type::M const & F
+                                                 )
+    {
+      return model.model_type::sigma(F);
+    }
+
+    /**
+     * The number of tetrahedra in one batch of the element force kernel.
+     * A batch fills one AVX register per quantity, that is 4 lanes of
+     * double or 8 lanes of float.
+     */
+    template<typename T>
+    class ElementBatch
+    {
+    public:
+
+      enum { width = 32u / sizeof(T) };
+
+    };
+
+    /**
+     * Compute the nodal forces of W tetrahedra, f = sigma (a x b) / 6 for
+     * each lane. The operations are done in the same order as the prod and
+     * cross functions of tiny, so the forces agree bitwise with the forces
+     * of a single element.
+     *
+     * @param S   The stress tensors of the lanes, S[r][c][l] is entry (r,c) of lane l.
+     * @param a   The first edge vectors of the lanes.
+     * @param b   The second edge vectors of the lanes.
+     * @param f   Upon return holds the nodal forces of the lanes.
+     */
+    template<typename T, size_t W>
+    inline void compute_batch_nodal_forces(
+                                           T const S[3][3][W]
+                                           , T const a[3][W]
+                                           , T const b[3][W]
+                                           , T f[3][W]
+                                           )
+    {
+      typedef tiny::ValueTraits<T>  VT;
+
+      T const zero = VT::zero();
+      T const six  = VT::numeric_cast(6.0);
+
+      for (size_t l = 0u; l < W; ++l)
+      {
+        T const n0 = a[1][l]*b[2][l] - a[2][l]*b[1][l];
+        T const n1 = a[2][l]*b[0][l] - a[0][l]*b[2][l];
+        T const n2 = a[0][l]*b[1][l] - a[1][l]*b[0][l];
+
+        for (size_t r = 0u; r < 3u; ++r)
+          f[r][l] = ( ( (zero + S[r][0][l]*n0) + S[r][1][l]*n1 ) + S[r][2][l]*n2 ) / six;
+      }
+    }
+
+    /**
+     * Compute the nodal forces of each tetrahedral element for a model of a
+     * known concrete type. The forces of element idx are stored in
+     * local_forces[4*idx ... 4*idx+3].
+     *
+     * The elements are processed in batches of ElementBatch<T>::width
+     * tetrahedra, and the batches are processed in parallel. A batch
+     * gathers the edge vectors of its tetrahedra into a structure of
+     * arrays. The deformation gradients and the nodal forces are then
+     * computed by loops over the lanes of the batch, which the compiler
+     * turns into packed SIMD instructions. Only the stress is evaluated one
+     * lane at a time, as the constitutive models are written in terms of
+     * tiny matrices. The last batch repeats its last tetrahedron in the
+     * lanes past the end of the mesh.
+     *
+     * @tparam MT           Math types type binder.
+     * @tparam model_type   The concrete type of the constitutive model.
+     */
+    template<typename MT, typename model_type>
+    inline void compute_element_force_batches(
+                                              mesh_array::T4Mesh  const & mesh
+                                              , typename MT::vector_block3x1_type const & x
+                                              , typename MT::vector_block3x1_type const & x0
+                                              , model_type const & model
+                                              , std::vector<typename MT::vector3_type> & local_forces
+                                              )
+    {
+      typedef typename MT::real_type               T;
+      typedef typename MT::matrix3x3_type          M;
+      typedef typename MT::vector3_type            V;
+      typedef typename MT::value_traits            VT;
+
+      size_t const W = ElementBatch<T>::width;
+
+      long const K = static_cast<long>( mesh.tetrahedron_size() );
+      long const B = ( K + static_cast<long>(W) - 1 ) / static_cast<long>(W);
+
+#pragma omp parallel for schedule(static)
+      for (long batch = 0; batch < B; ++batch)
+      {
+        long   const first = batch*static_cast<long>(W);
+        size_t const count = static_cast<size_t>( std::min( static_cast<long>(W), K - first ) );
+
+        T u[3][3][W];     // u[e][c][l] is coordinate c of edge e = ji, ki, mi of lane l in spatial space
+        T u0[3][3][W];    // The same edges in material space
+        T u_mj[3][W];
+        T u_kj[3][W];
+
+        //--- Gather the edge vectors of the tetrahedra of the batch -----------
+        for (size_t l = 0u; l < W; ++l)
+        {
+          mesh_array::Tetrahedron const & tetrahedron = mesh.tetrahedron( first + std::min( l, count - 1u ) );
+
+          unsigned int const i  = tetrahedron.i();
+          unsigned int const j  = tetrahedron.j();
+          unsigned int const k  = tetrahedron.k();
+          unsigned int const m  = tetrahedron.m();
+
+          V const xi = MT::convert( x[i] );
+          V const xj = MT::convert( x[j] );
+          V const xk = MT::convert( x[k] );
+          V const xm = MT::convert( x[m] );
+
+          V const x0i = MT::convert( x0[i] );
+          V const x0j = MT::convert( x0[j] );
+          V const x0k = MT::convert( x0[k] );
+          V const x0m = MT::convert( x0[m] );
+
+          for (size_t c = 0u; c < 3u; ++c)
+          {
+            u[0][c][l]  = xj(c) - xi(c);
+            u[1][c][l]  = xk(c) - xi(c);
+            u[2][c][l]  = xm(c) - xi(c);
+
+            u0[0][c][l] = x0j(c) - x0i(c);
+            u0[1][c][l] = x0k(c) - x0i(c);
+            u0[2][c][l] = x0m(c) - x0i(c);
+
+            u_mj[c][l]  = xm(c) - xj(c);
+            u_kj[c][l]  = xk(c) - xj(c);
+          }
+        }
+
+        //--- Compute the inverse of D0 by its adjoint, like tiny::inverse -----
+        T invD0[3][3][W];
+
+        for (size_t l = 0u; l < W; ++l)
+        {
+          T const a00 = u0[0][0][l];  T const a01 = u0[1][0][l];  T const a02 = u0[2][0][l];
+          T const a10 = u0[0][1][l];  T const a11 = u0[1][1][l];  T const a12 = u0[2][1][l];
+          T const a20 = u0[0][2][l];  T const a21 = u0[1][2][l];  T const a22 = u0[2][2][l];
+
+          T const adj00 = a11*a22 - a21*a12;
+          T const adj11 = a00*a22 - a20*a02;
+          T const adj22 = a00*a11 - a10*a01;
+          T const adj01 = a10*a22 - a20*a12;
+          T const adj02 = a10*a21 - a20*a11;
+          T const adj10 = a01*a22 - a21*a02;
+          T const adj12 = a00*a21 - a20*a01;
+          T const adj20 = a01*a12 - a11*a02;
+          T const adj21 = a00*a12 - a10*a02;
+
+          T const det = a00*adj00 - a01*adj01 + a02*adj02;
+
+          assert( det > VT::zero() || !"compute_element_force_batches(): degenerate tetrahedron in material space");
+
+          invD0[0][0][l] =  adj00/det;  invD0[0][1][l] = -adj10/det;  invD0[0][2][l] =  adj20/det;
+          invD0[1][0][l] = -adj01/det;  invD0[1][1][l] =  adj11/det;  invD0[1][2][l] = -adj21/det;
+          invD0[2][0][l] =  adj02/det;  invD0[2][1][l] = -adj12/det;  invD0[2][2][l] =  adj22/det;
+        }
+
+        //--- Compute deformation gradients F = D invD0 ------------------------
+        T F[3][3][W];
+
+        for (size_t r = 0u; r < 3u; ++r)
+          for (size_t c = 0u; c < 3u; ++c)
+            for (size_t l = 0u; l < W; ++l)
+              F[r][c][l] = ( ( VT::zero() + u[0][r][l]*invD0[0][c][l] ) + u[1][r][l]*invD0[1][c][l] ) + u[2][r][l]*invD0[2][c][l];
+
+        //--- Compute stress tensors, one lane at a time ------------------------
+        T S[3][3][W];
+
+        for (size_t l = 0u; l < W; ++l)
+        {
+          M const F_l = M::make(
+                                F[0][0][l], F[0][1][l], F[0][2][l]
+                                , F[1][0][l], F[1][1][l], F[1][2][l]
+                                , F[2][0][l], F[2][1][l], F[2][2][l]
+                                );
+
+          M const sigma = element_stress( model, F_l );
+
+          for (size_t r = 0u; r < 3u; ++r)
+            for (size_t c = 0u; c < 3u; ++c)
+            {
+              assert( is_number(sigma(r,c)) || !"compute_element_force_batches(): sigma is not a number");
+              assert( is_finite(sigma(r,c)) || !"compute_element_force_batches(): sigma is not finite");
+
+              S[r][c][l] = sigma(r,c);
+            }
+        }
+
+        //--- Compute the nodal element forces, see compute_elastic_forces -----
+        T fi[3][W];
+        T fj[3][W];
+        T fk[3][W];
+        T fm[3][W];
+
+        compute_batch_nodal_forces<T,W>( S, u_mj, u_kj, fi );
+        compute_batch_nodal_forces<T,W>( S, u[1], u[2], fj );
+        compute_batch_nodal_forces<T,W>( S, u[2], u[0], fk );
+        compute_batch_nodal_forces<T,W>( S, u[0], u[1], fm );
+
+        for (size_t l = 0u; l < count; ++l)
+        {
+          size_t const idx = static_cast<size_t>( first ) + l;
+
+          local_forces[ idx*4u + 0u ] = V::make( fi[0][l], fi[1][l], fi[2][l] );
+          local_forces[ idx*4u + 1u ] = V::make( fj[0][l], fj[1][l], fj[2][l] );
+          local_forces[ idx*4u + 2u ] = V::make( fk[0][l], fk[1][l], fk[2][l] );
+          local_forces[ idx*4u + 3u ] = V::make( fm[0][l], fm[1][l], fm[2][l] );
+        }
+      }
+    }
+
+    /**
+     * Compute the element forces with the batched kernel if the model is
+     * one of the built-in models. Only exact type matches are resolved, so
+     * models derived from a built-in model keep their own stress function.
+     *
+     * @return   If the model was a built-in model then the return value is
+     *           true, otherwise it is false and local_forces are untouched.
+     */
+    template<typename MT>
+    inline bool compute_built_in_element_forces(
+                                                mesh_array::T4Mesh  const & mesh
+                                                , typename MT::vector_block3x1_type const & x
+                                                , typename MT::vector_block3x1_type const & x0
+                                                , ConstitutiveEquation<MT> const & model
+                                                , std::vector<typename MT::vector3_type> & local_forces
+                                                )
+    {
+      std::type_info const & model_type = typeid( model );
+
+      if( model_type == typeid( SaintVernantKirchhoff<MT> ) )
+      {
+        compute_element_force_batches<MT>( mesh, x, x0, static_cast< SaintVernantKirchhoff<MT> const & >( model ), local_forces );
+        return true;
+      }
+
+      if( model_type == typeid( CorotationalElasticity<MT> ) )
+      {
+        compute_element_force_batches<MT>( mesh, x, x0, static_cast< CorotationalElasticity<MT> const & >( model ), local_forces );
+        return true;
+      }
+
+      if( model_type == typeid( NeoHookean<MT> ) )
+      {
+        compute_element_force_batches<MT>( mesh, x, x0, static_cast< NeoHookean<MT> const & >( model ), local_forces );
+        return true;
+      }
+
+      return false;
+    }
+
+  }// end namespace details
+
   /**
    * Compute elastic forces for the given mesh.
    *
+   * The built-in constitutive models are resolved once per call and their
+   * element forces are computed by the batched kernel, see
+   * details::compute_element_force_batches. Any other model is evaluated
+   * one element at a time through its virtual stress function. Elements
+   * and vertices are processed in parallel.
+   *
    * @tparam MT    Math types type binder.
    */
   template<typename MT>
@@ -45,7 +329,13 @@ namespace hyper
     local_forces.resize( K*4u );
 
     //--- Compute local elastic forces per tetrahedral element -----------------
-    for ( unsigned int idx = 0u; idx < K; ++idx)  // 2014-01-22 Kenny: This for-loop is naive parallel
+    bool const batched = details::compute_built_in_element_forces<MT>( mesh, x, x0, *model, local_forces );
+
+    //--- Other models are evaluated one element at a time
+    long const unbatched = batched ? 0 : static_cast<long>( K );
+
+#pragma omp parallel for schedule(static)
+    for ( long idx = 0; idx < unbatched; ++idx)
     {
       mesh_array::Tetrahedron const & tetrahedron = mesh.tetrahedron(idx);
 
@@ -309,7 +599,11 @@ namespace hyper
     //--- Gather tetrahedral elements forces per vertex ------------------------
     f.resize( mesh.vertex_size() );
 
-    for(size_t i = 0u; i < mesh.vertex_size(); ++i)  // 2014-01-22 Kenny: This outer for-loop is naive parallel
+    long const N = static_cast<long>( mesh.vertex_size() );
+
+    //--- Each vertex only writes its own entry of f, so no synchronization is needed
+#pragma omp parallel for schedule(static)
+    for(long i = 0; i < N; ++i)
     {
       V sum = V::zero();
 
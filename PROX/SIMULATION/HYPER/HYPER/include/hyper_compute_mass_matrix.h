@@ -6,6 +6,7 @@
 
 #include <mesh_array.h>
 
+#include <algorithm>
 #include <vector>
 #include <cassert>
 
@@ -94,6 +95,67 @@ namespace hyper
 
   }
 
+  /**
+   * Compute the smallest lumped node mass of a mesh. The lumped mass
+   * matrix gives each node a quarter of the mass of every element it
+   * belongs to. Nodes without any elements are ignored.
+   *
+   * @tparam MT    Math types type binder.
+   *
+   * @return       The smallest positive node mass, or zero if no node has any mass.
+   */
+  template<typename MT>
+  inline typename MT::real_type compute_min_node_mass(
+                                                      mesh_array::T4Mesh  const & mesh
+                                                      , typename MT::vector_block3x1_type const & x
+                                                      , typename MT::real_type const & rho
+                                                      )
+  {
+    using std::min;
+
+    typedef typename MT::vector3_type            V;
+    typedef typename MT::real_type               T;
+    typedef typename MT::value_traits            VT;
+
+    unsigned int const K = mesh.tetrahedron_size();
+
+    std::vector<T> mass( mesh.vertex_size(), VT::zero() );
+
+    for ( unsigned int idx = 0u; idx < K; ++idx)
+    {
+      mesh_array::Tetrahedron const & tetrahedron = mesh.tetrahedron(idx);
+
+      unsigned int const i  = tetrahedron.i();
+      unsigned int const j  = tetrahedron.j();
+      unsigned int const k  = tetrahedron.k();
+      unsigned int const m  = tetrahedron.m();
+
+      V const xi = MT::convert( x[i] );
+      V const xj = MT::convert( x[j] );
+      V const xk = MT::convert( x[k] );
+      V const xm = MT::convert( x[m] );
+
+      T const vol  = inner_prod( xm - xi,  cross(xj - xi, xk - xi) ) / VT::numeric_cast(6.0);
+
+      T const node_mass = rho*vol / VT::four();
+
+      mass[i] += node_mass;
+      mass[j] += node_mass;
+      mass[k] += node_mass;
+      mass[m] += node_mass;
+    }
+
+    T min_mass = VT::zero();
+
+    for (size_t n = 0u; n < mass.size(); ++n)
+    {
+      if( mass[n] > VT::zero() )
+        min_mass = (min_mass > VT::zero()) ? min( min_mass, mass[n] ) : mass[n];
+    }
+
+    return min_mass;
+  }
+
 }// namespace hyper
 
 // HYPER_COMPUTE_MASS_MATRIX_H
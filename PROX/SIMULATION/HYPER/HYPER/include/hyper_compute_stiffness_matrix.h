@@ -0,0 +1,148 @@
+#ifndef HYPER_COMPUTE_STIFFNESS_MATRIX_H
+#define HYPER_COMPUTE_STIFFNESS_MATRIX_H
+
+#include <hyper_constitutive_equation.h>
+#include <hyper_math_policy.h>
+
+#include <mesh_array.h>
+#include <tiny_is_finite.h>
+#include <tiny_is_number.h>
+
+#include <vector>
+#include <cassert>
+
+namespace hyper
+{
+
+  /**
+   * Compute elementwise tangent stiffness matrices.
+   *
+   * The elastic nodal forces of a tetrahedron are given by
+   *
+   *    f_a = P(F) G_a
+   *
+   * where G_a = V0 nabla_0 w_a is the volume weighted material gradient of
+   * the shape function of node a. The deformation gradient is
+   *
+   *    F = sum_b x_b nabla_0 w_b^T
+   *
+   * so moving node b along the unit axis e_c changes F by
+   * dF = e_c nabla_0 w_b^T. Column c of block K_ab is therefore
+   *
+   *    dP(F, e_c nabla_0 w_b^T) G_a
+   *
+   * The stiffness matrix is the derivative of the forces computed by
+   * compute_elastic_forces with respect to the spatial coordinates.
+   *
+   * @tparam MT    Math types type binder.
+   */
+  template<typename MT>
+  inline void compute_stiffness_matrix(
+                                       mesh_array::T4Mesh  const & mesh
+                                       , typename MT::vector_block3x1_type const & x
+                                       , typename MT::vector_block3x1_type const & x0
+                                       , ConstitutiveEquation<MT> const * model
+                                       , std::vector< typename MT::element_matrices_type > & Ke
+                                       )
+  {
+    assert( model || !"compute_stiffness_matrix(): model was NULL");
+
+    typedef typename MT::matrix3x3_type          M;
+    typedef typename MT::vector3_type            V;
+    typedef typename MT::real_type               T;
+    typedef typename MT::value_traits            VT;
+    typedef typename MT::element_matrices_type   element_matrices_type;
+
+    unsigned int const K = mesh.tetrahedron_size();
+
+    Ke.resize(K);
+
+    for ( unsigned int idx = 0u; idx < K; ++idx)
+    {
+      mesh_array::Tetrahedron const & tetrahedron = mesh.tetrahedron(idx);
+
+      unsigned int const i  = tetrahedron.i();
+      unsigned int const j  = tetrahedron.j();
+      unsigned int const k  = tetrahedron.k();
+      unsigned int const m  = tetrahedron.m();
+
+      V const xi = MT::convert( x[i] );
+      V const xj = MT::convert( x[j] );
+      V const xk = MT::convert( x[k] );
+      V const xm = MT::convert( x[m] );
+
+      V const x0i = MT::convert( x0[i] );
+      V const x0j = MT::convert( x0[j] );
+      V const x0k = MT::convert( x0[k] );
+      V const x0m = MT::convert( x0[m] );
+
+      V const u_ji = xj - xi;
+      V const u_ki = xk - xi;
+      V const u_mi = xm - xi;
+
+      V const u0_ji = x0j - x0i;
+      V const u0_ki = x0k - x0i;
+      V const u0_mi = x0m - x0i;
+
+      M const D = M::make(
+                          u_ji(0), u_ki(0), u_mi(0)
+                          , u_ji(1), u_ki(1), u_mi(1)
+                          , u_ji(2), u_ki(2), u_mi(2)
+                          );
+
+      M const D0 = M::make(
+                           u0_ji(0), u0_ki(0), u0_mi(0)
+                           , u0_ji(1), u0_ki(1), u0_mi(1)
+                           , u0_ji(2), u0_ki(2), u0_mi(2)
+                           );
+
+      M const invD0 = inverse(D0);
+      M const F     = prod(D, invD0 );
+      T const V0    = det(D0) / VT::numeric_cast(6.0);
+
+      assert( V0 > VT::zero() || !"compute_stiffness_matrix(): degenerate tetrahedron in material space");
+
+      //--- Material gradients of the shape functions --------------------------
+      V g[4];
+
+      g[1] = V::make( invD0(0,0), invD0(0,1), invD0(0,2) );
+      g[2] = V::make( invD0(1,0), invD0(1,1), invD0(1,2) );
+      g[3] = V::make( invD0(2,0), invD0(2,1), invD0(2,2) );
+      g[0] = -(g[1] + g[2] + g[3]);
+
+      element_matrices_type & E = Ke[idx];
+
+      for (unsigned int b = 0u; b < 4u; ++b)
+      {
+        for (unsigned int c = 0u; c < 3u; ++c)
+        {
+          V e_c = V::zero();
+          e_c(c) = VT::one();
+
+          M const dP = model->dP( F, tiny::outer_prod( e_c, g[b] ) );
+
+          for (unsigned int a = 0u; a < 4u; ++a)
+          {
+            V const df = prod( dP, g[a] ) * V0;
+
+            assert( is_number(df(0)) || !"compute_stiffness_matrix(): df(0) is not a number");
+            assert( is_number(df(1)) || !"compute_stiffness_matrix(): df(1) is not a number");
+            assert( is_number(df(2)) || !"compute_stiffness_matrix(): df(2) is not a number");
+
+            assert( is_finite(df(0)) || !"compute_stiffness_matrix(): df(0) is not finite");
+            assert( is_finite(df(1)) || !"compute_stiffness_matrix(): df(1) is not finite");
+            assert( is_finite(df(2)) || !"compute_stiffness_matrix(): df(2) is not finite");
+
+            E(a,b)(0,c) = df(0);
+            E(a,b)(1,c) = df(1);
+            E(a,b)(2,c) = df(2);
+          }
+        }
+      }
+    }
+  }
+
+}// namespace hyper
+
+// HYPER_COMPUTE_STIFFNESS_MATRIX_H
+#endif
@@ -3,6 +3,10 @@
 
 #include <hyper_material_parameters.h>
 
+#include <tiny.h>
+
+#include <cmath>
+#include <limits>
 #include <string>
 
 namespace hyper
@@ -58,6 +62,55 @@ namespace hyper
      */
     virtual M sigma(M const & F) const = 0;
 
+    /**
+     * Compute 1st Piola Kirchhoff Stress tensor
+     *
+     * @param F    The deformation gradient.
+     *
+     * @return     The 1st Piola Kirchhoff stress tensor, P = det(F) sigma F^{-T}.
+     */
+    virtual M P(M const & F) const
+    {
+      T const j = tiny::det( F );
+
+      return j * tiny::prod( this->sigma(F), tiny::trans( tiny::inverse(F) ) );
+    }
+
+    /**
+     * Compute the directional derivative of the 1st Piola Kirchhoff stress
+     * tensor. This is the material part of the tangent stiffness used by
+     * implicit time integration.
+     *
+     * The default implementation uses central differences of P, constitutive
+     * models are free to provide an analytical derivative.
+     *
+     * @param F    The deformation gradient.
+     * @param dF   The direction of change of the deformation gradient.
+     *
+     * @return     The change of the 1st Piola Kirchhoff stress tensor, dP = dP/dF : dF.
+     */
+    virtual M dP(M const & F, M const & dF) const
+    {
+      using std::abs;
+      using std::max;
+      using std::pow;
+
+      T scale = VT::zero();
+
+      for(unsigned int r = 0u; r < 3u; ++r)
+        for(unsigned int c = 0u; c < 3u; ++c)
+          scale = max( scale, abs( dF(r,c) ) );
+
+      if( scale <= VT::zero() )
+        return M::zero();
+
+      // Step size that balances truncation and round-off errors of central differences
+      T const h      = pow( std::numeric_limits<T>::epsilon(), VT::one() / VT::numeric_cast(3.0) );
+      M const delta  = (h / scale) * dF;
+
+      return ( scale / (VT::two() * h) ) * ( this->P( F + delta ) - this->P( F - delta ) );
+    }
+
     /**
      * Get human readable name for constitutive equation. Useful for making out text/error messages.
      *
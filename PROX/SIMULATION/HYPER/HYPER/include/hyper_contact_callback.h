@@ -38,6 +38,8 @@ namespace hyper
       body_type                   * m_body_i;   ///< A pointer to body i of the contact.
       body_type                   * m_body_j;   ///< A pointer to body j of the contact.
       std::vector< contact_type > * m_results;  ///< A pointer to a contact point container where all generated contacts should be added to.
+      size_t                        m_tetrahedron_i;  ///< The tetrahedron on body i currently being tested.
+      size_t                        m_tetrahedron_j;  ///< The tetrahedron on body j currently being tested.
 
     public:
 
@@ -45,12 +47,16 @@ namespace hyper
       : m_body_i(0)
       , m_body_j(0)
       , m_results(0)
+      , m_tetrahedron_i(0u)
+      , m_tetrahedron_j(0u)
       {}
 
       ContactCallbackFunctor(body_type * A, body_type * B, std::vector< hyper::ContactPoint<MT> > & results)
       : m_body_i(A)
       , m_body_j(B)
       , m_results(&results)
+      , m_tetrahedron_i(0u)
+      , m_tetrahedron_j(0u)
       {}
 
       ~ContactCallbackFunctor(){}
@@ -62,6 +68,8 @@ namespace hyper
           this->m_body_i  = callback.m_body_i;
           this->m_body_j  = callback.m_body_j;
           this->m_results = callback.m_results;
+          this->m_tetrahedron_i = callback.m_tetrahedron_i;
+          this->m_tetrahedron_j = callback.m_tetrahedron_j;
         }
         return *this;
       }
@@ -87,9 +95,25 @@ namespace hyper
         contact.set_normal( n );
         contact.set_body_i( this->m_body_i );
         contact.set_body_j( this->m_body_j );
+        contact.set_tetrahedra( this->m_tetrahedron_i, this->m_tetrahedron_j );
 
         this->m_results->push_back( contact );
       }
+
+      /*
+       * Set features callback function.
+       * The tandem traversal invokes this function before testing a pair of
+       * tetrahedra. The indices are stored in the generated contacts such
+       * that the contact response knows which nodes are involved.
+       *
+       * @param feature_a    The tetrahedron index on body i.
+       * @param feature_b    The tetrahedron index on body j.
+       */
+      void set_features( size_t const & feature_a, size_t const & feature_b)
+      {
+        this->m_tetrahedron_i = feature_a;
+        this->m_tetrahedron_j = feature_b;
+      }
     };
 
   }// namespace detail
@@ -23,6 +23,8 @@ namespace hyper
     
     body_type *      m_body_i;
     body_type *      m_body_j;
+    size_t           m_tetrahedron_i;    ///< Index of the tetrahedron on body i that generated the contact.
+    size_t           m_tetrahedron_j;    ///< Index of the tetrahedron on body j that generated the contact.
     
   public:
 
@@ -32,6 +34,8 @@ namespace hyper
     , m_depth(real_type(0))
     , m_body_i(0)
     , m_body_j(0)
+    , m_tetrahedron_i(0u)
+    , m_tetrahedron_j(0u)
     {}
     
     virtual ~ContactPoint(){}
@@ -50,6 +54,8 @@ namespace hyper
         this->m_depth       = point.m_depth;
         this->m_body_i      = point.m_body_i;
         this->m_body_j      = point.m_body_j;
+        this->m_tetrahedron_i = point.m_tetrahedron_i;
+        this->m_tetrahedron_j = point.m_tetrahedron_j;
       }
       return *this;
     }
@@ -59,12 +65,21 @@ namespace hyper
     real_type    const & get_depth()    const  {  return this->m_depth;    }
     body_type    const * get_body_i()    const {  return this->m_body_i;   }
     body_type    const * get_body_j()    const {  return this->m_body_j;   }
+    body_type          * get_body_i()          {  return this->m_body_i;   }
+    body_type          * get_body_j()          {  return this->m_body_j;   }
+    size_t       const & get_tetrahedron_i() const { return this->m_tetrahedron_i; }
+    size_t       const & get_tetrahedron_j() const { return this->m_tetrahedron_j; }
     
     void set_position(vector3_type const & p)  {  this->m_position = p;    }
     void set_normal(vector3_type const & n)    {  this->m_normal = n;      }
     void set_depth(real_type const & d)        {  this->m_depth = d;       }
     void set_body_i(body_type const * body_i)  {  this->m_body_i = const_cast<body_type*>(body_i); }  // 2009-11-25 Kenny: hmm can we not get rid of const casts?
     void set_body_j(body_type const * body_j)  {  this->m_body_j = const_cast<body_type*>(body_j); }  // 2009-11-25 Kenny: hmm can we not get rid of const casts?
+    void set_tetrahedra(size_t const & tetrahedron_i, size_t const & tetrahedron_j)
+    {
+      this->m_tetrahedron_i = tetrahedron_i;
+      this->m_tetrahedron_j = tetrahedron_j;
+    }
     
   };
 
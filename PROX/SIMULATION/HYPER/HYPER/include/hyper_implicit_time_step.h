@@ -0,0 +1,280 @@
+#ifndef HYPER_IMPLICIT_TIME_STEP_H
+#define HYPER_IMPLICIT_TIME_STEP_H
+
+#include <hyper_math_policy.h>
+#include <hyper_constitutive_equation.h>
+#include <hyper_compute_elastic_forces.h>
+#include <hyper_compute_stiffness_matrix.h>
+#include <hyper_assemble_matrix.h>
+#include <hyper_assembly_cache.h>
+#include <hyper_apply_dirichlet_conditions.h>
+#include <hyper_semi_implicit_time_step.h>
+
+#include <mesh_array.h>
+
+#include <sparse.h>
+#include <sparse_preconditioners.h>
+#include <sparse_conjugate_gradient.h>
+
+#include <util_log.h>
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <cassert>
+
+namespace hyper
+{
+
+  namespace details
+  {
+
+    /**
+     * Builds the preconditioner P of A, the storage of P is reused.
+     */
+    template<typename M>
+    inline void make_preconditioner(
+                                    preconditioner_type const & precond
+                                    , M const & A
+                                    , M & P
+                                    )
+    {
+      switch(precond)
+      {
+        case identity_precond:     sparse::make_identity_preconditioner(P);       break;
+        case jacobi_precond:       sparse::make_jacobi_preconditioner(A,P);       break;
+        case block_jacobi_precond: sparse::make_block_jacobi_preconditioner(A,P); break;
+      };
+    }
+
+    /**
+     * Computes the negative Newton residual:  b = M*(v0 - v) + dt*(Fext - f - C*v)
+     */
+    template<typename MT>
+    inline void compute_newton_rhs(
+                                   mesh_array::T4Mesh  const & mesh
+                                   , mesh_array::Neighborhoods const & neighbors
+                                   , typename MT::real_type const & dt
+                                   , std::vector< typename MT::element_matrices_type > const & Me
+                                   , std::vector< typename MT::element_matrices_type > const & Ce
+                                   , typename MT::vector_block3x1_type const & v0
+                                   , typename MT::vector_block3x1_type const & v
+                                   , typename MT::vector_block3x1_type const & Fext
+                                   , typename MT::vector_block3x1_type const & f
+                                   , typename MT::vector_block3x1_type & b
+                                   )
+    {
+      assert( v.size()    == v0.size()   || !"compute_newton_rhs(): v and v0 must have same size");
+      assert( v.size()    == Fext.size() || !"compute_newton_rhs(): v and Fext must have same size");
+      assert( Fext.size() == f.size()    || !"compute_newton_rhs(): Fext and f must have same size");
+      assert( v.size()    == b.size()    || !"compute_newton_rhs(): v and b must have same size");
+
+      typedef typename MT::vector_block3x1_type      vector_block3x1_type;
+      typedef typename MT::vector3_type              V;
+
+      unsigned int const N = v.size();  ///< Number of blocks
+
+      vector_block3x1_type dv(N);
+      vector_block3x1_type cv(N);
+      vector_block3x1_type mdv(N);
+
+      sparse::sub(v0, v, dv);
+
+      mul<MT>( mesh, neighbors, Ce, v, cv);
+      mul<MT>( mesh, neighbors, Me, dv, mdv);
+
+      for(size_t i = 0u; i < N; ++i)
+      {
+        V const Fext_i  = MT::convert( Fext[i] );
+        V const f_i     = MT::convert( f[i] );
+        V const cv_i    = MT::convert( cv[i] );
+        V const mdv_i   = MT::convert( mdv[i] );
+        V const b_i     = mdv_i + dt*(Fext_i - f_i - cv_i);
+        b[i]            = MT::convert( b_i );
+      }
+    }
+
+  }// end namespace details
+
+  /**
+   * Fully implicit time step.
+   *
+   * Backward Euler is used for the dynamics
+   *
+   *   M (v^{t+1} - v^t) = dt (Fext - f(x^{t+1}) - C v^{t+1})
+   *   x^{t+1}           = x^t + dt v^{t+1}
+   *
+   * The nonlinear equations are solved for v^{t+1} by Newton's method. Each
+   * Newton iteration solves
+   *
+   *   (M + dt C + dt^2 K) dv = M (v^t - v) + dt (Fext - f - C v)
+   *
+   * where K is the tangent stiffness matrix at x^t + dt v. Unlike the
+   * semi-implicit time step this is stable for large time steps on stiff
+   * materials, so no CFL condition is needed.
+   *
+   * K need not be positive definite, e.g. for inverted or strongly
+   * compressed elements. If the conjugate gradient method detects that the
+   * Newton matrix is indefinite then the Newton step is solved again with
+   * K dropped, M + dt C is always positive definite.
+   *
+   * @param max_iterations   The maximum number of Newton iterations.
+   * @param tolerance        Newton iterations stop once the largest velocity
+   *                         update is below this value.
+   * @param cache            Mass and damping element matrices and the fill
+   *                         pattern of the Newton matrix, these are reused
+   *                         from one time step to the next.
+   */
+  template<typename MT>
+  inline void implicit_time_step(
+                                 mesh_array::T4Mesh  const & mesh
+                                 , mesh_array::Neighborhoods const & neighbors
+                                 , std::vector<DirichletInfo<MT> > const & dirichlet_conditions
+                                 , typename MT::real_type const & dt
+                                 , typename MT::vector_block3x1_type & x
+                                 , typename MT::vector_block3x1_type const & x0
+                                 , typename MT::vector_block3x1_type & v
+                                 , typename MT::vector_block3x1_type const & Fext
+                                 , ConstitutiveEquation<MT> const * model
+                                 , preconditioner_type const & precond
+                                 , size_t const & max_iterations
+                                 , typename MT::real_type const & tolerance
+                                 , AssemblyCache<MT> & cache
+                                 )
+  {
+    assert( model || !"implicit_time_step(): model was NULL");
+
+    using std::abs;
+    using std::max;
+
+    typedef typename MT::vector3_type              V;
+    typedef typename MT::real_type                 T;
+    typedef typename MT::value_traits              VT;
+
+    typedef typename MT::vector_block3x1_type      vector_block3x1_type;
+    typedef typename MT::compressed_block3x3_type  compressed_block3x3_type;
+    typedef typename MT::element_matrices_type     element_matrices_type;
+
+    unsigned int const N = x.size();  ///< Number of blocks
+    unsigned int const K = mesh.tetrahedron_size();
+
+    vector_block3x1_type f(N);
+    vector_block3x1_type b(N);
+    vector_block3x1_type dv(N);
+    vector_block3x1_type xk(N);
+    vector_block3x1_type tmp(N);
+
+    cache.update( mesh, neighbors, x0, model );
+
+    std::vector< element_matrices_type > const & Me = cache.Me();
+    std::vector< element_matrices_type > const & Ce = cache.Ce();
+    std::vector< element_matrices_type >         Ke(K);
+    std::vector< element_matrices_type >         Ae(K);
+
+    compressed_block3x3_type P(N,N,N);
+
+    vector_block3x1_type const v0 = v;
+
+    //--- The velocity updates are zero at Dirichlet nodes, the initial
+    //--- guess of the new velocity already satisfies the conditions.
+    std::vector<DirichletInfo<MT> > homogeneous_conditions( dirichlet_conditions );
+
+    for(unsigned int i = 0u; i < dirichlet_conditions.size(); ++i)
+    {
+      v( dirichlet_conditions[i].idx() ) = MT::convert( dirichlet_conditions[i].value() );
+
+      homogeneous_conditions[i].value() = V::zero();
+    }
+
+    for(size_t iteration = 0u; iteration < max_iterations; ++iteration)
+    {
+      //--- xk = x + dt*v
+      xk = x;
+      sparse::prod(dt, v, tmp, true);
+      sparse::add(tmp, xk);
+
+      compute_elastic_forces<MT>( mesh, neighbors, xk, x0, f, model );
+      compute_stiffness_matrix<MT>( mesh, xk, x0, model, Ke );
+
+      details::compute_newton_rhs<MT>( mesh, neighbors, dt, Me, Ce, v0, v, Fext, f, b );
+
+      for(unsigned int e = 0u; e < K; ++e)
+        Ae[e] = Me[e] + Ce[e]*dt + Ke[e]*(dt*dt);
+
+      compressed_block3x3_type & A = cache.assemble( Ae );
+
+      apply_dirichlet_conditions<MT>(homogeneous_conditions, A, b);
+
+      details::make_preconditioner(precond, A, P);
+
+      dv.clear_data();
+
+      if( ! sparse::preconditioned_conjugate_gradient(P,A,dv,b) )
+      {
+        util::Log logging;
+
+        logging << "implicit_time_step(): Newton matrix is indefinite, solving without the stiffness matrix" << util::Log::newline();
+
+        for(unsigned int e = 0u; e < K; ++e)
+          Ae[e] = Me[e] + Ce[e]*dt;
+
+        cache.assemble( Ae );
+
+        apply_dirichlet_conditions<MT>(homogeneous_conditions, A, b);
+
+        details::make_preconditioner(precond, A, P);
+
+        dv.clear_data();
+
+        sparse::preconditioned_conjugate_gradient(P,A,dv,b);
+      }
+
+      sparse::add(dv, v);
+
+      T largest_update = VT::zero();
+
+      for(unsigned int i = 0u; i < N; ++i)
+      {
+        largest_update = max( abs( dv(i)(0) ), largest_update );
+        largest_update = max( abs( dv(i)(1) ), largest_update );
+        largest_update = max( abs( dv(i)(2) ), largest_update );
+      }
+
+      if( largest_update <= tolerance )
+        break;
+    }
+
+    //--- Position update ------------------------------------------------------
+    //    x = x + dt*v;
+    sparse::prod(dt, v, tmp, true);
+    sparse::add(tmp, x);
+  }
+
+  /**
+   * Fully implicit time step without reusing any data from previous time steps.
+   */
+  template<typename MT>
+  inline void implicit_time_step(
+                                 mesh_array::T4Mesh  const & mesh
+                                 , mesh_array::Neighborhoods const & neighbors
+                                 , std::vector<DirichletInfo<MT> > const & dirichlet_conditions
+                                 , typename MT::real_type const & dt
+                                 , typename MT::vector_block3x1_type & x
+                                 , typename MT::vector_block3x1_type const & x0
+                                 , typename MT::vector_block3x1_type & v
+                                 , typename MT::vector_block3x1_type const & Fext
+                                 , ConstitutiveEquation<MT> const * model
+                                 , preconditioner_type const & precond
+                                 , size_t const & max_iterations
+                                 , typename MT::real_type const & tolerance
+                                 )
+  {
+    AssemblyCache<MT> cache;
+
+    implicit_time_step<MT>( mesh, neighbors, dirichlet_conditions, dt, x, x0, v, Fext, model, precond, max_iterations, tolerance, cache );
+  }
+
+}// namespace hyper
+
+// HYPER_IMPLICIT_TIME_STEP_H
+#endif
@@ -44,6 +44,13 @@ namespace hyper
     T       m_adaptive_halving_tolerance;  ///< The havling tolerance, the maximum allowed error (accuracy).
     size_t  m_adaptive_doubling_count;     ///< The number of consecutive time steps to take before trying ot increase time step-size.
 
+    size_t  m_newton_max_iterations;       ///< The maximum number of Newton iterations per time step when using implicit time-stepping.
+    T       m_newton_tolerance;            ///< Newton iterations stop once the largest velocity update is below this value.
+
+    bool    m_use_contact_forces;          ///< Boolean flag for turning on/off penalty contact forces between bodies.
+    T       m_contact_stiffness;           ///< The penalty stiffness of contacts, force per unit of penetration depth.
+    T       m_contact_damping;             ///< The penalty damping of contacts, force per unit of approaching normal velocity.
+
   protected:
 
     bool   m_use_open_cl;
@@ -181,6 +188,46 @@ namespace hyper
       this->m_adaptive_doubling_count = value;
     }
 
+  public:
+
+    size_t const & newton_max_iterations() const    {      return this->m_newton_max_iterations;         }
+    T      const & newton_tolerance()      const    {      return this->m_newton_tolerance;              }
+
+    void set_newton_max_iterations(size_t const & value)
+    {
+      assert( value > 0u || !"set_newton_max_iterations(): illegal value");
+      this->m_newton_max_iterations = value;
+    }
+
+    void set_newton_tolerance(T const & value)
+    {
+      assert( value >= VT::zero() || !"set_newton_tolerance(): illegal value");
+      this->m_newton_tolerance = value;
+    }
+
+  public:
+
+    bool   const & use_contact_forces()    const    {      return this->m_use_contact_forces;            }
+    T      const & contact_stiffness()     const    {      return this->m_contact_stiffness;             }
+    T      const & contact_damping()       const    {      return this->m_contact_damping;               }
+
+    void set_use_contact_forces(bool const & value)
+    {
+      this->m_use_contact_forces = value;
+    }
+
+    void set_contact_stiffness(T const & value)
+    {
+      assert( value >= VT::zero() || !"set_contact_stiffness(): illegal value");
+      this->m_contact_stiffness = value;
+    }
+
+    void set_contact_damping(T const & value)
+    {
+      assert( value >= VT::zero() || !"set_contact_damping(): illegal value");
+      this->m_contact_damping = value;
+    }
+
   public:
 
     time_step_method_type get_time_step_method_type()const
@@ -224,6 +271,11 @@ namespace hyper
     , m_adaptive_max_dt(VT::numeric_cast(0.01))
     , m_adaptive_halving_tolerance(VT::numeric_cast(0.000001))
     , m_adaptive_doubling_count(5u)
+    , m_newton_max_iterations(10u)
+    , m_newton_tolerance(VT::numeric_cast(0.0001))
+    , m_use_contact_forces(false)
+    , m_contact_stiffness(VT::numeric_cast(1000.0))
+    , m_contact_damping(VT::numeric_cast(1.0))
     , m_use_open_cl( false )
     , m_open_cl_platform( 0 )
     , m_open_cl_device( 0 )
@@ -251,6 +303,13 @@ namespace hyper
       this->m_adaptive_halving_tolerance   = VT::numeric_cast(0.000001);
       this->m_adaptive_doubling_count      =  5u;
 
+      this->m_newton_max_iterations        = 10u;
+      this->m_newton_tolerance             = VT::numeric_cast(0.0001);
+
+      this->m_use_contact_forces           = false;
+      this->m_contact_stiffness            = VT::numeric_cast(1000.0);
+      this->m_contact_damping              = VT::numeric_cast(1.0);
+
       this->m_use_open_cl       = false;
       this->m_open_cl_platform  = 0;
       this->m_open_cl_device    = 0;
@@ -90,6 +90,30 @@ namespace hyper
       return (lambda * tiny::trace(E)) * M::identity() + (VT::two() * mu) * E;
     }
 
+    /**
+     * Compute the directional derivative of the 1st Piola Kirchhoff stress tensor.
+     *
+     * From P = F S we have dP = dF S + F dS where
+     *
+     *   dS = lambda tr(dE) I + 2 mu dE
+     *   dE = 1/2 (dF^T F + F^T dF)
+     *
+     * @param F    The deformation gradient.
+     * @param dF   The direction of change of the deformation gradient.
+     *
+     * @return     The change of the 1st Piola Kirchhoff stress tensor.
+     */
+    M dP(M const & F, M const & dF) const
+    {
+      T const lambda = this->m_material.lambda();
+      T const mu     = this->m_material.mu();
+
+      M const dE = VT::half() * ( tiny::prod( tiny::trans(dF), F ) + tiny::prod( tiny::trans(F), dF ) );
+      M const dS = (lambda * tiny::trace(dE)) * M::identity() + (VT::two() * mu) * dE;
+
+      return tiny::prod( dF, this->S(F) ) + tiny::prod( F, dS );
+    }
+
     /**
      * Compute Cauchy Stress tensor
      *
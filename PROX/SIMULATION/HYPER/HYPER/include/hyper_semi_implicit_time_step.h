@@ -8,6 +8,7 @@
 #include <hyper_compute_damping_matrix.h>
 #include <hyper_assemble_diagonal.h>
 #include <hyper_assemble_matrix.h>
+#include <hyper_assembly_cache.h>
 #include <hyper_apply_dirichlet_conditions.h>
 
 #include <mesh_array.h>
@@ -83,7 +84,11 @@ namespace hyper
   typedef enum { identity_precond, jacobi_precond, block_jacobi_precond} preconditioner_type;
 
   /**
+   * Semi-implicit time step.
    *
+   * @param cache   Mass and damping element matrices and the fill pattern
+   *                of the mass matrix, these are reused from one time step to
+   *                the next.
    */
   template<typename MT>
   inline void semi_implicit_time_step(
@@ -97,6 +102,7 @@ namespace hyper
                                       , typename MT::vector_block3x1_type const & Fext
                                       , ConstitutiveEquation<MT> const * model
                                       , preconditioner_type const & precond
+                                      , AssemblyCache<MT> & cache
                                       )
   {
     assert( model || !"semi_implicit_time_step(): model was NULL");
@@ -117,13 +123,12 @@ namespace hyper
     vector_block3x1_type b(N);
     vector_block3x1_type tmp(N);
 
-    std::vector< element_matrices_type > Me;
-    std::vector< element_matrices_type > Ce;
-
     compute_elastic_forces<MT>( mesh, neighbors, x, x0, f, model );
 
-    compute_mass_matrix<MT>( mesh, x0, model, Me);         // 2015-03-25 Kenny code review: Only needs to be recomputed if mesh changed
-    compute_damping_matrix<MT>( mesh, x0, model, Ce);      // 2015-03-25 Kenny code review: Only needs to be recomputed if mesh changed
+    cache.update( mesh, neighbors, x0, model );
+
+    std::vector< element_matrices_type > const & Me = cache.Me();
+    std::vector< element_matrices_type > const & Ce = cache.Ce();
 
     //--- Velocity update ------------------------------------------------------
     //--- solve
@@ -153,9 +158,7 @@ namespace hyper
     }
     else
     {
-      compressed_block3x3_type A;
-
-      assemble_matrix<MT>(mesh, neighbors, Me,  A);
+      compressed_block3x3_type & A = cache.assemble( Me );
 
       apply_dirichlet_conditions<MT>(dirichlet_conditions, A, b);
 
@@ -176,6 +179,28 @@ namespace hyper
     sparse::prod(dt, v, tmp);
     sparse::add(tmp, x);
   }
+
+  /**
+   * Semi-implicit time step without reusing any data from previous time steps.
+   */
+  template<typename MT>
+  inline void semi_implicit_time_step(
+                                      mesh_array::T4Mesh  const & mesh
+                                      , mesh_array::Neighborhoods const & neighbors
+                                      , std::vector<DirichletInfo<MT> > const & dirichlet_conditions
+                                      , typename MT::real_type const & dt
+                                      , typename MT::vector_block3x1_type & x
+                                      , typename MT::vector_block3x1_type const & x0
+                                      , typename MT::vector_block3x1_type & v
+                                      , typename MT::vector_block3x1_type const & Fext
+                                      , ConstitutiveEquation<MT> const * model
+                                      , preconditioner_type const & precond
+                                      )
+  {
+    AssemblyCache<MT> cache;
+
+    semi_implicit_time_step<MT>( mesh, neighbors, dirichlet_conditions, dt, x, x0, v, Fext, model, precond, cache );
+  }
   
 }// namespace hyper
 
@@ -4,7 +4,9 @@
 #include <hyper_engine.h>
 #include <hyper_collision_detection.h>
 #include <hyper_compute_gravity_forces.h>
+#include <hyper_compute_contact_forces.h>
 #include <hyper_semi_implicit_time_step.h>
+#include <hyper_implicit_time_step.h>
 #include <hyper_adaptive_time_step.h>
 #include <hyper_modifiers.h>
 #include <hyper_compute_CFL_time_step_size.h>
@@ -75,6 +77,25 @@ namespace hyper
 
       collision_detection( engine );
 
+      for (body_iterator body = engine.body_begin();body != engine.body_end(); ++body)
+      {
+        if(body->m_scripted_motion)
+          continue;
+
+        compute_traction_forces(body->m_traction_conditions, body->m_mesh, body->m_x, body->m_F);
+
+        sparse::add(body->m_Fext, body->m_F);
+      }
+
+      if( engine.params().use_contact_forces() )
+      {
+        compute_contact_forces<MT>(
+                                   engine.contacts()
+                                   , engine.params().contact_stiffness()
+                                   , engine.params().contact_damping()
+                                   );
+      }
+
       for (body_iterator body = engine.body_begin();body != engine.body_end(); ++body)
       {
 
@@ -84,10 +105,6 @@ namespace hyper
         }
         else
         {
-          compute_traction_forces(body->m_traction_conditions, body->m_mesh, body->m_x, body->m_F);
-
-          sparse::add(body->m_Fext, body->m_F);
-
           switch (engine.params().get_time_step_method_type())
           {
             case params_type::semi_implicit_type:
@@ -103,6 +120,7 @@ namespace hyper
                                       , body->m_F
                                       , body->m_model
                                       , jacobi_precond
+                                      , body->m_assembly_cache
                                       );
 
               break;
@@ -113,6 +131,26 @@ namespace hyper
 
               break;
 
+            case params_type::implicit_type:
+
+              implicit_time_step(
+                                 body->m_mesh
+                                 , body->m_neighbors
+                                 , body->m_dirichlet_conditions
+                                 , dt
+                                 , body->m_x
+                                 , body->m_x0
+                                 , body->m_v
+                                 , body->m_F
+                                 , body->m_model
+                                 , jacobi_precond
+                                 , engine.params().newton_max_iterations()
+                                 , engine.params().newton_tolerance()
+                                 , body->m_assembly_cache
+                                 );
+
+              break;
+
               
             default:
               break;
@@ -31,6 +31,34 @@ namespace hyper
     }
     
   }
+
+  /**
+   * Update kDOP BVHs of all bodies. The refit of each tree runs in
+   * parallel over the chunks of the tree.
+   */
+  template<typename MT>
+  inline void update_kdop_bvh(
+                              Engine<MT> & engine
+                              , kdop::parallel const & tag
+                              )
+  {
+    typedef typename MT::real_type    T;
+    typedef typename MT::vector3_type V;
+
+    typename Engine<MT>::body_iterator current = engine.body_begin();
+    typename Engine<MT>::body_iterator end     = engine.body_end();
+
+    for (; current != end; ++current)
+    {
+      Body<MT> & body    = *(current);
+
+      if(body.empty())
+        continue;
+
+      kdop::refit_tree<V,8,T>(body.m_tree, body.m_mesh, body.m_X, body.m_Y, body.m_Z, tag );
+    }
+
+  }
   
 } // namespace hyper
 
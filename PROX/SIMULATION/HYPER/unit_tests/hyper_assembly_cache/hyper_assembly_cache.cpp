@@ -0,0 +1,167 @@
+#include <hyper.h>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <cmath>
+
+typedef hyper::MathPolicy<double> MT;
+typedef MT::real_type             T;
+typedef MT::vector3_type          V;
+typedef MT::matrix3x3_type        M;
+typedef MT::value_traits          VT;
+
+typedef MT::vector_block3x1_type      vector_block3x1_type;
+typedef MT::compressed_block3x3_type  compressed_block3x3_type;
+typedef MT::element_matrices_type     element_matrices_type;
+
+/**
+ * Make a mesh of two tetrahedra sharing a face.
+ */
+void make_mesh(
+               mesh_array::T4Mesh & mesh
+               , mesh_array::Neighborhoods & neighbors
+               , vector_block3x1_type & x0
+               )
+{
+  mesh.clear();
+  mesh.set_capacity(5u, 2u);
+
+  mesh_array::Vertex const & i = mesh.push_vertex();
+  mesh_array::Vertex const & j = mesh.push_vertex();
+  mesh_array::Vertex const & k = mesh.push_vertex();
+  mesh_array::Vertex const & m = mesh.push_vertex();
+  mesh_array::Vertex const & n = mesh.push_vertex();
+
+  mesh.push_tetrahedron(i, j, k, m);
+  mesh.push_tetrahedron(j, i, k, n);
+
+  mesh_array::compute_neighbors(mesh, neighbors);
+
+  x0.resize(5u);
+  x0(0) = MT::convert( V::make( 0.0, 0.0,  0.0 ) );
+  x0(1) = MT::convert( V::make( 1.0, 0.0,  0.0 ) );
+  x0(2) = MT::convert( V::make( 0.0, 1.0,  0.0 ) );
+  x0(3) = MT::convert( V::make( 0.0, 0.0,  1.0 ) );
+  x0(4) = MT::convert( V::make( 0.3, 0.3, -1.0 ) );
+}
+
+/**
+ * Element matrices with distinct entries, so misplaced blocks are detected.
+ */
+void make_element_matrices( std::vector< element_matrices_type > & Ae )
+{
+  Ae.resize(2u);
+
+  for(unsigned int e = 0u; e < 2u; ++e)
+    for(unsigned int a = 0u; a < 4u; ++a)
+      for(unsigned int b = 0u; b < 4u; ++b)
+        for(unsigned int r = 0u; r < 3u; ++r)
+          for(unsigned int c = 0u; c < 3u; ++c)
+            Ae[e](a,b)(r,c) = 1000.0*e + 100.0*a + 10.0*b + 3.0*r + c + 1.0;
+}
+
+BOOST_AUTO_TEST_SUITE(hyper);
+
+BOOST_AUTO_TEST_CASE(scatter_matrix_test)
+{
+  mesh_array::T4Mesh        mesh;
+  mesh_array::Neighborhoods neighbors;
+  vector_block3x1_type      x0;
+
+  make_mesh(mesh, neighbors, x0);
+
+  std::vector< element_matrices_type > Ae;
+
+  make_element_matrices(Ae);
+
+  compressed_block3x3_type A_assembled;
+
+  hyper::assemble_matrix<MT>(mesh, neighbors, Ae, A_assembled);
+
+  compressed_block3x3_type const & A = A_assembled;
+
+  hyper::SaintVernantKirchhoff<MT> model;
+  hyper::AssemblyCache<MT>         cache;
+
+  cache.update(mesh, neighbors, x0, &model);
+
+  BOOST_CHECK( cache.is_valid(mesh, &model) );
+
+  // Assemble twice to make sure old values are not accumulated
+  cache.assemble( Ae );
+
+  compressed_block3x3_type const & B = cache.assemble( Ae );
+
+  BOOST_CHECK_EQUAL( A.size(), B.size() );
+
+  for(size_t r = 0u; r < 5u; ++r)
+  {
+    for(size_t c = 0u; c < 5u; ++c)
+    {
+      M const a = MT::convert( A(r,c) );
+      M const b = MT::convert( B(r,c) );
+
+      for(unsigned int i = 0u; i < 3u; ++i)
+        for(unsigned int j = 0u; j < 3u; ++j)
+          BOOST_CHECK_EQUAL( a(i,j), b(i,j) );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(cached_time_step_test)
+{
+  mesh_array::T4Mesh        mesh;
+  mesh_array::Neighborhoods neighbors;
+  vector_block3x1_type      x0;
+
+  make_mesh(mesh, neighbors, x0);
+
+  hyper::MaterialParameters<T> material = hyper::make_default_material<T>();
+
+  material.lumped() = false;
+
+  hyper::SaintVernantKirchhoff<MT> model( material );
+
+  std::vector<hyper::DirichletInfo<MT> > dirichlet_conditions;
+
+  dirichlet_conditions.push_back( hyper::make_dirichlet_info<MT>( 0u, V::zero() ) );
+
+  vector_block3x1_type Fext(5u);
+  Fext.clear_data();
+  Fext(4) = MT::convert( V::make( 0.0, 0.0, -10.0 ) );
+
+  vector_block3x1_type x_cached  = x0;
+  vector_block3x1_type v_cached(5u);
+  vector_block3x1_type x_fresh   = x0;
+  vector_block3x1_type v_fresh(5u);
+
+  v_cached.clear_data();
+  v_fresh.clear_data();
+
+  hyper::AssemblyCache<MT> cache;
+
+  T const dt = 0.001;
+
+  for(unsigned int step = 0u; step < 5u; ++step)
+  {
+    hyper::semi_implicit_time_step<MT>( mesh, neighbors, dirichlet_conditions, dt, x_cached, x0, v_cached, Fext, &model, hyper::jacobi_precond, cache );
+    hyper::semi_implicit_time_step<MT>( mesh, neighbors, dirichlet_conditions, dt, x_fresh,  x0, v_fresh,  Fext, &model, hyper::jacobi_precond );
+  }
+
+  for(size_t i = 0u; i < 5u; ++i)
+  {
+    for(unsigned int j = 0u; j < 3u; ++j)
+    {
+      BOOST_CHECK_EQUAL( x_cached(i)(j), x_fresh(i)(j) );
+      BOOST_CHECK_EQUAL( v_cached(i)(j), v_fresh(i)(j) );
+    }
+  }
+
+  BOOST_CHECK( cache.is_valid(mesh, &model) );
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,138 @@
+#include <hyper.h>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+
+typedef hyper::MathPolicy<double> MT;
+typedef MT::real_type             T;
+typedef MT::vector3_type          V;
+typedef MT::value_traits          VT;
+
+typedef hyper::Engine<MT>                             engine_type;
+typedef engine_type::body_type                        body_type;
+typedef std::pair<body_type*, body_type*>             overlap_type;
+
+T random_value(T const & lower, T const & upper)
+{
+  return lower + (upper - lower) * std::rand() / RAND_MAX;
+}
+
+/**
+ * Give a body a root kDOP around a random center, all slabs of the
+ * kDOP are given the same width.
+ */
+void set_random_root( body_type & body, T const & domain, T const & size )
+{
+  V const c = V::make( random_value(0.0, domain), random_value(0.0, domain), random_value(0.0, domain) );
+
+  T const projections[4] = { c(0), c(1), c(2), (c(0) + c(1) + c(2)) / std::sqrt(3.0) };
+
+  for(size_t k = 0u; k < 4u; ++k)
+  {
+    body.m_tree.m_root(k).lower() = projections[k] - size;
+    body.m_tree.m_root(k).upper() = projections[k] + size;
+  }
+}
+
+/**
+ * All pairs reference solution.
+ */
+void brute_force( engine_type & engine, std::vector<overlap_type> & overlaps )
+{
+  overlaps.clear();
+
+  for(engine_type::body_iterator A = engine.body_begin(); A != engine.body_end(); ++A)
+    for(engine_type::body_iterator B = A + 1; B != engine.body_end(); ++B)
+      if( geometry::overlap_dop_dop( A->m_tree.m_root, B->m_tree.m_root ) )
+        overlaps.push_back( hyper::make_overlap<MT>( &(*A), &(*B) ) );
+
+  std::sort( overlaps.begin(), overlaps.end() );
+}
+
+void check_overlaps( engine_type & engine )
+{
+  std::vector<overlap_type> expected;
+  std::vector<overlap_type> overlaps;
+  T                         efficiency = VT::zero();
+
+  brute_force( engine, expected );
+
+  bool const found = hyper::broad_phase( engine, overlaps, efficiency );
+
+  BOOST_CHECK_EQUAL( found, !expected.empty() );
+  BOOST_CHECK_EQUAL( overlaps.size(), expected.size() );
+  BOOST_CHECK( overlaps == expected );
+  BOOST_CHECK( efficiency >= VT::zero() );
+  BOOST_CHECK( efficiency <= VT::one() );
+}
+
+BOOST_AUTO_TEST_SUITE(hyper);
+
+BOOST_AUTO_TEST_CASE(random_bodies_test)
+{
+  std::srand(42);
+
+  engine_type engine;
+
+  for(size_t i = 0u; i < 500u; ++i)
+    engine.create_body();
+
+  for(engine_type::body_iterator body = engine.body_begin(); body != engine.body_end(); ++body)
+    set_random_root( *body, 20.0, random_value(0.1, 1.5) );
+
+  check_overlaps( engine );
+}
+
+BOOST_AUTO_TEST_CASE(stacked_bodies_test)
+{
+  engine_type engine;
+
+  // A column of touching boxes, only neighbors overlap
+  for(size_t i = 0u; i < 50u; ++i)
+  {
+    body_type & body = engine.get_body( engine.create_body() );
+
+    T const y = 1.0 * i;
+
+    body.m_tree.m_root(0).lower() = -0.5;
+    body.m_tree.m_root(0).upper() =  0.5;
+    body.m_tree.m_root(1).lower() = y - 0.5;
+    body.m_tree.m_root(1).upper() = y + 0.5;
+    body.m_tree.m_root(2).lower() = -0.5;
+    body.m_tree.m_root(2).upper() =  0.5;
+    body.m_tree.m_root(3).lower() = (y - 1.5) / std::sqrt(3.0);
+    body.m_tree.m_root(3).upper() = (y + 1.5) / std::sqrt(3.0);
+  }
+
+  // A body without any tetrahedra has an empty root kDOP
+  engine.create_body();
+
+  check_overlaps( engine );
+
+  std::vector<overlap_type> overlaps;
+  T                         efficiency = VT::zero();
+
+  hyper::broad_phase( engine, overlaps, efficiency );
+
+  BOOST_CHECK_EQUAL( overlaps.size(), 49u );
+}
+
+BOOST_AUTO_TEST_CASE(empty_engine_test)
+{
+  engine_type engine;
+
+  std::vector<overlap_type> overlaps;
+  T                         efficiency = VT::one();
+
+  BOOST_CHECK( !hyper::broad_phase( engine, overlaps, efficiency ) );
+  BOOST_CHECK( overlaps.empty() );
+}
+
+BOOST_AUTO_TEST_SUITE_END();
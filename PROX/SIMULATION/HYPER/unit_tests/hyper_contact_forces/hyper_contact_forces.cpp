@@ -0,0 +1,203 @@
+#include <hyper.h>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <vector>
+
+typedef hyper::MathPolicy<double> MT;
+typedef MT::real_type             T;
+typedef MT::vector3_type          V;
+typedef MT::value_traits          VT;
+
+typedef hyper::Body<MT>           body_type;
+typedef hyper::ContactPoint<MT>   contact_type;
+
+/**
+ * Make a body of a single tetrahedron at rest, translated by the given offset.
+ */
+void make_body( body_type & body, V const & offset )
+{
+  body.m_mesh.clear();
+  body.m_mesh.set_capacity(4u, 1u);
+
+  mesh_array::Vertex const & i = body.m_mesh.push_vertex();
+  mesh_array::Vertex const & j = body.m_mesh.push_vertex();
+  mesh_array::Vertex const & k = body.m_mesh.push_vertex();
+  mesh_array::Vertex const & m = body.m_mesh.push_vertex();
+
+  body.m_mesh.push_tetrahedron(i, j, k, m);
+
+  body.m_x.resize(4u);
+  body.m_x(0) = MT::convert( V::make( 0.0, 0.0, 0.0 ) + offset );
+  body.m_x(1) = MT::convert( V::make( 1.0, 0.0, 0.0 ) + offset );
+  body.m_x(2) = MT::convert( V::make( 0.0, 1.0, 0.0 ) + offset );
+  body.m_x(3) = MT::convert( V::make( 0.0, 0.0, 1.0 ) + offset );
+
+  body.m_v.resize(4u);
+  body.m_v.clear_data();
+
+  body.m_F.resize(4u);
+  body.m_F.clear_data();
+}
+
+/**
+ * Make a contact at the centroid of the tetrahedron of body i, the
+ * tetrahedron of body j is placed on top of it.
+ */
+contact_type make_contact( body_type & body_i, body_type & body_j, T const & depth )
+{
+  contact_type contact;
+
+  contact.set_body_i( &body_i );
+  contact.set_body_j( &body_j );
+  contact.set_tetrahedra( 0u, 0u );
+  contact.set_position( V::make( 0.25, 0.25, 0.25 ) );
+  contact.set_normal( V::make( 0.0, 0.0, 1.0 ) );
+  contact.set_depth( depth );
+
+  return contact;
+}
+
+void check_force( body_type const & body, size_t const & idx, V const & expected )
+{
+  V const f = MT::convert( body.m_F(idx) );
+
+  BOOST_CHECK_SMALL( f(0) - expected(0), 1e-10 );
+  BOOST_CHECK_SMALL( f(1) - expected(1), 1e-10 );
+  BOOST_CHECK_SMALL( f(2) - expected(2), 1e-10 );
+}
+
+BOOST_AUTO_TEST_SUITE(hyper);
+
+BOOST_AUTO_TEST_CASE(penetration_test)
+{
+  body_type body_i;
+  body_type body_j;
+
+  make_body( body_i, V::make( 0.0, 0.0, 0.0 ) );
+  make_body( body_j, V::make( 0.0, 0.0, 0.25 ) );
+
+  std::vector<contact_type> contacts;
+
+  contacts.push_back( make_contact( body_i, body_j, -0.1 ) );
+
+  T const k = 1000.0;
+
+  hyper::compute_contact_forces<MT>( contacts, k, VT::zero() );
+
+  V sum_i = V::zero();
+  V sum_j = V::zero();
+
+  for(size_t a = 0u; a < 4u; ++a)
+  {
+    sum_i += MT::convert( body_i.m_F(a) );
+    sum_j += MT::convert( body_j.m_F(a) );
+  }
+
+  // Equal and opposite, pushing body j along the normal
+  BOOST_CHECK_CLOSE( sum_j(2),  k*0.1, 1e-8 );
+  BOOST_CHECK_CLOSE( sum_i(2), -k*0.1, 1e-8 );
+  BOOST_CHECK_SMALL( sum_i(0), 1e-10 );
+  BOOST_CHECK_SMALL( sum_i(1), 1e-10 );
+  BOOST_CHECK_SMALL( sum_j(0), 1e-10 );
+  BOOST_CHECK_SMALL( sum_j(1), 1e-10 );
+
+  // The contact point is the centroid of the tetrahedron of body i
+  for(size_t a = 0u; a < 4u; ++a)
+    check_force( body_i, a, V::make( 0.0, 0.0, -k*0.1/4.0 ) );
+}
+
+BOOST_AUTO_TEST_CASE(separation_test)
+{
+  body_type body_i;
+  body_type body_j;
+
+  make_body( body_i, V::make( 0.0, 0.0, 0.0 ) );
+  make_body( body_j, V::make( 0.0, 0.0, 0.25 ) );
+
+  std::vector<contact_type> contacts;
+
+  contacts.push_back( make_contact( body_i, body_j, 0.1 ) );
+
+  hyper::compute_contact_forces<MT>( contacts, 1000.0, 1.0 );
+
+  for(size_t a = 0u; a < 4u; ++a)
+  {
+    check_force( body_i, a, V::zero() );
+    check_force( body_j, a, V::zero() );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(damping_test)
+{
+  body_type body_i;
+  body_type body_j;
+
+  make_body( body_i, V::make( 0.0, 0.0, 0.0 ) );
+  make_body( body_j, V::make( 0.0, 0.0, 0.25 ) );
+
+  T const k = 1000.0;
+  T const c = 10.0;
+
+  // Body j approaches body i, damping adds to the penalty force
+  for(size_t a = 0u; a < 4u; ++a)
+    body_j.m_v(a) = MT::convert( V::make( 0.0, 0.0, -2.0 ) );
+
+  std::vector<contact_type> contacts;
+
+  contacts.push_back( make_contact( body_i, body_j, -0.1 ) );
+
+  hyper::compute_contact_forces<MT>( contacts, k, c );
+
+  for(size_t a = 0u; a < 4u; ++a)
+    check_force( body_i, a, V::make( 0.0, 0.0, -(k*0.1 + c*2.0)/4.0 ) );
+
+  // Body j moves away fast enough for damping to cancel the penalty force
+  make_body( body_i, V::make( 0.0, 0.0, 0.0 ) );
+
+  for(size_t a = 0u; a < 4u; ++a)
+    body_j.m_v(a) = MT::convert( V::make( 0.0, 0.0, 1000.0 ) );
+
+  body_j.m_F.clear_data();
+
+  hyper::compute_contact_forces<MT>( contacts, k, c );
+
+  for(size_t a = 0u; a < 4u; ++a)
+  {
+    check_force( body_i, a, V::zero() );
+    check_force( body_j, a, V::zero() );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(stable_time_step_test)
+{
+  body_type body;
+
+  make_body( body, V::make( 0.0, 0.0, 0.0 ) );
+
+  // The tetrahedron has volume 1/6, so each node gets a lumped mass of 1/4
+  T const rho = 6.0;
+  T const k   = 100.0;
+
+  T const dt = hyper::compute_contact_time_step_size<MT>( body.m_mesh, body.m_x, rho, k, 1.0 );
+
+  BOOST_CHECK_CLOSE( dt, std::sqrt( 0.25 / k ), 1e-8 );
+
+  // The same limit is found from a precomputed smallest node mass
+  T const min_node_mass = hyper::compute_min_node_mass<MT>( body.m_mesh, body.m_x, rho );
+
+  BOOST_CHECK_CLOSE( min_node_mass, 0.25, 1e-8 );
+  BOOST_CHECK_EQUAL( hyper::compute_contact_time_step_size<MT>( min_node_mass, k, 1.0 ), dt );
+
+  // A small wanted time step is already stable
+  BOOST_CHECK_EQUAL( hyper::compute_contact_time_step_size<MT>( body.m_mesh, body.m_x, rho, k, 0.01 ), 0.01 );
+
+  // Without penalty stiffness there is no limit
+  BOOST_CHECK_EQUAL( hyper::compute_contact_time_step_size<MT>( body.m_mesh, body.m_x, rho, VT::zero(), 1.0 ), 1.0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END();
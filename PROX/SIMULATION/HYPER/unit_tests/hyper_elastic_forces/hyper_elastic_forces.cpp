@@ -0,0 +1,182 @@
+#include <hyper.h>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <cmath>
+#include <algorithm>
+#include <string>
+
+typedef hyper::MathPolicy<double> MT;
+typedef MT::real_type             T;
+typedef MT::vector3_type          V;
+typedef MT::matrix3x3_type        M;
+
+typedef MT::vector_block3x1_type  vector_block3x1_type;
+
+/**
+ * A model only known through the base class, it forwards to another model
+ * through the virtual stress function.
+ */
+class ForwardingModel
+: public hyper::ConstitutiveEquation<MT>
+{
+protected:
+
+  hyper::ConstitutiveEquation<MT> const * m_model;
+
+public:
+
+  ForwardingModel( hyper::ConstitutiveEquation<MT> const * model )
+  : hyper::ConstitutiveEquation<MT>( model->material() )
+  , m_model( model )
+  {}
+
+  M sigma(M const & F) const { return this->m_model->sigma(F); }
+
+  std::string name() const { return "Forwarding " + this->m_model->name(); }
+
+};
+
+/**
+ * A model derived from a built-in model, the element force kernel must
+ * use the overridden stress function for such models.
+ */
+class ScaledSaintVernantKirchhoff
+: public hyper::SaintVernantKirchhoff<MT>
+{
+public:
+
+  M sigma(M const & F) const
+  {
+    return hyper::SaintVernantKirchhoff<MT>::sigma(F) * 2.0;
+  }
+
+  std::string name() const { return "ScaledSaintVernantKirchhoff"; }
+
+};
+
+/**
+ * Make a unit cube split into five tetrahedra and deform it a little.
+ */
+void make_mesh(
+               mesh_array::T4Mesh & mesh
+               , mesh_array::Neighborhoods & neighbors
+               , vector_block3x1_type & x0
+               , vector_block3x1_type & x
+               )
+{
+  // Corner c of the cube is at ( c&1, (c>>1)&1, (c>>2)&1 )
+  unsigned int const tetrahedra[5][4] = {
+    {0u, 1u, 2u, 4u}
+    , {3u, 2u, 1u, 7u}
+    , {5u, 1u, 4u, 7u}
+    , {6u, 4u, 2u, 7u}
+    , {1u, 2u, 4u, 7u}
+  };
+
+  mesh.clear();
+  mesh.set_capacity(8u, 5u);
+
+  x0.resize(8u);
+  x.resize(8u);
+
+  for(unsigned int c = 0u; c < 8u; ++c)
+  {
+    mesh.push_vertex();
+
+    T const X = (c & 1u);
+    T const Y = (c >> 1u) & 1u;
+    T const Z = (c >> 2u) & 1u;
+
+    x0(c) = MT::convert( V::make( X, Y, Z ) );
+    x(c)  = MT::convert( V::make( 1.1*X + 0.05*Y, 0.95*Y, Z - 0.1*X ) );
+  }
+
+  for(unsigned int e = 0u; e < 5u; ++e)
+  {
+    unsigned int const * t = tetrahedra[e];
+
+    V const u_ji = MT::convert( x0(t[1]) ) - MT::convert( x0(t[0]) );
+    V const u_ki = MT::convert( x0(t[2]) ) - MT::convert( x0(t[0]) );
+    V const u_mi = MT::convert( x0(t[3]) ) - MT::convert( x0(t[0]) );
+
+    // Keep all tetrahedra positively oriented
+    if( u_mi(0)*(u_ji(1)*u_ki(2) - u_ji(2)*u_ki(1))
+       + u_mi(1)*(u_ji(2)*u_ki(0) - u_ji(0)*u_ki(2))
+       + u_mi(2)*(u_ji(0)*u_ki(1) - u_ji(1)*u_ki(0)) > 0.0 )
+      mesh.push_tetrahedron( mesh.vertex(t[0]), mesh.vertex(t[1]), mesh.vertex(t[2]), mesh.vertex(t[3]) );
+    else
+      mesh.push_tetrahedron( mesh.vertex(t[0]), mesh.vertex(t[2]), mesh.vertex(t[1]), mesh.vertex(t[3]) );
+  }
+
+  mesh_array::compute_neighbors(mesh, neighbors);
+}
+
+/**
+ * Compare forces of a model against the forces of a reference model scaled by a factor.
+ */
+void check_forces(
+                  hyper::ConstitutiveEquation<MT> const * model
+                  , hyper::ConstitutiveEquation<MT> const * reference
+                  , T const & scale
+                  )
+{
+  mesh_array::T4Mesh        mesh;
+  mesh_array::Neighborhoods neighbors;
+  vector_block3x1_type      x0;
+  vector_block3x1_type      x;
+
+  make_mesh(mesh, neighbors, x0, x);
+
+  vector_block3x1_type f;
+  vector_block3x1_type f_reference;
+
+  hyper::compute_elastic_forces<MT>( mesh, neighbors, x, x0, f, model );
+  hyper::compute_elastic_forces<MT>( mesh, neighbors, x, x0, f_reference, reference );
+
+  BOOST_CHECK_EQUAL( f.size(), 8u );
+  BOOST_CHECK_EQUAL( f_reference.size(), 8u );
+
+  T largest = 0.0;
+
+  for(size_t i = 0u; i < f.size(); ++i)
+  {
+    for(unsigned int j = 0u; j < 3u; ++j)
+    {
+      BOOST_CHECK_EQUAL( f(i)(j), scale*f_reference(i)(j) );
+
+      largest = std::max( largest, std::fabs( f(i)(j) ) );
+    }
+  }
+
+  // The mesh is deformed so the forces can not vanish
+  BOOST_CHECK( largest > 0.0 );
+}
+
+BOOST_AUTO_TEST_SUITE(hyper);
+
+BOOST_AUTO_TEST_CASE(elastic_forces_test)
+{
+  hyper::SaintVernantKirchhoff<MT>  svk;
+  hyper::CorotationalElasticity<MT> cor;
+  hyper::NeoHookean<MT>             neo;
+  ScaledSaintVernantKirchhoff       scaled;
+
+  ForwardingModel virtual_svk( &svk );
+  ForwardingModel virtual_cor( &cor );
+  ForwardingModel virtual_neo( &neo );
+
+  // Statically bound kernels agree with the virtual stress function
+  check_forces( &svk, &virtual_svk, 1.0 );
+  check_forces( &cor, &virtual_cor, 1.0 );
+  check_forces( &neo, &virtual_neo, 1.0 );
+
+  // Derived models are not mistaken for the built-in model they derive from
+  check_forces( &scaled, &svk, 2.0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,190 @@
+#include <hyper.h>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <cmath>
+
+typedef hyper::MathPolicy<double> MT;
+typedef MT::real_type             T;
+typedef MT::vector3_type          V;
+typedef MT::matrix3x3_type        M;
+typedef MT::value_traits          VT;
+
+typedef MT::vector_block3x1_type  vector_block3x1_type;
+typedef MT::element_matrices_type element_matrices_type;
+
+/**
+ * Make a mesh of a single unit tetrahedron.
+ */
+void make_tetrahedron(
+                      mesh_array::T4Mesh & mesh
+                      , mesh_array::Neighborhoods & neighbors
+                      , vector_block3x1_type & x0
+                      )
+{
+  mesh.clear();
+  mesh.set_capacity(4u, 1u);
+
+  mesh_array::Vertex const & i = mesh.push_vertex();
+  mesh_array::Vertex const & j = mesh.push_vertex();
+  mesh_array::Vertex const & k = mesh.push_vertex();
+  mesh_array::Vertex const & m = mesh.push_vertex();
+
+  mesh.push_tetrahedron(i, j, k, m);
+
+  mesh_array::compute_neighbors(mesh, neighbors);
+
+  x0.resize(4u);
+  x0(0) = MT::convert( V::make( 0.0, 0.0, 0.0 ) );
+  x0(1) = MT::convert( V::make( 1.0, 0.0, 0.0 ) );
+  x0(2) = MT::convert( V::make( 0.0, 1.0, 0.0 ) );
+  x0(3) = MT::convert( V::make( 0.0, 0.0, 1.0 ) );
+}
+
+/**
+ * Deform the unit tetrahedron a little.
+ */
+void make_deformed( vector_block3x1_type const & x0, vector_block3x1_type & x )
+{
+  x = x0;
+  x(1) = MT::convert( V::make(  1.2,  0.1, -0.05 ) );
+  x(2) = MT::convert( V::make( -0.1,  0.9,  0.1  ) );
+  x(3) = MT::convert( V::make(  0.05, 0.1,  1.15 ) );
+}
+
+/**
+ * Compare the tangent stiffness against central differences of the elastic forces.
+ */
+void check_stiffness( hyper::ConstitutiveEquation<MT> const * model, T const & tolerance )
+{
+  mesh_array::T4Mesh        mesh;
+  mesh_array::Neighborhoods neighbors;
+  vector_block3x1_type      x0;
+  vector_block3x1_type      x;
+
+  make_tetrahedron(mesh, neighbors, x0);
+  make_deformed(x0, x);
+
+  std::vector< element_matrices_type > Ke;
+
+  hyper::compute_stiffness_matrix<MT>( mesh, x, x0, model, Ke );
+
+  BOOST_CHECK_EQUAL( Ke.size(), 1u );
+
+  T const h = 1e-6;
+
+  for(unsigned int b = 0u; b < 4u; ++b)
+  {
+    for(unsigned int c = 0u; c < 3u; ++c)
+    {
+      vector_block3x1_type xp = x;
+      vector_block3x1_type xm = x;
+
+      xp(b)(c) += h;
+      xm(b)(c) -= h;
+
+      vector_block3x1_type fp(4u);
+      vector_block3x1_type fm(4u);
+
+      hyper::compute_elastic_forces<MT>( mesh, neighbors, xp, x0, fp, model );
+      hyper::compute_elastic_forces<MT>( mesh, neighbors, xm, x0, fm, model );
+
+      for(unsigned int a = 0u; a < 4u; ++a)
+      {
+        for(unsigned int r = 0u; r < 3u; ++r)
+        {
+          T const expected = ( fp(a)(r) - fm(a)(r) ) / (2.0*h);
+
+          BOOST_CHECK( std::fabs( Ke[0](a,b)(r,c) - expected ) <= tolerance * model->material().E() );
+        }
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(hyper);
+
+BOOST_AUTO_TEST_CASE(stiffness_matrix_test)
+{
+  hyper::SaintVernantKirchhoff<MT> svk;
+  hyper::NeoHookean<MT>            neo;
+
+  // Analytical derivative
+  check_stiffness( &svk, 1e-6 );
+
+  // Central differences of the default implementation
+  check_stiffness( &neo, 1e-4 );
+}
+
+BOOST_AUTO_TEST_CASE(implicit_time_step_test)
+{
+  mesh_array::T4Mesh        mesh;
+  mesh_array::Neighborhoods neighbors;
+  vector_block3x1_type      x0;
+  vector_block3x1_type      x;
+
+  make_tetrahedron(mesh, neighbors, x0);
+  make_deformed(x0, x);
+
+  hyper::MaterialParameters<T> material = hyper::make_default_material<T>();
+
+  material.E() = 1.0e6;   // Very stiff material, semi-implicit stepping would need tiny time steps
+
+  hyper::SaintVernantKirchhoff<MT> model( material );
+
+  vector_block3x1_type v(4u);
+  vector_block3x1_type Fext(4u);
+
+  v.clear_data();
+  Fext.clear_data();
+
+  std::vector<hyper::DirichletInfo<MT> > dirichlet_conditions;
+
+  // Fix the first vertex
+  dirichlet_conditions.push_back( hyper::make_dirichlet_info<MT>( 0u, V::zero() ) );
+
+  T const dt = 0.01;
+
+  for(unsigned int step = 0u; step < 10u; ++step)
+  {
+    hyper::implicit_time_step<MT>(
+                                  mesh
+                                  , neighbors
+                                  , dirichlet_conditions
+                                  , dt
+                                  , x
+                                  , x0
+                                  , v
+                                  , Fext
+                                  , &model
+                                  , hyper::jacobi_precond
+                                  , 20u
+                                  , 1e-8
+                                  );
+  }
+
+  // Fixed vertex did not move
+  BOOST_CHECK_SMALL( std::fabs( x(0)(0) ), 1e-10 );
+  BOOST_CHECK_SMALL( std::fabs( x(0)(1) ), 1e-10 );
+  BOOST_CHECK_SMALL( std::fabs( x(0)(2) ), 1e-10 );
+
+  // Backward Euler is dissipative, the stiff tetrahedron must not blow up
+  // but come to rest in its undeformed shape (up to a rigid motion).
+  for(unsigned int a = 0u; a < 4u; ++a)
+  {
+    for(unsigned int b = a+1u; b < 4u; ++b)
+    {
+      V const e  = MT::convert( x(b) )  - MT::convert( x(a) );
+      V const e0 = MT::convert( x0(b) ) - MT::convert( x0(a) );
+
+      BOOST_CHECK( std::isfinite( norm(e) ) );
+      BOOST_CHECK_CLOSE( norm(e), norm(e0), 1.0 );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -442,7 +442,7 @@ namespace kdop {
                                         }
                                     }
                                     ++nodes_processed;
-                                    if (node.is_root()) { // ... but always generate root indices
+                                    if (n == 0u) { // ... but always generate root indices, the root of a branch is its first node
                                         chunk_root_indices[t][trees[t]->number_of_levels() - 1].push_back((KernelI) out_index);
                                     }
                                 }
@@ -487,7 +487,7 @@ namespace kdop {
                                             }
                                         }
                                         ++nodes_processed;
-                                        if (node.is_root()) { // ... but always generate root indices
+                                        if (n == 0u) { // ... but always generate root indices, the root of a branch is its first node
                                             chunk_root_indices[t][h - 1].push_back((KernelI) out_index);
                                         }
                                     }
@@ -28,9 +28,8 @@ namespace kdop
       template<typename T, size_t K>
       inline void print_subtree(std::ostream & output, kdop::Node<T, K> const & node, kdop::SubTree<T,K> const & tree)
       {
-        output << "(root,leaf,undef) = (" << node.is_root() << ", " << node.is_leaf() << ", " << node.is_undefined() << ")" << std::endl;
+        output << "(leaf,undef) = (" << node.is_leaf() << ", " << node.is_undefined() << ")" << std::endl;
         output << node.m_volume << std::endl;
-        output << "\tparent      = " << node.m_parent << std::endl;
         output << "\tchild start = " << node.m_start  << std::endl;
         output << "\tchild end   = " << node.m_end    << std::endl;
 
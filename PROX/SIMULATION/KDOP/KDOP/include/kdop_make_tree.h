@@ -74,9 +74,7 @@ namespace kdop
         size_t const right_idx = free_idx+1;
         free_idx += 2u;
 
-        size_t const nodes = branch.m_nodes.size();
-
-        assert(parent_idx < nodes || !"make_tree: out of bounds");
+        assert(parent_idx < branch.m_nodes.size() || !"make_tree: out of bounds");
 
         Node<T,K> & parent      = branch.m_nodes[parent_idx];
         parent.m_start          = left_idx;
@@ -87,15 +85,8 @@ namespace kdop
         MeshChunkInfo<T> const left_geometry(  geometry.m_first, mid, geometry.m_mesh, geometry.m_X, geometry.m_Y, geometry.m_Z );
         MeshChunkInfo<T> const right_geometry( mid+1, geometry.m_last, geometry.m_mesh, geometry.m_X, geometry.m_Y, geometry.m_Z );
  
-        assert(left_idx < nodes || !"make_tree: out of bounds");
-
-        Node<T,K> & left_child  = branch.m_nodes[left_idx];
-        left_child.m_parent     = parent_idx;
-
-        assert(right_idx < nodes || !"make_tree: out of bounds");
-
-        Node<T,K> & right_child = branch.m_nodes[right_idx];
-        right_child.m_parent    = parent_idx;
+        assert(left_idx < branch.m_nodes.size() || !"make_tree: out of bounds");
+        assert(right_idx < branch.m_nodes.size() || !"make_tree: out of bounds");
                 
         size_t left_height  = 0u;
         size_t right_height = 0u;
@@ -139,9 +130,7 @@ namespace kdop
 
         free_idx += 2u;
         
-        size_t const nodes = super_chunk.m_nodes.size();
-
-        assert(parent_idx < nodes || !"make_tree: out of bounds");
+        assert(parent_idx < super_chunk.m_nodes.size() || !"make_tree: out of bounds");
 
         Node<T,K> & parent = super_chunk.m_nodes[parent_idx];
 
@@ -150,17 +139,8 @@ namespace kdop
         
         size_t const mid  = floor((first + last) / 2.0);
  
-        assert(left_idx < nodes || !"make_tree: out of bounds");
-
-        Node<T,K> & left_child = super_chunk.m_nodes[left_idx];
-
-        left_child.m_parent = parent_idx;
-
-        assert(right_idx < nodes || !"make_tree: out of bounds");
-
-        Node<T,K> & right_child = super_chunk.m_nodes[right_idx];
-
-        right_child.m_parent = parent_idx;
+        assert(left_idx < super_chunk.m_nodes.size() || !"make_tree: out of bounds");
+        assert(right_idx < super_chunk.m_nodes.size() || !"make_tree: out of bounds");
                 
         size_t left_height  = 0u;
         size_t right_height = 0u;
@@ -228,6 +208,9 @@ namespace kdop
     size_t       C          = ceil( VT::one()*M / L);                         // Total number of chunks to divide the mesh into
     size_t const H          = max(ceil(log(C) / log(L)), 1.0);                // Total number of chunk levels (C could be 1)
     
+    assert( N_perfect < UNDEFINED() || !"make_tree(): chunks have too many nodes for 32 bit node indices");
+    assert( M         < UNDEFINED() || !"make_tree(): too many tetrahedra for 32 bit node indices");
+    
     
     //--- Create enough branches to hold all subtrees correspodining to --------
     //--- the chuncks of the mesh. ---------------------------------------------
@@ -19,7 +19,92 @@ namespace kdop
   
   namespace details
   {
-  
+
+    /**
+     * Refit the kDOP of a leaf node to the four vertices of its tetrahedron.
+     */
+    template< typename V, size_t K, typename T>
+    inline void refit_leaf(
+                           Node<T,K> & node
+                           , mesh_array::T4Mesh const & mesh
+                           , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & X
+                           , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & Y
+                           , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & Z
+                           , geometry::DirectionTable<V,(K/2)> const & DT
+                           )
+    {
+      using namespace mesh_array;
+
+      Tetrahedron const Tet = mesh.tetrahedron(node.m_start);
+
+      V points[4];
+
+      points[0] = V::make( X(Tet.i()), Y(Tet.i()), Z(Tet.i()) );
+      points[1] = V::make( X(Tet.j()), Y(Tet.j()), Z(Tet.j()) );
+      points[2] = V::make( X(Tet.k()), Y(Tet.k()), Z(Tet.k()) );
+      points[3] = V::make( X(Tet.m()), Y(Tet.m()), Z(Tet.m()) );
+
+      V const * begin = points;
+      V const * end   = points + 4;
+
+      node.m_volume = geometry::make_dop(begin, end, DT);
+    }
+
+    /**
+     * Test if any leaf of a branch covers a tetrahedron with a dirty vertex.
+     */
+    template<size_t K, typename T>
+    inline bool is_dirty(
+                         SubTree<T,K> const & branch
+                         , mesh_array::T4Mesh const & mesh
+                         , mesh_array::VertexAttribute<bool,mesh_array::T4Mesh> const & dirty
+                         )
+    {
+      using namespace mesh_array;
+
+      size_t const N = branch.m_nodes.size();
+
+      for(size_t i = 0; i<N; ++i)
+      {
+        Node<T,K> const & node = branch.m_nodes[i];
+
+        if(node.is_undefined() || !node.is_leaf())
+          continue;
+
+        Tetrahedron const Tet = mesh.tetrahedron(node.m_start);
+
+        if( dirty(Tet.i()) || dirty(Tet.j()) || dirty(Tet.k()) || dirty(Tet.m()) )
+          return true;
+      }
+
+      return false;
+    }
+
+    /**
+     * Test if any leaf of a super chunk points to a changed chunk.
+     */
+    template<size_t K, typename T>
+    inline bool is_dirty(
+                         SubTree<T,K> const & super_chunk
+                         , std::vector<char> const & changed_children
+                         )
+    {
+      size_t const N = super_chunk.m_nodes.size();
+
+      for(size_t i = 0; i<N; ++i)
+      {
+        Node<T,K> const & node = super_chunk.m_nodes[i];
+
+        if(node.is_undefined() || !node.is_leaf())
+          continue;
+
+        if( changed_children[node.m_start] )
+          return true;
+      }
+
+      return false;
+    }
+
     template< typename V, size_t K, typename T>
     inline void refit_subtree(
                               SubTree<T,K> & branch
@@ -43,29 +128,7 @@ namespace kdop
         
         if(node.is_leaf())
         {
-          size_t      const tet_idx = node.m_start;
-          Tetrahedron const Tet     = mesh.tetrahedron(tet_idx);
-          
-          std::vector<V> points;
-          points.resize(4);
-          
-          points[0](0) = X(Tet.i());
-          points[0](1) = Y(Tet.i());
-          points[0](2) = Z(Tet.i());
-          
-          points[1](0) = X(Tet.j());
-          points[1](1) = Y(Tet.j());
-          points[1](2) = Z(Tet.j());
-          
-          points[2](0) = X(Tet.k());
-          points[2](1) = Y(Tet.k());
-          points[2](2) = Z(Tet.k());
-          
-          points[3](0) = X(Tet.m());
-          points[3](1) = Y(Tet.m());
-          points[3](2) = Z(Tet.m());
-          
-          node.m_volume = make_dop(points.begin(), points.end(), DT);
+          refit_leaf<V,K,T>(node, mesh, X, Y, Z, DT);
           
         }else{
           
@@ -98,7 +161,7 @@ namespace kdop
         
         if(node.is_leaf())
         {
-          SubTree<T, K> const subtree = chunk_children[node.m_start];
+          SubTree<T, K> const & subtree = chunk_children[node.m_start];
 
           node.m_volume = subtree.m_nodes[0].m_volume;
         }
@@ -114,6 +177,22 @@ namespace kdop
       }
     }
     
+    /**
+     * Create the root kDOP of the whole tree from the top level chunks.
+     */
+    template<size_t K, typename T>
+    inline void refit_root( Tree<T,K> & tree )
+    {
+      tree.m_root = tree.super_chunks(0)[0].m_nodes[0].m_volume;
+
+      size_t const C = tree.super_chunks(0).size();
+
+      for( size_t c = 1u; c < C;++c)
+      {
+        tree.m_root = geometry::make_union( tree.m_root, tree.super_chunks(0)[c].m_nodes[0].m_volume );
+      }
+    }
+
   } // end of namespace details
   
   template< typename V, size_t K, typename T>
@@ -152,13 +231,109 @@ namespace kdop
     }
     
     //--- Loop over all the subtrees and create the root BV of the whole tree --
-    tree.m_root = tree.super_chunks(0)[0].m_nodes[0].m_volume;
+    details::refit_root( tree );
+  }
+
+  /**
+   * Parallel refit.
+   * The branches are independent of each other and so are all super chunks
+   * on the same level, so each level is refitted by a parallel loop.
+   */
+  template< typename V, size_t K, typename T>
+  inline void refit_tree(
+                         Tree<T,K> & tree
+                         , mesh_array::T4Mesh const & mesh
+                         , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & X
+                         , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & Y
+                         , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & Z
+                         , parallel const & /* tag */
+                         )
+  {
+    geometry::DirectionTable<V,(K/2)> const DT = geometry::DirectionTableHelper<V,(K/2)>::make();
+
+    std::vector< SubTree<T,K> > & branches = tree.branches();
+
+#pragma omp parallel for schedule(static)
+    for( long c = 0; c < static_cast<long>( branches.size() ); ++c)
+    {
+      details::refit_subtree<V,K,T>(branches[c], mesh, X, Y, Z, DT);
+    }
+
+    for(size_t h = tree.number_of_levels() - 1; h >= 1; --h)
+    {
+      std::vector< SubTree<T,K> >       & super_chunks   = tree.super_chunks(h - 1);
+      std::vector< SubTree<T,K> > const & chunk_children = tree.super_chunks(h);
+
+#pragma omp parallel for schedule(static)
+      for(long c = 0; c < static_cast<long>( super_chunks.size() ); ++c)
+      {
+        details::refit_subtree<V,K,T>( super_chunks[c], chunk_children );
+      }
+    }
+
+    details::refit_root( tree );
+  }
+
+  /**
+   * Parallel refit of moved parts of a tree.
+   * Only branches covering a tetrahedron with a dirty vertex are refitted,
+   * and only super chunks above a refitted chunk. All other nodes keep
+   * their kDOPs, so the tree must have been fitted to the current positions
+   * of all clean vertices already.
+   *
+   * @param dirty     A vertex attribute that is true for all vertices that
+   *                  have moved since the tree was last refitted.
+   */
+  template< typename V, size_t K, typename T>
+  inline void refit_tree(
+                         Tree<T,K> & tree
+                         , mesh_array::T4Mesh const & mesh
+                         , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & X
+                         , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & Y
+                         , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & Z
+                         , mesh_array::VertexAttribute<bool,mesh_array::T4Mesh> const & dirty
+                         , parallel const & /* tag */
+                         )
+  {
+    geometry::DirectionTable<V,(K/2)> const DT = geometry::DirectionTableHelper<V,(K/2)>::make();
+
+    std::vector< SubTree<T,K> > & branches = tree.branches();
+
+    std::vector<char> changed( branches.size(), 0 );   // Non-zero for refitted chunks on the current level
+    std::vector<char> changed_children;
+
+#pragma omp parallel for schedule(static)
+    for( long c = 0; c < static_cast<long>( branches.size() ); ++c)
+    {
+      if( !details::is_dirty(branches[c], mesh, dirty) )
+        continue;
+
+      details::refit_subtree<V,K,T>(branches[c], mesh, X, Y, Z, DT);
+
+      changed[c] = 1;
+    }
+
+    for(size_t h = tree.number_of_levels() - 1; h >= 1; --h)
+    {
+      std::vector< SubTree<T,K> >       & super_chunks   = tree.super_chunks(h - 1);
+      std::vector< SubTree<T,K> > const & chunk_children = tree.super_chunks(h);
+
+      changed_children.swap( changed );
+      changed.assign( super_chunks.size(), 0 );
+
+#pragma omp parallel for schedule(static)
+      for(long c = 0; c < static_cast<long>( super_chunks.size() ); ++c)
+      {
+        if( !details::is_dirty( super_chunks[c], changed_children ) )
+          continue;
+
+        details::refit_subtree<V,K,T>( super_chunks[c], chunk_children );
+
+        changed[c] = 1;
+      }
+    }
 
-    C = tree.super_chunks(0).size();
-    for( size_t c = 1u; c < C;++c)
-    {      
-      tree.m_root = geometry::make_union( tree.m_root, tree.super_chunks(0)[c].m_nodes[0].m_volume );
-    }    
+    details::refit_root( tree );
   }
   
 }// namespace kdop
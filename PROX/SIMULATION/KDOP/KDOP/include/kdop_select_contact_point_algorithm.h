@@ -33,6 +33,11 @@ namespace kdop
 
   public:
 
+    static algorithm_type get_algorithm()
+    {
+      return get_algorithm_choice();
+    }
+
     static bool is_using_closest_point()
     {
       return get_algorithm_choice() == use_closest_points;
@@ -77,13 +82,13 @@ namespace kdop
 
   public:
 
-    template<typename V>
+    template<typename V, typename S>
     static bool call_algorithm(
                       geometry::Tetrahedron<V> const & A
                     , geometry::Tetrahedron<V> const & B
                     , geometry::ContactsCallback<V> & callback
-                    , std::vector<bool> const & surface_A
-                    , std::vector<bool> const & surface_B
+                    , S const & surface_A
+                    , S const & surface_B
                     )
     {
       switch ( get_algorithm_choice() )
@@ -40,6 +40,8 @@ namespace kdop
      * @param should_flip            By default normals point from shape (being object A) towards
      *                               tetrahedral mesh ( being object B). However, if order is reversed then
      *                               setting this flag to true will flip the normals.
+     * @param shape_feature          The feature index of the shape, reported to the callback together
+     *                               with the index of the tetrahedron being tested.
      */
     template< typename V, size_t K, typename T, typename S>
     inline void traversal(
@@ -54,6 +56,7 @@ namespace kdop
                           , mesh_array::TetrahedronAttribute<mesh_array::TetrahedronSurfaceInfo,mesh_array::T4Mesh> const & surface_map
                           , geometry::ContactsCallback<V> & callback
                           , bool const & should_flip
+                          , size_t const & shape_feature
                           )
     {
       using namespace mesh_array;
@@ -83,6 +86,11 @@ namespace kdop
         surface[2] = surface_map( tet ).m_k;
         surface[3] = surface_map( tet ).m_m;
 
+        if(should_flip)
+          callback.set_features( tet.idx(), shape_feature );
+        else
+          callback.set_features( shape_feature, tet.idx() );
+
         contacts_shape_tetrahedron(shape, tetrahedron, surface, callback, should_flip);
       }
       else
@@ -102,6 +110,7 @@ namespace kdop
                                , surface_map
                                , callback
                                , should_flip
+                               , shape_feature
                                );
         }
 
@@ -119,6 +128,8 @@ namespace kdop
    * @param should_flip            By default normals point from shape (being object A) towards
    *                               tetrahedral mesh ( being object B). However, if order is reversed then
    *                               setting this flag to true will flip the normals.
+   * @param shape_feature          The feature index of the shape (see
+   *                               geometry::ContactsCallback::set_features).
    */
   template< typename V, size_t K, typename T, typename S>
   inline void single_traversal(
@@ -131,6 +142,7 @@ namespace kdop
                                , mesh_array::TetrahedronAttribute<mesh_array::TetrahedronSurfaceInfo,mesh_array::T4Mesh> const & surface_map
                                , geometry::ContactsCallback<V> & callback
                                , bool const & should_flip = false
+                               , size_t const & shape_feature = 0u
                                )
   {
     geometry::DOP<T,K> const shape_dop = geometry::convert<K,V>( shape );
@@ -156,6 +168,7 @@ namespace kdop
                                   , surface_map
                                   , callback
                                   , should_flip
+                                  , shape_feature
                                   );
     }
   }
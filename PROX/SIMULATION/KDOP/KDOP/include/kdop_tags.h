@@ -13,6 +13,9 @@ namespace kdop
   struct sequential
   {};
 
+  struct parallel
+  {};
+
   struct dikucl
   {
     struct gproximity {};
@@ -3,6 +3,7 @@
 
 #include <kdop_tags.h>
 #include <kdop_test_pair.h>
+#include <kdop_transform.h>
 #include <kdop_tree.h>
 #include <kdop_select_contact_point_algorithm.h>
 
@@ -10,189 +11,573 @@
 
 #include <util_profiling.h>
 
+#include <bitset>
+#include <vector>
+#include <cassert>
+
 namespace kdop
 {
   namespace details
   {
-    
-    template< typename V, size_t K, typename T>
-    inline void traversal(
-                          size_t const & node_idx_A
-                          , SubTree<T,K> const & branch_A
-                          , mesh_array::T4Mesh const & mesh_A
-                          , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & X_A
-                          , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & Y_A
-                          , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & Z_A
-                          , mesh_array::TetrahedronAttribute<mesh_array::TetrahedronSurfaceInfo,mesh_array::T4Mesh> const & surface_map_A
-                          , size_t const & node_idx_B
-                          , SubTree<T,K> const & branch_B
-                          , mesh_array::T4Mesh const & mesh_B
-                          , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & X_B
-                          , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & Y_B
-                          , mesh_array::VertexAttribute<T,mesh_array::T4Mesh> const & Z_B
-                          , mesh_array::TetrahedronAttribute<mesh_array::TetrahedronSurfaceInfo,mesh_array::T4Mesh> const & surface_map_B
-                          , geometry::ContactsCallback<V> & callback
-                          )
+
+    /**
+     * Timer policies of the traversal. The sequential batch traversal keeps
+     * track of the time spent in exact tests, when traversing from several
+     * threads the (shared) profiling timers must be left alone.
+     */
+    class TraversalTimers
     {
-      using namespace mesh_array;
-      
-      Node<T,K> const & node_A = branch_A.m_nodes[node_idx_A];
-      Node<T,K> const & node_B = branch_B.m_nodes[node_idx_B];
-      
-      if(!geometry::overlap_dop_dop(node_A.m_volume, node_B.m_volume))
-        return;
-      
-      bool const A_is_leaf = node_A.is_leaf();
-      bool const B_is_leaf = node_B.is_leaf();
-      
-      if(A_is_leaf && B_is_leaf)
+    public:
+
+      static void begin_exact_test()
       {
         PAUSE_TIMER("tandem_traversal");
         RESUME_TIMER("exact_test");
+      }
+
+      static void end_exact_test()
+      {
+        PAUSE_TIMER("exact_test");
+        RESUME_TIMER("tandem_traversal");
+      }
+
+    };
+
+    class NoTimers
+    {
+    public:
+
+      static void begin_exact_test() {}
+
+      static void end_exact_test() {}
+
+    };
+
+    /**
+     * A pair of indices. On the traversal stack it is a pair of nodes, in
+     * the leaf buffer it is a pair of tetrahedra.
+     */
+    class IndexPair
+    {
+    public:
+
+      index_type m_a;
+      index_type m_b;
+
+    public:
+
+      IndexPair()
+      : m_a( UNDEFINED() )
+      , m_b( UNDEFINED() )
+      {}
+
+      IndexPair(index_type const & a, index_type const & b)
+      : m_a(a)
+      , m_b(b)
+      {}
 
-        Tetrahedron const & tet_A = mesh_A.tetrahedron( node_A.m_start );
-        Tetrahedron const & tet_B = mesh_B.tetrahedron( node_B.m_start );
-        
-        bool const & surface_Ai = surface_map_A( tet_A ).m_i;
-        bool const & surface_Aj = surface_map_A( tet_A ).m_j;
-        bool const & surface_Ak = surface_map_A( tet_A ).m_k;
-        bool const & surface_Am = surface_map_A( tet_A ).m_m;
-
-        if (
-            !surface_Ai &&
-            !surface_Aj &&
-            !surface_Ak &&
-            !surface_Am
-            )
+    };
+
+    /**
+     * Scratch buffers of the traversal. The buffers are cleared but never
+     * shrunk, so a workspace that is reused for many traversals stops
+     * allocating memory after the first few.
+     */
+    class TraversalWorkspace
+    {
+    public:
+
+      std::vector<IndexPair> m_stack;    ///< Overlapping node pairs that are still to be visited.
+      std::vector<IndexPair> m_leaves;   ///< Tetrahedron pairs waiting for the exact test.
+
+    };
+
+    inline bool has_surface_face(mesh_array::TetrahedronSurfaceInfo const & info)
+    {
+      return info.m_i || info.m_j || info.m_k || info.m_m;
+    }
+
+    inline std::bitset<4> make_surface_flags(mesh_array::TetrahedronSurfaceInfo const & info)
+    {
+      std::bitset<4> flags;
+
+      flags[0] = info.m_i;
+      flags[1] = info.m_j;
+      flags[2] = info.m_k;
+      flags[3] = info.m_m;
+
+      return flags;
+    }
+
+    /**
+     * Tandem traversal of two nodes whose volumes are known to overlap.
+     *
+     * The traversal uses an explicit stack of node pairs. When descending,
+     * all children of one node are tested against the other node in one
+     * batched overlap test, and only overlapping pairs are pushed. Children
+     * are pushed in reverse order such that node pairs are visited in the
+     * same depth first order as a recursive traversal would.
+     *
+     * Leaf pairs are not tested here, they are appended to the leaf buffer
+     * of the workspace. Pairs where one of the tetrahedra has no surface
+     * faces are dropped right away.
+     *
+     * @param X       Transform that brings the volumes of B into the frame of A.
+     */
+    template< typename V, size_t K, typename T, typename transform_type>
+    inline void collect_leaf_pairs(
+                                   TestPair<V,K,T> const & work_item
+                                   , SubTree<T,K> const & branch_A
+                                   , index_type const & node_idx_A
+                                   , SubTree<T,K> const & branch_B
+                                   , index_type const & node_idx_B
+                                   , transform_type const & X
+                                   , TraversalWorkspace & workspace
+                                   )
+    {
+      typedef geometry::DOP<T,K> volume_type;
+
+      std::vector<IndexPair> & stack  = workspace.m_stack;
+      std::vector<IndexPair> & leaves = workspace.m_leaves;
+
+      stack.clear();
+      stack.push_back( IndexPair( node_idx_A, node_idx_B ) );
+
+      while( !stack.empty() )
+      {
+        IndexPair const pair = stack.back();
+
+        stack.pop_back();
+
+        Node<T,K> const & node_A = branch_A.m_nodes[pair.m_a];
+        Node<T,K> const & node_B = branch_B.m_nodes[pair.m_b];
+
+        bool const A_is_leaf = node_A.is_leaf();
+        bool const B_is_leaf = node_B.is_leaf();
+
+        assert( A_is_leaf || node_A.m_end == node_A.m_start + 1u || !"collect_leaf_pairs(): internal error, expected two children");
+        assert( B_is_leaf || node_B.m_end == node_B.m_start + 1u || !"collect_leaf_pairs(): internal error, expected two children");
+
+        if(A_is_leaf && B_is_leaf)
         {
-          PAUSE_TIMER("exact_test");
-          RESUME_TIMER("tandem_traversal");
-          return;
+          mesh_array::Tetrahedron const & tet_A = work_item.m_mesh_a->tetrahedron( node_A.m_start );
+          mesh_array::Tetrahedron const & tet_B = work_item.m_mesh_b->tetrahedron( node_B.m_start );
+
+          if( has_surface_face( (*work_item.m_surface_map_a)( tet_A ) ) && has_surface_face( (*work_item.m_surface_map_b)( tet_B ) ) )
+            leaves.push_back( IndexPair( node_A.m_start, node_B.m_start ) );
         }
+        else if(!B_is_leaf)
+        {
+          // The children of B are brought into the frame of A once and
+          // tested against A or each child of A in turn
+          volume_type const & B0 = X.transform_dop( branch_B.m_nodes[node_B.m_start].m_volume );
+          volume_type const & B1 = X.transform_dop( branch_B.m_nodes[node_B.m_end  ].m_volume );
+
+          index_type const a_begin = A_is_leaf ? pair.m_a : node_A.m_start;
+          index_type const a_end   = A_is_leaf ? pair.m_a : node_A.m_end;
+
+          for(index_type a = a_end + 1u; a-- > a_begin; )
+          {
+            unsigned int const overlaps = geometry::overlap_dop_dops( branch_A.m_nodes[a].m_volume, B0, B1 );
 
-        bool const & surface_Bi = surface_map_B( tet_B ).m_i;
-        bool const & surface_Bj = surface_map_B( tet_B ).m_j;
-        bool const & surface_Bk = surface_map_B( tet_B ).m_k;
-        bool const & surface_Bm = surface_map_B( tet_B ).m_m;
-
-        if (
-            !surface_Bi &&
-            !surface_Bj &&
-            !surface_Bk &&
-            !surface_Bm
-            )
+            if( overlaps & 2u )
+              stack.push_back( IndexPair( a, node_B.m_end ) );
+
+            if( overlaps & 1u )
+              stack.push_back( IndexPair( a, node_B.m_start ) );
+          }
+        }
+        else
         {
-          PAUSE_TIMER("exact_test");
-          RESUME_TIMER("tandem_traversal");
-          return; // all faces of B are internal
+          volume_type const & B = X.transform_dop( node_B.m_volume );
+
+          unsigned int const overlaps = geometry::overlap_dop_dops( B, branch_A.m_nodes[node_A.m_start].m_volume, branch_A.m_nodes[node_A.m_end].m_volume );
+
+          if( overlaps & 2u )
+            stack.push_back( IndexPair( node_A.m_end, pair.m_b ) );
+
+          if( overlaps & 1u )
+            stack.push_back( IndexPair( node_A.m_start, pair.m_b ) );
         }
+      }
+    }
+
+    /**
+     * Exact contact tests of a batch of tetrahedron pairs with one
+     * contact point algorithm.
+     *
+     * @param X       Transform that brings the vertices of B into the frame
+     *                of A. The contact points are reported in the frame of A.
+     */
+    template< typename V, size_t K, typename T, typename transform_type, typename algorithm_tag>
+    inline void exact_tests(
+                            TestPair<V,K,T> const & work_item
+                            , std::vector<IndexPair> const & leaves
+                            , geometry::ContactsCallback<V> & callback
+                            , transform_type const & X
+                            , algorithm_tag const & algorithm
+                            )
+    {
+      using namespace mesh_array;
+
+      VertexAttribute<T,T4Mesh> const & X_A = *(work_item.m_x_a);
+      VertexAttribute<T,T4Mesh> const & Y_A = *(work_item.m_y_a);
+      VertexAttribute<T,T4Mesh> const & Z_A = *(work_item.m_z_a);
+      VertexAttribute<T,T4Mesh> const & X_B = *(work_item.m_x_b);
+      VertexAttribute<T,T4Mesh> const & Y_B = *(work_item.m_y_b);
+      VertexAttribute<T,T4Mesh> const & Z_B = *(work_item.m_z_b);
+
+      for(size_t l = 0u; l < leaves.size(); ++l)
+      {
+        Tetrahedron const & tet_A = work_item.m_mesh_a->tetrahedron( leaves[l].m_a );
+        Tetrahedron const & tet_B = work_item.m_mesh_b->tetrahedron( leaves[l].m_b );
+
+        std::bitset<4> const surface_A = make_surface_flags( (*work_item.m_surface_map_a)( tet_A ) );
+        std::bitset<4> const surface_B = make_surface_flags( (*work_item.m_surface_map_b)( tet_B ) );
 
         V const a0 = V::make( X_A( tet_A.i() ), Y_A( tet_A.i() ), Z_A( tet_A.i() ) );
         V const a1 = V::make( X_A( tet_A.j() ), Y_A( tet_A.j() ), Z_A( tet_A.j() ) );
         V const a2 = V::make( X_A( tet_A.k() ), Y_A( tet_A.k() ), Z_A( tet_A.k() ) );
         V const a3 = V::make( X_A( tet_A.m() ), Y_A( tet_A.m() ), Z_A( tet_A.m() ) );
-        
-        V const b0 = V::make( X_B( tet_B.i() ), Y_B( tet_B.i() ), Z_B( tet_B.i() ) );
-        V const b1 = V::make( X_B( tet_B.j() ), Y_B( tet_B.j() ), Z_B( tet_B.j() ) );
-        V const b2 = V::make( X_B( tet_B.k() ), Y_B( tet_B.k() ), Z_B( tet_B.k() ) );
-        V const b3 = V::make( X_B( tet_B.m() ), Y_B( tet_B.m() ), Z_B( tet_B.m() ) );
 
-        std::vector<bool> surface_A( 4u, false );
-        std::vector<bool> surface_B( 4u, false );
+        V const b0 = X.transform_point( V::make( X_B( tet_B.i() ), Y_B( tet_B.i() ), Z_B( tet_B.i() ) ) );
+        V const b1 = X.transform_point( V::make( X_B( tet_B.j() ), Y_B( tet_B.j() ), Z_B( tet_B.j() ) ) );
+        V const b2 = X.transform_point( V::make( X_B( tet_B.k() ), Y_B( tet_B.k() ), Z_B( tet_B.k() ) ) );
+        V const b3 = X.transform_point( V::make( X_B( tet_B.m() ), Y_B( tet_B.m() ), Z_B( tet_B.m() ) ) );
 
         geometry::Tetrahedron<V> const gtet_A = geometry::make_tetrahedron(a0,a1,a2,a3);
         geometry::Tetrahedron<V> const gtet_B = geometry::make_tetrahedron(b0,b1,b2,b3);
 
-        surface_A[0] = surface_Ai;
-        surface_A[1] = surface_Aj;
-        surface_A[2] = surface_Ak;
-        surface_A[3] = surface_Am;
-        
-        surface_B[0] = surface_Bi;
-        surface_B[1] = surface_Bj;
-        surface_B[2] = surface_Bk;
-        surface_B[3] = surface_Bm;
+        callback.set_features( tet_A.idx(), tet_B.idx() );
 
-        SelectContactPointAlgorithm::call_algorithm(gtet_A, gtet_B, callback, surface_A, surface_B );
+        geometry::contacts_tetrahedron_tetrahedron( gtet_A, gtet_B, callback, surface_A, surface_B, algorithm );
+      }
+    }
 
-        PAUSE_TIMER("exact_test");
-        RESUME_TIMER("tandem_traversal");
+    /**
+     * Exact contact tests of a batch of tetrahedron pairs. The contact point
+     * algorithm is looked up once for the whole batch, the loop over the
+     * batch is compiled for the selected algorithm.
+     */
+    template< typename V, size_t K, typename T, typename transform_type>
+    inline void exact_tests(
+                            TestPair<V,K,T> const & work_item
+                            , std::vector<IndexPair> const & leaves
+                            , geometry::ContactsCallback<V> & callback
+                            , transform_type const & X
+                            )
+    {
+      if( leaves.empty() )
+        return;
 
+      switch ( SelectContactPointAlgorithm::get_algorithm() )
+      {
+        case SelectContactPointAlgorithm::use_sat:
+          exact_tests<V,K,T>( work_item, leaves, callback, X, geometry::SAT() );
+          break;
+        case SelectContactPointAlgorithm::use_restricted_sat:
+          exact_tests<V,K,T>( work_item, leaves, callback, X, geometry::RESTRICTED_SAT() );
+          break;
+        case SelectContactPointAlgorithm::use_most_opposing_surfaces:
+          exact_tests<V,K,T>( work_item, leaves, callback, X, geometry::MOST_OPPOSING_SURFACES() );
+          break;
+        case SelectContactPointAlgorithm::use_triangle_intersection:
+          exact_tests<V,K,T>( work_item, leaves, callback, X, geometry::TRIANGLE_INTERSECTION() );
+          break;
+        case SelectContactPointAlgorithm::use_vertex_only:
+          exact_tests<V,K,T>( work_item, leaves, callback, X, geometry::VERTEX_ONLY_INTERSECTION() );
+          break;
+        case SelectContactPointAlgorithm::use_consistent_vertex:
+          exact_tests<V,K,T>( work_item, leaves, callback, X, geometry::CONSISTENT_VERTEX() );
+          break;
+        case SelectContactPointAlgorithm::use_growth:
+          exact_tests<V,K,T>( work_item, leaves, callback, X, geometry::GROWTH() );
+          break;
+        case SelectContactPointAlgorithm::use_closest_points:
+          exact_tests<V,K,T>( work_item, leaves, callback, X, geometry::CLOSEST_POINTS() );
+          break;
+        default:
+          assert(false || !"exact_tests(): unrecognized algorithm choice");
+          break;
       }
-      else if(!A_is_leaf && !B_is_leaf)
+    }
+
+    /**
+     * Tandem traversal of a node pair of two branches of a test pair. All
+     * leaf pairs are collected first and then tested in one batch.
+     *
+     * @param X       Transform that brings the volumes and vertices of B into
+     *                the frame of A. The contact points are reported in the
+     *                frame of A.
+     * @param timers  The timer policy, either TraversalTimers or NoTimers.
+     */
+    template< typename V, size_t K, typename T, typename transform_type, typename timers_type>
+    inline void traversal(
+                          TestPair<V,K,T> const & work_item
+                          , size_t const & branch_idx_A
+                          , index_type const & node_idx_A
+                          , size_t const & branch_idx_B
+                          , index_type const & node_idx_B
+                          , geometry::ContactsCallback<V> & callback
+                          , transform_type const & X
+                          , timers_type const & /*timers*/
+                          , TraversalWorkspace & workspace
+                          )
+    {
+      SubTree<T,K> const & branch_A = work_item.m_tree_a->branches()[branch_idx_A];
+      SubTree<T,K> const & branch_B = work_item.m_tree_b->branches()[branch_idx_B];
+
+      if(!geometry::overlap_dop_dop(branch_A.m_nodes[node_idx_A].m_volume, X.transform_dop(branch_B.m_nodes[node_idx_B].m_volume)))
+        return;
+
+      workspace.m_leaves.clear();
+
+      collect_leaf_pairs<V,K,T>( work_item, branch_A, node_idx_A, branch_B, node_idx_B, X, workspace );
+
+      timers_type::begin_exact_test();
+
+      exact_tests<V,K,T>( work_item, workspace.m_leaves, callback, X );
+
+      timers_type::end_exact_test();
+    }
+    
+  }// namespace details
+
+  namespace details
+  {
+
+    template< typename V, size_t K, typename T, typename transform_type, typename timers_type>
+    inline void tandem_traversal(
+                                 TestPair<V,K,T> & work_item
+                                 , geometry::ContactsCallback<V> & callback
+                                 , transform_type const & X
+                                 , timers_type const & timers
+                                 , TraversalWorkspace & workspace
+                                 )
+    {
+      if(!geometry::overlap_dop_dop(work_item.m_tree_a->m_root, X.transform_dop(work_item.m_tree_b->m_root)))
+        return;
+
+      size_t const C_A = work_item.m_tree_a->branches().size();
+      size_t const C_B = work_item.m_tree_b->branches().size();
+
+      for( size_t a = 0u; a < C_A; ++a)
+        for( size_t b = 0u; b < C_B; ++b)
+          details::traversal<V,K,T>( work_item, a, 0u, b, 0u, callback, X, timers, workspace );
+    }
+
+    /**
+     * Tandem traversal of a single test pair.
+     *
+     * If the trees of the test pair are fitted in body frames then the
+     * traversal is done in the body frame of A. The volumes of B are
+     * re-bounded in the body frame of A on the fly and only the vertices of
+     * B that reach the exact tests are transformed. This way rigid objects
+     * never need to have their trees refitted.
+     */
+    template< typename V, size_t K, typename T, typename timers_type>
+    inline void tandem_traversal( TestPair<V,K,T> & work_item, timers_type const & timers, TraversalWorkspace & workspace )
+    {
+      typedef typename TestPair<V,K,T>::coordsys_type C;
+
+      if( !work_item.m_body_frames )
       {
-        for(size_t a = node_A.m_start; a <= node_A.m_end; ++a)
-        {
-          for(size_t b = node_B.m_start; b <= node_B.m_end; ++b)
-          {
-            traversal<V,K,T>(  a, branch_A, mesh_A, X_A, Y_A, Z_A, surface_map_A
-                             , b, branch_B, mesh_B, X_B, Y_B, Z_B, surface_map_B
-                             , callback
-                             );
-          }
-        }
+        details::tandem_traversal<V,K,T>( work_item, *(work_item.m_callback), IdentityTransform<V,K>(), timers, workspace );
+
+        return;
       }
-      else if(!A_is_leaf && B_is_leaf)
+
+      C const BtoA = tiny::prod( tiny::inverse( work_item.m_frame_a ), work_item.m_frame_b );
+
+      TransformedContactsCallback<V> callback( work_item.m_frame_a, *(work_item.m_callback) );
+
+      details::tandem_traversal<V,K,T>( work_item, callback, RigidTransform<V,K>( BtoA ), timers, workspace );
+    }
+
+    /**
+     * A unit of work of the parallel tandem traversal. A task is a pair of
+     * nodes from a pair of branches of the trees of a test pair.
+     */
+    class TraversalTask
+    {
+    public:
+
+      size_t m_item;       ///< Index of the test pair in the work pool.
+      size_t m_branch_a;   ///< Index of the branch of tree A.
+      size_t m_branch_b;   ///< Index of the branch of tree B.
+      size_t m_node_a;     ///< Index of the node in the branch of tree A.
+      size_t m_node_b;     ///< Index of the node in the branch of tree B.
+
+    public:
+
+      TraversalTask()
+      : m_item(0u)
+      , m_branch_a(0u)
+      , m_branch_b(0u)
+      , m_node_a(0u)
+      , m_node_b(0u)
+      {}
+
+      TraversalTask(size_t const & item, size_t const & branch_a, size_t const & branch_b, size_t const & node_a, size_t const & node_b)
+      : m_item(item)
+      , m_branch_a(branch_a)
+      , m_branch_b(branch_b)
+      , m_node_a(node_a)
+      , m_node_b(node_b)
+      {}
+
+    };
+
+    /**
+     * Buffered Contacts Callback.
+     * Each task of the parallel tandem traversal reports to its own buffer.
+     * Afterwards the buffers are replayed in task order into the callbacks
+     * of the test pairs, which gives the same sequence of calls as the
+     * sequential traversal.
+     */
+    template<typename V>
+    class BufferedContactsCallback
+    : public geometry::ContactsCallback<V>
+    {
+    public:
+
+      typedef typename V::real_type     T;
+      typedef typename V::value_traits  VT;
+
+    protected:
+
+      class Event
       {
-        for(size_t a = node_A.m_start; a <= node_A.m_end; ++a)
-        {
-          traversal<V,K,T>(           a, branch_A, mesh_A, X_A, Y_A, Z_A, surface_map_A
-                           , node_idx_B, branch_B, mesh_B, X_B, Y_B, Z_B, surface_map_B
-                           , callback
-                           );
-        }
+      public:
+
+        bool   m_features;   ///< If true then the event is a set_features call, otherwise it is a contact point.
+        size_t m_feature_a;
+        size_t m_feature_b;
+        V      m_point;
+        V      m_normal;
+        T      m_distance;
+
+      public:
+
+        Event( V const & point, V const & normal, T const & distance )
+        : m_features(false)
+        , m_feature_a(0u)
+        , m_feature_b(0u)
+        , m_point(point)
+        , m_normal(normal)
+        , m_distance(distance)
+        {}
+
+        Event( size_t const & feature_a, size_t const & feature_b )
+        : m_features(true)
+        , m_feature_a(feature_a)
+        , m_feature_b(feature_b)
+        , m_point( V::zero() )
+        , m_normal( V::zero() )
+        , m_distance( VT::zero() )
+        {}
+
+      };
+
+      std::vector<Event> m_events;
+
+    public:
+
+      void operator()( V const & point, V const & normal, T const & distance )
+      {
+        this->m_events.push_back( Event( point, normal, distance ) );
+      }
+
+      void set_features( size_t const & feature_a, size_t const & feature_b )
+      {
+        this->m_events.push_back( Event( feature_a, feature_b ) );
       }
-      else if( A_is_leaf && !B_is_leaf)
+
+      void replay( geometry::ContactsCallback<V> & callback ) const
       {
-        for(size_t b = node_B.m_start; b <= node_B.m_end; ++b)
+        for(size_t e = 0u; e < this->m_events.size(); ++e)
         {
-          traversal<V,K,T>(  node_idx_A, branch_A, mesh_A, X_A, Y_A, Z_A, surface_map_A
-                           ,          b, branch_B, mesh_B, X_B, Y_B, Z_B, surface_map_B
-                           , callback
-                           );
+          Event const & event = this->m_events[e];
+
+          if( event.m_features )
+            callback.set_features( event.m_feature_a, event.m_feature_b );
+          else
+            callback( event.m_point, event.m_normal, event.m_distance );
         }
       }
-      
+
+    };
+
+    /**
+     * Split a task into tasks of the child node pairs.
+     * Child pairs are appended in the same order as the recursive traversal
+     * visits them, tasks with non-overlapping volumes are dropped and leaf
+     * pairs are kept as they are.
+     */
+    template< typename V, size_t K, typename T, typename transform_type>
+    inline void split_task(
+                           TraversalTask const & task
+                           , TestPair<V,K,T> const & work_item
+                           , transform_type const & X
+                           , std::vector<TraversalTask> & tasks
+                           )
+    {
+      SubTree<T,K> const & branch_A = work_item.m_tree_a->branches()[task.m_branch_a];
+      SubTree<T,K> const & branch_B = work_item.m_tree_b->branches()[task.m_branch_b];
+
+      Node<T,K> const & node_A = branch_A.m_nodes[task.m_node_a];
+      Node<T,K> const & node_B = branch_B.m_nodes[task.m_node_b];
+
+      if(!geometry::overlap_dop_dop(node_A.m_volume, X.transform_dop(node_B.m_volume)))
+        return;
+
+      bool const A_is_leaf = node_A.is_leaf();
+      bool const B_is_leaf = node_B.is_leaf();
+
+      size_t const a_begin = A_is_leaf ? task.m_node_a : node_A.m_start;
+      size_t const a_end   = A_is_leaf ? task.m_node_a : node_A.m_end;
+      size_t const b_begin = B_is_leaf ? task.m_node_b : node_B.m_start;
+      size_t const b_end   = B_is_leaf ? task.m_node_b : node_B.m_end;
+
+      for(size_t a = a_begin; a <= a_end; ++a)
+        for(size_t b = b_begin; b <= b_end; ++b)
+          tasks.push_back( TraversalTask( task.m_item, task.m_branch_a, task.m_branch_b, a, b ) );
     }
-    
+
+    template< typename V, size_t K, typename T, typename transform_type>
+    inline void run_task(
+                         TraversalTask const & task
+                         , TestPair<V,K,T> const & work_item
+                         , geometry::ContactsCallback<V> & callback
+                         , transform_type const & X
+                         , TraversalWorkspace & workspace
+                         )
+    {
+      details::traversal<V,K,T>(  work_item
+                                , task.m_branch_a
+                                , task.m_node_a
+                                , task.m_branch_b
+                                , task.m_node_b
+                                , callback
+                                , X
+                                , NoTimers()
+                                , workspace
+                                );
+    }
+
   }// namespace details
 
+  /**
+   * Tandem traversal of a single test pair.
+   * No profiling timers are touched so this may be invoked from several
+   * threads at once, as long as the test pairs have different callbacks.
+   */
   template< typename V, size_t K, typename T>
   inline void tandem_traversal( TestPair<V,K,T> & work_item  )
   {
+    details::TraversalWorkspace workspace;
 
-    if(!geometry::overlap_dop_dop(work_item.m_tree_a->m_root, work_item.m_tree_b->m_root))
-      return;
-
-    size_t const C_A = work_item.m_tree_a->branches().size();
-    size_t const C_B = work_item.m_tree_b->branches().size();
-
-    for( size_t a = 0u; a < C_A; ++a)
-    {
-      SubTree<T,K> const & branch_A = work_item.m_tree_a->branches()[a];
-
-      for( size_t b = 0u; b < C_B; ++b)
-      {
-        SubTree<T,K> const & branch_B = work_item.m_tree_b->branches()[b];
-
-        details::traversal<V,K,T>(  0
-                                  , branch_A
-                                  , *(work_item.m_mesh_a)
-                                  , *(work_item.m_x_a)
-                                  , *(work_item.m_y_a)
-                                  , *(work_item.m_z_a)
-                                  , *(work_item.m_surface_map_a)
-                                  , 0
-                                  , branch_B
-                                  , *(work_item.m_mesh_b)
-                                  , *(work_item.m_x_b)
-                                  , *(work_item.m_y_b)
-                                  , *(work_item.m_z_b)
-                                  , *(work_item.m_surface_map_b)
-                                  , *(work_item.m_callback)
-                                  );
-      }
-    }
+    details::tandem_traversal<V,K,T>( work_item, details::NoTimers(), workspace );
   }
 
   template< typename V, size_t K, typename T>
@@ -212,12 +597,14 @@ namespace kdop
     START_TIMER("exact_test");
     PAUSE_TIMER("exact_test");
 
+    details::TraversalWorkspace workspace;
+
     work_item_iterator end     = work_pool.end();
     work_item_iterator current = work_pool.begin();
 
     for(;current != end; ++current)
     {
-      tandem_traversal<V, K, T>( *current );
+      details::tandem_traversal<V, K, T>( *current, details::TraversalTimers(), workspace );
     }
 
     RESUME_TIMER("exact_test");
@@ -225,6 +612,127 @@ namespace kdop
     STOP_TIMER("tandem_traversal");
   }
 
+  /**
+   * Multicore tandem traversal of a work pool.
+   *
+   * Work is created for every pair of branches of every test pair with
+   * overlapping root volumes. While there are too few tasks to keep all
+   * threads busy the node pairs of the tasks are split into their child
+   * node pairs, this way a single pair of large meshes is also spread over
+   * all threads. Tasks report contacts to their own buffers, and the
+   * buffers are handed over to the callbacks of the test pairs in task
+   * order once all tasks are done.
+   */
+  template< typename V, size_t K, typename T>
+  inline void tandem_traversal(
+                               std::vector< TestPair<V,K,T> > & work_pool
+                               , parallel const & /*tag*/
+                               )
+  {
+    if( work_pool.empty() )
+      return;
+
+    typedef          TestPair<V,K,T>                  work_item_type;
+
+    size_t const min_tasks  = 256u;   // Keep splitting until there are at least this many tasks
+    size_t const max_splits = 4u;     // but never split more than this many levels down the branches
+
+    START_TIMER("tandem_traversal");
+
+    size_t const N = work_pool.size();
+
+    //--- Transforms that bring B into the body frame of A -------------------
+    std::vector< RigidTransform<V,K> > transforms( N );
+
+    for(size_t i = 0u; i < N; ++i)
+    {
+      work_item_type const & item = work_pool[i];
+
+      if( item.m_body_frames )
+        transforms[i] = RigidTransform<V,K>( tiny::prod( tiny::inverse( item.m_frame_a ), item.m_frame_b ) );
+    }
+
+    //--- Create tasks of all pairs of branches ------------------------------
+    std::vector<details::TraversalTask> tasks;
+    std::vector<details::TraversalTask> split;
+
+    for(size_t i = 0u; i < N; ++i)
+    {
+      work_item_type const & item = work_pool[i];
+
+      bool const overlap = item.m_body_frames
+                         ? geometry::overlap_dop_dop( item.m_tree_a->m_root, transforms[i].transform_dop( item.m_tree_b->m_root ) )
+                         : geometry::overlap_dop_dop( item.m_tree_a->m_root, item.m_tree_b->m_root );
+
+      if( !overlap )
+        continue;
+
+      size_t const C_A = item.m_tree_a->branches().size();
+      size_t const C_B = item.m_tree_b->branches().size();
+
+      for( size_t a = 0u; a < C_A; ++a)
+        for( size_t b = 0u; b < C_B; ++b)
+          tasks.push_back( details::TraversalTask( i, a, b, 0u, 0u ) );
+    }
+
+    //--- Split tasks of deep traversals -------------------------------------
+    for(size_t level = 0u; level < max_splits && !tasks.empty() && tasks.size() < min_tasks; ++level)
+    {
+      split.clear();
+
+      for(size_t t = 0u; t < tasks.size(); ++t)
+      {
+        work_item_type const & item = work_pool[ tasks[t].m_item ];
+
+        if( item.m_body_frames )
+          details::split_task<V,K,T>( tasks[t], item, transforms[ tasks[t].m_item ], split );
+        else
+          details::split_task<V,K,T>( tasks[t], item, IdentityTransform<V,K>(), split );
+      }
+
+      tasks.swap( split );
+    }
+
+    //--- Run all tasks, each task has its own contact buffer ----------------
+    //--- and each thread has its own traversal workspace -------------------
+    std::vector< details::BufferedContactsCallback<V> > buffers( tasks.size() );
+
+#pragma omp parallel
+    {
+      details::TraversalWorkspace workspace;
+
+#pragma omp for schedule(dynamic, 1)
+      for(long t = 0; t < static_cast<long>( tasks.size() ); ++t)
+      {
+        work_item_type const & item = work_pool[ tasks[t].m_item ];
+
+        if( item.m_body_frames )
+          details::run_task<V,K,T>( tasks[t], item, buffers[t], transforms[ tasks[t].m_item ], workspace );
+        else
+          details::run_task<V,K,T>( tasks[t], item, buffers[t], IdentityTransform<V,K>(), workspace );
+      }
+    }
+
+    //--- Hand over contacts in task order -----------------------------------
+    for(size_t t = 0u; t < tasks.size(); ++t)
+    {
+      work_item_type const & item = work_pool[ tasks[t].m_item ];
+
+      if( item.m_body_frames )
+      {
+        TransformedContactsCallback<V> callback( item.m_frame_a, *(item.m_callback) );
+
+        buffers[t].replay( callback );
+      }
+      else
+      {
+        buffers[t].replay( *(item.m_callback) );
+      }
+    }
+
+    STOP_TIMER("tandem_traversal");
+  }
+
 }// namespace kdop
 
 // KDOP_TANDEM_TRAVERSAL_H
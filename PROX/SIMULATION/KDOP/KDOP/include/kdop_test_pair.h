@@ -9,12 +9,18 @@
 #include <mesh_array_t4mesh.h>
 #include <mesh_array_vertex_attribute.h>
 
+#include <tiny_math_types.h>
+
 namespace kdop
 {
 
   template< typename V, size_t K, typename T >
   class TestPair
   {
+  public:
+
+    typedef typename tiny::MathTypes<T>::coordsys_type coordsys_type;
+
   public:
 
     Tree<T, K> const * m_tree_a;
@@ -36,6 +42,11 @@ namespace kdop
 
     geometry::ContactsCallback<V> * m_callback;
 
+    bool          m_body_frames;  ///< If true then trees and vertex coordinates are given in body frames
+                                  ///< and m_frame_a and m_frame_b place the body frames in the world.
+    coordsys_type m_frame_a;      ///< Body frame to world transform of A, only used with body frames.
+    coordsys_type m_frame_b;      ///< Body frame to world transform of B, only used with body frames.
+
   public:
 
     TestPair()
@@ -52,8 +63,50 @@ namespace kdop
     , m_surface_map_a(0)
     , m_surface_map_b(0)
     , m_callback(0)
+    , m_body_frames(false)
+    , m_frame_a()
+    , m_frame_b()
+    {}
+
+    TestPair(
+               Tree<T, K> const & tree_A
+             , Tree<T, K> const & tree_B
+             , mesh_array::T4Mesh const & mesh_A
+             , mesh_array::T4Mesh const & mesh_B
+             , mesh_array::VertexAttribute<T, mesh_array::T4Mesh> const & X_A
+             , mesh_array::VertexAttribute<T, mesh_array::T4Mesh> const & X_B
+             , mesh_array::VertexAttribute<T, mesh_array::T4Mesh> const & Y_A
+             , mesh_array::VertexAttribute<T, mesh_array::T4Mesh> const & Y_B
+             , mesh_array::VertexAttribute<T, mesh_array::T4Mesh> const & Z_A
+             , mesh_array::VertexAttribute<T, mesh_array::T4Mesh> const & Z_B
+             , mesh_array::TetrahedronAttribute<mesh_array::TetrahedronSurfaceInfo, mesh_array::T4Mesh> const & surface_map_a
+             , mesh_array::TetrahedronAttribute<mesh_array::TetrahedronSurfaceInfo, mesh_array::T4Mesh> const & surface_map_b
+             , geometry::ContactsCallback<V> & callback
+             )
+    : m_tree_a(&tree_A)
+    , m_tree_b(&tree_B)
+    , m_mesh_a(&mesh_A)
+    , m_mesh_b(&mesh_B)
+    , m_x_a(&X_A)
+    , m_x_b(&X_B)
+    , m_y_a(&Y_A)
+    , m_y_b(&Y_B)
+    , m_z_a(&Z_A)
+    , m_z_b(&Z_B)
+    , m_surface_map_a(&surface_map_a)
+    , m_surface_map_b(&surface_map_b)
+    , m_callback(&callback)
+    , m_body_frames(false)
+    , m_frame_a()
+    , m_frame_b()
     {}
 
+    /**
+     * Create a test pair of two trees that are fitted in body frames.
+     *
+     * @param frame_A   The body frame to world transform of A.
+     * @param frame_B   The body frame to world transform of B.
+     */
     TestPair(
                Tree<T, K> const & tree_A
              , Tree<T, K> const & tree_B
@@ -68,6 +121,8 @@ namespace kdop
              , mesh_array::TetrahedronAttribute<mesh_array::TetrahedronSurfaceInfo, mesh_array::T4Mesh> const & surface_map_a
              , mesh_array::TetrahedronAttribute<mesh_array::TetrahedronSurfaceInfo, mesh_array::T4Mesh> const & surface_map_b
              , geometry::ContactsCallback<V> & callback
+             , coordsys_type const & frame_A
+             , coordsys_type const & frame_B
              )
     : m_tree_a(&tree_A)
     , m_tree_b(&tree_B)
@@ -82,6 +137,9 @@ namespace kdop
     , m_surface_map_a(&surface_map_a)
     , m_surface_map_b(&surface_map_b)
     , m_callback(&callback)
+    , m_body_frames(true)
+    , m_frame_a(frame_A)
+    , m_frame_b(frame_B)
     {}
 
   };
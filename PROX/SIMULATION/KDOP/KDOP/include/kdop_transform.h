@@ -0,0 +1,251 @@
+#ifndef KDOP_TRANSFORM_H
+#define KDOP_TRANSFORM_H
+
+#include <types/geometry_direction_table.h>
+#include <types/geometry_dop.h>
+
+#include <contacts/geometry_contacts_callback.h>
+
+#include <tiny_math_types.h>
+#include <tiny_coordsys_functions.h>
+#include <tiny_vector_functions.h>
+
+#include <algorithm>  // Needed for std::min
+#include <cmath>      // Needed for std::sqrt
+#include <cstddef>    // Needed for size_t
+
+namespace kdop
+{
+
+  namespace details
+  {
+
+    /**
+     * Support Function of a kDOP.
+     * Computes the largest value of inner_prod(n, p) for any point p inside
+     * a kDOP. The primary template does not know the geometry of the slab
+     * directions and returns a conservative unbounded value.
+     *
+     * @tparam T   The real type.
+     * @tparam K   The number of slab planes of the kDOP.
+     */
+    template<typename T, size_t K>
+    class DOPSupport
+    {
+    public:
+
+      template<typename V>
+      static T upper(geometry::DOP<T,K> const & /*dop*/, V const & /*n*/)
+      {
+        return tiny::ValueTraits<T>::highest();
+      }
+    };
+
+    /**
+     * A 6-DOP is an axis aligned box (see geometry::make3), so the support
+     * function is simply the box corner that is furthest along n.
+     */
+    template<typename T>
+    class DOPSupport<T,6>
+    {
+    public:
+
+      template<typename V>
+      static T upper(geometry::DOP<T,6> const & dop, V const & n)
+      {
+        typedef tiny::ValueTraits<T> VT;
+
+        T value = VT::zero();
+
+        for(size_t i = 0u; i < 3u; ++i)
+          value += n(i) > VT::zero() ? n(i)*dop(i).upper() : n(i)*dop(i).lower();
+
+        return value;
+      }
+    };
+
+    /**
+     * The slab normals of an 8-DOP are the four diagonals d_0, .., d_3 of
+     * geometry::make4. They form a tight frame, n = 3/4 sum_i (d_i . n) d_i,
+     * and have the single linear dependency d_0 - d_1 - d_2 + d_3 = 0.
+     *
+     * By linear programming duality the support value is the smallest
+     * value of sum_i c_i slab_i over all ways to write n = sum_i c_i d_i,
+     * where slab_i is the upper or lower slab value depending on the sign
+     * of c_i. This is a convex piecewise linear function along the
+     * dependency, so the minimum is found at one of the four
+     * decompositions that only use three of the directions. The result is
+     * the exact support value, not just a bound.
+     */
+    template<typename T>
+    class DOPSupport<T,8>
+    {
+    public:
+
+      template<typename V>
+      static T upper(geometry::DOP<T,8> const & dop, V const & n)
+      {
+        using std::min;
+        using std::sqrt;
+
+        typedef tiny::ValueTraits<T> VT;
+
+        T const w[4] = { VT::one(), -VT::one(), -VT::one(), VT::one() };
+
+        // Frame coefficients, 3/4 (d_i . n), with d_i = (1, +-1, +-1)/sqrt(3)
+        T const s = VT::numeric_cast(0.75) / sqrt( VT::numeric_cast(3.0) );
+
+        T const c[4] = {
+          s*(  n(0) + n(1) + n(2) )
+          , s*(  n(0) + n(1) - n(2) )
+          , s*(  n(0) - n(1) + n(2) )
+          , s*(  n(0) - n(1) - n(2) )
+        };
+
+        T value = VT::highest();
+
+        for(size_t m = 0u; m < 4u; ++m)
+        {
+          T const lambda = - c[m] / w[m];
+
+          T bound = VT::zero();
+
+          for(size_t i = 0u; i < 4u; ++i)
+          {
+            T const c_i = (i == m) ? VT::zero() : c[i] + lambda*w[i];
+
+            bound += c_i > VT::zero() ? c_i*dop(i).upper() : c_i*dop(i).lower();
+          }
+
+          value = min( value, bound );
+        }
+
+        return value;
+      }
+    };
+
+  } // namespace details
+
+  /**
+   * Identity Transform.
+   * Used by the traversals when both trees are fitted in the same
+   * coordinate frame. Everything is passed through untouched.
+   */
+  template<typename V, size_t K>
+  class IdentityTransform
+  {
+  public:
+
+    typedef typename V::real_type  T;
+
+    geometry::DOP<T,K> const & transform_dop(geometry::DOP<T,K> const & dop) const { return dop; }
+
+    V const & transform_point(V const & p) const { return p; }
+
+  };
+
+  /**
+   * Rigid Transform.
+   * Brings kDOPs and points from the frame of one tree (B) into the frame of
+   * another tree (A). The kDOP slab directions of frame A are expressed in
+   * frame B once, such that a kDOP of B can be re-bounded in frame A using
+   * a few inner products. The re-bounded kDOP is the tightest kDOP in frame
+   * A that contains the (exact) kDOP of B.
+   */
+  template<typename V, size_t K>
+  class RigidTransform
+  {
+  public:
+
+    typedef typename V::real_type                          T;
+    typedef typename tiny::MathTypes<T>::coordsys_type     C;
+
+  protected:
+
+    C m_X;                   ///< The transform from frame B into frame A.
+    V m_directions[K/2];     ///< The slab directions of frame A expressed in frame B.
+    T m_offsets[K/2];        ///< The slab directions of frame A dotted with the origin of frame B.
+
+  public:
+
+    RigidTransform()
+    : m_X()
+    {}
+
+    RigidTransform(C const & X)
+    : m_X(X)
+    {
+      geometry::DirectionTable<V,(K/2)> const DT = geometry::DirectionTableHelper<V,(K/2)>::make();
+
+      for(size_t k = 0u; k < (K/2); ++k)
+      {
+        this->m_directions[k] = tiny::rotate( tiny::conj( X.Q() ), DT(k) );
+        this->m_offsets[k]    = tiny::inner_prod( DT(k), X.T() );
+      }
+    }
+
+  public:
+
+    geometry::DOP<T,K> transform_dop(geometry::DOP<T,K> const & dop) const
+    {
+      geometry::DOP<T,K> result;
+
+      for(size_t k = 0u; k < (K/2); ++k)
+      {
+        result(k).upper() = this->m_offsets[k] + details::DOPSupport<T,K>::upper( dop,  this->m_directions[k] );
+        result(k).lower() = this->m_offsets[k] - details::DOPSupport<T,K>::upper( dop, -this->m_directions[k] );
+      }
+
+      return result;
+    }
+
+    V transform_point(V const & p) const
+    {
+      return tiny::xform_point( this->m_X, p );
+    }
+
+  };
+
+  /**
+   * Transformed Contacts Callback.
+   * Traversals done in the body frame of an object report contact points in
+   * that frame. This callback brings the contact points and normals into
+   * the world frame before handing them over to the actual callback.
+   */
+  template<typename V>
+  class TransformedContactsCallback
+  : public geometry::ContactsCallback<V>
+  {
+  public:
+
+    typedef typename V::real_type                          T;
+    typedef typename tiny::MathTypes<T>::coordsys_type     C;
+
+  protected:
+
+    C                               m_X;         ///< Body frame to world frame transform.
+    geometry::ContactsCallback<V> * m_callback;  ///< The callback receiving world frame contacts.
+
+  public:
+
+    TransformedContactsCallback(C const & X, geometry::ContactsCallback<V> & callback)
+    : m_X(X)
+    , m_callback(&callback)
+    {}
+
+    void operator()( V const & point, V const & normal, T const & distance )
+    {
+      (*this->m_callback)( tiny::xform_point( this->m_X, point ), tiny::xform_vector( this->m_X, normal ), distance );
+    }
+
+    void set_features( size_t const & feature_a, size_t const & feature_b )
+    {
+      this->m_callback->set_features( feature_a, feature_b );
+    }
+
+  };
+
+}// namespace kdop
+
+// KDOP_TRANSFORM_H
+#endif
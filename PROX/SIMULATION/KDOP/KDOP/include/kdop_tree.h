@@ -3,14 +3,29 @@
 
 #include <types/geometry_dop.h>
 
+#include <tiny_aligned_16.h>
+
 #include <vector>
 #include <cassert>
 
 namespace kdop
 {
 
-  inline size_t UNDEFINED() { return 0xFFFF; }
-
+  /**
+   * Node indices are stored as 32 bit values to keep nodes small, the
+   * largest value is reserved for marking unused nodes.
+   */
+  typedef unsigned int index_type;
+
+  inline index_type UNDEFINED() { return 0xFFFFFFFFu; }
+
+  /**
+   * A kDOP tree node.
+   * The kDOP comes first and is 16 byte aligned such that the slabs can
+   * be loaded directly into SIMD registers. Parent indices are not
+   * stored, all traversals and refits are top down or bottom up sweeps
+   * over the node array.
+   */
   template<typename T, size_t K>
   class Node
   {
@@ -20,16 +35,14 @@ namespace kdop
 
   public:
 
-    volume_type m_volume;
-    size_t      m_parent;   // Index of parent node, undefined for root node
-    size_t      m_start;    // Index of first child node
-    size_t      m_end;      // Index of last child node, if node is a leaf then start==end and start has the index value of the geometry entity (tetrahedron) covered by the node.
+    ALIGNED_16 volume_type m_volume;
+    index_type             m_start;    // Index of first child node
+    index_type             m_end;      // Index of last child node, if node is a leaf then start==end and start has the index value of the geometry entity (tetrahedron) covered by the node.
 
   public:
 
     Node()
     : m_volume()
-    , m_parent( UNDEFINED() )
     , m_start( UNDEFINED() )
     , m_end( UNDEFINED() )
     {}
@@ -46,7 +59,6 @@ namespace kdop
       if( this != &node)
       {
         this->m_volume = node.m_volume;
-        this->m_parent = node.m_parent;
         this->m_start  = node.m_start;
         this->m_end    = node.m_end;
       }
@@ -54,21 +66,15 @@ namespace kdop
     }
   public:
 
-    bool is_root() const
-    {
-      return m_parent == UNDEFINED() && m_start!=UNDEFINED() && m_end!=UNDEFINED();
-    }
-
     bool is_leaf() const
     {
-      //return m_parent != UNDEFINED() && m_start==m_end;
       return m_start==m_end;
     }
 
     bool is_undefined() const
     {
-      // If all indices are undefined then this node is neither a root, a leaf or an internal node of a tree.
-      return m_parent == UNDEFINED() && m_start==UNDEFINED() && m_end==UNDEFINED();
+      // If the indices are undefined then this node is neither a root, a leaf or an internal node of a tree.
+      return m_start==UNDEFINED() && m_end==UNDEFINED();
     }
 
 
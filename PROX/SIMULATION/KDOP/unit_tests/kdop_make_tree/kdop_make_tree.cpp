@@ -47,4 +47,29 @@ BOOST_AUTO_TEST_CASE(kdop_make_tree)
   kdop::Tree<T,8> tree = kdop::make_tree<V,8,T>( 8000, mesh_out, X_out, Y_out, Z_out, kdop::sequential() );
 }
 
+BOOST_AUTO_TEST_CASE(kdop_node_layout)
+{
+  typedef kdop::Node<float,8> node_type;
+
+  // An 8-DOP of floats and two 32 bit indices, padded to 16 bytes
+  BOOST_CHECK_EQUAL( sizeof(node_type), 48u );
+  BOOST_CHECK_EQUAL( sizeof(node_type::volume_type), 8u*sizeof(float) );
+
+  std::vector<node_type> nodes(3);
+
+  for(size_t n = 0u; n < nodes.size(); ++n)
+    BOOST_CHECK_EQUAL( reinterpret_cast<size_t>( &(nodes[n].m_volume) ) % 16u, 0u );
+
+  // Indices beyond 16 bits are valid indices and not the sentinel
+  node_type leaf;
+
+  BOOST_CHECK( leaf.is_undefined() );
+
+  leaf.m_start = 0xFFFFu;
+  leaf.m_end   = 0xFFFFu;
+
+  BOOST_CHECK( !leaf.is_undefined() );
+  BOOST_CHECK( leaf.is_leaf() );
+}
+
 BOOST_AUTO_TEST_SUITE_END();
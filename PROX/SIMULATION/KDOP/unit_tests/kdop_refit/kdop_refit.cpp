@@ -12,6 +12,39 @@
 
 #include <vector>
 
+template<typename T, size_t K>
+void check_equal_trees(kdop::Tree<T,K> const & A, kdop::Tree<T,K> const & B)
+{
+  BOOST_CHECK_EQUAL( A.number_of_levels(), B.number_of_levels() );
+
+  for(size_t k = 0u; k < K/2; ++k)
+  {
+    BOOST_CHECK_EQUAL( A.m_root(k).lower(), B.m_root(k).lower() );
+    BOOST_CHECK_EQUAL( A.m_root(k).upper(), B.m_root(k).upper() );
+  }
+
+  for(size_t h = 0u; h < A.number_of_levels(); ++h)
+  {
+    BOOST_CHECK_EQUAL( A.super_chunks(h).size(), B.super_chunks(h).size() );
+
+    for(size_t c = 0u; c < A.super_chunks(h).size(); ++c)
+    {
+      kdop::SubTree<T,K> const & a = A.super_chunks(h)[c];
+      kdop::SubTree<T,K> const & b = B.super_chunks(h)[c];
+
+      BOOST_CHECK_EQUAL( a.m_nodes.size(), b.m_nodes.size() );
+
+      for(size_t n = 0u; n < a.m_nodes.size(); ++n)
+      {
+        for(size_t k = 0u; k < K/2; ++k)
+        {
+          BOOST_CHECK_EQUAL( a.m_nodes[n].m_volume(k).lower(), b.m_nodes[n].m_volume(k).lower() );
+          BOOST_CHECK_EQUAL( a.m_nodes[n].m_volume(k).upper(), b.m_nodes[n].m_volume(k).upper() );
+        }
+      }
+    }
+  }
+}
 
 BOOST_AUTO_TEST_SUITE(kdop);
 
@@ -48,4 +81,59 @@ BOOST_AUTO_TEST_CASE(kdop_refit)
   kdop::refit_tree<V,8,T>(tree, mesh_out, X_out, Y_out, Z_out, kdop::sequential() );
 }
 
+BOOST_AUTO_TEST_CASE(kdop_parallel_refit)
+{
+  typedef tiny::MathTypes<float> MT;
+  typedef MT::vector3_type       V;
+  typedef MT::real_type          T;
+
+  mesh_array::T3Mesh surface;
+  mesh_array::VertexAttribute<T,mesh_array::T3Mesh> sX;
+  mesh_array::VertexAttribute<T,mesh_array::T3Mesh> sY;
+  mesh_array::VertexAttribute<T,mesh_array::T3Mesh> sZ;
+  mesh_array::make_box<MT>( 1.0f, 1.0f, 2.0f, surface, sX, sY, sZ);
+
+  mesh_array::T4Mesh mesh_in;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> X_in;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> Y_in;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> Z_in;
+  mesh_array::TetGenSettings settings = mesh_array::tetgen_quality_settings();
+  settings.m_maximum_volume = 0.01;
+  mesh_array::tetgen(surface, sX, sY, sZ, mesh_in, X_in, Y_in, Z_in, settings );
+
+  mesh_array::T4Mesh mesh;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> X;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> Y;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> Z;
+  kdop::mesh_reorder( mesh_in, X_in, Y_in, Z_in, mesh, X, Y, Z );
+
+  // Little memory gives small chunks and several chunk levels
+  kdop::Tree<T,8> sequential_tree = kdop::make_tree<V,8,T>( 1024, mesh, X, Y, Z, kdop::sequential() );
+  kdop::Tree<T,8> parallel_tree   = sequential_tree;
+  kdop::Tree<T,8> dirty_tree      = sequential_tree;
+
+  BOOST_CHECK( sequential_tree.number_of_levels() > 1u );
+
+  //--- Bend the upper half of the box, the lower half stays in place ------
+  mesh_array::VertexAttribute<bool,mesh_array::T4Mesh> dirty;
+  dirty.bind(mesh);
+
+  for(size_t n = 0u; n < mesh.vertex_size(); ++n)
+  {
+    mesh_array::Vertex const & v = mesh.vertex(n);
+
+    dirty(v) = Z(v) > 0.0f;
+
+    if( dirty(v) )
+      X(v) += 0.5f * Z(v) * Z(v);
+  }
+
+  kdop::refit_tree<V,8,T>(sequential_tree, mesh, X, Y, Z, kdop::sequential() );
+  kdop::refit_tree<V,8,T>(parallel_tree, mesh, X, Y, Z, kdop::parallel() );
+  kdop::refit_tree<V,8,T>(dirty_tree, mesh, X, Y, Z, dirty, kdop::parallel() );
+
+  check_equal_trees( sequential_tree, parallel_tree );
+  check_equal_trees( sequential_tree, dirty_tree );
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -1,4 +1,5 @@
 #include <kdop_tandem_traversal.h>
+#include <kdop_transform.h>
 #include <kdop_refit_tree.h>
 #include <kdop_mesh_reorder.h>
 #include <kdop_make_tree.h>
@@ -7,6 +8,9 @@
 #include <mesh_array.h>
 #include <tiny.h>
 
+#include <algorithm>
+#include <vector>
+
 #define BOOST_AUTO_TEST_MAIN
 #include <boost/test/auto_unit_test.hpp>
 #include <boost/test/unit_test_suite.hpp>
@@ -41,6 +45,90 @@ public:
   }
 };
 
+class RecordCallback : public geometry::ContactsCallback<V>
+{
+public:
+
+  std::vector<V> m_points;
+  std::vector<V> m_normals;
+
+  void operator()( V const & p, V const & n, V::real_type const & d )
+  {
+    m_points.push_back(p);
+    m_normals.push_back(n);
+  }
+};
+
+/**
+ * Records contacts together with the features that generated them.
+ */
+class FeatureCallback : public geometry::ContactsCallback<V>
+{
+public:
+
+  std::vector<size_t> m_features_a;
+  std::vector<size_t> m_features_b;
+  std::vector<V>      m_points;
+
+  size_t m_current_a;
+  size_t m_current_b;
+
+  FeatureCallback()
+  : m_current_a(0u)
+  , m_current_b(0u)
+  {}
+
+  void operator()( V const & p, V const & n, V::real_type const & d )
+  {
+    m_features_a.push_back(m_current_a);
+    m_features_b.push_back(m_current_b);
+    m_points.push_back(p);
+  }
+
+  void set_features( size_t const & feature_a, size_t const & feature_b )
+  {
+    m_current_a = feature_a;
+    m_current_b = feature_b;
+  }
+
+  /**
+   * Contact order sorted by features, contacts of the same feature pair
+   * keep the order they were reported in.
+   */
+  std::vector<size_t> sorted_order() const
+  {
+    std::vector<size_t> order( m_points.size() );
+
+    for(size_t i = 0u; i < order.size(); ++i)
+      order[i] = i;
+
+    std::stable_sort( order.begin(), order.end(), FeatureLess( *this ) );
+
+    return order;
+  }
+
+protected:
+
+  class FeatureLess
+  {
+  public:
+
+    FeatureCallback const & m_callback;
+
+    FeatureLess(FeatureCallback const & callback)
+    : m_callback(callback)
+    {}
+
+    bool operator()(size_t const & i, size_t const & j) const
+    {
+      if( m_callback.m_features_a[i] != m_callback.m_features_a[j] )
+        return m_callback.m_features_a[i] < m_callback.m_features_a[j];
+      return m_callback.m_features_b[i] < m_callback.m_features_b[j];
+    }
+  };
+
+};
+
 /**
  * Creates a test mesh which is basically a tetrahedron and its x-y plane mirrored counter part.
  *
@@ -161,4 +249,343 @@ BOOST_AUTO_TEST_CASE(kdop_tandem_traversal)
                                 );
 }
 
+BOOST_AUTO_TEST_CASE(kdop_rigid_transform_dop)
+{
+  geometry::DirectionTable<V,4> const DT = geometry::DirectionTableHelper<V,4>::make();
+
+  std::vector<V> points;
+  points.push_back( V::make(  0.1f,  0.2f, -0.3f ) );
+  points.push_back( V::make(  1.0f, -0.5f,  0.7f ) );
+  points.push_back( V::make( -0.4f,  0.9f,  0.2f ) );
+  points.push_back( V::make(  0.3f,  0.1f,  1.2f ) );
+
+  geometry::DOP<T,8> const dop = geometry::make_dop( points.begin(), points.end(), DT );
+
+  // The identity transform must reproduce the kDOP exactly
+  MT::coordsys_type const I;
+
+  kdop::RigidTransform<V,8> const identity( I );
+
+  geometry::DOP<T,8> const same = identity.transform_dop( dop );
+
+  for(size_t k = 0u; k < 4u; ++k)
+  {
+    BOOST_CHECK_CLOSE( same(k).lower(), dop(k).lower(), 0.01f );
+    BOOST_CHECK_CLOSE( same(k).upper(), dop(k).upper(), 0.01f );
+  }
+
+  // Any rigid transform must give a kDOP containing the transformed points
+  MT::quaternion_type const Q = MT::quaternion_type::Ru( 0.7f, unit( V::make( 1.0f, 2.0f, 3.0f ) ) );
+
+  MT::coordsys_type const X( V::make( 0.5f, -1.0f, 2.0f ), Q );
+
+  kdop::RigidTransform<V,8> const transform( X );
+
+  geometry::DOP<T,8> const moved = transform.transform_dop( dop );
+
+  for(size_t i = 0u; i < points.size(); ++i)
+  {
+    V const p = transform.transform_point( points[i] );
+
+    for(size_t k = 0u; k < 4u; ++k)
+    {
+      T const projection = inner_prod( DT(k), p );
+
+      BOOST_CHECK( projection >= moved(k).lower() - 1e-5f );
+      BOOST_CHECK( projection <= moved(k).upper() + 1e-5f );
+    }
+  }
+}
+
+/**
+ * Place two instances of the same mesh in the world and traverse their body
+ * frame trees. The body frames are given by XA and XB.
+ */
+void body_frame_tandem_traversal(
+                                 GeometryInfo const & info
+                                 , kdop::Tree<T,8> const & body_tree
+                                 , MT::coordsys_type const & XA
+                                 , MT::coordsys_type const & XB
+                                 , RecordCallback & callback
+                                 )
+{
+  std::vector<kdop::TestPair<V, 8, T> > test_pairs;
+
+  test_pairs.push_back( kdop::TestPair<V, 8, T>(
+                                                body_tree, body_tree
+                                                , info.m_mesh, info.m_mesh
+                                                , info.m_X, info.m_X
+                                                , info.m_Y, info.m_Y
+                                                , info.m_Z, info.m_Z
+                                                , info.m_surface_map, info.m_surface_map
+                                                , callback
+                                                , XA
+                                                , XB
+                                                )
+                       );
+
+  kdop::tandem_traversal<V,8,T>( test_pairs, kdop::sequential() );
+}
+
+BOOST_AUTO_TEST_CASE(kdop_body_frame_tandem_traversal)
+{
+  GeometryInfo info;
+  make_geometry(info);
+
+  mesh_array::T4Mesh const & mesh = info.m_mesh;
+
+  kdop::Tree<T,8> const body_tree = kdop::make_tree<V,8,T>( 32000, mesh, info.m_X, info.m_Y, info.m_Z, kdop::sequential() );
+
+  // Placement of B in the body frame of A
+  MT::quaternion_type const Q  = MT::quaternion_type::Ru( 0.3f, unit( V::make( 1.0f, 0.0f, 1.0f ) ) );
+  MT::coordsys_type   const BtoA( V::make( 1.6f, 0.1f, -0.1f ), Q );
+
+  // Reference solution, the coordinates of B are moved into the body frame
+  // of A and the tree of B is refitted.
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> X_B;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> Y_B;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> Z_B;
+
+  X_B.bind(mesh);
+  Y_B.bind(mesh);
+  Z_B.bind(mesh);
+
+  for(size_t n = 0u; n < mesh.vertex_size(); ++n)
+  {
+    mesh_array::Vertex const & v = mesh.vertex(n);
+
+    V const p = tiny::xform_point( BtoA, V::make( info.m_X(v), info.m_Y(v), info.m_Z(v) ) );
+
+    X_B(v) = p(0);
+    Y_B(v) = p(1);
+    Z_B(v) = p(2);
+  }
+
+  kdop::Tree<T,8> tree_B = body_tree;
+  kdop::refit_tree<V,8,T>( tree_B, mesh, X_B, Y_B, Z_B, kdop::sequential() );
+
+  // The meshes overlap without any vertices inside the other mesh,
+  // triangle intersections are used to be sure contacts are generated.
+  kdop::SelectContactPointAlgorithm::set_algorithm( "intersection" );
+
+  RecordCallback reference;
+
+  std::vector<kdop::TestPair<V, 8, T> > test_pairs;
+
+  test_pairs.push_back( kdop::TestPair<V, 8, T>(
+                                                body_tree, tree_B
+                                                , mesh, mesh
+                                                , info.m_X, X_B
+                                                , info.m_Y, Y_B
+                                                , info.m_Z, Z_B
+                                                , info.m_surface_map, info.m_surface_map
+                                                , reference
+                                                )
+                       );
+
+  kdop::tandem_traversal<V,8,T>( test_pairs, kdop::sequential() );
+
+  // Body frame traversal with A placed at the origin
+  RecordCallback local;
+
+  body_frame_tandem_traversal( info, body_tree, MT::coordsys_type(), BtoA, local );
+
+  // Body frame traversal with both bodies moved by some rigid motion G
+  MT::coordsys_type const G( V::make( 3.0f, -2.0f, 1.0f ), MT::quaternion_type::Ru( 1.3f, unit( V::make( 1.0f, 2.0f, 3.0f ) ) ) );
+
+  RecordCallback moved;
+
+  body_frame_tandem_traversal( info, body_tree, G, tiny::prod( G, BtoA ), moved );
+
+  kdop::SelectContactPointAlgorithm::set_algorithm( "opposing" );
+
+  BOOST_CHECK( reference.m_points.size() > 0u );
+  BOOST_CHECK_EQUAL( reference.m_points.size(), local.m_points.size() );
+  BOOST_CHECK_EQUAL( reference.m_points.size(), moved.m_points.size() );
+
+  for(size_t i = 0u; i < reference.m_points.size() && i < local.m_points.size() && i < moved.m_points.size(); ++i)
+  {
+    BOOST_CHECK( norm( reference.m_points[i]  - local.m_points[i]  ) < 1e-4f );
+    BOOST_CHECK( norm( reference.m_normals[i] - local.m_normals[i] ) < 1e-4f );
+
+    BOOST_CHECK( norm( tiny::xform_point( G, reference.m_points[i] )   - moved.m_points[i]  ) < 1e-4f );
+    BOOST_CHECK( norm( tiny::xform_vector( G, reference.m_normals[i] ) - moved.m_normals[i] ) < 1e-4f );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(kdop_parallel_tandem_traversal)
+{
+  GeometryInfo info;
+  make_geometry(info);
+
+  mesh_array::T4Mesh const & mesh = info.m_mesh;
+
+  kdop::Tree<T,8> const body_tree = kdop::make_tree<V,8,T>( 32000, mesh, info.m_X, info.m_Y, info.m_Z, kdop::sequential() );
+
+  MT::quaternion_type const Q  = MT::quaternion_type::Ru( 0.3f, unit( V::make( 1.0f, 0.0f, 1.0f ) ) );
+  MT::coordsys_type   const BtoA( V::make( 1.6f, 0.1f, -0.1f ), Q );
+  MT::coordsys_type   const G( V::make( 3.0f, -2.0f, 1.0f ), MT::quaternion_type::Ru( 1.3f, unit( V::make( 1.0f, 2.0f, 3.0f ) ) ) );
+
+  kdop::SelectContactPointAlgorithm::set_algorithm( "intersection" );
+
+  // The same work pool of a world frame test pair and a body frame test
+  // pair is traversed sequentially and in parallel, both must report the
+  // same contacts in the same order.
+  RecordCallback sequential_world;
+  RecordCallback sequential_body;
+  RecordCallback parallel_world;
+  RecordCallback parallel_body;
+
+  RecordCallback * world_callbacks[2] = { &sequential_world, &parallel_world };
+  RecordCallback * body_callbacks[2]  = { &sequential_body,  &parallel_body  };
+
+  for(size_t run = 0u; run < 2u; ++run)
+  {
+    std::vector<kdop::TestPair<V, 8, T> > test_pairs;
+
+    test_pairs.push_back( kdop::TestPair<V, 8, T>(
+                                                  body_tree, body_tree
+                                                  , mesh, mesh
+                                                  , info.m_X, info.m_X
+                                                  , info.m_Y, info.m_Y
+                                                  , info.m_Z, info.m_Z
+                                                  , info.m_surface_map, info.m_surface_map
+                                                  , *world_callbacks[run]
+                                                  )
+                         );
+
+    test_pairs.push_back( kdop::TestPair<V, 8, T>(
+                                                  body_tree, body_tree
+                                                  , mesh, mesh
+                                                  , info.m_X, info.m_X
+                                                  , info.m_Y, info.m_Y
+                                                  , info.m_Z, info.m_Z
+                                                  , info.m_surface_map, info.m_surface_map
+                                                  , *body_callbacks[run]
+                                                  , G
+                                                  , tiny::prod( G, BtoA )
+                                                  )
+                         );
+
+    if( run == 0u )
+      kdop::tandem_traversal<V,8,T>( test_pairs, kdop::sequential() );
+    else
+      kdop::tandem_traversal<V,8,T>( test_pairs, kdop::parallel() );
+  }
+
+  kdop::SelectContactPointAlgorithm::set_algorithm( "opposing" );
+
+  BOOST_CHECK( sequential_world.m_points.size() > 0u );
+  BOOST_CHECK( sequential_body.m_points.size() > 0u );
+  BOOST_CHECK_EQUAL( sequential_world.m_points.size(), parallel_world.m_points.size() );
+  BOOST_CHECK_EQUAL( sequential_body.m_points.size(), parallel_body.m_points.size() );
+
+  for(size_t i = 0u; i < sequential_world.m_points.size() && i < parallel_world.m_points.size(); ++i)
+  {
+    BOOST_CHECK( norm( sequential_world.m_points[i]  - parallel_world.m_points[i]  ) < 1e-6f );
+    BOOST_CHECK( norm( sequential_world.m_normals[i] - parallel_world.m_normals[i] ) < 1e-6f );
+  }
+
+  for(size_t i = 0u; i < sequential_body.m_points.size() && i < parallel_body.m_points.size(); ++i)
+  {
+    BOOST_CHECK( norm( sequential_body.m_points[i]  - parallel_body.m_points[i]  ) < 1e-6f );
+    BOOST_CHECK( norm( sequential_body.m_normals[i] - parallel_body.m_normals[i] ) < 1e-6f );
+  }
+}
+
+BOOST_AUTO_TEST_CASE(kdop_batched_exact_tests)
+{
+  GeometryInfo info;
+  make_geometry(info);
+
+  mesh_array::T4Mesh const & mesh = info.m_mesh;
+
+  kdop::Tree<T,8> const tree = kdop::make_tree<V,8,T>( 32000, mesh, info.m_X, info.m_Y, info.m_Z, kdop::sequential() );
+
+  char const * algorithms[3] = { "intersection", "sat", "opposing" };
+
+  // The batched traversal must find the same contacts as testing all
+  // pairs of tetrahedra with surface faces one by one
+  for(size_t a = 0u; a < 3u; ++a)
+  {
+    kdop::SelectContactPointAlgorithm::set_algorithm( algorithms[a] );
+
+    FeatureCallback traversed;
+    FeatureCallback all_pairs;
+
+    std::vector<kdop::TestPair<V, 8, T> > test_pairs;
+
+    test_pairs.push_back( kdop::TestPair<V, 8, T>(
+                                                  tree, tree
+                                                  , mesh, mesh
+                                                  , info.m_X, info.m_X
+                                                  , info.m_Y, info.m_Y
+                                                  , info.m_Z, info.m_Z
+                                                  , info.m_surface_map, info.m_surface_map
+                                                  , traversed
+                                                  )
+                         );
+
+    kdop::tandem_traversal<V,8,T>( test_pairs, kdop::sequential() );
+
+    for(size_t i = 0u; i < mesh.tetrahedron_size(); ++i)
+    {
+      for(size_t j = 0u; j < mesh.tetrahedron_size(); ++j)
+      {
+        mesh_array::Tetrahedron const & tet_A = mesh.tetrahedron(i);
+        mesh_array::Tetrahedron const & tet_B = mesh.tetrahedron(j);
+
+        mesh_array::TetrahedronSurfaceInfo const & info_A = info.m_surface_map(tet_A);
+        mesh_array::TetrahedronSurfaceInfo const & info_B = info.m_surface_map(tet_B);
+
+        std::vector<bool> surface_A(4u, false);
+        std::vector<bool> surface_B(4u, false);
+
+        surface_A[0] = info_A.m_i;  surface_A[1] = info_A.m_j;  surface_A[2] = info_A.m_k;  surface_A[3] = info_A.m_m;
+        surface_B[0] = info_B.m_i;  surface_B[1] = info_B.m_j;  surface_B[2] = info_B.m_k;  surface_B[3] = info_B.m_m;
+
+        if( !(surface_A[0] || surface_A[1] || surface_A[2] || surface_A[3]) )
+          continue;
+        if( !(surface_B[0] || surface_B[1] || surface_B[2] || surface_B[3]) )
+          continue;
+
+        geometry::Tetrahedron<V> const A = geometry::make_tetrahedron(
+                                                                      V::make( info.m_X(tet_A.i()), info.m_Y(tet_A.i()), info.m_Z(tet_A.i()) )
+                                                                      , V::make( info.m_X(tet_A.j()), info.m_Y(tet_A.j()), info.m_Z(tet_A.j()) )
+                                                                      , V::make( info.m_X(tet_A.k()), info.m_Y(tet_A.k()), info.m_Z(tet_A.k()) )
+                                                                      , V::make( info.m_X(tet_A.m()), info.m_Y(tet_A.m()), info.m_Z(tet_A.m()) )
+                                                                      );
+        geometry::Tetrahedron<V> const B = geometry::make_tetrahedron(
+                                                                      V::make( info.m_X(tet_B.i()), info.m_Y(tet_B.i()), info.m_Z(tet_B.i()) )
+                                                                      , V::make( info.m_X(tet_B.j()), info.m_Y(tet_B.j()), info.m_Z(tet_B.j()) )
+                                                                      , V::make( info.m_X(tet_B.k()), info.m_Y(tet_B.k()), info.m_Z(tet_B.k()) )
+                                                                      , V::make( info.m_X(tet_B.m()), info.m_Y(tet_B.m()), info.m_Z(tet_B.m()) )
+                                                                      );
+
+        all_pairs.set_features( tet_A.idx(), tet_B.idx() );
+
+        kdop::SelectContactPointAlgorithm::call_algorithm( A, B, all_pairs, surface_A, surface_B );
+      }
+    }
+
+    BOOST_CHECK( traversed.m_points.size() > 0u );
+    BOOST_CHECK_EQUAL( traversed.m_points.size(), all_pairs.m_points.size() );
+
+    std::vector<size_t> const order_traversed = traversed.sorted_order();
+    std::vector<size_t> const order_all_pairs = all_pairs.sorted_order();
+
+    for(size_t c = 0u; c < order_traversed.size() && c < order_all_pairs.size(); ++c)
+    {
+      size_t const t = order_traversed[c];
+      size_t const p = order_all_pairs[c];
+
+      BOOST_CHECK_EQUAL( traversed.m_features_a[t], all_pairs.m_features_a[p] );
+      BOOST_CHECK_EQUAL( traversed.m_features_b[t], all_pairs.m_features_b[p] );
+      BOOST_CHECK( norm( traversed.m_points[t] - all_pairs.m_points[p] ) < 1e-6f );
+    }
+  }
+
+  kdop::SelectContactPointAlgorithm::set_algorithm( "opposing" );
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -53,6 +53,8 @@ namespace narrow
       {
         for( box_iterator b = B.begin(); b!=B.end(); ++b )
         {
+          callback.set_features( box_feature( a - A.begin() ), box_feature( b - B.begin() ) );
+
           C shapeAtobodyA = C(a->transform().T(), a->transform().Q());
           C shapeBtobodyB = C(b->transform().T(), b->transform().Q());
           C shapeAtoWCS = tiny::prod(shapeAtobodyA, bodyAtoWCS);
@@ -2,6 +2,7 @@
 #define NARROW_DISPATCH_COLLISION_HANDLER_H
 
 #include <narrow_test_pair.h>
+#include <narrow_tags.h>
 #include <narrow_box_box.h>
 #include <narrow_box_sphere.h>
 #include <narrow_sphere_box.h>
@@ -17,142 +18,156 @@ namespace narrow
 
   namespace details
   {
+    template< typename M>
+    inline void dispatch_primitives( System<M> const & system, TestPair<M> & pair )
+    {
+      typedef typename Geometry<M>::box_container          box_container;
+      typedef typename Geometry<M>::sphere_container       sphere_container;
+      //typedef typename Geometry<M>::convex_container       convex_container;
+
+      Geometry<M> const & geoA = system.get_geometry( pair.obj_a().get_geometry_idx() );
+      Geometry<M> const & geoB = system.get_geometry( pair.obj_b().get_geometry_idx() );
+
+      box_container      const & boxesA     = geoA.m_boxes;
+      sphere_container   const & spheresA   = geoA.m_spheres;
+      //convex_container   const & hullsA     = geoA.m_hulls;
+
+      box_container      const & boxesB     = geoB.m_boxes;
+      sphere_container   const & spheresB   = geoB.m_spheres;
+      //convex_container   const & hullsB     = geoB.m_hulls;
+
+      detail::box_box<M>(
+                         boxesA
+                         , boxesB
+                         , pair.t_a()
+                         , pair.Q_a()
+                         , pair.t_b()
+                         , pair.Q_b()
+                         , system.params().get_envelope()
+                         , pair.callback()
+                         );
+
+      detail::box_sphere<M>(
+                            boxesA
+                            , spheresB
+                            , pair.t_a()
+                            , pair.Q_a()
+                            , pair.t_b()
+                            , pair.Q_b()
+                            , system.params().get_envelope()
+                            , pair.callback()
+                            );
+
+      detail::sphere_box<M>(
+                            spheresA
+                            , boxesB
+                            , pair.t_a()
+                            , pair.Q_a()
+                            , pair.t_b()
+                            , pair.Q_b()
+                            , system.params().get_envelope()
+                            , pair.callback()
+                            );
+
+      detail::sphere_sphere<M>(
+                               spheresA
+                               , spheresB
+                               , pair.t_a()
+                               , pair.Q_a()
+                               , pair.t_b()
+                               , pair.Q_b()
+                               , system.params().get_envelope()
+                               , pair.callback()
+                               );
+/*
+      detail::convex_convex<M>(
+                         hullsA
+                         , hullsB
+                         , pair.t_a()
+                         , pair.Q_a()
+                         , pair.t_b()
+                         , pair.Q_b()
+                         , system.params().get_envelope()
+                         , pair.callback()
+                         );
+ */
+    }
+
     template< typename M>
     inline void dispatch_primitives( System<M> const & system, std::vector<TestPair<M> > & test_pairs )
     {
       assert( ! test_pairs.empty() || !"dispatch_primitives : test_pairs are empty" );
       
       typedef typename std::vector<TestPair<M> >::iterator pair_iterator;
-      typedef typename Geometry<M>::box_container          box_container;
-      typedef typename Geometry<M>::sphere_container       sphere_container;
-      //typedef typename Geometry<M>::convex_container       convex_container;
 
       pair_iterator current = test_pairs.begin();
       pair_iterator end     = test_pairs.end();
 
       for(;current!=end;++current)
       {
-        Geometry<M> const & geoA = system.get_geometry( current->obj_a().get_geometry_idx() );
-        Geometry<M> const & geoB = system.get_geometry( current->obj_b().get_geometry_idx() );
-
-        box_container      const & boxesA     = geoA.m_boxes;
-        sphere_container   const & spheresA   = geoA.m_spheres;
-        //convex_container   const & hullsA     = geoA.m_hulls;
-
-        box_container      const & boxesB     = geoB.m_boxes;
-        sphere_container   const & spheresB   = geoB.m_spheres;
-        //convex_container   const & hullsB     = geoB.m_hulls;
-
-        detail::box_box<M>(
-                           boxesA
-                           , boxesB
-                           , current->t_a()
-                           , current->Q_a()
-                           , current->t_b()
-                           , current->Q_b()
-                           , system.params().get_envelope()
-                           , current->callback()
-                           );
-
-        detail::box_sphere<M>(
-                              boxesA
-                              , spheresB
-                              , current->t_a()
-                              , current->Q_a()
-                              , current->t_b()
-                              , current->Q_b()
-                              , system.params().get_envelope()
-                              , current->callback()
-                              );
-
-        detail::sphere_box<M>(
-                              spheresA
-                              , boxesB
-                              , current->t_a()
-                              , current->Q_a()
-                              , current->t_b()
-                              , current->Q_b()
-                              , system.params().get_envelope()
-                              , current->callback()
-                              );
-
-        detail::sphere_sphere<M>(
-                                 spheresA
-                                 , spheresB
-                                 , current->t_a()
-                                 , current->Q_a()
-                                 , current->t_b()
-                                 , current->Q_b()
-                                 , system.params().get_envelope()
-                                 , current->callback()
-                                 );
-/*
-        detail::convex_convex<M>(
-                           hullsA
-                           , hullsB
-                           , current->t_a()
-                           , current->Q_a()
-                           , current->t_b()
-                           , current->Q_b()
-                           , system.params().get_envelope()
-                           , current->callback()
-                           );
- */
+        dispatch_primitives( system, *current );
+      }
+    }
+
+
+    template< typename M>
+    inline void dispatch_mixed( System<M> const & system, TestPair<M> & pair )
+    {
+      typedef typename Geometry<M>::sphere_container       sphere_container;
+
+      Geometry<M> const & geoA = system.get_geometry( pair.obj_a().get_geometry_idx() );
+      Geometry<M> const & geoB = system.get_geometry( pair.obj_b().get_geometry_idx() );
 
+      //box_container      const & boxesA     = geoA.m_boxes;
+      sphere_container   const & spheresA   = geoA.m_spheres;
 
+      //box_container      const & boxesB     = geoB.m_boxes;
+      sphere_container   const & spheresB   = geoB.m_spheres;
+
+      if ( geoA.m_tetramesh.has_data() )
+      {
+        detail::spheres_tetramesh<M>(
+                                     spheresB
+                                     , pair.t_b()
+                                     , pair.Q_b()
+                                     , pair.obj_a()
+                                     , pair.t_a()
+                                     , pair.Q_a()
+                                     , geoA
+                                     , pair.callback()
+                                      , true
+                                     );
       }
 
+      if ( geoB.m_tetramesh.has_data() )
+      {
+        detail::spheres_tetramesh<M>(
+                                     spheresA
+                                     , pair.t_a()
+                                     , pair.Q_a()
+                                     , pair.obj_b()
+                                     , pair.t_b()
+                                     , pair.Q_b()
+                                     , geoB
+                                     , pair.callback()
+                                     , false
+                                     );
+      }
     }
 
-
     template< typename M>
     inline void dispatch_mixed( System<M> const & system, std::vector<TestPair<M> > & test_pairs )
     {
       assert( ! test_pairs.empty() || !"dispatch_mixed : test_pairs are empty" );
       
       typedef typename std::vector<TestPair<M> >::iterator pair_iterator;
-      typedef typename Geometry<M>::sphere_container       sphere_container;
 
       pair_iterator current = test_pairs.begin();
       pair_iterator end     = test_pairs.end();
 
       for(;current!=end;++current)
       {
-        Geometry<M> const & geoA = system.get_geometry( current->obj_a().get_geometry_idx() );
-        Geometry<M> const & geoB = system.get_geometry( current->obj_b().get_geometry_idx() );
-
-        //box_container      const & boxesA     = geoA.m_boxes;
-        sphere_container   const & spheresA   = geoA.m_spheres;
-
-        //box_container      const & boxesB     = geoB.m_boxes;
-        sphere_container   const & spheresB   = geoB.m_spheres;
-
-        if ( geoA.m_tetramesh.has_data() )
-        {
-          detail::spheres_tetramesh<M>(
-                                       spheresB
-                                       , current->t_b()
-                                       , current->Q_b()
-                                       , current->obj_a()
-                                       , geoA
-                                       , current->callback()
-                                        , true
-                                       );
-        }
-
-        if ( geoB.m_tetramesh.has_data() )
-        {
-          detail::spheres_tetramesh<M>(
-                                       spheresA
-                                       , current->t_a()
-                                       , current->Q_a()
-                                       , current->obj_b()
-                                       , geoB
-                                       , current->callback()
-                                       , false
-                                       );
-        }
-
+        dispatch_mixed( system, *current );
       }
     }
 
@@ -203,6 +218,68 @@ namespace narrow
     if ( ! mixed_pairs.empty() )
       details::dispatch_mixed( system, mixed_pairs );
   }
+
+  /**
+   * Parallel dispatch of test pairs.
+   * Every primitive and mixed test pair is processed as an independent task,
+   * idle threads pick up the next unprocessed pair so expensive pairs do not
+   * stall the others. The callback of each test pair must only be used by
+   * that test pair, that way contacts can be gathered without any locking.
+   *
+   * The tetramesh pairs are dispatched as one batch afterwards, this way
+   * the kDOP tandem traversal can spread the work of a few large mesh pairs
+   * over all threads (or hand the batch to OpenCL).
+   */
+  template< typename M>
+  inline void dispatch_collision_handlers(
+                                          System<M> const & system
+                                          , std::vector<TestPair<M> > const & test_pairs
+                                          , parallel const & /*tag*/
+                                          )
+  {
+    assert( ! test_pairs.empty() || !"dispatch_collision_handlers : test_pairs are empty" );
+
+    std::vector< TestPair<M> > tetramesh_pairs;
+    std::vector< TestPair<M> > other_pairs;
+
+    other_pairs.reserve( test_pairs.size() );
+
+    for(size_t p = 0u; p < test_pairs.size(); ++p)
+    {
+      TestPair<M> const & pair = test_pairs[p];
+
+      bool const A_is_tetramesh = system.get_geometry( pair.obj_a().get_geometry_idx() ).m_tetramesh.has_data();
+      bool const B_is_tetramesh = system.get_geometry( pair.obj_b().get_geometry_idx() ).m_tetramesh.has_data();
+
+      if (A_is_tetramesh && B_is_tetramesh)
+        tetramesh_pairs.push_back( pair );
+      else
+        other_pairs.push_back( pair );
+    }
+
+    long const N = static_cast<long>( other_pairs.size() );
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for(long p = 0; p < N; ++p)
+    {
+      TestPair<M> & pair = other_pairs[p];
+
+      bool const A_is_tetramesh = system.get_geometry( pair.obj_a().get_geometry_idx() ).m_tetramesh.has_data();
+      bool const B_is_tetramesh = system.get_geometry( pair.obj_b().get_geometry_idx() ).m_tetramesh.has_data();
+
+      if (A_is_tetramesh || B_is_tetramesh)
+      {
+        details::dispatch_mixed( system, pair );
+      }
+      else
+      {
+        details::dispatch_primitives( system, pair );
+      }
+    }
+
+    if ( ! tetramesh_pairs.empty() )
+      details::dispatch_tetramesh_tetramesh( system, tetramesh_pairs );
+  }
   
 } //namespace narrow
 
@@ -3,6 +3,7 @@
 
 #include <narrow_geometry.h>
 #include <narrow_params.h>
+#include <narrow_signed_distance_field.h>
 
 #include <kdop_make_tree.h>
 #include <kdop_tags.h>
@@ -35,7 +36,7 @@ namespace narrow
   public:
 
     template<typename MP>
-    friend void make_kdop_bvh(Params<MP> const & params, Object<MP> & object, Geometry<MP> const & geometry);
+    friend void make_kdop_bvh(Params<MP> const & params, Object<MP> & object, Geometry<MP> & geometry);
 
     mesh_array::VertexAttribute<T,mesh_array::T4Mesh> m_X;      ///< Deformed (spatial) x-coordinate
     mesh_array::VertexAttribute<T,mesh_array::T4Mesh> m_Y;      ///< Deformed (spatial) y-coordinate
@@ -43,6 +44,10 @@ namespace narrow
 
     kdop::Tree<T,8> m_tree;                                     ///< kDOP BVH tree used for collision detection of deformed (spatial) mesh
 
+    bool            m_instanced;                                ///< If true then the object is an instance of its geometry. Collision
+                                                                ///< detection uses the body frame kDOP BVH and undeformed coordinates
+                                                                ///< stored in the geometry, and m_X, m_Y, m_Z and m_tree are unused.
+
   protected:
     
     size_t           m_geometry_idx;  ///< A geometry index.
@@ -66,6 +71,7 @@ namespace narrow
     , m_Y()
     , m_Z()
     , m_tree()
+    , m_instanced( false )
     , m_geometry_idx( 0u )
     {}
 
@@ -84,6 +90,7 @@ namespace narrow
         this->m_Y = obj.m_Y;
         this->m_Z = obj.m_Z;
         this->m_tree          = obj.m_tree;
+        this->m_instanced     = obj.m_instanced;
         this->m_geometry_idx  = obj.m_geometry_idx;
       }
       return *this;
@@ -93,43 +100,93 @@ namespace narrow
 
 
 
+  /**
+   * Make the kDOP BVH of a tetramesh geometry.
+   * The BVH is fitted to the undeformed (body frame) coordinates and shared
+   * by all objects that use the geometry. The BVH is only made if the
+   * geometry does not have one already. If signed distance fields are used
+   * then the signed distance field of the geometry is made from the BVH as
+   * well.
+   */
   template<typename M>
-  inline void make_kdop_bvh(Params<M> const & params, Object<M> & object, Geometry<M> const & geometry)
+  inline void make_kdop_bvh(Params<M> const & params, Geometry<M> & geometry)
   {
     typedef typename M::real_type                         T;
     typedef typename M::vector3_type                      V;
 
-    if( geometry.m_tetramesh.has_data() )
+    if( !geometry.m_tetramesh.has_data() )
+      return;
+
+    if( geometry.m_tetramesh.m_tree.number_of_levels() == 0u )
     {
-      size_t mem_bytes;
+      geometry.m_tetramesh.m_tree = kdop::make_tree<V,8,T>(
+                                                           params.get_chunk_bytes()
+                                                           , geometry.m_tetramesh.m_mesh
+                                                           , geometry.m_tetramesh.m_X0
+                                                           , geometry.m_tetramesh.m_Y0
+                                                           , geometry.m_tetramesh.m_Z0
+                                                           , kdop::sequential()
+                                                           );
+    }
+
+    // The signed distance field is made from the tree
+    if( params.use_sdf() )
+      make_sdf( params.sdf_resolution(), geometry );
+  }
 
+  template<typename M>
+  inline void make_kdop_bvh(Params<M> const & params, Object<M> & object, Geometry<M> & geometry)
+  {
+    if( geometry.m_tetramesh.has_data() )
+    {
 #ifdef HAS_DIKUCL
-      if(params.use_open_cl() && params.use_gproximity() )
+      // The OpenCL traversals work on trees fitted to spatial coordinates,
+      // so every object needs its own copy of tree and coordinates.
+      if(params.use_open_cl() )
       {
-        // make sure there is only ever one chunk per object
-        mem_bytes = std::numeric_limits<std::size_t>::max();
-      } else {
-#endif // HAS_DIKUCL
-        
-        // 8000 bytes if gProximity cannot/should not be used
-        mem_bytes = params.get_chunk_bytes();
-        
-#ifdef HAS_DIKUCL
+        typedef typename M::real_type                         T;
+        typedef typename M::vector3_type                      V;
+
+        size_t mem_bytes;
+
+        if( params.use_gproximity() )
+        {
+          // make sure there is only ever one chunk per object
+          mem_bytes = std::numeric_limits<std::size_t>::max();
+        } else {
+          mem_bytes = params.get_chunk_bytes();
+        }
+
+        object.m_tree = kdop::make_tree<V,8,T>(
+                                               mem_bytes
+                                               , geometry.m_tetramesh.m_mesh
+                                               , geometry.m_tetramesh.m_X0
+                                               , geometry.m_tetramesh.m_Y0
+                                               , geometry.m_tetramesh.m_Z0
+                                               , kdop::sequential()
+                                               );
+
+        object.m_instanced = false;
+
+        object.m_X.bind(geometry.m_tetramesh.m_mesh);
+        object.m_Y.bind(geometry.m_tetramesh.m_mesh);
+        object.m_Z.bind(geometry.m_tetramesh.m_mesh);
+
+        return;
       }
 #endif // HAS_DIKUCL
-      
-      object.m_tree = kdop::make_tree<V,8,T>(
-                                             mem_bytes
-                                             , geometry.m_tetramesh.m_mesh
-                                             , geometry.m_tetramesh.m_X0
-                                             , geometry.m_tetramesh.m_Y0
-                                             , geometry.m_tetramesh.m_Z0
-                                             , kdop::sequential()
-                                             );
-
-      object.m_X.bind(geometry.m_tetramesh.m_mesh);
-      object.m_Y.bind(geometry.m_tetramesh.m_mesh);
-      object.m_Z.bind(geometry.m_tetramesh.m_mesh);
+
+      // Rigid objects never change their shape, they only need to know
+      // their placement. Traversals are done in body frames using the
+      // BVH and coordinates of the geometry.
+      make_kdop_bvh( params, geometry );
+
+      object.m_instanced = true;
+
+      object.m_tree.clear();
+      object.m_X.release();
+      object.m_Y.release();
+      object.m_Z.release();
     }
   }
   
@@ -18,8 +18,11 @@ namespace narrow
     size_t m_open_cl_device;
     bool   m_use_gproximity;
     bool   m_use_batching;
+    bool   m_use_parallel;          ///< If true then batched test pairs are dispatched in parallel
     T      m_envelope;              ///< Procentage of scale of smallest object size to be used as collision envelope
     size_t m_chunk_bytes;
+    bool   m_use_sdf;               ///< If true then rigid tetramesh pairs use signed distance fields instead of tetrahedron tests
+    size_t m_sdf_resolution;        ///< Number of grid nodes along the longest side of a signed distance field
 
   public:
     
@@ -28,8 +31,11 @@ namespace narrow
     size_t const & open_cl_device()    const { return this->m_open_cl_device;     }
     bool   const & use_gproximity()    const { return this->m_use_gproximity;     }
     bool   const & use_batching()      const { return this->m_use_batching;       }
+    bool   const & use_parallel()      const { return this->m_use_parallel;       }
     T      const & get_envelope()      const { return this->m_envelope;           }
     size_t const & get_chunk_bytes()   const { return this->m_chunk_bytes;        }
+    bool   const & use_sdf()           const { return this->m_use_sdf;            }
+    size_t const & sdf_resolution()    const { return this->m_sdf_resolution;     }
 
 
   public:      
@@ -39,8 +45,11 @@ namespace narrow
     void set_open_cl_device(size_t const & value)   { this->m_open_cl_device = value;   }
     void set_use_gproximity(bool const & value)     { this->m_use_gproximity = value;   }
     void set_use_batching(bool const & value)       { this->m_use_batching   = value;   }
+    void set_use_parallel(bool const & value)       { this->m_use_parallel   = value;   }
     void set_envelope(T const & value)              { this->m_envelope       = value;   }
     void set_chunk_bytes(size_t const & value)      { this->m_chunk_bytes    = value;   }
+    void set_use_sdf(bool const & value)            { this->m_use_sdf        = value;   }
+    void set_sdf_resolution(size_t const & value)   { this->m_sdf_resolution = value;   }
 
   public:
     
@@ -50,8 +59,11 @@ namespace narrow
     , m_open_cl_device( 0 )
     , m_use_gproximity( false )
     , m_use_batching( true )
+    , m_use_parallel( false )
     , m_envelope(VT::numeric_cast(0.01))
     , m_chunk_bytes(8000)
+    , m_use_sdf( false )
+    , m_sdf_resolution( 32 )
     {}
   };
   
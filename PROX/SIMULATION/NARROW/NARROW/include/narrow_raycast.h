@@ -38,18 +38,46 @@ namespace narrow
 
     if ( geoA.m_tetramesh.has_data() )
     {
-      return kdop::raycast<V, 8>(
-                                 ray
-                                 , objA.m_tree
-                                 , geoA.m_tetramesh.m_mesh
-                                 , objA.m_X
-                                 , objA.m_Y
-                                 , objA.m_Z
-                                 , geoA.m_tetramesh.m_surface_map
-                                 , point
-                                 , distance
-                                 );
+      if( !objA.m_instanced )
+      {
+        return kdop::raycast<V, 8>(
+                                   ray
+                                   , objA.m_tree
+                                   , geoA.m_tetramesh.m_mesh
+                                   , objA.m_X
+                                   , objA.m_Y
+                                   , objA.m_Z
+                                   , geoA.m_tetramesh.m_surface_map
+                                   , point
+                                   , distance
+                                   );
+      }
 
+      // Instances use the body frame tree of the geometry, so the ray is cast
+      // in the body frame. Distances are not changed by the rigid transform.
+      C const bodyAtoWCS = C(tA, qA);
+      C const WCStobodyA = tiny::inverse( bodyAtoWCS );
+
+      geometry::Ray<V> const body_ray = geometry::make_ray(
+                                                           tiny::xform_point( WCStobodyA, ray.origin() )
+                                                           , tiny::xform_vector( WCStobodyA, ray.direction() )
+                                                           );
+
+      bool const did_hit = kdop::raycast<V, 8>(
+                                               body_ray
+                                               , geoA.m_tetramesh.m_tree
+                                               , geoA.m_tetramesh.m_mesh
+                                               , geoA.m_tetramesh.m_X0
+                                               , geoA.m_tetramesh.m_Y0
+                                               , geoA.m_tetramesh.m_Z0
+                                               , geoA.m_tetramesh.m_surface_map
+                                               , point
+                                               , distance
+                                               );
+
+      point = tiny::xform_point( bodyAtoWCS, point );
+
+      return did_hit;
     }
     else
     {
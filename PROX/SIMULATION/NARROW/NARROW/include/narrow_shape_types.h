@@ -4,9 +4,12 @@
 #include <convex_shapes.h> // Needed for convex::ConvexHull data type
 #include <mesh_array.h>    // needed for mesh_array data types
 #include <kdop.h>
+#include <grid_grid.h>      // needed for grid::Grid data type
 
 #include <tiny_vector_functions.h>  // needed for tiny::norm
 
+#include <limits>
+
 namespace narrow
 {
   namespace detail
@@ -137,6 +140,9 @@ namespace narrow
 
         mesh_array::TetrahedronAttribute<mesh_array::TetrahedronSurfaceInfo,mesh_array::T4Mesh> m_surface_map;
 
+        kdop::Tree<T,8>         m_tree;   ///< kDOP BVH fitted to the undeformed coordinates, shared by all objects using this geometry
+        grid::Grid<T,T>         m_sdf;    ///< Signed distance field in the undeformed coordinates, empty unless signed distance fields are used
+
         T                       m_mesh_radius;
         T                       m_mesh_scale;
 
@@ -148,6 +154,8 @@ namespace narrow
         , m_Y0()
         , m_Z0()
         , m_surface_map()
+        , m_tree()
+        , m_sdf()
         , m_mesh_radius( VT::zero() )
         , m_mesh_scale(VT::zero() )
         {}
@@ -207,6 +215,10 @@ namespace narrow
           }
 
           m_mesh_scale = min(  max_coord-min_coord );
+
+          // The shape changed so any old BVH or signed distance field is no longer valid
+          m_tree.clear();
+          m_sdf = grid::Grid<T,T>();
         }
 
 
@@ -221,6 +233,8 @@ namespace narrow
           m_Y0.release();
           m_Z0.release();
           m_surface_map.release();
+          m_tree.clear();
+          m_sdf = grid::Grid<T,T>();
 
           m_mesh.clear();
           m_mesh_radius = VT::zero();
@@ -231,6 +245,37 @@ namespace narrow
       };
 
     };
+
+    /**
+     * Feature index of a box shape.
+     * Collision handlers report feature indices to the contacts callback
+     * such that contact points can be traced back to the shapes that
+     * generated them. The lowest bit encodes the shape type so a box and a
+     * sphere with the same index in a geometry never share a feature index.
+     *
+     * @param idx    The index of the box in the geometry box container.
+     *
+     * @return       The feature index of the box.
+     */
+    inline size_t box_feature(size_t const & idx)    { return 2u*idx;      }
+
+    /**
+     * Feature index of a sphere shape.
+     *
+     * @param idx    The index of the sphere in the geometry sphere container.
+     *
+     * @return       The feature index of the sphere.
+     */
+    inline size_t sphere_feature(size_t const & idx) { return 2u*idx + 1u; }
+
+    /**
+     * Feature index of a signed distance field. Contacts between a vertex
+     * and the signed distance field of a tetramesh use the vertex index as
+     * the feature of the vertex side and this index on the field side.
+     *
+     * @return       The feature index of a signed distance field.
+     */
+    inline size_t sdf_feature()                      { return std::numeric_limits<size_t>::max(); }
     
   } // namespace detail
   
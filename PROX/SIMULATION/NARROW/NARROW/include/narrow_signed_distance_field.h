@@ -0,0 +1,362 @@
+#ifndef NARROW_SIGNED_DISTANCE_FIELD_H
+#define NARROW_SIGNED_DISTANCE_FIELD_H
+
+#include <narrow_geometry.h>
+#include <narrow_shape_types.h>
+
+#include <grid_grid.h>
+#include <grid_node_position.h>
+#include <grid_value_at.h>
+#include <grid_gradient_at.h>
+
+#include <geometry.h>
+
+#include <mesh_array.h>
+
+#include <tiny_coordsys_functions.h>
+#include <tiny_vector_functions.h>
+
+#include <kdop_tree.h>
+
+#include <cmath>
+#include <vector>
+#include <algorithm> // needed for std::swap
+#include <cassert>
+
+namespace narrow
+{
+
+  namespace details
+  {
+
+    /**
+     * Lower bound on the distance from a point to a kDOP. Every slab of the
+     * kDOP contains the kDOP, so the distance to the kDOP is at least the
+     * largest distance from the point to one of the slabs.
+     *
+     * @param D   The unit directions of the slabs of the kDOP.
+     */
+    template<typename V, size_t K>
+    inline typename V::real_type distance_lower_bound(
+                                                      geometry::DOP<typename V::real_type,K> const & dop
+                                                      , geometry::DirectionTable<V,K/2> const & D
+                                                      , V const & q
+                                                      )
+    {
+      using std::max;
+
+      typedef typename V::real_type   T;
+      typedef typename V::value_traits  VT;
+
+      T bound = VT::zero();
+
+      for(size_t k = 0u; k < K/2; ++k)
+      {
+        T const projection = tiny::inner_prod( D(k), q );
+
+        bound = max( bound, max( dop(k).lower() - projection, projection - dop(k).upper() ) );
+      }
+
+      return bound;
+    }
+
+    /**
+     * Find the distance from a point to the closest surface triangle of the
+     * tetrahedra below a node of a kDOP tree branch. Subtrees whose kDOP is
+     * no closer than the closest triangle found so far are skipped, and the
+     * closer child is visited first.
+     *
+     * @param distance   Upon entry the distance to the closest triangle found
+     *                   so far, upon return the distance to the closest
+     *                   triangle below the node if it is closer.
+     */
+    template<typename M>
+    inline void closest_surface_distance(
+                                         typename M::vector3_type const & q
+                                         , size_t const & node_idx
+                                         , kdop::SubTree<typename M::real_type,8> const & branch
+                                         , typename detail::ShapeTypes<M>::Tetramesh const & tetramesh
+                                         , geometry::DirectionTable<typename M::vector3_type,4> const & D
+                                         , typename M::real_type & distance
+                                         )
+    {
+      using std::min;
+
+      typedef typename M::real_type                         T;
+      typedef typename M::vector3_type                      V;
+
+      kdop::Node<T,8> const & node = branch.m_nodes[node_idx];
+
+      if( node.is_leaf() )
+      {
+        mesh_array::Tetrahedron const & tet = tetramesh.m_mesh.tetrahedron( node.m_start );
+
+        mesh_array::TetrahedronSurfaceInfo const & info = tetramesh.m_surface_map(tet);
+
+        if( !( info.m_i || info.m_j || info.m_k || info.m_m ) )
+          return;
+
+        V const p0 = V::make( tetramesh.m_X0(tet.i()), tetramesh.m_Y0(tet.i()), tetramesh.m_Z0(tet.i()) );
+        V const p1 = V::make( tetramesh.m_X0(tet.j()), tetramesh.m_Y0(tet.j()), tetramesh.m_Z0(tet.j()) );
+        V const p2 = V::make( tetramesh.m_X0(tet.k()), tetramesh.m_Y0(tet.k()), tetramesh.m_Z0(tet.k()) );
+        V const p3 = V::make( tetramesh.m_X0(tet.m()), tetramesh.m_Y0(tet.m()), tetramesh.m_Z0(tet.m()) );
+
+        if( info.m_i ) distance = min( distance, tiny::norm( q - geometry::closest_point_on_triangle( q, geometry::make_triangle( p1, p2, p3 ) ) ) );
+        if( info.m_j ) distance = min( distance, tiny::norm( q - geometry::closest_point_on_triangle( q, geometry::make_triangle( p0, p2, p3 ) ) ) );
+        if( info.m_k ) distance = min( distance, tiny::norm( q - geometry::closest_point_on_triangle( q, geometry::make_triangle( p0, p1, p3 ) ) ) );
+        if( info.m_m ) distance = min( distance, tiny::norm( q - geometry::closest_point_on_triangle( q, geometry::make_triangle( p0, p1, p2 ) ) ) );
+
+        return;
+      }
+
+      //--- Visit the children in order of their lower bounds, closest first
+      size_t first  = node.m_start;
+      size_t second = node.m_end;
+
+      T first_bound  = distance_lower_bound( branch.m_nodes[first].m_volume,  D, q );
+      T second_bound = distance_lower_bound( branch.m_nodes[second].m_volume, D, q );
+
+      if( second_bound < first_bound )
+      {
+        std::swap( first, second );
+        std::swap( first_bound, second_bound );
+      }
+
+      if( first_bound < distance )
+        closest_surface_distance<M>( q, first, branch, tetramesh, D, distance );
+
+      if( second_bound < distance )
+        closest_surface_distance<M>( q, second, branch, tetramesh, D, distance );
+    }
+
+  } // namespace details
+
+  /**
+   * Make the signed distance field of a tetramesh geometry.
+   *
+   * The field is sampled on a regular grid fitted to the undeformed (body
+   * frame) coordinates of the mesh, padded by two cells on all sides. The
+   * distance of a grid node is the distance to the closest surface
+   * triangle and the sign is negative if the node lies inside a
+   * tetrahedron of the mesh. The closest triangle is found by a branch
+   * and bound search of the kDOP tree of the geometry, so the tree must be
+   * made first. Nothing is done if the geometry already has a signed
+   * distance field.
+   *
+   * @param resolution   The number of grid nodes along the longest side of the mesh.
+   */
+  template<typename M>
+  inline void make_sdf(size_t const & resolution, Geometry<M> & geometry)
+  {
+    using std::ceil;
+    using std::floor;
+    using std::min;
+    using std::max;
+    using tiny::min;
+    using tiny::max;
+
+    typedef typename M::real_type                         T;
+    typedef typename M::vector3_type                      V;
+    typedef typename M::value_traits                      VT;
+
+    typename detail::ShapeTypes<M>::Tetramesh & tetramesh = geometry.m_tetramesh;
+
+    if( !tetramesh.has_data() )
+      return;
+
+    if( !tetramesh.m_sdf.empty() )
+      return;
+
+    assert( resolution > 1u || !"make_sdf(): resolution must be larger than one");
+    assert( tetramesh.m_tree.number_of_levels() > 0u || !"make_sdf(): the kDOP tree must be made first");
+
+    mesh_array::T4Mesh const & mesh = tetramesh.m_mesh;
+
+    size_t const N = mesh.vertex_size();
+    size_t const E = mesh.tetrahedron_size();
+
+    V min_coord = V(VT::highest());
+    V max_coord = V(VT::lowest());
+
+    for(size_t n = 0u; n < N; ++n)
+    {
+      mesh_array::Vertex const & v = mesh.vertex(n);
+
+      V const r0 = V::make( tetramesh.m_X0(v), tetramesh.m_Y0(v), tetramesh.m_Z0(v) );
+
+      min_coord = min( min_coord, r0 );
+      max_coord = max( max_coord, r0 );
+    }
+
+    T const h = max( max_coord - min_coord ) / VT::numeric_cast( resolution - 1u );
+
+    min_coord -= V( VT::two()*h );
+    max_coord += V( VT::two()*h );
+
+    size_t const I = static_cast<size_t>( ceil( (max_coord(0) - min_coord(0)) / h ) ) + 1u;
+    size_t const J = static_cast<size_t>( ceil( (max_coord(1) - min_coord(1)) / h ) ) + 1u;
+    size_t const K = static_cast<size_t>( ceil( (max_coord(2) - min_coord(2)) / h ) ) + 1u;
+
+    grid::Grid<T,T> & sdf = tetramesh.m_sdf;
+
+    sdf.create(
+               min_coord(0)
+               , min_coord(1)
+               , min_coord(2)
+               , min_coord(0) + (I-1u)*h
+               , min_coord(1) + (J-1u)*h
+               , min_coord(2) + (K-1u)*h
+               , I
+               , J
+               , K
+               );
+
+    std::vector<bool> inside( sdf.size(), false );
+
+    for(size_t e = 0u; e < E; ++e)
+    {
+      mesh_array::Tetrahedron const & tet = mesh.tetrahedron(e);
+
+      V const p0 = V::make( tetramesh.m_X0(tet.i()), tetramesh.m_Y0(tet.i()), tetramesh.m_Z0(tet.i()) );
+      V const p1 = V::make( tetramesh.m_X0(tet.j()), tetramesh.m_Y0(tet.j()), tetramesh.m_Z0(tet.j()) );
+      V const p2 = V::make( tetramesh.m_X0(tet.k()), tetramesh.m_Y0(tet.k()), tetramesh.m_Z0(tet.k()) );
+      V const p3 = V::make( tetramesh.m_X0(tet.m()), tetramesh.m_Y0(tet.m()), tetramesh.m_Z0(tet.m()) );
+
+      // Mark all grid nodes inside the tetrahedron
+      V const lower = min( min(p0, p1), min(p2, p3) );
+      V const upper = max( max(p0, p1), max(p2, p3) );
+
+      size_t const i_begin = static_cast<size_t>( ceil ( (lower(0) - sdf.min_x()) / h ) );
+      size_t const j_begin = static_cast<size_t>( ceil ( (lower(1) - sdf.min_y()) / h ) );
+      size_t const k_begin = static_cast<size_t>( ceil ( (lower(2) - sdf.min_z()) / h ) );
+      size_t const i_end   = static_cast<size_t>( floor( (upper(0) - sdf.min_x()) / h ) );
+      size_t const j_end   = static_cast<size_t>( floor( (upper(1) - sdf.min_y()) / h ) );
+      size_t const k_end   = static_cast<size_t>( floor( (upper(2) - sdf.min_z()) / h ) );
+
+      for(size_t k = k_begin; k <= k_end; ++k)
+        for(size_t j = j_begin; j <= j_end; ++j)
+          for(size_t i = i_begin; i <= i_end; ++i)
+          {
+            V q;
+
+            grid::node_position( sdf, i, j, k, q(0), q(1), q(2) );
+
+            T w0, w1, w2, w3;
+
+            geometry::barycentric( p0, p1, p2, p3, q, w0, w1, w2, w3 );
+
+            if( w0 >= VT::zero() && w1 >= VT::zero() && w2 >= VT::zero() && w3 >= VT::zero() )
+              inside[ (k*J + j)*I + i ] = true;
+          }
+    }
+
+    long const G = static_cast<long>( sdf.size() );
+
+    T * data = sdf.data_ptr();
+
+    std::vector< kdop::SubTree<T,8> > const & branches = tetramesh.m_tree.branches();
+
+    geometry::DirectionTable<V,4> const D = geometry::DirectionTableHelper<V,4>::make();
+
+#pragma omp parallel for schedule(static)
+    for(long g = 0; g < G; ++g)
+    {
+      size_t const i = static_cast<size_t>( g ) % I;
+      size_t const j = ( static_cast<size_t>( g ) / I ) % J;
+      size_t const k = static_cast<size_t>( g ) / ( I*J );
+
+      V q;
+
+      grid::node_position( sdf, i, j, k, q(0), q(1), q(2) );
+
+      T distance = VT::highest();
+
+      for(size_t b = 0u; b < branches.size(); ++b)
+        if( details::distance_lower_bound( branches[b].m_nodes[0].m_volume, D, q ) < distance )
+          details::closest_surface_distance<M>( q, 0u, branches[b], tetramesh, D, distance );
+
+      data[g] = inside[g] ? -distance : distance;
+    }
+  }
+
+  namespace details
+  {
+
+    /**
+     * Append the surface vertices of a tetrahedron. A vertex is on the
+     * surface if one of the three faces sharing the vertex is.
+     */
+    inline void append_surface_vertices(
+                                        mesh_array::Tetrahedron const & tet
+                                        , mesh_array::TetrahedronSurfaceInfo const & info
+                                        , std::vector<size_t> & vertices
+                                        )
+    {
+      if( info.m_j || info.m_k || info.m_m ) vertices.push_back( tet.i() );
+      if( info.m_i || info.m_k || info.m_m ) vertices.push_back( tet.j() );
+      if( info.m_i || info.m_j || info.m_m ) vertices.push_back( tet.k() );
+      if( info.m_i || info.m_j || info.m_k ) vertices.push_back( tet.m() );
+    }
+
+    /**
+     * Contacts between a set of vertices and a signed distance field. The
+     * vertices are given in the frame of the source body and the signed
+     * distance field in the frame of the target body.
+     *
+     * @param X          Transform from the frame of the source to the frame of the target.
+     * @param flip       If false then the normals point out of the target and the
+     *                   features are reported as (sdf, vertex) otherwise the normals
+     *                   point into the target and the features are (vertex, sdf).
+     * @param callback   Callback taking contacts in the frame of the target.
+     */
+    template<typename M>
+    inline void sdf_contacts(
+                             std::vector<size_t> const & vertices
+                             , typename detail::ShapeTypes<M>::Tetramesh const & source
+                             , grid::Grid<typename M::real_type, typename M::real_type> const & sdf
+                             , typename M::coordsys_type const & X
+                             , bool const & flip
+                             , geometry::ContactsCallback<typename M::vector3_type> & callback
+                             )
+    {
+      typedef typename M::real_type                         T;
+      typedef typename M::vector3_type                      V;
+      typedef typename M::value_traits                      VT;
+
+      for(size_t v = 0u; v < vertices.size(); ++v)
+      {
+        mesh_array::Vertex const & vertex = source.m_mesh.vertex( vertices[v] );
+
+        V const p = tiny::xform_point( X, V::make( source.m_X0(vertex), source.m_Y0(vertex), source.m_Z0(vertex) ) );
+
+        T const phi = grid::value_at( sdf, p(0), p(1), p(2) );
+
+        if( phi >= VT::zero() )
+          continue;
+
+        V g;
+
+        grid::gradient_at( sdf, p(0), p(1), p(2), g(0), g(1), g(2) );
+
+        T const length = tiny::norm( g );
+
+        if( length <= VT::zero() )
+          continue;
+
+        V const n = flip ? -g / length : g / length;
+
+        if( flip )
+          callback.set_features( vertex.idx(), detail::sdf_feature() );
+        else
+          callback.set_features( detail::sdf_feature(), vertex.idx() );
+
+        callback( p, n, phi );
+      }
+    }
+
+  } // namespace details
+
+} //namespace narrow
+
+// NARROW_SIGNED_DISTANCE_FIELD_H
+#endif
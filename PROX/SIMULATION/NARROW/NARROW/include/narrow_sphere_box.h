@@ -59,6 +59,7 @@ namespace narrow
       {
         for( box_iterator b = B.begin(); b!=B.end(); ++b )
         {
+          callback.set_features( sphere_feature( a - A.begin() ), box_feature( b - B.begin() ) );
           
           C shapeAtobodyA = C(a->transform().T(), a->transform().Q());
           C shapeBtobodyB = C(b->transform().T(), b->transform().Q());
@@ -5,6 +5,7 @@
 #include <narrow_geometry.h>
 
 #include <kdop_single_traversal.h>
+#include <kdop_transform.h>
 
 namespace narrow
 {
@@ -18,6 +19,8 @@ namespace narrow
                                   , typename M::vector3_type const & tA
                                   , typename M::quaternion_type const & qA
                                   , Object<M> const & objB
+                                  , typename M::vector3_type const & tB
+                                  , typename M::quaternion_type const & qB
                                   , Geometry<M> const & geoB
                                   , typename geometry::ContactsCallback<typename M::vector3_type> & callback
                                   , bool const & should_flip
@@ -34,24 +37,34 @@ namespace narrow
 
       C const bodyAtoWCS = C(tA, qA);
 
+      // If B is an instance of its geometry then the spheres are tested
+      // against the body frame tree of the geometry and the contacts are
+      // brought back into the world frame.
+      C const WCStobodyB = objB.m_instanced ? tiny::inverse( C(tB, qB) ) : C();
+
+      kdop::TransformedContactsCallback<V> bodyB_callback( C(tB, qB), callback );
+
+      geometry::ContactsCallback<V> & traversal_callback = objB.m_instanced ? bodyB_callback : callback;
+
       for( sphere_iterator a = A.begin(); a!=A.end(); ++a )
       {
         C const shapeAtobodyA = C(a->transform().T(), a->transform().Q());
 
         C const shapeAtoWCS = tiny::prod(shapeAtobodyA, bodyAtoWCS);
 
-        geometry::Sphere<V> const sphere = geometry::make_sphere(shapeAtoWCS.T(), a->radius());
+        geometry::Sphere<V> const sphere = geometry::make_sphere( tiny::xform_point( WCStobodyB, shapeAtoWCS.T() ), a->radius());
 
         kdop::single_traversal<V, 8, T>(
                                           sphere
-                                        , objB.m_tree
+                                        , objB.m_instanced ? geoB.m_tetramesh.m_tree : objB.m_tree
                                         , geoB.m_tetramesh.m_mesh
-                                        , objB.m_X
-                                        , objB.m_Y
-                                        , objB.m_Z
+                                        , objB.m_instanced ? geoB.m_tetramesh.m_X0 : objB.m_X
+                                        , objB.m_instanced ? geoB.m_tetramesh.m_Y0 : objB.m_Y
+                                        , objB.m_instanced ? geoB.m_tetramesh.m_Z0 : objB.m_Z
                                         , geoB.m_tetramesh.m_surface_map
-                                        , callback
+                                        , traversal_callback
                                         , should_flip
+                                        , sphere_feature( a - A.begin() )
                                         );
       }
     }
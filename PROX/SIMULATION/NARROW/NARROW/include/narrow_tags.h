@@ -13,6 +13,9 @@ namespace narrow
   struct sequential
   {};
 
+  struct parallel
+  {};
+
   struct dikucl
   {};
   
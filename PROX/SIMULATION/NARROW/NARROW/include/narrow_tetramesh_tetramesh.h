@@ -3,6 +3,7 @@
 
 #include "narrow_object.h"
 #include "narrow_geometry.h"
+#include "narrow_signed_distance_field.h"
 
 #ifdef HAS_DIKUCL
 #include <cl/gproximity/kdop_cl_gproximity_tandem_traversal.h>
@@ -11,12 +12,184 @@
 
 #include <kdop_tandem_traversal.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace narrow
 {
 
   namespace details
   {
 
+    /**
+     * Create the kDOP test pair of a tetramesh versus tetramesh test pair.
+     * Instances are traversed using the body frame tree and undeformed
+     * coordinates of their geometry, a tree fitted to spatial coordinates
+     * simply has the world frame as its body frame.
+     */
+    template< typename M>
+    inline kdop::TestPair<typename M::vector3_type, 8, typename M::real_type> make_kdop_test_pair( System<M> const & system, TestPair<M> & pair )
+    {
+      typedef typename M::vector3_type                     V;
+      typedef typename M::real_type                        T;
+      typedef typename M::coordsys_type                    C;
+      typedef typename kdop::TestPair<V, 8, T>             kdop_pair_type;
+
+      Object<M> const & objA = pair.obj_a();
+      Object<M> const & objB = pair.obj_b();
+
+      Geometry<M> const & geoA = system.get_geometry( objA.get_geometry_idx() );
+      Geometry<M> const & geoB = system.get_geometry( objB.get_geometry_idx() );
+
+      if( objA.m_instanced || objB.m_instanced )
+      {
+        return kdop_pair_type(
+                              objA.m_instanced ? geoA.m_tetramesh.m_tree : objA.m_tree
+                              , objB.m_instanced ? geoB.m_tetramesh.m_tree : objB.m_tree
+                              , geoA.m_tetramesh.m_mesh
+                              , geoB.m_tetramesh.m_mesh
+                              , objA.m_instanced ? geoA.m_tetramesh.m_X0 : objA.m_X
+                              , objB.m_instanced ? geoB.m_tetramesh.m_X0 : objB.m_X
+                              , objA.m_instanced ? geoA.m_tetramesh.m_Y0 : objA.m_Y
+                              , objB.m_instanced ? geoB.m_tetramesh.m_Y0 : objB.m_Y
+                              , objA.m_instanced ? geoA.m_tetramesh.m_Z0 : objA.m_Z
+                              , objB.m_instanced ? geoB.m_tetramesh.m_Z0 : objB.m_Z
+                              , geoA.m_tetramesh.m_surface_map
+                              , geoB.m_tetramesh.m_surface_map
+                              , pair.callback()
+                              , objA.m_instanced ? C( pair.t_a(), pair.Q_a() ) : C()
+                              , objB.m_instanced ? C( pair.t_b(), pair.Q_b() ) : C()
+                              );
+      }
+
+      return kdop_pair_type(
+                            objA.m_tree
+                            , objB.m_tree
+                            , geoA.m_tetramesh.m_mesh
+                            , geoB.m_tetramesh.m_mesh
+                            , objA.m_X
+                            , objB.m_X
+                            , objA.m_Y
+                            , objB.m_Y
+                            , objA.m_Z
+                            , objB.m_Z
+                            , geoA.m_tetramesh.m_surface_map
+                            , geoB.m_tetramesh.m_surface_map
+                            , pair.callback()
+                            );
+    }
+
+    /**
+     * Scratch buffers of the signed distance field test pairs, reused
+     * between test pairs to avoid memory allocations.
+     */
+    class SDFWorkspace
+    {
+    public:
+
+      kdop::details::TraversalWorkspace m_traversal;
+      std::vector<size_t>               m_vertices_a;   ///< Surface vertices of A that are close to B.
+      std::vector<size_t>               m_vertices_b;   ///< Surface vertices of B that are close to A.
+
+    };
+
+    template< typename M>
+    inline bool has_sdf( System<M> const & system, TestPair<M> & pair )
+    {
+      Object<M> const & objA = pair.obj_a();
+      Object<M> const & objB = pair.obj_b();
+
+      if( !objA.m_instanced || !objB.m_instanced )
+        return false;
+
+      return ! system.get_geometry( objA.get_geometry_idx() ).m_tetramesh.m_sdf.empty()
+          && ! system.get_geometry( objB.get_geometry_idx() ).m_tetramesh.m_sdf.empty();
+    }
+
+    /**
+     * Signed distance field test of a tetramesh versus tetramesh test pair.
+     *
+     * The kDOP trees of the geometries are only used for culling. The
+     * surface vertices of the overlapping leaves of B are tested against the
+     * signed distance field of A and vice versa. Both objects must be
+     * instances and both geometries must have signed distance fields.
+     */
+    template< typename M>
+    inline void sdf_test_pair( System<M> const & system, TestPair<M> & pair, SDFWorkspace & workspace )
+    {
+      typedef typename M::vector3_type                     V;
+      typedef typename M::real_type                        T;
+      typedef typename M::coordsys_type                    C;
+      typedef typename kdop::TestPair<V, 8, T>             kdop_pair_type;
+
+      Object<M> const & objA = pair.obj_a();
+      Object<M> const & objB = pair.obj_b();
+
+      assert( (objA.m_instanced && objB.m_instanced) || !"sdf_test_pair(): objects must be instances");
+
+      typename detail::ShapeTypes<M>::Tetramesh const & meshA = system.get_geometry( objA.get_geometry_idx() ).m_tetramesh;
+      typename detail::ShapeTypes<M>::Tetramesh const & meshB = system.get_geometry( objB.get_geometry_idx() ).m_tetramesh;
+
+      kdop_pair_type const item = make_kdop_test_pair( system, pair );
+
+      C const BtoA = tiny::prod( tiny::inverse( item.m_frame_a ), item.m_frame_b );
+      C const AtoB = tiny::inverse( BtoA );
+
+      kdop::RigidTransform<V,8> const X( BtoA );
+
+      if(!geometry::overlap_dop_dop(item.m_tree_a->m_root, X.transform_dop(item.m_tree_b->m_root)))
+        return;
+
+      std::vector<kdop::details::IndexPair> & leaves = workspace.m_traversal.m_leaves;
+
+      leaves.clear();
+
+      size_t const C_A = item.m_tree_a->branches().size();
+      size_t const C_B = item.m_tree_b->branches().size();
+
+      for( size_t a = 0u; a < C_A; ++a)
+        for( size_t b = 0u; b < C_B; ++b)
+        {
+          kdop::SubTree<T,8> const & branch_A = item.m_tree_a->branches()[a];
+          kdop::SubTree<T,8> const & branch_B = item.m_tree_b->branches()[b];
+
+          if(!geometry::overlap_dop_dop(branch_A.m_nodes[0u].m_volume, X.transform_dop(branch_B.m_nodes[0u].m_volume)))
+            continue;
+
+          kdop::details::collect_leaf_pairs<V,8,T>( item, branch_A, 0u, branch_B, 0u, X, workspace.m_traversal );
+        }
+
+      if( leaves.empty() )
+        return;
+
+      std::vector<size_t> & vertices_a = workspace.m_vertices_a;
+      std::vector<size_t> & vertices_b = workspace.m_vertices_b;
+
+      vertices_a.clear();
+      vertices_b.clear();
+
+      for(size_t l = 0u; l < leaves.size(); ++l)
+      {
+        mesh_array::Tetrahedron const & tet_A = meshA.m_mesh.tetrahedron( leaves[l].m_a );
+        mesh_array::Tetrahedron const & tet_B = meshB.m_mesh.tetrahedron( leaves[l].m_b );
+
+        append_surface_vertices( tet_A, meshA.m_surface_map( tet_A ), vertices_a );
+        append_surface_vertices( tet_B, meshB.m_surface_map( tet_B ), vertices_b );
+      }
+
+      std::sort( vertices_a.begin(), vertices_a.end() );
+      std::sort( vertices_b.begin(), vertices_b.end() );
+
+      vertices_a.erase( std::unique( vertices_a.begin(), vertices_a.end() ), vertices_a.end() );
+      vertices_b.erase( std::unique( vertices_b.begin(), vertices_b.end() ), vertices_b.end() );
+
+      kdop::TransformedContactsCallback<V> callback_A( item.m_frame_a, pair.callback() );
+      kdop::TransformedContactsCallback<V> callback_B( item.m_frame_b, pair.callback() );
+
+      sdf_contacts<M>( vertices_b, meshB, meshA.m_sdf, BtoA, false, callback_A );
+      sdf_contacts<M>( vertices_a, meshA, meshB.m_sdf, AtoB, true,  callback_B );
+    }
+
     template< typename M>
     inline void dispatch_tetramesh_tetramesh( System<M> const & system, std::vector< TestPair<M> > & test_pairs )
     {
@@ -31,33 +204,48 @@ namespace narrow
       pair_iterator end     = test_pairs.end();
 
       std::vector< kdop_pair_type > kdop_test_pairs;
+      std::vector< TestPair<M> * >  sdf_test_pairs;
+
+      kdop_test_pairs.reserve( test_pairs.size() );
 
       for(;current!=end;++current)
       {
-        Object<M> const & objA = current->obj_a();
-        Object<M> const & objB = current->obj_b();
-
-        Geometry<M> const & geoA = system.get_geometry( objA.get_geometry_idx() );
-        Geometry<M> const & geoB = system.get_geometry( objB.get_geometry_idx() );
-
-        kdop_pair_type const test_pair = kdop_pair_type(
-                                                        objA.m_tree
-                                                        , objB.m_tree
-                                                        , geoA.m_tetramesh.m_mesh
-                                                        , geoB.m_tetramesh.m_mesh
-                                                        , objA.m_X
-                                                        , objB.m_X
-                                                        , objA.m_Y
-                                                        , objB.m_Y
-                                                        , objA.m_Z
-                                                        , objB.m_Z
-                                                        , geoA.m_tetramesh.m_surface_map
-                                                        , geoB.m_tetramesh.m_surface_map
-                                                        , current->callback()
-                                                        );
-
-        kdop_test_pairs.push_back( test_pair );
+        // Pairs of instances whose geometries both have signed distance
+        // fields skip the tetrahedron tests
+        if( system.params().use_sdf() && has_sdf( system, *current ) )
+        {
+          sdf_test_pairs.push_back( &(*current) );
+
+          continue;
+        }
+
+        kdop_test_pairs.push_back( make_kdop_test_pair( system, *current ) );
       }
+
+      // Every test pair has its own callback, so the signed distance field
+      // pairs are tested concurrently with a workspace per thread
+      long const S = static_cast<long>( sdf_test_pairs.size() );
+
+      if( system.params().use_parallel() )
+      {
+#pragma omp parallel
+        {
+          SDFWorkspace sdf_workspace;
+
+#pragma omp for schedule(dynamic, 1)
+          for(long s = 0; s < S; ++s)
+            sdf_test_pair( system, *sdf_test_pairs[s], sdf_workspace );
+        }
+      } else {
+        SDFWorkspace sdf_workspace;
+
+        for(long s = 0; s < S; ++s)
+          sdf_test_pair( system, *sdf_test_pairs[s], sdf_workspace );
+      }
+
+      if( kdop_test_pairs.empty() )
+        return;
+
 #ifdef HAS_DIKUCL
 
       if(system.params().use_open_cl())
@@ -82,9 +270,16 @@ namespace narrow
 #endif // HAS_DIKUCL
           
         // use regular tandem traversal if DIKUCL is not available or should not be used
-        kdop::tandem_traversal<V, 8, T>(  kdop_test_pairs
-                                        , kdop::sequential()
-                                        );
+        if(system.params().use_parallel())
+        {
+          kdop::tandem_traversal<V, 8, T>(  kdop_test_pairs
+                                          , kdop::parallel()
+                                          );
+        } else {
+          kdop::tandem_traversal<V, 8, T>(  kdop_test_pairs
+                                          , kdop::sequential()
+                                          );
+        }
         
 #ifdef HAS_DIKUCL
       }
@@ -150,6 +150,10 @@ namespace narrow
 
       if( N <= 0u)
         continue;
+
+      // Instances share the body frame BVH of their geometry, it never changes
+      if( object.m_instanced )
+        continue;
       
       for(size_t n = 0u; n < N;++n)
       {
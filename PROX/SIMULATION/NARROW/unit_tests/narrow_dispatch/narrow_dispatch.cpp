@@ -7,6 +7,9 @@
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/test_tools.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 typedef tiny::MathTypes<float>   M;
 typedef M::real_type             T;
 typedef M::vector3_type          V;
@@ -86,10 +89,11 @@ inline void do_test(
 
   // The part in the block below is specific for tetrahedra  meshes.
   //
-  // Their BVH needs to be created in the "object" prior to using
-  // them (as pre-processing before simulation) by using make_kdop_bvh. During
-  // run-time while simulating their BVH must be updated to reflect positional
-  // changes. This is done using the update_kdop_bvh.
+  // Their BVH needs to be created prior to using them (as pre-processing
+  // before simulation) by using make_kdop_bvh. Rigid objects become
+  // instances that share the body frame BVH of their geometry. Objects
+  // with their own BVH fitted to spatial coordinates must have it updated
+  // to reflect positional changes, this is done using the update_kdop_bvh.
   {
     std::vector< narrow::KDopBvhUpdateWorkItem< M > > work_pool;
 
@@ -128,6 +132,61 @@ inline void do_test(
 }
 
 
+class CountCallback
+  : public geometry::ContactsCallback<V>
+{
+public:
+
+  size_t m_count;
+
+  CountCallback()
+  : m_count(0u)
+  {}
+
+  void operator()(
+                  V const & point
+                  , V const & normal
+                  , V::real_type const & distance
+                  )
+  {
+    ++m_count;
+  }
+
+};
+
+class SDFCallback
+  : public geometry::ContactsCallback<V>
+{
+public:
+
+  std::vector<V> m_normals;
+  std::vector<T> m_depths;
+  size_t         m_sdf_features;
+
+  SDFCallback()
+  : m_normals()
+  , m_depths()
+  , m_sdf_features(0u)
+  {}
+
+  void operator()(
+                  V const & point
+                  , V const & normal
+                  , V::real_type const & distance
+                  )
+  {
+    m_normals.push_back(normal);
+    m_depths.push_back(distance);
+  }
+
+  void set_features( size_t const & feature_a, size_t const & feature_b )
+  {
+    if( feature_a == narrow::detail::sdf_feature() || feature_b == narrow::detail::sdf_feature() )
+      ++m_sdf_features;
+  }
+
+};
+
 BOOST_AUTO_TEST_SUITE(narrow);
 
 BOOST_AUTO_TEST_CASE(dispatch_sphere_box_test)
@@ -287,6 +346,165 @@ BOOST_AUTO_TEST_CASE(dispatch_tetmesh_tetmesh_test)
   }
 }
 
+BOOST_AUTO_TEST_CASE(dispatch_sdf_test)
+{
+  mesh_array::T3Mesh surface;
+  mesh_array::VertexAttribute<T,mesh_array::T3Mesh> sX;
+  mesh_array::VertexAttribute<T,mesh_array::T3Mesh> sY;
+  mesh_array::VertexAttribute<T,mesh_array::T3Mesh> sZ;
+
+  mesh_array::make_box<M>( 2.0f, 2.0f, 2.0f, surface, sX, sY, sZ);
+
+  mesh_array::T4Mesh mesh;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> X;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> Y;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> Z;
+
+  mesh_array::tetgen(surface, sX, sY, sZ, mesh, X, Y, Z);
+
+  tetramesh_type tetramesh;
+  tetramesh.set_tetramesh_shape(mesh, X, Y, Z);
+
+  narrow::System<M> system;
+
+  system.params().set_use_sdf( true );
+  system.params().set_sdf_resolution( 32u );
+
+  size_t const tetramesh_idx = system.create_geometry();
+
+  system.get_geometry( tetramesh_idx ).add_shape( tetramesh );
+
+  MyObject objA;
+  MyObject objB;
+
+  objA.set_geometry_idx( tetramesh_idx );
+  objB.set_geometry_idx( tetramesh_idx );
+
+  narrow::make_kdop_bvh( system.params(), objA, system.get_geometry( tetramesh_idx ) );
+  narrow::make_kdop_bvh( system.params(), objB, system.get_geometry( tetramesh_idx ) );
+
+  // The field of the box is the distance to the closest face, negative inside
+  grid::Grid<T,T> const & sdf = system.get_geometry( tetramesh_idx ).m_tetramesh.m_sdf;
+
+  BOOST_CHECK( ! sdf.empty() );
+  BOOST_CHECK_SMALL( grid::value_at( sdf, 0.5f, 0.1f, -0.2f ) + 0.5f, 0.01f );
+  BOOST_CHECK_SMALL( grid::value_at( sdf, 1.1f, 0.0f,  0.0f ) - 0.1f, 0.01f );
+
+  // The tree search finds the same closest surface triangles as testing all of them
+  {
+    tetramesh_type const & shape = system.get_geometry( tetramesh_idx ).m_tetramesh;
+
+    std::vector< geometry::Triangle<V> > triangles;
+
+    for(size_t e = 0u; e < shape.m_mesh.tetrahedron_size(); ++e)
+    {
+      mesh_array::Tetrahedron const & tet = shape.m_mesh.tetrahedron(e);
+
+      V const p0 = V::make( shape.m_X0(tet.i()), shape.m_Y0(tet.i()), shape.m_Z0(tet.i()) );
+      V const p1 = V::make( shape.m_X0(tet.j()), shape.m_Y0(tet.j()), shape.m_Z0(tet.j()) );
+      V const p2 = V::make( shape.m_X0(tet.k()), shape.m_Y0(tet.k()), shape.m_Z0(tet.k()) );
+      V const p3 = V::make( shape.m_X0(tet.m()), shape.m_Y0(tet.m()), shape.m_Z0(tet.m()) );
+
+      mesh_array::TetrahedronSurfaceInfo const & info = shape.m_surface_map(tet);
+
+      if( info.m_i ) triangles.push_back( geometry::make_triangle( p1, p2, p3 ) );
+      if( info.m_j ) triangles.push_back( geometry::make_triangle( p0, p2, p3 ) );
+      if( info.m_k ) triangles.push_back( geometry::make_triangle( p0, p1, p3 ) );
+      if( info.m_m ) triangles.push_back( geometry::make_triangle( p0, p1, p2 ) );
+    }
+
+    T largest_error = 0.0f;
+
+    for(size_t k = 0u; k < sdf.K(); ++k)
+      for(size_t j = 0u; j < sdf.J(); ++j)
+        for(size_t i = 0u; i < sdf.I(); ++i)
+        {
+          V q;
+
+          grid::node_position( sdf, i, j, k, q(0), q(1), q(2) );
+
+          T distance = 1e30f;
+
+          for(size_t s = 0u; s < triangles.size(); ++s)
+            distance = std::min( distance, tiny::norm( q - geometry::closest_point_on_triangle( q, triangles[s] ) ) );
+
+          largest_error = std::max( largest_error, std::fabs( std::fabs( sdf(i,j,k) ) - distance ) );
+        }
+
+    BOOST_CHECK_SMALL( largest_error, 1e-5f );
+  }
+
+  // Overlapping boxes, vertices of each box are 0.1 inside the other box
+  {
+    SDFCallback callback;
+
+    std::vector<narrow::TestPair<M> > test_pairs;
+    test_pairs.push_back( narrow::TestPair<M>( objA, objB, V::make(-0.95f, 0.0f, 0.0f), Q::identity(), V::make(0.95f, 0.3f, 0.2f), Q::identity(), callback ) );
+
+    narrow::dispatch_collision_handlers( system, test_pairs );
+
+    BOOST_CHECK( callback.m_depths.size() > 0u );
+    BOOST_CHECK_EQUAL( callback.m_sdf_features, callback.m_depths.size() );
+
+    for(size_t i = 0u; i < callback.m_depths.size(); ++i)
+    {
+      BOOST_CHECK( callback.m_depths[i] < 0.0f );
+      BOOST_CHECK( callback.m_depths[i] > -0.11f );
+
+      // The normals points from A towards B
+      BOOST_CHECK( callback.m_normals[i](0) > 0.9f );
+    }
+  }
+
+  // Separated boxes
+  {
+    SDFCallback callback;
+
+    std::vector<narrow::TestPair<M> > test_pairs;
+    test_pairs.push_back( narrow::TestPair<M>( objA, objB, V::make(-1.1f, 0.0f, 0.0f), Q::identity(), V::make(1.1f, 0.3f, 0.2f), Q::identity(), callback ) );
+
+    narrow::dispatch_collision_handlers( system, test_pairs );
+
+    BOOST_CHECK_EQUAL( callback.m_depths.size(), 0u );
+  }
+
+  // Many overlapping pairs give the same contacts when tested in parallel
+  {
+    size_t const N = 8u;
+
+    std::vector<SDFCallback> sequential_callbacks( N );
+    std::vector<SDFCallback> parallel_callbacks( N );
+
+    std::vector<narrow::TestPair<M> > sequential_pairs;
+    std::vector<narrow::TestPair<M> > parallel_pairs;
+
+    for(size_t i = 0u; i < N; ++i)
+    {
+      V const posB = V::make( 0.95f, 0.05f*i, 0.2f );
+
+      sequential_pairs.push_back( narrow::TestPair<M>( objA, objB, V::make(-0.95f, 0.0f, 0.0f), Q::identity(), posB, Q::identity(), sequential_callbacks[i] ) );
+      parallel_pairs.push_back(   narrow::TestPair<M>( objA, objB, V::make(-0.95f, 0.0f, 0.0f), Q::identity(), posB, Q::identity(), parallel_callbacks[i]   ) );
+    }
+
+    narrow::dispatch_collision_handlers( system, sequential_pairs );
+
+    system.params().set_use_parallel( true );
+
+    narrow::dispatch_collision_handlers( system, parallel_pairs, narrow::parallel() );
+
+    system.params().set_use_parallel( false );
+
+    for(size_t i = 0u; i < N; ++i)
+    {
+      BOOST_CHECK( sequential_callbacks[i].m_depths.size() > 0u );
+      BOOST_REQUIRE_EQUAL( parallel_callbacks[i].m_depths.size(), sequential_callbacks[i].m_depths.size() );
+
+      for(size_t c = 0u; c < sequential_callbacks[i].m_depths.size(); ++c)
+        BOOST_CHECK_EQUAL( parallel_callbacks[i].m_depths[c], sequential_callbacks[i].m_depths[c] );
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(dispatch_sphere_tetmesh_test)
 {
   sphere_type shapeA;
@@ -329,6 +547,80 @@ BOOST_AUTO_TEST_CASE(dispatch_sphere_tetmesh_test)
 }
 
 
+BOOST_AUTO_TEST_CASE(dispatch_parallel_test)
+{
+  mesh_array::T3Mesh surface;
+  mesh_array::VertexAttribute<T,mesh_array::T3Mesh> sX;
+  mesh_array::VertexAttribute<T,mesh_array::T3Mesh> sY;
+  mesh_array::VertexAttribute<T,mesh_array::T3Mesh> sZ;
+
+  mesh_array::make_box<M>( 2.0f, 2.0f, 2.0f, surface, sX, sY, sZ);
+
+  mesh_array::T4Mesh mesh;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> X;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> Y;
+  mesh_array::VertexAttribute<T,mesh_array::T4Mesh> Z;
+
+  mesh_array::tetgen(surface, sX, sY, sZ, mesh, X, Y, Z);
+
+  tetramesh_type tetramesh;
+  tetramesh.set_tetramesh_shape(mesh, X, Y, Z);
+
+  sphere_type sphere;
+  sphere.radius()    = 1.0f;
+  sphere.transform() = C::identity();
+
+  narrow::System<M> system;
+
+  size_t const tetramesh_idx = system.create_geometry();
+  size_t const sphere_idx    = system.create_geometry();
+
+  system.get_geometry( tetramesh_idx ).add_shape( tetramesh );
+  system.get_geometry( sphere_idx    ).add_shape( sphere );
+
+  // A row of one tetramesh followed by two spheres and so on, every neighbour pair is in contact
+  size_t const N = 12u;
+
+  std::vector<MyObject> objects( N );
+  std::vector<V>        positions( N );
+
+  for(size_t i = 0u; i < N; ++i)
+  {
+    objects[i].set_geometry_idx( (i % 3u == 0u) ? tetramesh_idx : sphere_idx );
+    positions[i] = V::make( 1.9f*i, 0.0f, 0.0f );
+
+    if( i % 3u == 0u )
+      narrow::make_kdop_bvh( system.params(), objects[i], system.get_geometry( tetramesh_idx ) );
+  }
+
+  std::vector<CountCallback> sequential_callbacks( N - 1u );
+  std::vector<CountCallback> parallel_callbacks( N - 1u );
+
+  std::vector<narrow::TestPair<M> > sequential_pairs;
+  std::vector<narrow::TestPair<M> > parallel_pairs;
+
+  for(size_t i = 0u; i + 1u < N; ++i)
+  {
+    sequential_pairs.push_back( narrow::TestPair<M>( objects[i], objects[i+1u], positions[i], Q::identity(), positions[i+1u], Q::identity(), sequential_callbacks[i] ) );
+    parallel_pairs.push_back(   narrow::TestPair<M>( objects[i], objects[i+1u], positions[i], Q::identity(), positions[i+1u], Q::identity(), parallel_callbacks[i]   ) );
+  }
+
+  narrow::dispatch_collision_handlers( system, sequential_pairs );
+  narrow::dispatch_collision_handlers( system, parallel_pairs, narrow::parallel() );
+
+  size_t total = 0u;
+
+  for(size_t i = 0u; i + 1u < N; ++i)
+  {
+    BOOST_CHECK_EQUAL( parallel_callbacks[i].m_count, sequential_callbacks[i].m_count );
+
+    total += sequential_callbacks[i].m_count;
+  }
+
+  BOOST_CHECK( total > 0u );
+}
+
+
 BOOST_AUTO_TEST_CASE(dispatch_convex_convex_test)
 {	
   convex_type shapeA;
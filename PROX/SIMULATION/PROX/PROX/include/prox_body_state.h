@@ -0,0 +1,356 @@
+#ifndef PROX_BODY_STATE_H
+#define PROX_BODY_STATE_H
+
+#include <prox_update_inertia_tensor.h>
+
+#include <tiny_is_number.h>
+#include <tiny_is_finite.h>
+#include <tiny_matrix_functions.h>
+
+#include <vector>
+#include <cmath>
+#include <cassert>
+
+namespace prox
+{
+
+  /**
+   * Struct-of-arrays store of the dynamic state of the rigid bodies.
+   *
+   * The time steppers gather the bodies into this store in a single pass,
+   * do all integration on the flat arrays and only write positions and
+   * velocities back to the bodies when the collision detection or the
+   * caller needs them. Entry k of every array belongs to the kth body.
+   *
+   * The store is a copy of the bodies, not a view onto them. RigidBody
+   * keeps its own position, orientation and velocities, as the broad
+   * phase (get_box), the narrow phase, the force callbacks and the
+   * simulators API all read the bodies directly and bodies may be added or
+   * removed between steps. A step therefore gathers once with
+   * get_body_state and writes back with set_body_positions before the
+   * collision detection and after the post stabilization, and with
+   * set_body_state at the end of the step. Each of these is a single
+   * linear pass over the bodies.
+   *
+   * @tparam MT   Math types policy
+   */
+  template< typename MT >
+  class BodyState
+  {
+  public:
+
+    typedef typename MT::real_type         T;
+    typedef typename MT::matrix3x3_type    M;
+    typedef typename MT::vector6_type      V6;
+    typedef typename MT::vector7_type      V7;
+
+  public:
+
+    V7                 m_q;          ///< Positions and orientations of the bodies.
+    V6                 m_u;          ///< Linear and angular velocities of the bodies.
+    std::vector<T>     m_inv_mass;   ///< Inverse masses, zero if the body is fixed or scripted.
+    std::vector<M>     m_I_bf;       ///< Inertia tensors of the bodies wrt their body frames.
+    std::vector<char>  m_active;     ///< Non-zero if the body is neither fixed nor scripted.
+
+  public:
+
+    size_t size() const { return this->m_inv_mass.size(); }
+
+    void resize(size_t const & N)
+    {
+      this->m_q.resize(N);
+      this->m_u.resize(N);
+      this->m_inv_mass.resize(N);
+      this->m_I_bf.resize(N);
+      this->m_active.resize(N);
+    }
+
+    void clear()
+    {
+      this->m_q.clear();
+      this->m_u.clear();
+      this->m_inv_mass.clear();
+      this->m_I_bf.clear();
+      this->m_active.clear();
+    }
+
+  };
+
+  /**
+   * Gather the state of all bodies into the body state store. This fuses
+   * what get_position_vector and get_velocity_vector do into one pass over
+   * the bodies and also picks up the mass properties used by
+   * get_inverse_mass_matrix.
+   *
+   * @param begin   Random access iterator to the first body.
+   * @param end     Random access iterator to one past the last body.
+   */
+  template<typename body_iterator, typename MT>
+  inline void get_body_state(
+                             body_iterator begin
+                             , body_iterator end
+                             , BodyState<MT> & state
+                             , MT const & /*tag*/
+                             )
+  {
+    using std::fabs;
+
+    typedef typename MT::vector3_type     V;
+    typedef typename MT::quaternion_type  Q;
+    typedef typename MT::block6x1_type    B6x1;
+    typedef typename MT::block7x1_type    B7x1;
+    typedef typename MT::value_traits     VT;
+
+    long const N = static_cast<long>( std::distance(begin,end) );
+
+    state.resize( N );
+
+#pragma omp parallel for schedule(static)
+    for(long k = 0; k < N; ++k)
+    {
+      body_iterator const body = begin + k;
+
+      V const & r = body->get_position();
+      Q const & o = body->get_orientation();
+
+      assert(is_number(r(0))        || !"get_body_state(): non number encountered");
+      assert(is_number(r(1))        || !"get_body_state(): non number encountered");
+      assert(is_number(r(2))        || !"get_body_state(): non number encountered");
+      assert(is_number(o.real())    || !"get_body_state(): non number encountered");
+      assert(is_number(o.imag()(0)) || !"get_body_state(): non number encountered");
+      assert(is_number(o.imag()(1)) || !"get_body_state(): non number encountered");
+      assert(is_number(o.imag()(2)) || !"get_body_state(): non number encountered");
+
+      B7x1 & q = state.m_q( k );
+
+      q(0) = r(0);
+      q(1) = r(1);
+      q(2) = r(2);
+      q(3) = o.real();
+      q(4) = o.imag()(0);
+      q(5) = o.imag()(1);
+      q(6) = o.imag()(2);
+
+      B6x1 & u = state.m_u( k );
+
+      if( body->is_fixed() )
+      {
+        u(0) = VT::zero();
+        u(1) = VT::zero();
+        u(2) = VT::zero();
+        u(3) = VT::zero();
+        u(4) = VT::zero();
+        u(5) = VT::zero();
+      }
+      else
+      {
+        V const & v = body->get_velocity();
+        V const & w = body->get_spin();
+
+        assert(is_number(v(0)) || !"get_body_state(): non number encountered");
+        assert(is_number(v(1)) || !"get_body_state(): non number encountered");
+        assert(is_number(v(2)) || !"get_body_state(): non number encountered");
+        assert(is_number(w(0)) || !"get_body_state(): non number encountered");
+        assert(is_number(w(1)) || !"get_body_state(): non number encountered");
+        assert(is_number(w(2)) || !"get_body_state(): non number encountered");
+
+        u(0) = v(0);
+        u(1) = v(1);
+        u(2) = v(2);
+        u(3) = w(0);
+        u(4) = w(1);
+        u(5) = w(2);
+      }
+
+      bool const active = !body->is_fixed() && !body->is_scripted();
+
+      state.m_active[k] = active ? 1 : 0;
+      state.m_I_bf[k]   = body->get_inertia_bf();
+
+      if( active )
+      {
+        assert( fabs(body->get_mass()) > VT::zero() || !"get_body_state(): Divide by zero!");
+
+        state.m_inv_mass[k] = VT::one() / body->get_mass();
+
+        assert(is_number(state.m_inv_mass[k])   || !"get_body_state(): Nan");
+        assert(is_finite(state.m_inv_mass[k])   || !"get_body_state(): Inf");
+        assert(state.m_inv_mass[k] > VT::zero() || !"get_body_state(): Negative mass");
+      }
+      else
+      {
+        state.m_inv_mass[k] = VT::zero();
+      }
+    }
+  }
+
+  /**
+   * Write positions back to all bodies that are neither fixed nor scripted.
+   *
+   * @param q       The position vector to write, it need not be the one of the state.
+   * @param state   The state the bodies were gathered into, tells which bodies are active.
+   */
+  template<typename body_iterator, typename MT>
+  inline void set_body_positions(
+                                 body_iterator begin
+                                 , body_iterator end
+                                 , typename MT::vector7_type const & q
+                                 , BodyState<MT> const & state
+                                 , MT const & /*tag*/
+                                 )
+  {
+    typedef typename MT::vector3_type     V;
+    typedef typename MT::quaternion_type  Q;
+    typedef typename MT::block7x1_type    B7x1;
+
+    long const N = static_cast<long>( std::distance(begin,end) );
+
+    assert(q.size()     == static_cast<size_t>(N) || !"set_body_positions(): q has incorrect dimension");
+    assert(state.size() == static_cast<size_t>(N) || !"set_body_positions(): state has incorrect dimension");
+
+#pragma omp parallel for schedule(static)
+    for(long k = 0; k < N; ++k)
+    {
+      if( !state.m_active[k] )
+        continue;
+
+      B7x1 const & b = q( k );
+
+      assert(is_number(b(0)) || !"set_body_positions(): non number encountered");
+      assert(is_number(b(1)) || !"set_body_positions(): non number encountered");
+      assert(is_number(b(2)) || !"set_body_positions(): non number encountered");
+      assert(is_number(b(3)) || !"set_body_positions(): non number encountered");
+      assert(is_number(b(4)) || !"set_body_positions(): non number encountered");
+      assert(is_number(b(5)) || !"set_body_positions(): non number encountered");
+      assert(is_number(b(6)) || !"set_body_positions(): non number encountered");
+
+      body_iterator const body = begin + k;
+
+      body->set_position( V::make( b(0), b(1), b(2) ) );
+      body->set_orientation( Q( b(3), b(4), b(5), b(6) ) );
+    }
+  }
+
+  /**
+   * Write positions and velocities of the state back to all bodies that are
+   * neither fixed nor scripted, in one pass over the bodies.
+   */
+  template<typename body_iterator, typename MT>
+  inline void set_body_state(
+                             body_iterator begin
+                             , body_iterator end
+                             , BodyState<MT> const & state
+                             , MT const & /*tag*/
+                             )
+  {
+    typedef typename MT::vector3_type     V;
+    typedef typename MT::quaternion_type  Q;
+    typedef typename MT::block6x1_type    B6x1;
+    typedef typename MT::block7x1_type    B7x1;
+
+    long const N = static_cast<long>( std::distance(begin,end) );
+
+    assert(state.size() == static_cast<size_t>(N) || !"set_body_state(): state has incorrect dimension");
+
+#pragma omp parallel for schedule(static)
+    for(long k = 0; k < N; ++k)
+    {
+      if( !state.m_active[k] )
+        continue;
+
+      B7x1 const & q = state.m_q( k );
+      B6x1 const & u = state.m_u( k );
+
+      assert(is_number(q(0)) || !"set_body_state(): non number encountered");
+      assert(is_number(q(1)) || !"set_body_state(): non number encountered");
+      assert(is_number(q(2)) || !"set_body_state(): non number encountered");
+      assert(is_number(q(3)) || !"set_body_state(): non number encountered");
+      assert(is_number(q(4)) || !"set_body_state(): non number encountered");
+      assert(is_number(q(5)) || !"set_body_state(): non number encountered");
+      assert(is_number(q(6)) || !"set_body_state(): non number encountered");
+      assert(is_number(u(0)) || !"set_body_state(): non number encountered");
+      assert(is_number(u(1)) || !"set_body_state(): non number encountered");
+      assert(is_number(u(2)) || !"set_body_state(): non number encountered");
+      assert(is_number(u(3)) || !"set_body_state(): non number encountered");
+      assert(is_number(u(4)) || !"set_body_state(): non number encountered");
+      assert(is_number(u(5)) || !"set_body_state(): non number encountered");
+
+      body_iterator const body = begin + k;
+
+      body->set_position( V::make( q(0), q(1), q(2) ) );
+      body->set_orientation( Q( q(3), q(4), q(5), q(6) ) );
+      body->set_velocity( V::make( u(0), u(1), u(2) ) );
+      body->set_spin( V::make( u(3), u(4), u(5) ) );
+    }
+  }
+
+  /**
+   * Compute the inverse mass matrix from the body state store without
+   * touching the bodies.
+   *
+   * @param q       The positions at which the world frame inertia tensors are wanted.
+   * @param W       Upon return holds the inverse mass matrix.
+   */
+  template <typename MT >
+  inline void get_inverse_mass_matrix(
+                                      BodyState<MT> const & state
+                                      , typename MT::vector7_type const & q
+                                      , typename MT::diagonal6x6_type & W
+                                      , MT const & /*tag*/
+                                      )
+  {
+    typedef typename MT::real_type          T;
+    typedef typename MT::matrix3x3_type     M;
+    typedef typename MT::quaternion_type    Q;
+    typedef typename MT::block6x6_type      B6x6;
+    typedef typename MT::block7x1_type      B7x1;
+    typedef typename MT::value_traits       VT;
+
+    long const N = static_cast<long>( state.size() );
+
+    assert(q.size() == state.size() || !"get_inverse_mass_matrix(): q has incorrect dimension");
+
+    W.resize( N );
+
+#pragma omp parallel for schedule(static)
+    for(long k = 0; k < N; ++k)
+    {
+      T const inv_mass = state.m_inv_mass[k];
+      M       inv_I    = M::make(
+                                   VT::zero(), VT::zero(), VT::zero()
+                                 , VT::zero(), VT::zero(), VT::zero()
+                                 , VT::zero(), VT::zero(), VT::zero()
+                                 );
+
+      if( state.m_active[k] )
+      {
+        B7x1 const & b = q( k );
+
+        M const R = tiny::make( Q( b(3), b(4), b(5), b(6) ) );
+
+        detail::update_inertia_tensor<MT>( R, state.m_I_bf[k], inv_I );
+
+        inv_I = tiny::inverse( inv_I );
+      }
+
+      B6x6 & w = W( k );
+
+      w(0,0) = inv_mass;
+      w(1,1) = inv_mass;
+      w(2,2) = inv_mass;
+      w(3,3) = inv_I(0,0);
+      w(3,4) = inv_I(0,1);
+      w(3,5) = inv_I(0,2);
+      w(4,3) = inv_I(1,0);
+      w(4,4) = inv_I(1,1);
+      w(4,5) = inv_I(1,2);
+      w(5,3) = inv_I(2,0);
+      w(5,4) = inv_I(2,1);
+      w(5,5) = inv_I(2,2);
+    }
+  }
+
+} // namespace prox
+
+// PROX_BODY_STATE_H
+#endif
@@ -14,12 +14,14 @@
 #include <narrow_tags.h>
 #include <narrow_update_kdop_bvh.h>
 
+#include <prox_contact_cache.h>
 #include <prox_contact_point.h>
 #include <prox_params.h>
 #include <prox_rigid_body.h>
 
 #include <util_profiling.h>
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 
@@ -52,6 +54,9 @@ namespace prox
       body_type                   * m_body_i;   ///< A pointer to body i of the contact.
       body_type                   * m_body_j;   ///< A pointer to body j of the contact.
       std::vector< contact_type > * m_results;  ///< A pointer to a contact point container where all generated contacts should be added to.
+      size_t                        m_feature_i;      ///< The feature on body i currently being tested.
+      size_t                        m_feature_j;      ///< The feature on body j currently being tested.
+      size_t                        m_feature_point;  ///< The number of contacts generated so far by the current feature pair.
 
     public:
 
@@ -59,12 +64,18 @@ namespace prox
       : m_body_i(0)
       , m_body_j(0)
       , m_results(0)
+      , m_feature_i(0u)
+      , m_feature_j(0u)
+      , m_feature_point(0u)
       {}
 
       ContactCallbackFunctor(body_type * A, body_type * B, std::vector< prox::ContactPoint<M> > & results)
       : m_body_i(A)
       , m_body_j(B)
       , m_results(&results)
+      , m_feature_i(0u)
+      , m_feature_j(0u)
+      , m_feature_point(0u)
       {
         assert(A || !"ContactCallbackFunctor(...) body A was null");
         assert(B || !"ContactCallbackFunctor(...) body B was null");
@@ -79,6 +90,9 @@ namespace prox
           this->m_body_i  = callback.m_body_i;
           this->m_body_j  = callback.m_body_j;
           this->m_results = callback.m_results;
+          this->m_feature_i     = callback.m_feature_i;
+          this->m_feature_j     = callback.m_feature_j;
+          this->m_feature_point = callback.m_feature_point;
         }
         return *this;
       }
@@ -106,9 +120,27 @@ namespace prox
         contact.set_normal( n );
         contact.set_body_i( this->m_body_i );
         contact.set_body_j( this->m_body_j );
+        contact.set_features( this->m_feature_i, this->m_feature_j, this->m_feature_point++ );
 
         this->m_results->push_back( contact );
       }
+
+      /*
+       * Set features callback function.
+       * The contact point generation library invokes this function before
+       * testing a new pair of features. The feature indices are stored in
+       * the generated contacts such that they can be recognized in the next
+       * time step when warm starting.
+       *
+       * @param feature_a    The feature index on body i.
+       * @param feature_b    The feature index on body j.
+       */
+      void set_features( size_t const & feature_a, size_t const & feature_b)
+      {
+        this->m_feature_i     = feature_a;
+        this->m_feature_j     = feature_b;
+        this->m_feature_point = 0u;
+      }
     };
 
   }// namespace detail
@@ -149,58 +181,54 @@ namespace prox
 
     START_TIMER("collision_detection");
 
+    ContactCache<M> cache;
+
     //--- First we preprocess data structures for doing collision detection ----
     {
       START_TIMER("collision_detection_preprocessing");
 
-      //--- Update kDOP BVHs to reflect changes in tetramesh geometry ----------
-      START_TIMER("collision_detection_creating_kdop_work_pool");
-
-      std::vector< narrow::KDopBvhUpdateWorkItem< tiny_types > > kdop_bvh_update_work_pool;
+      //--- Rigid tetrameshes are instances of their geometry and share its body
+      //--- frame kDOP BVH, the traversals work in body frames so nothing needs
+      //--- to be refitted. Only the OpenCL traversals need BVHs fitted to
+      //--- spatial coordinates.
+#ifdef HAS_DIKUCL
+      if( narrow_system.params().use_open_cl() )
+      {
+        START_TIMER("collision_detection_creating_kdop_work_pool");
 
-      kdop_bvh_update_work_pool.reserve( bodies.size() ); // Make sure all space we may need is pre-allocated.
+        std::vector< narrow::KDopBvhUpdateWorkItem< tiny_types > > kdop_bvh_update_work_pool;
 
-      for(body_iterator body = bodies.begin(); body != bodies.end(); ++body)
-      {
-        geometry_type const & geometry = narrow_system.get_geometry( body->get_geometry_idx() );
+        kdop_bvh_update_work_pool.reserve( bodies.size() ); // Make sure all space we may need is pre-allocated.
 
-        if(geometry.m_tetramesh.has_data() )
+        for(body_iterator body = bodies.begin(); body != bodies.end(); ++body)
         {
-          narrow::KDopBvhUpdateWorkItem<tiny_types> work_item = narrow::KDopBvhUpdateWorkItem<tiny_types>(
-                                                                                                          *body
-                                                                                                          , geometry
-                                                                                                          , body->get_position()
-                                                                                                          , body->get_orientation()
-                                                                                                          );
-          kdop_bvh_update_work_pool.push_back( work_item );
+          geometry_type const & geometry = narrow_system.get_geometry( body->get_geometry_idx() );
+
+          if(geometry.m_tetramesh.has_data() && !body->m_instanced )
+          {
+            narrow::KDopBvhUpdateWorkItem<tiny_types> work_item = narrow::KDopBvhUpdateWorkItem<tiny_types>(
+                                                                                                            *body
+                                                                                                            , geometry
+                                                                                                            , body->get_position()
+                                                                                                            , body->get_orientation()
+                                                                                                            );
+            kdop_bvh_update_work_pool.push_back( work_item );
+          }
         }
-      }
-      STOP_TIMER("collision_detection_creating_kdop_work_pool");
+        STOP_TIMER("collision_detection_creating_kdop_work_pool");
 
-      START_TIMER("collision_detection_updating_kdop");
-      if( ! kdop_bvh_update_work_pool.empty() )
-      {
-#ifdef HAS_DIKUCL
-        if( narrow_system.params().use_open_cl() )
+        START_TIMER("collision_detection_updating_kdop");
+        if( ! kdop_bvh_update_work_pool.empty() )
         {
           narrow::update_kdop_bvh(  kdop_bvh_update_work_pool
                                   , narrow::dikucl()
                                   , narrow_system.params().open_cl_platform()
                                   , narrow_system.params().open_cl_device()
                                   );
-        } else {
-#endif // HAS_DIKUCL
-          
-          // use regular updating of KDOP BVHs if DIKUCL is not available or should not be used
-          narrow::update_kdop_bvh(  kdop_bvh_update_work_pool
-                                  , narrow::sequential()
-                                  );
-          
-#ifdef HAS_DIKUCL
         }
-#endif // HAS_DIKUCL
+        STOP_TIMER("collision_detection_updating_kdop");
       }
-      STOP_TIMER("collision_detection_updating_kdop");
+#endif // HAS_DIKUCL
 
 
       //--- Update bounding spheres (radius) of all geometries in the system -----
@@ -215,34 +243,28 @@ namespace prox
         geometry->update_radius();
       }
 
-      // 2013-07-06 Kenny code review: This will clear all data in
-      //            the broad phase collision detection system. This
-      //            may not be the most efficient approach, as all
-      //            configuration data needs to be build up from stracth
-      //            again. Ideally only newly added bodies or geometry
-      //            changed bodies should be cleared/added to the broad
-      //            phase system.
-      broad_system.clear();
-
-      //--- Update body radius and connect their AABBs to the broad phase system -
+      //--- Update body radius, their AABBs follow the bodies --------------------
       for(body_iterator body = bodies.begin(); body != bodies.end(); ++body)
       {
         geometry_type const & geometry = narrow_system.get_geometry( body->get_geometry_idx() );
 
         body->set_radius( geometry.get_radius() );
-
-        // 2013-07-06 Kenny code review: Here we re-connect all bodies
-        //            to the broad phase collision detection system.
-        //            See my review comment above about efficiency.
-        broad_system.connect( &(*body)  );
       }
 
-      // 2015-03-03 Kenny code review: This optimal spacing requires
-      // sorting of all objects, so it runs O(n lg n). However, grid
-      // algorithm is trying to run in O(n). Hence, one could argue that
-      // a sweep-line algorithm would be better as its performance do
-      // not depend on the obejct sizes.
-      broad_system.compute_optimal_cell_spacing(); 
+      //--- Bodies stay connected to the broad phase system from one step to
+      //--- the next, only added or removed bodies change the connections. The
+      //--- cell spacing is only recomputed when the connections changed or
+      //--- the sizes of the AABBs have drifted.
+      bool const reconnected = broad_system.synchronize( bodies.begin(), bodies.end() );
+      bool const respaced    = broad_system.update();
+
+#ifdef USE_PROFILING
+      RECORD("broad_reconnected", reconnected ? 1 : 0 );
+      RECORD("broad_respaced",    respaced    ? 1 : 0 );
+#else
+      (void)reconnected;
+      (void)respaced;
+#endif
 
       STOP_TIMER("collision_detection_preprocessing");
     }
@@ -256,14 +278,22 @@ namespace prox
 
       float efficiency = 0.0f;
 
-      if( params.use_all_pair() )
-      {
-         broad::find_overlaps( broad_system, overlaps, efficiency, broad::all_pair_algorithm() );
-      }
-      else
+      switch( params.broad_phase() )
       {
-         broad::find_overlaps( broad_system, overlaps, efficiency, broad::grid_algorithm() );
-      }
+        case all_pair_broad_phase:
+          broad::find_overlaps( broad_system, overlaps, efficiency, broad::all_pair_algorithm() );
+          break;
+        case sweep_and_prune_broad_phase:
+          broad::find_overlaps( broad_system, overlaps, efficiency, broad::sweep_and_prune_algorithm() );
+          break;
+        case parallel_grid_broad_phase:
+          broad::find_overlaps( broad_system, overlaps, efficiency, broad::parallel_grid_algorithm() );
+          break;
+        case grid_broad_phase:
+        default:
+          broad::find_overlaps( broad_system, overlaps, efficiency, broad::grid_algorithm() );
+          break;
+      };
 
       STOP_TIMER("broad_phase");
 
@@ -283,6 +313,12 @@ namespace prox
     {
       START_TIMER("narrow_phase");
 
+      //--- Remember impulses of old contacts before we throw them away -------
+      if( params.solver_params().use_warm_starting() )
+      {
+        cache.store( contacts.begin(), contacts.end() );
+      }
+
       //--- Make sure we do not carry any old contact information around. ------
       contacts.clear();
 
@@ -292,6 +328,15 @@ namespace prox
       callbacks.resize( overlaps.size() );
       typename std::vector< callback_type >::iterator callback = callbacks.begin();
 
+      // When dispatching in parallel every test pair writes to its own
+      // contact buffer, the buffers are concatenated in test pair order
+      // afterwards so the contacts come out the same for any thread count.
+      bool const use_parallel = narrow_system.params().use_batching() && narrow_system.params().use_parallel();
+
+      std::vector< std::vector< ContactPoint<M> > > pair_contacts;
+      if( use_parallel )
+        pair_contacts.resize( overlaps.size() );
+
       for(overlap_iterator o = overlaps.begin(); o != overlaps.end(); ++o, ++callback)
       {
         body_type * bodyA = static_cast<body_type *>(o->first);    // 2009-11-25 Kenny: hmm can we not get rid of static casts?
@@ -307,7 +352,10 @@ namespace prox
         if (bodyA->is_scripted() && bodyB->is_scripted())
           continue;
 
-        *callback = callback_type( bodyA, bodyB, contacts );
+        if( use_parallel )
+          *callback = callback_type( bodyA, bodyB, pair_contacts[ narrow_test_pairs.size() ] );
+        else
+          *callback = callback_type( bodyA, bodyB, contacts );
 
         narrow::TestPair<tiny_types> narrow_pair = narrow::TestPair<tiny_types>(
                                                                                 *bodyA
@@ -332,7 +380,22 @@ namespace prox
         }
       }
 
-      if ( ! narrow_test_pairs.empty() )
+      if ( ! narrow_test_pairs.empty() && use_parallel )
+      {
+        narrow::dispatch_collision_handlers( narrow_system, narrow_test_pairs, narrow::parallel() );
+
+        std::vector<size_t> offsets( narrow_test_pairs.size() + 1u, 0u );
+
+        for(size_t p = 0u; p < narrow_test_pairs.size(); ++p)
+          offsets[p+1u] = offsets[p] + pair_contacts[p].size();
+
+        contacts.resize( offsets.back() );
+
+#pragma omp parallel for schedule(static)
+        for(long p = 0; p < static_cast<long>( narrow_test_pairs.size() ); ++p)
+          std::copy( pair_contacts[p].begin(), pair_contacts[p].end(), contacts.begin() + offsets[p] );
+      }
+      else if ( ! narrow_test_pairs.empty() )
       {
         narrow::dispatch_collision_handlers( narrow_system, narrow_test_pairs );
       }
@@ -352,7 +415,19 @@ namespace prox
       STOP_TIMER("contact_reduction");
     }
 
-    //--- Fifth phase we collect statistics on contact points ------------------
+    //--- Fifth phase we transfer old impulses to new contacts for warm starting
+    if( params.solver_params().use_warm_starting() )
+    {
+      START_TIMER("contact_cache");
+
+      size_t const matches = cache.restore( contacts.begin(), contacts.end() );
+
+      STOP_TIMER("contact_cache");
+
+      RECORD("warm_started_contacts", matches );
+    }
+
+    //--- Sixth phase we collect statistics on contact points ------------------
     {
       RECORD("contacts", contacts.size() );
 
@@ -45,7 +45,9 @@ namespace prox
     {
       geometry_type const & geometry = narrow_system.get_geometry( body->get_geometry_idx() );
 
-      if(geometry.m_tetramesh.has_data() )
+      // Only trees fitted to spatial coordinates need to be refitted,
+      // instances are raycasted in the body frame of their geometry.
+      if(geometry.m_tetramesh.has_data() && !body->m_instanced )
       {
         narrow::KDopBvhUpdateWorkItem<tiny_types> work_item = narrow::KDopBvhUpdateWorkItem<tiny_types>(
                                                                                                         *body
@@ -0,0 +1,241 @@
+#ifndef PROX_CONTACT_CACHE_H
+#define PROX_CONTACT_CACHE_H
+
+#include <prox_contact_point.h>
+
+#include <tiny_vector_functions.h>  // needed for tiny::inner_prod and tiny::orthonormal_vectors
+
+#include <algorithm> // needed for std::sort and std::lower_bound
+#include <cassert>
+#include <vector>
+
+namespace prox
+{
+
+  /**
+   * Contact Cache.
+   * This class remembers the contact impulses and the post stabilization
+   * impulses of one time step such that they can be used as the initial
+   * iterate (warm starting) of the prox solvers and the stabilization solver
+   * in the next time step.
+   *
+   * Contacts are identified by the pair of bodies and the pair of features
+   * (box, sphere or tetrahedron indices) that generated them, and by their
+   * order among all contacts of the same feature pair. Body pairs are stored
+   * in a canonical order so it does not matter in what order the broad phase
+   * reports the bodies from one time step to the next.
+   *
+   * Friction impulses are remembered as world space vectors and projected
+   * onto the tangent plane of the new contact. This way an impulse survives
+   * small changes in the contact normal. Entries whose normal has changed too
+   * much are ignored.
+   *
+   * @tparam M   The math policy used.
+   */
+  template< typename M >
+  class ContactCache
+  {
+  public:
+
+    typedef typename M::real_type       T;
+    typedef typename M::value_traits    VT;
+    typedef typename M::vector3_type    V;
+    typedef typename M::block4x1_type   B4x1;
+
+  protected:
+
+    class Entry
+    {
+    public:
+
+      size_t m_body_i;            ///< Canonical index of body i (the smallest index of the two bodies).
+      size_t m_body_j;            ///< Canonical index of body j (the largest index of the two bodies).
+      size_t m_feature_i;         ///< The feature index on body i.
+      size_t m_feature_j;         ///< The feature index on body j.
+      size_t m_feature_point;     ///< The order of the contact among contacts from the same feature pair.
+
+      V      m_normal;            ///< Contact normal pointing from body i towards body j.
+      T      m_normal_impulse;    ///< Magnitude of the normal impulse.
+      V      m_friction_impulse;  ///< World space friction impulse acting on body j.
+      T      m_torsional_impulse; ///< Magnitude of the torsional friction impulse.
+      T      m_stabilization_impulse; ///< Magnitude of the post stabilization normal impulse.
+
+    public:
+
+      bool operator<(Entry const & entry) const
+      {
+        if( this->m_body_i != entry.m_body_i )
+          return this->m_body_i < entry.m_body_i;
+        if( this->m_body_j != entry.m_body_j )
+          return this->m_body_j < entry.m_body_j;
+        if( this->m_feature_i != entry.m_feature_i )
+          return this->m_feature_i < entry.m_feature_i;
+        if( this->m_feature_j != entry.m_feature_j )
+          return this->m_feature_j < entry.m_feature_j;
+        return this->m_feature_point < entry.m_feature_point;
+      }
+
+      bool has_same_key(Entry const & entry) const
+      {
+        return this->m_body_i        == entry.m_body_i
+            && this->m_body_j        == entry.m_body_j
+            && this->m_feature_i     == entry.m_feature_i
+            && this->m_feature_j     == entry.m_feature_j
+            && this->m_feature_point == entry.m_feature_point;
+      }
+
+    };
+
+    /**
+     * Make a cache key from a contact point.
+     *
+     * @param contact   The contact point.
+     * @param entry     Upon return holds the canonical key and the contact normal.
+     *
+     * @return          If true then body i and j of the contact were swapped to get a canonical order.
+     */
+    template<typename contact_type>
+    static bool make_key(contact_type const & contact, Entry & entry)
+    {
+      bool const swapped = contact.get_body_idx_i() > contact.get_body_idx_j();
+
+      entry.m_body_i        = swapped ? contact.get_body_idx_j() : contact.get_body_idx_i();
+      entry.m_body_j        = swapped ? contact.get_body_idx_i() : contact.get_body_idx_j();
+      entry.m_feature_i     = swapped ? contact.get_feature_j()  : contact.get_feature_i();
+      entry.m_feature_j     = swapped ? contact.get_feature_i()  : contact.get_feature_j();
+      entry.m_feature_point = contact.get_feature_point();
+      entry.m_normal        = swapped ? -contact.get_normal()    : contact.get_normal();
+
+      return swapped;
+    }
+
+  protected:
+
+    std::vector<Entry>  m_entries;           ///< Cache entries sorted by their keys.
+    T                   m_normal_tolerance;  ///< Cosine of the largest angle the contact normal
+                                             ///< may change and still reuse the cached impulse.
+
+  public:
+
+    ContactCache()
+    : m_entries()
+    , m_normal_tolerance( VT::numeric_cast(0.9f) )
+    {}
+
+  public:
+
+    T const & normal_tolerance() const { return this->m_normal_tolerance; }
+
+    void set_normal_tolerance(T const & value)
+    {
+      assert(value >= -VT::one() || !"set_normal_tolerance(): value must be a cosine");
+      assert(value <=  VT::one() || !"set_normal_tolerance(): value must be a cosine");
+
+      this->m_normal_tolerance = value;
+    }
+
+    size_t size() const { return this->m_entries.size(); }
+
+    void clear() { this->m_entries.clear(); }
+
+    /**
+     * Remember the impulses of a range of contact points.
+     * Any previously cached impulses are forgotten.
+     *
+     * @param begin    Iterator to the first contact point.
+     * @param end      Iterator to one past the last contact point.
+     */
+    template<typename contact_iterator>
+    void store(contact_iterator begin, contact_iterator end)
+    {
+      this->m_entries.clear();
+      this->m_entries.reserve( std::distance(begin, end) );
+
+      for(contact_iterator contact = begin; contact != end; ++contact)
+      {
+        B4x1 const & impulse = contact->get_impulse();
+
+        Entry entry;
+
+        bool const swapped = make_key( *contact, entry );
+
+        // The tangent vectors are recomputed the same way as
+        // get_jacobian_matrix does for isotropic friction.
+        V s;
+        V t;
+        tiny::orthonormal_vectors( s, t, contact->get_normal() );
+
+        V const F = t*impulse(1) + s*impulse(2);
+
+        entry.m_normal_impulse    = impulse(0);
+        entry.m_friction_impulse  = swapped ? -F : F;
+        entry.m_torsional_impulse = impulse(3);
+        entry.m_stabilization_impulse = contact->get_stabilization_impulse();
+
+        this->m_entries.push_back( entry );
+      }
+
+      std::sort( this->m_entries.begin(), this->m_entries.end() );
+    }
+
+    /**
+     * Look up cached impulses for a range of contact points.
+     * Contacts without a matching cache entry get a zero impulse.
+     *
+     * @param begin    Iterator to the first contact point.
+     * @param end      Iterator to one past the last contact point.
+     *
+     * @return         The number of contact points that got a cached impulse.
+     */
+    template<typename contact_iterator>
+    size_t restore(contact_iterator begin, contact_iterator end) const
+    {
+      typedef typename std::vector<Entry>::const_iterator entry_iterator;
+
+      size_t matches = 0u;
+
+      for(contact_iterator contact = begin; contact != end; ++contact)
+      {
+        B4x1 impulse( VT::zero() );
+        T    stabilization_impulse = VT::zero();
+
+        Entry key;
+
+        bool const swapped = make_key( *contact, key );
+
+        entry_iterator entry = std::lower_bound( this->m_entries.begin(), this->m_entries.end(), key );
+
+        if( entry != this->m_entries.end() && entry->has_same_key(key) )
+        {
+          if( tiny::inner_prod( entry->m_normal, key.m_normal ) >= this->m_normal_tolerance )
+          {
+            V s;
+            V t;
+            tiny::orthonormal_vectors( s, t, contact->get_normal() );
+
+            V const F = swapped ? -entry->m_friction_impulse : entry->m_friction_impulse;
+
+            impulse(0) = entry->m_normal_impulse;
+            impulse(1) = tiny::inner_prod( F, t );
+            impulse(2) = tiny::inner_prod( F, s );
+            impulse(3) = entry->m_torsional_impulse;
+
+            stabilization_impulse = entry->m_stabilization_impulse;
+
+            ++matches;
+          }
+        }
+
+        contact->set_impulse( impulse );
+        contact->set_stabilization_impulse( stabilization_impulse );
+      }
+
+      return matches;
+    }
+
+  };
+
+} // namespace prox
+
+// PROX_CONTACT_CACHE_H
+#endif
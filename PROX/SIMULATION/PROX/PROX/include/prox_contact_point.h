@@ -18,6 +18,7 @@ namespace prox
     
     typedef typename M::real_type       real_type;
     typedef typename M::vector3_type    vector3_type;
+    typedef typename M::block4x1_type   block4x1_type;
     typedef          RigidBody<M>       body_type;
     
   protected:
@@ -28,6 +29,17 @@ namespace prox
     
     body_type *      m_body_i;
     body_type *      m_body_j;
+
+    size_t           m_body_idx_i;      ///< The index of body i at the time the contact was generated.
+    size_t           m_body_idx_j;      ///< The index of body j at the time the contact was generated.
+    size_t           m_feature_i;       ///< The feature index on body i that generated the contact (shape or tetrahedron index).
+    size_t           m_feature_j;       ///< The feature index on body j that generated the contact (shape or tetrahedron index).
+    size_t           m_feature_point;   ///< The order of the contact among all contacts generated by the same feature pair.
+
+    block4x1_type    m_impulse;         ///< The contact impulse (normal, two friction and torsional
+                                        ///< components) used for warm starting the prox solvers.
+    real_type        m_stabilization_impulse; ///< The normal impulse of the post stabilization, used for
+                                              ///< warm starting the stabilization solver.
     
   public:
 
@@ -37,6 +49,13 @@ namespace prox
     , m_depth(real_type(0))
     , m_body_i(0)
     , m_body_j(0)
+    , m_body_idx_i(0u)
+    , m_body_idx_j(0u)
+    , m_feature_i(0u)
+    , m_feature_j(0u)
+    , m_feature_point(0u)
+    , m_impulse(real_type(0))
+    , m_stabilization_impulse(real_type(0))
     {}
     
     virtual ~ContactPoint(){}
@@ -58,6 +77,13 @@ namespace prox
         this->m_depth       = point.m_depth;
         this->m_body_i      = point.m_body_i;
         this->m_body_j      = point.m_body_j;
+        this->m_body_idx_i    = point.m_body_idx_i;
+        this->m_body_idx_j    = point.m_body_idx_j;
+        this->m_feature_i     = point.m_feature_i;
+        this->m_feature_j     = point.m_feature_j;
+        this->m_feature_point = point.m_feature_point;
+        this->m_impulse       = point.m_impulse;
+        this->m_stabilization_impulse = point.m_stabilization_impulse;
       }
       return *this;
     }
@@ -67,16 +93,36 @@ namespace prox
     real_type    const & get_depth()    const  {  return this->m_depth;    }
     body_type    const * get_body_i()    const {  return this->m_body_i;   }
     body_type    const * get_body_j()    const {  return this->m_body_j;   }
+
+    size_t const & get_body_idx_i()    const { return this->m_body_idx_i;    }
+    size_t const & get_body_idx_j()    const { return this->m_body_idx_j;    }
+    size_t const & get_feature_i()     const { return this->m_feature_i;     }
+    size_t const & get_feature_j()     const { return this->m_feature_j;     }
+    size_t const & get_feature_point() const { return this->m_feature_point; }
+
+    block4x1_type const & get_impulse() const { return this->m_impulse; }
+    real_type     const & get_stabilization_impulse() const { return this->m_stabilization_impulse; }
     
     void set_position(vector3_type const & p)  {  this->m_position = p;    }
     void set_normal(vector3_type const & n)    {  this->m_normal = n;      }
     void set_depth(real_type const & d)        {  this->m_depth = d;       }
 
+    void set_features(size_t const & feature_i, size_t const & feature_j, size_t const & feature_point)
+    {
+      this->m_feature_i     = feature_i;
+      this->m_feature_j     = feature_j;
+      this->m_feature_point = feature_point;
+    }
+
+    void set_impulse(block4x1_type const & impulse) { this->m_impulse = impulse; }
+    void set_stabilization_impulse(real_type const & impulse) { this->m_stabilization_impulse = impulse; }
+
     void set_body_i(body_type const * body_i)
     {
       assert(body_i  || !"ContactPoint::set_body_i(): body i pointer was null ");
 
       this->m_body_i = const_cast<body_type*>(body_i); // 2009-11-25 Kenny: hmm can we not get rid of const casts?
+      this->m_body_idx_i = body_i->get_idx();
     }
 
     void set_body_j(body_type const * body_j)
@@ -84,6 +130,7 @@ namespace prox
       assert(body_j  || !"ContactPoint::set_body_i(): body j pointer was null ");
 
       this->m_body_j = const_cast<body_type*>(body_j);   // 2009-11-25 Kenny: hmm can we not get rid of const casts?
+      this->m_body_idx_j = body_j->get_idx();
     }
 
   public:
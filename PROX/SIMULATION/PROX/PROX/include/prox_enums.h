@@ -19,6 +19,8 @@ namespace prox
   typedef enum {
     jacobi
     , gauss_seidel
+    , parallel_gauss_seidel
+    , parallel_jacobi
   } solver_type;
 
 
@@ -58,6 +60,16 @@ namespace prox
     , friction_infinity
   } friction_sub_solver_type;
 
+  /**
+   * Broad phase collision detection algorithm type.
+   */
+  typedef enum {
+    grid_broad_phase
+    , all_pair_broad_phase
+    , sweep_and_prune_broad_phase
+    , parallel_grid_broad_phase
+  } broad_phase_type;
+
 
 } // namespace prox
 
@@ -13,6 +13,8 @@ namespace prox
 
   /**
    *
+   * @param begin  Random access iterator to the first body.
+   * @param end    Random access iterator to one past the last body.
    * @param h      Upon return this parameter contains the total external forces
    *               and torques acting on the bodies in the system
    */
@@ -31,12 +33,16 @@ namespace prox
     typedef typename MT::block6x1_type    B6x1;
     typedef typename MT::value_traits     VT;
 
-    size_t const N = std::distance(begin,end);
+    long const N = static_cast<long>( std::distance(begin,end) );
     h.resize( N );
 
-    size_t k = 0u;
-    for(body_iterator body = begin;body!=end;++body, ++k)
+    // Force callbacks are const and only read the body they are given, so
+    // the bodies can be processed in parallel.
+#pragma omp parallel for schedule(static)
+    for(long k = 0; k < N; ++k)
     {
+      body_iterator const body = begin + k;
+
       B6x1 & b = h( k );
 
       if(body->is_fixed() || body->is_scripted() )
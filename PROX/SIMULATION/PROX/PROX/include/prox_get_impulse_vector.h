@@ -0,0 +1,31 @@
+#ifndef PROX_GET_IMPULSE_VECTOR_H
+#define PROX_GET_IMPULSE_VECTOR_H
+
+namespace prox
+{
+  
+  template<
+  typename contact_iterator
+  , typename math_policy
+  >
+  inline void get_impulse_vector( 
+                                 contact_iterator begin
+                                 , contact_iterator end
+                                 , typename math_policy::vector4_type & lambda
+                                 , math_policy const & /*tag*/ 
+                                 , size_t const K
+                                 )
+  {
+    lambda.resize( K );
+
+    size_t k = 0u;
+    for(contact_iterator contact = begin;contact!=end;++contact, ++k)
+    {
+      lambda( k ) = contact->get_impulse();
+    }
+  }
+  
+} // namespace prox
+
+// PROX_GET_IMPULSE_VECTOR_H
+#endif 
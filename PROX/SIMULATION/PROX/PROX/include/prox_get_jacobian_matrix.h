@@ -28,9 +28,12 @@ namespace prox
     typedef typename math_policy::vector3_type       vector3_type;
     typedef typename math_policy::quaternion_type    quaternion_type;
     typedef typename math_policy::block4x6_type      block4x6_type;
+    typedef typename math_policy::real_type          real_type;
+    typedef typename math_policy::value_traits       value_traits;
     
     size_t const N = bodies.size();
     
+    J.clear();  // Keeps the storage of J, so the matrix can be reused from step to step
     J.resize( K, N, 2*K );
     
     size_t k = 0u;
@@ -76,10 +79,10 @@ namespace prox
         }
         
         s_k = tiny::rotate( Q, property->get_s_vector() );	  
-        float const c = tiny::inner_prod(n_k,s_k);  
+        real_type const c = tiny::inner_prod(n_k,s_k);  
         s_k = tiny::unit(s_k - n_k*c);
-        float const s_test = tiny::inner_prod(s_k,s_k);
-        if (s_test>10e-5f)
+        real_type const s_test = tiny::inner_prod(s_k,s_k);
+        if (s_test > value_traits::numeric_cast(10e-5f))
         {
           t_k = tiny::cross(n_k,s_k);
         } 
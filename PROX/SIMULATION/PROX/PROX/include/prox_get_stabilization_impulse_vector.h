@@ -0,0 +1,36 @@
+#ifndef PROX_GET_STABILIZATION_IMPULSE_VECTOR_H
+#define PROX_GET_STABILIZATION_IMPULSE_VECTOR_H
+
+namespace prox
+{
+  
+  template<
+  typename contact_iterator
+  , typename math_policy
+  >
+  inline void get_stabilization_impulse_vector( 
+                                               contact_iterator begin
+                                               , contact_iterator end
+                                               , typename math_policy::vector4_type & lambda
+                                               , math_policy const & /*tag*/ 
+                                               , size_t const K
+                                               )
+  {
+    typedef typename math_policy::value_traits VT;
+
+    lambda.resize( K );
+
+    size_t k = 0u;
+    for(contact_iterator contact = begin;contact!=end;++contact, ++k)
+    {
+      lambda( k )( 0 ) = contact->get_stabilization_impulse();
+      lambda( k )( 1 ) = VT::zero();
+      lambda( k )( 2 ) = VT::zero();
+      lambda( k )( 3 ) = VT::zero();
+    }
+  }
+  
+} // namespace prox
+
+// PROX_GET_STABILIZATION_IMPULSE_VECTOR_H
+#endif 
@@ -12,7 +12,15 @@
 namespace prox
 {
         
-    template< typename T >
+    /**
+     * Math types policy.
+     *
+     * @tparam T   The real type used for body states and accumulation.
+     * @tparam S   The real type used for the blocks of the contact solver. Mixed
+     *             precision keeps T as double and lets S be float to save memory
+     *             bandwidth in the solver.
+     */
+    template< typename T, typename S = T >
     class MathPolicy
     : public tiny::MathTypes<T>
     {
@@ -20,6 +28,7 @@ namespace prox
         
         typedef tiny::MathTypes<T>                            base_type;
         typedef tiny::MathTypes<T>                            tiny_types;
+        typedef MathPolicy<S>                                 solver_policy;
 
     public:
         
@@ -90,10 +99,21 @@ namespace prox
         {
             compressed6x4_type JT;
             
+            compute_WJT(W, J, JT, WJT);
+        }
+        
+        // JT is a work buffer for the transpose of J, pass the same
+        // buffer on every call to reuse its storage.
+        static void compute_WJT(
+                                diagonal6x6_type const& W
+                                , compressed4x6_type const& J
+                                , compressed6x4_type & JT
+                                , compressed6x4_type & WJT
+                                )
+        {
             // TODO: can probably be optimised by doing W x J -> WJ^T on the fly
             sparse::transpose(J, JT);
-            WJT.resize(W.nrows(), JT.ncols(), JT.size());
-            sparse::prod(W, JT, WJT);
+            compute_WJT(W, JT, WJT);
         }
         
         static void compute_WJT(
@@ -102,6 +122,7 @@ namespace prox
                                 , compressed6x4_type & WJT
                                 )
         {
+            WJT.clear();  // Keeps the storage, but the product accumulates into the blocks of WJT
             WJT.resize(W.nrows(), JT.ncols(), JT.size());
             sparse::prod(W, JT, WJT);
         }
@@ -1,6 +1,7 @@
 #ifndef PROX_PARAMS_H
 #define PROX_PARAMS_H
 
+#include <prox_enums.h>                    // Needed for broad_phase_type
 #include <solvers/prox_solver_params.h>    // Needed for SolverParams
 #include <steppers/prox_stepper_params.h>  // Needed for StepperParams
 
@@ -28,10 +29,11 @@ namespace prox
     solver_params_type  m_solver_params;     ///< Parameters used for prox solvers.
     stepper_params_type m_stepper_params;    ///< Parameters used for prox steppers.
 
-    bool   m_use_all_pair;                   ///< Parameter for controlling if
-                                             ///< all-pair or grid algorithm should
-                                             ///< be used for broad phase collision
-                                             ///< detetection. Default is false (=off).
+    broad_phase_type m_broad_phase;          ///< Parameter for controlling if
+                                             ///< grid, all-pair, sweep and prune or
+                                             ///< parallel grid algorithm should be
+                                             ///< used for broad phase collision
+                                             ///< detetection. Default is grid.
     
   public:
 
@@ -41,15 +43,15 @@ namespace prox
     stepper_params_type const & stepper_params() const { return this->m_stepper_params; }
     stepper_params_type       & stepper_params()       { return this->m_stepper_params; }
 
-    bool const & use_all_pair() const { return this->m_use_all_pair; }
-    bool       & use_all_pair()       { return this->m_use_all_pair; }
+    broad_phase_type const & broad_phase() const { return this->m_broad_phase; }
+    broad_phase_type       & broad_phase()       { return this->m_broad_phase; }
 
   public:
     
     Params()
     : m_solver_params()
     , m_stepper_params()
-    , m_use_all_pair(false)
+    , m_broad_phase(grid_broad_phase)
     {}
   };
 
@@ -22,6 +22,7 @@ namespace prox
     typedef typename math_policy::block6x1_type block6x1_type;
     typedef typename math_policy::block7x1_type block7x1_type;
     
+    typedef typename math_policy::real_type     real_type;
     typedef typename math_policy::value_traits  value_traits;
     
     size_t const N = u.size();
@@ -39,9 +40,12 @@ namespace prox
       qnew.resize( N );
     }
     
-    float const dt_half = dt / value_traits::two();
+    real_type const dt_half = dt / value_traits::two();
     
-    for(size_t i = 0; i<N; ++i)
+    long const B = static_cast<long>( N );
+
+#pragma omp parallel for schedule(static)
+    for(long i = 0; i<B; ++i)
     {
       block7x1_type & qnew_b = qnew( i );
       block7x1_type const& q_b = q( i );
@@ -86,7 +90,7 @@ namespace prox
         //   Q \leftarrow  H Q
         //
         // There should be no need to normalize Q after this operation.
-        float const radian = tiny::norm( W )*dt;
+        real_type const radian = tiny::norm( W )*dt;
         vector3_type axis  = tiny::unit( W );
         quaternion_type R = quaternion_type::Ru( radian, axis ); 
         Q = tiny::prod(R,Q);
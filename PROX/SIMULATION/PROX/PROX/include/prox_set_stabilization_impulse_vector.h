@@ -0,0 +1,28 @@
+#ifndef PROX_SET_STABILIZATION_IMPULSE_VECTOR_H
+#define PROX_SET_STABILIZATION_IMPULSE_VECTOR_H
+
+namespace prox
+{
+  
+  template<
+  typename contact_iterator
+  , typename math_policy
+  >
+  inline void set_stabilization_impulse_vector( 
+                                               contact_iterator begin
+                                               , contact_iterator end
+                                               , typename math_policy::vector4_type const & lambda
+                                               , math_policy const & /*tag*/ 
+                                               )
+  {
+    size_t k = 0u;
+    for(contact_iterator contact = begin;contact!=end;++contact, ++k)
+    {
+      contact->set_stabilization_impulse( lambda( k )( 0 ) );
+    }
+  }
+  
+} // namespace prox
+
+// PROX_SET_STABILIZATION_IMPULSE_VECTOR_H
+#endif 
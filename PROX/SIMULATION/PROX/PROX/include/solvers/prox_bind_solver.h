@@ -7,6 +7,10 @@
 
 #include <solvers/prox_jacobi_solver.h>
 #include <solvers/prox_gauss_seidel_solver.h>
+#include <solvers/prox_parallel_gauss_seidel_solver.h>
+#include <solvers/prox_parallel_jacobi_solver.h>
+
+#include <solvers/sub/prox_sub_solver_ops.h>
 
 #include <util_log.h>
 
@@ -34,6 +38,7 @@ namespace prox
                                   , NormalSubSolver<typename M::real_type> const &
                                   , FrictionSubSolver<typename M::real_type> const &
                                   , SolverParams<M> const &
+                                  , SolverWorkspace<M> &
                                   , M const & tag 
                                   );
     
@@ -63,12 +68,13 @@ namespace prox
                     , NormalSubSolver<typename M::real_type> const & normal_solver
                     , FrictionSubSolver<typename M::real_type> const & friction_solver
                     , SolverParams<M> const & params
+                    , SolverWorkspace<M> & workspace
                     , M const & tag
                     ) const
     {
       assert( this->m_solver || !"SolverBinder(): solver was null");
       
-      this->m_solver( J, WJT, b, mu, lambda, strategy, normal_solver, friction_solver, params, M() );
+      this->m_solver( J, WJT, b, mu, lambda, strategy, normal_solver, friction_solver, params, workspace, M() );
     }
     
   };
@@ -91,6 +97,14 @@ namespace prox
         logging << "bind_solver(): using gauss seidel solver"<< util::Log::newline();
         return SolverBinder<M>( &gauss_seidel_solver<M> );
         
+      case parallel_gauss_seidel:
+        logging << "bind_solver(): using parallel gauss seidel solver"<< util::Log::newline();
+        return SolverBinder<M>( &parallel_gauss_seidel_solver<M> );
+        
+      case parallel_jacobi:
+        logging << "bind_solver(): using parallel jacobi solver"<< util::Log::newline();
+        return SolverBinder<M>( &parallel_jacobi_solver<M> );
+        
       default:
         assert(!"bind_solver(): unknown solver type");
         break;
@@ -98,6 +112,101 @@ namespace prox
     
     return SolverBinder<M>();
   }
+
+  /**
+   * Bind the parallel Jacobi solver instantiated with the normal sub
+   * solver functor NS and the friction sub solver functor of the given type.
+   */
+  template<typename M, typename NS>
+  inline SolverBinder<M> bind_parallel_jacobi_solver( friction_sub_solver_type const & friction )
+  {
+    typedef typename M::real_type  T;
+
+    switch( friction )
+    {
+      case analytical_sphere:
+        return SolverBinder<M>( &parallel_jacobi_solver< M, NS, AnalyticalSphereOp<T> > );
+
+      case analytical_ellipsoid:
+        return SolverBinder<M>( &parallel_jacobi_solver< M, NS, AnalyticalEllipsoidOp<T> > );
+
+      case numerical_ellipsoid:
+        return SolverBinder<M>( &parallel_jacobi_solver< M, NS, NumericalEllipsoidOp<T> > );
+
+      case gjk_ellipsoid:
+        return SolverBinder<M>( &parallel_jacobi_solver< M, NS, GJKEllipsoidOp<T> > );
+
+      case box_model:
+        return SolverBinder<M>( &parallel_jacobi_solver< M, NS, BoxModelOp<T> > );
+
+      case friction_origin:
+        return SolverBinder<M>( &parallel_jacobi_solver< M, NS, FrictionOriginOp<T> > );
+
+      case friction_infinity:
+        return SolverBinder<M>( &parallel_jacobi_solver< M, NS, FrictionInfinityOp<T> > );
+
+      default:
+        assert(!"bind_parallel_jacobi_solver(): unknown friction solver type");
+        break;
+    };
+
+    return SolverBinder<M>();
+  }
+
+  /**
+   * Bind the parallel Jacobi solver instantiated with the sub solver
+   * functors of the given types.
+   */
+  template<typename M>
+  inline SolverBinder<M> bind_parallel_jacobi_solver(
+                                                     normal_sub_solver_type const & normal
+                                                     , friction_sub_solver_type const & friction
+                                                     )
+  {
+    typedef typename M::real_type  T;
+
+    switch( normal )
+    {
+      case nonnegative:
+        return bind_parallel_jacobi_solver< M, NonnegativeOp<T> >( friction );
+
+      case normal_origin:
+        return bind_parallel_jacobi_solver< M, NormalOriginOp<T> >( friction );
+
+      case normal_infinity:
+        return bind_parallel_jacobi_solver< M, NormalInfinityOp<T> >( friction );
+
+      default:
+        assert(!"bind_parallel_jacobi_solver(): unknown normal solver type");
+        break;
+    };
+
+    return SolverBinder<M>();
+  }
+
+  /**
+   * Bind a solver knowing the sub solvers it will be called with. Solvers
+   * that are templated on the sub solvers are then instantiated with the
+   * concrete sub solver types, currently only the parallel Jacobi solver.
+   * The sub solver binders must still be passed to the bound solver, the
+   * other solvers call the sub solvers through them.
+   */
+  template<typename M>
+  inline SolverBinder<M> bind_solver(
+                                     solver_type const & type
+                                     , normal_sub_solver_type const & normal
+                                     , friction_sub_solver_type const & friction
+                                     )
+  {
+    if( type != parallel_jacobi )
+      return bind_solver<M>( type );
+
+    util::Log logging;
+
+    logging << "bind_solver(): using parallel jacobi solver"<< util::Log::newline();
+
+    return bind_parallel_jacobi_solver<M>( normal, friction );
+  }
   
 } //namespace prox
 
@@ -0,0 +1,121 @@
+#ifndef PROX_CONTACT_COLORING_H
+#define PROX_CONTACT_COLORING_H
+
+#include <vector>
+
+namespace prox
+{
+
+  namespace detail
+  {
+
+    /**
+     * The contacts grouped by color in compressed row form. The contacts
+     * of color c are found in m_contacts in the range
+     * [m_color_ptr[c], m_color_ptr[c+1]).
+     */
+    class ContactColoring
+    {
+    public:
+
+      std::vector<size_t> m_color_ptr;    ///< Start of each color in m_contacts, one more entry than there are colors.
+      std::vector<size_t> m_contacts;     ///< Contact indices ordered by color.
+      std::vector<size_t> m_last_color;   ///< Scratch buffer, the last color given to a contact of each body.
+      std::vector<size_t> m_uncolored;    ///< Scratch buffer, the contacts still without a color.
+
+    public:
+
+      size_t size() const { return this->m_color_ptr.empty() ? 0u : this->m_color_ptr.size() - 1u; }
+
+    };
+
+    /**
+     * Greedy coloring of the contact graph. Two contacts get different colors
+     * if they share a dynamic body. Contacts of the same color can therefore
+     * be solved concurrently by a Gauss-Seidel scheme as they never update the
+     * same entries of w = W J^T x.
+     *
+     * The colors are handed out one at a time. A sweep over the contacts
+     * without a color gives the current color to every contact none of
+     * whose dynamic bodies already has it, which is checked against the last
+     * color given to each body. Each contact so gets the lowest color not
+     * used by a contact before it that shares a dynamic body, like a
+     * first-fit coloring in contact order.
+     *
+     * @param J          The Jacobian matrix.
+     * @param dynamic    Tells for each body whether it is dynamic or not.
+     * @param coloring   Upon return holds the contacts of each color.
+     */
+    template< typename M >
+    inline void color_contacts(
+                               typename M::compressed4x6_type const & J
+                               , std::vector<bool> const & dynamic
+                               , ContactColoring & coloring
+                               )
+    {
+      typedef typename M::compressed4x6_type                  CSR4x6;
+      typedef typename CSR4x6::const_row_iterator             row_iterator;
+
+      size_t const K = J.nrows();
+      size_t const N = J.ncols();
+
+      std::vector<size_t> & last_color = coloring.m_last_color;
+      std::vector<size_t> & uncolored  = coloring.m_uncolored;
+
+      last_color.assign( N, K );  // No contact has K colors, so K means not colored yet
+
+      uncolored.resize( K );
+      for(size_t k = 0u; k < K; ++k)
+        uncolored[k] = k;
+
+      coloring.m_contacts.clear();
+      coloring.m_color_ptr.assign( 1u, 0u );
+
+      size_t remaining = K;
+
+      for(size_t color = 0u; remaining > 0u; ++color)
+      {
+        size_t left = 0u;  // Contacts that did not get this color are moved to the front of uncolored
+
+        for(size_t m = 0u; m < remaining; ++m)
+        {
+          size_t const k = uncolored[m];
+
+          bool conflict = false;
+
+          for(row_iterator iter = J.row_begin(k); iter != J.row_end(k) && !conflict; ++iter)
+          {
+            size_t const i = col(iter);
+
+            conflict = dynamic[i] && last_color[i] == color;
+          }
+
+          if( conflict )
+          {
+            uncolored[left++] = k;
+            continue;
+          }
+
+          for(row_iterator iter = J.row_begin(k); iter != J.row_end(k); ++iter)
+          {
+            size_t const i = col(iter);
+
+            if( dynamic[i] )
+              last_color[i] = color;
+          }
+
+          coloring.m_contacts.push_back( k );
+        }
+
+        coloring.m_color_ptr.push_back( coloring.m_contacts.size() );
+
+        remaining = left;
+      }
+    }
+
+  } // namespace detail
+
+} //namespace prox
+
+// PROX_CONTACT_COLORING_H
+#endif
@@ -0,0 +1,193 @@
+#ifndef PROX_FLAT_BLOCK_MATRIX_H
+#define PROX_FLAT_BLOCK_MATRIX_H
+
+#include <vector>
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+namespace prox
+{
+
+  namespace detail
+  {
+
+    /**
+     * A flat copy of a compressed row block matrix. The values of all blocks
+     * are stored back to back in one contiguous array, such that the solver
+     * kernels can stream through them without going through the block
+     * iterators and the column look-ups of the sparse library.
+     *
+     * Each block is stored column by column, as a structure of its column
+     * arrays. A column of a 4x6 block of J is four consecutive values and a
+     * column of a 6x4 block of W J^T is six consecutive values. A block times
+     * vector product is then a sum of whole columns scaled by the vector
+     * entries, see prod_add_4x6 and prod_add_6x4. This maps onto packed
+     * multiply-adds of the columns, where the row-major layout needs a
+     * horizontal sum for every row.
+     *
+     * The arrays are only resized when a new matrix is assigned, so a copy
+     * kept alive between calls does not allocate unless the matrix grows.
+     *
+     * @tparam T   The real type.
+     * @tparam R   The number of rows in a block.
+     * @tparam C   The number of columns in a block.
+     */
+    template<typename T, size_t R, size_t C>
+    class FlatBlockMatrix
+    {
+    public:
+
+      static size_t const block_size = R*C;
+
+      std::vector<size_t> m_row_ptr;   ///< Blocks of row i are found in the range [m_row_ptr[i], m_row_ptr[i+1]).
+      std::vector<size_t> m_cols;      ///< Block column index of each block.
+      std::vector<T>      m_data;      ///< Column-major values of each block, block_size values per block.
+
+    public:
+
+      template<typename matrix_type>
+      void assign(matrix_type const & A)
+      {
+        typedef typename matrix_type::const_row_iterator  row_iterator;
+
+        size_t const rows = A.nrows();
+
+        this->m_row_ptr.resize( rows + 1u );
+        this->m_cols.resize( A.size() );
+        this->m_data.resize( A.size()*block_size );
+
+        size_t p = 0u;
+
+        for(size_t i = 0u; i < rows; ++i)
+        {
+          this->m_row_ptr[i] = p;
+
+          if( i < A.top_non_zero_row() )
+          {
+            for(row_iterator iter = A.row_begin(i); iter != A.row_end(i); ++iter, ++p)
+            {
+              this->m_cols[p] = col(iter);
+
+              T * block = &this->m_data[p*block_size];
+
+              for(size_t c = 0u; c < C; ++c)
+                for(size_t r = 0u; r < R; ++r)
+                  block[c*R + r] = (*iter)(r,c);
+            }
+          }
+        }
+
+        this->m_row_ptr[rows] = p;
+      }
+
+    };
+
+    /**
+     * y += A x, where A is a column-major 4x6 block of a FlatBlockMatrix.
+     */
+    template<typename T>
+    inline void prod_add_4x6( T const * A, T const * x, T * y )
+    {
+      for(size_t c = 0u; c < 6u; ++c)
+        for(size_t r = 0u; r < 4u; ++r)
+          y[r] += A[4u*c + r]*x[c];
+    }
+
+    /**
+     * y += A x, where A is a column-major 6x4 block of a FlatBlockMatrix.
+     */
+    template<typename T>
+    inline void prod_add_6x4( T const * A, T const * x, T * y )
+    {
+      for(size_t c = 0u; c < 4u; ++c)
+        for(size_t r = 0u; r < 6u; ++r)
+          y[r] += A[6u*c + r]*x[c];
+    }
+
+#if defined(__SSE__)
+
+    /**
+     * A float column of a 4x6 block fills one register, so the product is
+     * six multiply-adds of the columns with the broadcasted entries of x.
+     */
+    inline void prod_add_4x6( float const * A, float const * x, float * y )
+    {
+      __m128 acc = _mm_loadu_ps( y );
+
+      for(size_t c = 0u; c < 6u; ++c)
+        acc = _mm_add_ps( acc, _mm_mul_ps( _mm_loadu_ps( A + 4u*c ), _mm_set1_ps( x[c] ) ) );
+
+      _mm_storeu_ps( y, acc );
+    }
+
+    /**
+     * A float column of a 6x4 block is split into rows 0-3, loaded as one
+     * register, and rows 4-5, loaded into the lower half of another.
+     */
+    inline void prod_add_6x4( float const * A, float const * x, float * y )
+    {
+      __m128 lower = _mm_loadu_ps( y );
+      __m128 upper = _mm_loadl_pi( _mm_setzero_ps(), reinterpret_cast<__m64 const *>( y + 4u ) );
+
+      for(size_t c = 0u; c < 4u; ++c)
+      {
+        __m128 const x_c = _mm_set1_ps( x[c] );
+
+        lower = _mm_add_ps( lower, _mm_mul_ps( _mm_loadu_ps( A + 6u*c ), x_c ) );
+        upper = _mm_add_ps( upper, _mm_mul_ps( _mm_loadl_pi( _mm_setzero_ps(), reinterpret_cast<__m64 const *>( A + 6u*c + 4u ) ), x_c ) );
+      }
+
+      _mm_storeu_ps( y, lower );
+      _mm_storel_pi( reinterpret_cast<__m64 *>( y + 4u ), upper );
+    }
+
+#endif // defined(__SSE__)
+
+#if defined(__AVX__)
+
+    /**
+     * Double precision version, a column of a 4x6 block fills one AVX register.
+     */
+    inline void prod_add_4x6( double const * A, double const * x, double * y )
+    {
+      __m256d acc = _mm256_loadu_pd( y );
+
+      for(size_t c = 0u; c < 6u; ++c)
+        acc = _mm256_add_pd( acc, _mm256_mul_pd( _mm256_loadu_pd( A + 4u*c ), _mm256_set1_pd( x[c] ) ) );
+
+      _mm256_storeu_pd( y, acc );
+    }
+
+    /**
+     * Double precision version, rows 0-3 of a column of a 6x4 block are
+     * loaded as one AVX register and rows 4-5 as one SSE register.
+     */
+    inline void prod_add_6x4( double const * A, double const * x, double * y )
+    {
+      __m256d lower = _mm256_loadu_pd( y );
+      __m128d upper = _mm_loadu_pd( y + 4u );
+
+      for(size_t c = 0u; c < 4u; ++c)
+      {
+        lower = _mm256_add_pd( lower, _mm256_mul_pd( _mm256_loadu_pd( A + 6u*c ), _mm256_set1_pd( x[c] ) ) );
+        upper = _mm_add_pd( upper, _mm_mul_pd( _mm_loadu_pd( A + 6u*c + 4u ), _mm_set1_pd( x[c] ) ) );
+      }
+
+      _mm256_storeu_pd( y, lower );
+      _mm_storeu_pd( y + 4u, upper );
+    }
+
+#endif // defined(__AVX__)
+
+  } // namespace detail
+
+} //namespace prox
+
+// PROX_FLAT_BLOCK_MATRIX_H
+#endif
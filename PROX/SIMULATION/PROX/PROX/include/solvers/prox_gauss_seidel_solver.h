@@ -6,6 +6,7 @@
 #include <solvers/strategies/prox_R_strategy.h>
 
 #include <solvers/prox_solver_params.h>
+#include <solvers/prox_solver_workspace.h>
 
 #include <util_profiling.h>
 #include <util_log.h>
@@ -30,6 +31,7 @@ namespace prox
                                   , NormalSubSolver<typename M::real_type> const & normal_solver
                                   , FrictionSubSolver<typename M::real_type> const & friction_solver
                                   , SolverParams<M> const& params
+                                  , SolverWorkspace<M> & workspace
                                   , M const & tag
                                   )
   {
@@ -51,7 +53,10 @@ namespace prox
     size_t rel_conv_in_iteration = 0u; //used for profiling, to record in what iteration we found relative convergence
     size_t count_divergence      = 0u; //used for profiling, to record how many times we have discovered divergence
     
-    if( !params.use_warm_starting() )
+    //--- Only warm start if the caller supplied an initial iterate for all contacts
+    bool const warm_start = params.use_warm_starting() && (lambda.size() == K);
+
+    if( !warm_start )
     {
       lambda.resize( K );
     }
@@ -59,28 +64,50 @@ namespace prox
     if( K == 0u )
       return;
     
-    V4 x;           // Solution iterates, separate from lambda to be able to roll back
+    V4 & x = workspace.m_x;   // Solution iterates, separate from lambda to be able to roll back
     
-    x.resize( K );  // 2012-07-14 Sarah code review: x only gets initialized
-                    // when using warm starting? but x(k) is used in either case
+    x.resize( K );
     
-    if( params.use_warm_starting() )
+    if( warm_start )
     {
       x = lambda;   // Only in case of warm-starting
     }
+    else
+    {
+      x.clear_data();
+    }
     
-    V4 residual;
+    V4 & residual = workspace.m_residual;
     residual.resize( K );
     
     T last_residual_norm = VT::infinity();    // Used to detect divergence.
     
-    D4x4 R;
-    D4x4 nu;
+    D4x4 & R  = workspace.m_R;
+    D4x4 & nu = workspace.m_nu;
+    
+    R.resize( K, false );   // The strategies only write the diagonals
+    nu.resize( K, false );
     
     strategy(J, WJT, R, nu );
     
-    V6 w;
-    w.resize( J.ncols() );// what is in w???
+    V6 & w = workspace.m_w;
+    w.resize( J.ncols() );
+
+    //--- w = W J^T x must match the initial iterate, otherwise the
+    //--- incremental updates of w are off by the warm started impulses.
+    if( warm_start )
+    {
+      sparse::prod( WJT, x, w, true );
+    }
+    else
+    {
+      w.clear_data();
+    }
+
+    //--- Find the blocks of WJT used by the w updates once, instead of
+    //--- searching for them in every iteration.
+    std::vector<size_t> & WJT_index = workspace.m_WJT_index;
+    sparse::column_prod_index( WJT, J, WJT_index );
     
     T residual_norm;
     
@@ -117,7 +144,7 @@ namespace prox
         sparse::sub(x_k, delta_x, delta_x);
         
         //--- Updating w, math_policy::update_w(WJT, J, delta_x, k, w);
-        sparse::column_prod( WJT, J, delta_x, w, k);
+        sparse::column_prod( WJT, J, WJT_index, delta_x, w, k);
       }
       
       //--- compute the residual, residual = lambda^k - lambda^(k+1)
@@ -2,6 +2,7 @@
 #define PROX_JACOBI_SOLVER_H
 
 #include <solvers/prox_solver_params.h>
+#include <solvers/prox_solver_workspace.h>
 
 #include <solvers/sub/prox_normal_sub_solver.h>
 #include <solvers/sub/prox_friction_sub_solver.h>
@@ -33,6 +34,7 @@ namespace prox
                             , NormalSubSolver<typename M::real_type> const & normal_solver
                             , FrictionSubSolver<typename M::real_type> const & friction_solver
                             , SolverParams<M> const & params
+                            , SolverWorkspace<M> & workspace
                             , M const & tag
                             ) 
   {
@@ -54,7 +56,9 @@ namespace prox
     size_t count_divergence      = 0u; //used for profiling, to record how many times we have discovered divergence
 
     //--- If warm starting is not used then clear the initial iterate
-    if(! params.use_warm_starting() )
+    bool const warm_start = params.use_warm_starting() && (lambda.size() == K);
+
+    if(! warm_start )
     {
       lambda.resize( K );
     }
@@ -65,26 +69,34 @@ namespace prox
     size_t in = 0;    // Solution vector index that remembers the input iterate to the Jacobi scheme.
     size_t out = 1;   // Solution vector index that remembers the output iterate to the Jacobi scheme.
     
-    V4 x[2]; // solution iterates, needed to do flip-flopping of solution vector in the Jacobi scheme
-    x[in].resize( K );
-    x[out].resize( K );
+    V4 * x[2] = { &workspace.m_x, &workspace.m_y }; // solution iterates, needed to do flip-flopping of solution vector in the Jacobi scheme
+    x[in]->resize( K );
+    x[out]->resize( K );
+    x[out]->clear_data();
     
-    if(params.use_warm_starting())
+    if(warm_start)
     {
-      x[in] = lambda;
+      *x[in] = lambda;
+    }
+    else
+    {
+      x[in]->clear_data();
     }
     
-    V4 residual;
+    V4 & residual = workspace.m_residual;
     residual.resize( K );
     
     T last_residual_norm = VT::infinity(); // Used to detect divergence.
     
-    D4x4 R;
-    D4x4 nu;
+    D4x4 & R  = workspace.m_R;
+    D4x4 & nu = workspace.m_nu;
+    
+    R.resize( K, false );   // The strategies only write the diagonals
+    nu.resize( K, false );
     
     strategy(J, WJT, R, nu );
     
-    V4 z;
+    V4 & z = workspace.m_z;
     bool last_iteration_diverged = false;
     
     //--- Jacobi loops
@@ -95,14 +107,14 @@ namespace prox
       last_iteration_diverged = false;
       
       //--- Compute z = x - R(J W J^T x  + b)  = x - R( A x  + b)
-      M::compute_z( x[in], R, J, WJT, b, z );
+      M::compute_z( *x[in], R, J, WJT, b, z );
       
       for(size_t k = 0u; k < K;++k )
       {
         B4x1 const &  mu_k    = mu(k);
         B4x1 const &  z_k     = z(k);
-        B4x1 const &  x_k_in  = x[in](k);
-        B4x1       &  x_k_out = x[out](k);
+        B4x1 const &  x_k_in  = (*x[in])(k);
+        B4x1       &  x_k_out = (*x[out])(k);
         
         size_t const n   = 0u;
         size_t const s   = 1u;
@@ -115,7 +127,7 @@ namespace prox
       }
       
       //--- Compute residual, residual = lambda^k - lambda^(k+1)
-      sparse::sub(x[in], x[out], residual );
+      sparse::sub(*x[in], *x[out], residual );
       
       T const residual_norm = M::compute_norm_inf( residual );
       
@@ -177,9 +189,9 @@ namespace prox
     }
 
     if( last_iteration_diverged )
-      lambda = x[in];
+      lambda = *x[in];
     else
-      lambda = x[out];
+      lambda = *x[out];
     
     RECORD("abs_conv",   abs_conv_in_iteration);
     RECORD("rel_conv",   rel_conv_in_iteration);
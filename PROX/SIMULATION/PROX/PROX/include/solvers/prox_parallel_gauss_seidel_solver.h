@@ -0,0 +1,310 @@
+#ifndef PROX_PARALLEL_GAUSS_SEIDEL_SOLVER_H
+#define PROX_PARALLEL_GAUSS_SEIDEL_SOLVER_H
+
+#include <solvers/sub/prox_normal_sub_solver.h>
+#include <solvers/sub/prox_friction_sub_solver.h>
+#include <solvers/strategies/prox_R_strategy.h>
+
+#include <solvers/prox_solver_params.h>
+#include <solvers/prox_solver_workspace.h>
+#include <solvers/prox_contact_coloring.h>
+
+#include <util_profiling.h>
+#include <util_log.h>
+
+#include <vector>
+#include <cassert>
+
+namespace prox
+{
+
+  namespace detail
+  {
+
+    /**
+     * Find the bodies that can be affected by the contact impulses. A body
+     * is dynamic if its row in W J^T is non-zero. Fixed and scripted bodies
+     * have a zero inverse mass matrix and will never change their part of
+     * w = W J^T x.
+     *
+     * @param WJT       The product of the inverse mass matrix and the transposed Jacobian.
+     * @param dynamic   Upon return dynamic[i] is true if body i is dynamic.
+     */
+    template< typename M >
+    inline void find_dynamic_bodies(
+                                    typename M::compressed6x4_type const & WJT
+                                    , std::vector<bool> & dynamic
+                                    )
+    {
+      typedef typename M::compressed6x4_type                  CSR6x4;
+      typedef typename CSR6x4::const_row_iterator             row_iterator;
+      typedef typename M::block6x4_type                       B6x4;
+      typedef typename M::value_traits                        VT;
+
+      size_t const N = WJT.nrows();
+
+      dynamic.assign( N, false );
+
+      for(size_t i = 0u; i < N; ++i)
+      {
+        for(row_iterator iter = WJT.row_begin(i); iter != WJT.row_end(i) && !dynamic[i]; ++iter)
+        {
+          B6x4 const & block = *iter;
+
+          for(size_t r = 0u; r < B6x4::nrows() && !dynamic[i]; ++r)
+            for(size_t c = 0u; c < B6x4::ncols() && !dynamic[i]; ++c)
+              dynamic[i] = block(r,c) != VT::zero();
+        }
+      }
+    }
+
+  } // namespace detail
+
+  /**
+   * This solver use the proximal map formulation of the constraints
+   * on the motion of a rigid body system to compute the contact impulses
+   * of the contact points. The system of constraints is solved using a
+   * factorized Gauss-Seidel approach, like the gauss_seidel_solver.
+   *
+   * The contacts are colored such that no two contacts of the same color
+   * share a dynamic body. The colors are swept in turn and all contacts of
+   * one color are solved concurrently. Within one sweep the contacts are
+   * visited in a different order than the gauss_seidel_solver uses, so the
+   * iterates are not bitwise identical with the sequential solver.
+   */
+  template< typename M >
+  inline void parallel_gauss_seidel_solver(
+                                           typename M::compressed4x6_type const& J
+                                           , typename M::compressed6x4_type const& WJT
+                                           , typename M::vector4_type const& b
+                                           , typename M::vector4_type const& mu
+                                           , typename M::vector4_type & lambda
+                                           , RStrategy<M> const & strategy
+                                           , NormalSubSolver<typename M::real_type> const & normal_solver
+                                           , FrictionSubSolver<typename M::real_type> const & friction_solver
+                                           , SolverParams<M> const& params
+                                           , SolverWorkspace<M> & workspace
+                                           , M const & tag
+                                           )
+  {
+    RECORD_VECTOR_NEW("convergence");
+    RECORD_VECTOR_NEW("rfactor");
+
+    typedef typename M::block4x1_type       B4x1;
+    typedef typename M::vector4_type        V4;
+    typedef typename M::vector6_type        V6;
+    typedef typename M::diagonal4x4_type    D4x4;
+    typedef typename M::compressed4x6_type  CSR4x6;
+    typedef typename M::compressed6x4_type  CSR6x4;
+    typedef typename M::real_type           T;
+    typedef typename M::value_traits        VT;
+
+    typedef typename CSR4x6::accessor       A;
+    typedef typename CSR6x4::accessor       AT;
+
+    START_TIMER("solver");
+
+    size_t const K = J.nrows( ); // Number of blocks
+
+    size_t abs_conv_in_iteration = 0u; //used for profiling, to record in what iteration we found absolute convergence
+    size_t rel_conv_in_iteration = 0u; //used for profiling, to record in what iteration we found relative convergence
+    size_t count_divergence      = 0u; //used for profiling, to record how many times we have discovered divergence
+
+    //--- Only warm start if the caller supplied an initial iterate for all contacts
+    bool const warm_start = params.use_warm_starting() && (lambda.size() == K);
+
+    if( !warm_start )
+    {
+      lambda.resize( K );
+    }
+
+    if( K == 0u )
+      return;
+
+    V4 & x = workspace.m_x;   // Solution iterates, separate from lambda to be able to roll back
+
+    x.resize( K );
+
+    if( warm_start )
+    {
+      x = lambda;   // Only in case of warm-starting
+    }
+    else
+    {
+      x.clear_data();
+    }
+
+    V4 & residual = workspace.m_residual;
+    residual.resize( K );
+
+    T last_residual_norm = VT::infinity();    // Used to detect divergence.
+
+    D4x4 & R  = workspace.m_R;
+    D4x4 & nu = workspace.m_nu;
+
+    R.resize( K, false );   // The strategies only write the diagonals
+    nu.resize( K, false );
+
+    strategy(J, WJT, R, nu );
+
+    START_TIMER("solver_coloring");
+
+    std::vector<bool> & dynamic = workspace.m_dynamic;
+    detail::find_dynamic_bodies<M>( WJT, dynamic );
+
+    detail::ContactColoring & coloring = workspace.m_coloring;
+    detail::color_contacts<M>( J, dynamic, coloring );
+
+    STOP_TIMER("solver_coloring");
+
+    RECORD("colors", coloring.size() );
+
+    V6 & w = workspace.m_w;
+    w.resize( J.ncols() );
+
+    if( warm_start )
+    {
+      sparse::prod( WJT, x, w, true );
+    }
+    else
+    {
+      w.clear_data();
+    }
+
+    //--- Find the blocks of WJT used by the w updates once, instead of
+    //--- searching for them in every iteration.
+    std::vector<size_t> & WJT_index = workspace.m_WJT_index;
+    sparse::column_prod_index( WJT, J, WJT_index );
+
+    typename A::row_ptrs_container_type const & row_ptrs = A::row_ptrs( J );
+    typename A::cols_container_type     const & cols     = A::cols( J );
+    typename AT::data_container_type    const & WJT_data = AT::data( WJT );
+
+    assert( row_ptrs.size() == K+1u || !"parallel_gauss_seidel_solver(): every contact must have a row in J");
+
+    T residual_norm;
+
+    //--- Gauss--Seidel loops
+    for(size_t iteration = 0u; iteration < params.max_iterations(); ++iteration )
+    {
+      RECORD_VECTOR_PUSH("rfactor", R(1)(1,1));
+
+      //--- Loop over colors, contacts of the same color are independent
+      for(size_t c = 0u; c < coloring.size(); ++c)
+      {
+        size_t const * color = &coloring.m_contacts[ coloring.m_color_ptr[c] ];
+
+        long const C = static_cast<long>( coloring.m_color_ptr[c+1] - coloring.m_color_ptr[c] );
+
+#pragma omp parallel for schedule(static)
+        for(long m = 0; m < C; ++m)
+        {
+          size_t const k = color[m];
+
+          B4x1 z_k(     VT::zero() );
+          B4x1 delta_x( VT::zero() );
+
+          B4x1 const &  mu_k    = mu(k);
+          B4x1       &  x_k     = x(k);
+          delta_x               = x(k); // save old value
+
+          M::compute_z_k( x_k, w, R(k), J, b(k), z_k, k );
+
+          size_t const n   = 0u;
+          size_t const s   = 1u;
+          size_t const t   = 2u;
+          size_t const tau = 3u;
+
+          //--- Solve lambda_n = prox_{R^+}( lambda_n - r (A lambda_n + b))
+          normal_solver( z_k(n), x_k(n) );
+
+          //--- Solve lambda_f = prox_C( lambda_f - r (A lambda_f + b))
+          friction_solver(z_k(s), z_k(t), z_k(tau), mu_k(s), mu_k(t), mu_k(tau), x_k(n), x_k(s), x_k(t), x_k(tau));
+
+          //--- delta_x = x_k_new - x_k_old (saved in delta_x)
+          sparse::sub(x_k, delta_x, delta_x);
+
+          //--- Updating w, only dynamic bodies are touched so threads never
+          //--- write to the same blocks of w.
+          for(size_t p = row_ptrs[k]; p < row_ptrs[k+1]; ++p)
+          {
+            size_t const i = cols[p];
+
+            if( dynamic[i] && WJT_index[p] < WJT_data.size() )
+              sparse::prod( WJT_data[ WJT_index[p] ], delta_x, w(i) );
+          }
+        }
+      }
+
+      //--- compute the residual, residual = lambda^k - lambda^(k+1)
+      sparse::sub(lambda, x, residual);
+      residual_norm = M::compute_norm_inf( residual );
+
+      RECORD_VECTOR_PUSH("convergence", residual_norm );
+
+      if( residual_norm < params.absolute_tolerance() )
+      {
+        util::Log logging;
+
+        logging << "parallel_gauss_seidel_solver(): absolute convergence in "
+                << iteration
+                << " iterations |residual| = "
+                << residual_norm
+                << util::Log::newline();
+
+        abs_conv_in_iteration = iteration;
+
+        break;
+      }
+
+      if( fabs(residual_norm-last_residual_norm) < params.relative_tolerance()*last_residual_norm )
+      {
+        util::Log logging;
+
+        logging << "parallel_gauss_seidel_solver(): relative convergence in "
+                << iteration
+                << " iterations"
+                << util::Log::newline();
+
+        rel_conv_in_iteration = iteration;
+
+        break;
+      }
+
+      if( residual_norm > last_residual_norm)
+      {
+        util::Log logging;
+
+        logging << "parallel_gauss_seidel_solver(): divergence in "
+                << iteration
+                << " iterations. |residual| = "
+                << residual_norm
+                << util::Log::newline();
+
+        // Reduce R-factor and roll-back solution to last known good iterate!
+        M::compute_prod( nu, R );
+        x = lambda;
+        ++count_divergence;
+
+        // w must follow the rolled back iterate.
+        sparse::prod( WJT, x, w, true );
+      }
+      else
+      {
+        // save x to lambda.
+        last_residual_norm = residual_norm;
+        lambda = x;
+      }
+    }
+    lambda = x;
+
+    RECORD("abs_conv",   abs_conv_in_iteration);
+    RECORD("rel_conv",   rel_conv_in_iteration);
+    RECORD("div_count",  count_divergence     );
+    STOP_TIMER("solver");
+  }
+
+} //namespace prox
+
+// PROX_PARALLEL_GAUSS_SEIDEL_SOLVER_H
+#endif
@@ -0,0 +1,315 @@
+#ifndef PROX_PARALLEL_JACOBI_SOLVER_H
+#define PROX_PARALLEL_JACOBI_SOLVER_H
+
+#include <solvers/prox_solver_params.h>
+#include <solvers/prox_solver_workspace.h>
+#include <solvers/prox_flat_block_matrix.h>
+
+#include <solvers/sub/prox_normal_sub_solver.h>
+#include <solvers/sub/prox_friction_sub_solver.h>
+#include <solvers/strategies/prox_R_strategy.h>
+
+#include <util_profiling.h>
+#include <util_log.h>
+
+#include <sparse.h>
+
+#include <algorithm> // needed for std::max
+#include <cmath>
+#include <vector>
+
+namespace prox
+{
+
+  namespace detail
+  {
+
+    /**
+     * The parallel Jacobi solver with the sub solvers given as functors of
+     * type NS and FS. The contact pass calls them directly, so when these
+     * are the concrete sub solver functors the projections are inlined into
+     * the loop over the contacts.
+     */
+    template< typename M, typename NS, typename FS >
+    inline void parallel_jacobi_solve(
+                                      typename M::compressed4x6_type const& J
+                                      , typename M::compressed6x4_type const& WJT
+                                      , typename M::vector4_type const& b
+                                      , typename M::vector4_type const& mu
+                                      , typename M::vector4_type & lambda
+                                      , RStrategy<M> const & strategy
+                                      , NS const & normal_solver
+                                      , FS const & friction_solver
+                                      , SolverParams<M> const & params
+                                      , SolverWorkspace<M> & workspace
+                                      )
+    {
+      RECORD_VECTOR_NEW("convergence");
+      RECORD_VECTOR_NEW("rfactor");
+
+      typedef typename M::real_type           T;
+      typedef typename M::value_traits        VT;
+      typedef typename M::block4x1_type       B4x1;
+      typedef typename M::block4x4_type       B4x4;
+      typedef typename M::diagonal4x4_type    D4x4;
+
+      using std::fabs;
+
+      START_TIMER("solver");
+
+      size_t const K = J.nrows( ); // Number of blocks
+      size_t const N = J.ncols( ); // Number of bodies
+
+      size_t abs_conv_in_iteration = 0u; //used for profiling, to record in what iteration we found absolute convergence
+      size_t rel_conv_in_iteration = 0u; //used for profiling, to record in what iteration we found relative convergence
+      size_t count_divergence      = 0u; //used for profiling, to record how many times we have discovered divergence
+
+      //--- If warm starting is not used then clear the initial iterate
+      bool const warm_start = params.use_warm_starting() && (lambda.size() == K);
+
+      if(! warm_start )
+      {
+        lambda.resize( K );
+      }
+
+      if( K == 0u )
+        return;
+
+      D4x4 & R  = workspace.m_R;
+      D4x4 & nu = workspace.m_nu;
+
+      R.resize( K, false );   // The strategies only write the diagonals
+      nu.resize( K, false );
+
+      strategy(J, WJT, R, nu );
+
+      //--- Set up flat copies and work buffers once and for all ---------------
+      FlatBlockMatrix<T,4,6> & flat_J   = workspace.m_flat_J;
+      FlatBlockMatrix<T,6,4> & flat_WJT = workspace.m_flat_WJT;
+
+      flat_J.assign( J );
+      flat_WJT.assign( WJT );
+
+      std::vector<T> * x_in  = &workspace.m_flat_x;  // Input iterate to the Jacobi scheme, 4 values per contact
+      std::vector<T> * x_out = &workspace.m_flat_y;  // Output iterate to the Jacobi scheme, 4 values per contact
+
+      x_in->assign( 4u*K, VT::zero() );
+      x_out->resize( 4u*K );
+
+      std::vector<T> & w        = workspace.m_flat_w;         // w = W J^T x, 6 values per body
+      std::vector<T> & residual = workspace.m_flat_residual;  // per contact infinity norm of the change in the iterate
+
+      w.resize( 6u*N );
+      residual.resize( K );
+
+      if( warm_start )
+      {
+        for(size_t k = 0u; k < K; ++k)
+          for(size_t i = 0u; i < 4u; ++i)
+            (*x_in)[4u*k + i] = lambda(k)(i);
+      }
+
+      T last_residual_norm = VT::infinity(); // Used to detect divergence.
+
+      bool last_iteration_diverged = false;
+
+      long const signed_N = static_cast<long>( N );
+      long const signed_K = static_cast<long>( K );
+
+      //--- Jacobi loops
+      for(size_t iteration = 0u; iteration < params.max_iterations(); ++iteration )
+      {
+        RECORD_VECTOR_PUSH("rfactor", R(1)(1,1));
+
+        last_iteration_diverged = false;
+
+        T const * x_in_data  = &(*x_in)[0];
+        T       * x_out_data = &(*x_out)[0];
+
+        //--- First pass, w = W J^T x, every body only reads its own row of W J^T
+#pragma omp parallel for schedule(static)
+        for(long body = 0; body < signed_N; ++body)
+        {
+          T w_i[6] = { VT::zero(), VT::zero(), VT::zero(), VT::zero(), VT::zero(), VT::zero() };
+
+          for(size_t p = flat_WJT.m_row_ptr[body]; p < flat_WJT.m_row_ptr[body+1]; ++p)
+            prod_add_6x4( &flat_WJT.m_data[p*24u], x_in_data + 4u*flat_WJT.m_cols[p], w_i );
+
+          for(size_t r = 0u; r < 6u; ++r)
+            w[6u*body + r] = w_i[r];
+        }
+
+        //--- Second pass, z = x - R(J w + b) followed by the proximal projections
+#pragma omp parallel for schedule(static)
+        for(long k = 0; k < signed_K; ++k)
+        {
+          B4x1 const & b_k  = b(k);
+          B4x1 const & mu_k = mu(k);
+          B4x4 const & R_k  = R(k);
+
+          T y[4] = { b_k(0), b_k(1), b_k(2), b_k(3) };
+
+          for(size_t p = flat_J.m_row_ptr[k]; p < flat_J.m_row_ptr[k+1]; ++p)
+            prod_add_4x6( &flat_J.m_data[p*24u], &w[6u*flat_J.m_cols[p]], y );
+
+          T const * x_k_in  = x_in_data  + 4u*k;
+          T       * x_k_out = x_out_data + 4u*k;
+
+          T z[4];
+          for(size_t r = 0u; r < 4u; ++r)
+            z[r] = x_k_in[r] - ( R_k(r,0)*y[0] + R_k(r,1)*y[1] + R_k(r,2)*y[2] + R_k(r,3)*y[3] );
+
+          size_t const n   = 0u;
+          size_t const s   = 1u;
+          size_t const t   = 2u;
+          size_t const tau = 3u;
+
+          normal_solver( z[n], x_k_out[n] );
+
+          friction_solver(z[s], z[t], z[tau], mu_k(s), mu_k(t), mu_k(tau), x_k_in[n], x_k_out[s], x_k_out[t], x_k_out[tau]);
+
+          T norm = VT::zero();
+          for(size_t r = 0u; r < 4u; ++r)
+            norm = std::max( norm, fabs( x_k_in[r] - x_k_out[r] ) );
+
+          residual[k] = norm;
+        }
+
+        //--- Compute residual, residual = lambda^k - lambda^(k+1)
+        T residual_norm = VT::zero();
+        for(size_t k = 0u; k < K; ++k)
+          residual_norm = std::max( residual_norm, residual[k] );
+
+        RECORD_VECTOR_PUSH( "convergence", residual_norm );
+
+        if( residual_norm < params.absolute_tolerance() )
+        {
+          util::Log logging;
+
+          logging << "parallel_jacobi_solver(): absolute convergence in "
+                  << iteration
+                  << " iterations |residual| = "
+                  << residual_norm
+                  << util::Log::newline();
+
+          abs_conv_in_iteration = iteration;
+
+          break;
+        }
+
+        if( fabs(residual_norm - last_residual_norm) < params.relative_tolerance()*last_residual_norm )
+        {
+          util::Log logging;
+
+          logging << "parallel_jacobi_solver(): relative convergence in "
+                  << iteration
+                  << " iterations"
+                  << util::Log::newline();
+
+          rel_conv_in_iteration = iteration;
+
+          break;
+        }
+
+        if( residual_norm > last_residual_norm )
+        {
+          util::Log logging;
+
+          logging << "parallel_jacobi_solver(): divergence in "
+                  << iteration
+                  << " iterations. |residual| = "
+                  << residual_norm
+                  << util::Log::newline();
+
+          // Reduce R-factor and roll-back solution to last known good
+          // iterate! (same as not doing a flip-flop on x-vectors).
+          M::compute_prod( nu, R );
+
+          last_iteration_diverged = true;
+
+          ++count_divergence;
+        }
+        else
+        {
+          last_residual_norm = residual_norm;
+          std::swap( x_in, x_out );
+          last_iteration_diverged = false;
+        }
+      }
+
+      std::vector<T> const & solution = last_iteration_diverged ? *x_in : *x_out;
+
+      for(size_t k = 0u; k < K; ++k)
+        for(size_t i = 0u; i < 4u; ++i)
+          lambda(k)(i) = solution[4u*k + i];
+
+      RECORD("abs_conv",   abs_conv_in_iteration);
+      RECORD("rel_conv",   rel_conv_in_iteration);
+      RECORD("div_count",  count_divergence     );
+      STOP_TIMER("solver");
+    }
+
+  } // namespace detail
+
+  /**
+   * This solver use the proximal map formulation of the constraints
+   * on the motion of a rigid body system to compute the contact impulses
+   * of the contact points. The system of constraints is solved using a
+   * factorized Jacobi approach, exactly like the jacobi_solver.
+   *
+   * Each iteration is done in two fused passes. First w = W J^T x is computed
+   * body by body, then z = x - R (J w + b), the proximal projections and the
+   * residual are computed contact by contact. Both passes are
+   * multithreaded. The work buffers and the flat copies of J and W J^T are
+   * kept in the workspace, so no memory is allocated inside the iterations
+   * and, when the workspace is reused, none across calls either.
+   *
+   * This version calls the sub solvers through their abstract interfaces.
+   */
+  template< typename M >
+  inline void parallel_jacobi_solver(
+                                     typename M::compressed4x6_type const& J
+                                     , typename M::compressed6x4_type const& WJT
+                                     , typename M::vector4_type const& b
+                                     , typename M::vector4_type const& mu
+                                     , typename M::vector4_type & lambda
+                                     , RStrategy<M> const & strategy
+                                     , NormalSubSolver<typename M::real_type> const & normal_solver
+                                     , FrictionSubSolver<typename M::real_type> const & friction_solver
+                                     , SolverParams<M> const & params
+                                     , SolverWorkspace<M> & workspace
+                                     , M const & tag
+                                     )
+  {
+    detail::parallel_jacobi_solve<M>( J, WJT, b, mu, lambda, strategy, normal_solver, friction_solver, params, workspace );
+  }
+
+  /**
+   * The parallel Jacobi solver instantiated with the sub solver functors NS
+   * and FS (see prox_sub_solver_ops.h). The sub solver arguments are not
+   * used, the projections of NS and FS are called directly instead. This
+   * version is selected by bind_solver when it is told the sub solver
+   * types, so the sub solvers are resolved once when the solver is bound.
+   */
+  template< typename M, typename NS, typename FS >
+  inline void parallel_jacobi_solver(
+                                     typename M::compressed4x6_type const& J
+                                     , typename M::compressed6x4_type const& WJT
+                                     , typename M::vector4_type const& b
+                                     , typename M::vector4_type const& mu
+                                     , typename M::vector4_type & lambda
+                                     , RStrategy<M> const & strategy
+                                     , NormalSubSolver<typename M::real_type> const & /*normal_solver*/
+                                     , FrictionSubSolver<typename M::real_type> const & /*friction_solver*/
+                                     , SolverParams<M> const & params
+                                     , SolverWorkspace<M> & workspace
+                                     , M const & tag
+                                     )
+  {
+    detail::parallel_jacobi_solve<M>( J, WJT, b, mu, lambda, strategy, NS(), FS(), params, workspace );
+  }
+
+} //namespace prox
+
+// PROX_PARALLEL_JACOBI_SOLVER_H
+#endif
@@ -6,6 +6,7 @@
 #include <solvers/sub/prox_friction_sub_solver.h>
 
 #include <solvers/prox_solver_params.h>
+#include <solvers/prox_solver_workspace.h>
 
 namespace prox
 {
@@ -28,6 +29,7 @@ namespace prox
                             , NormalSubSolver<typename M::real_type> const &
                             , FrictionSubSolver<typename M::real_type> const &
                             , SolverParams<M> const &
+                            , SolverWorkspace<M> &
                             , M const & 
                             ) const = 0;
     
@@ -119,6 +119,21 @@ namespace prox
     , m_friction_sub_solver(analytical_ellipsoid)
     {}
 
+    /**
+     * Copy the settings of solver parameters using another precision.
+     */
+    template< typename MT2 >
+    explicit SolverParams(SolverParams<MT2> const & params)
+    : m_max_iterations( params.max_iterations() )
+    , m_absolute_tolerance( static_cast<T>( params.absolute_tolerance() ) )
+    , m_relative_tolerance( static_cast<T>( params.relative_tolerance() ) )
+    , m_use_warm_starting( params.use_warm_starting() )
+    , m_solver( params.solver() )
+    , m_r_factor_strategy( params.r_factor_strategy() )
+    , m_normal_sub_solver( params.normal_sub_solver() )
+    , m_friction_sub_solver( params.friction_sub_solver() )
+    {}
+
   };
   
 } // namespace prox
@@ -0,0 +1,140 @@
+#ifndef PROX_SOLVER_PRECISION_H
+#define PROX_SOLVER_PRECISION_H
+
+#include <solvers/prox_solver.h>
+
+#include <sparse.h>
+
+namespace prox
+{
+
+  namespace detail
+  {
+
+    /**
+     * Mixed precision solver invocation. The contact problem is converted
+     * into the precision of the solver policy S, solved and the resulting
+     * impulses are converted back into the precision of M.
+     */
+    template<typename M, typename S>
+    class SolverPrecision
+    {
+    public:
+
+      static void solve(
+                        Solver<S> const & solver
+                        , typename M::compressed4x6_type const & J
+                        , typename M::compressed6x4_type const & WJT
+                        , typename M::vector4_type const & b
+                        , typename M::vector4_type const & mu
+                        , typename M::vector4_type & lambda
+                        , RStrategy<S> const & strategy
+                        , NormalSubSolver<typename S::real_type> const & normal_solver
+                        , FrictionSubSolver<typename S::real_type> const & friction_solver
+                        , SolverParams<M> const & params
+                        , SolverWorkspace<S> & workspace
+                        )
+      {
+        typename S::compressed4x6_type & J_s      = workspace.m_J;
+        typename S::compressed6x4_type & WJT_s    = workspace.m_WJT;
+        typename S::vector4_type       & b_s      = workspace.m_b;
+        typename S::vector4_type       & mu_s     = workspace.m_mu;
+        typename S::vector4_type       & lambda_s = workspace.m_lambda;
+
+        sparse::convert( J,      J_s      );
+        sparse::convert( WJT,    WJT_s    );
+        sparse::convert( b,      b_s      );
+        sparse::convert( mu,     mu_s     );
+        sparse::convert( lambda, lambda_s );
+
+        solver(
+               J_s
+               , WJT_s
+               , b_s
+               , mu_s
+               , lambda_s
+               , strategy
+               , normal_solver
+               , friction_solver
+               , SolverParams<S>( params )
+               , workspace
+               , S()
+               );
+
+        sparse::convert( lambda_s, lambda );
+      }
+
+    };
+
+    /**
+     * Solver and bodies share the same precision, so no conversion is needed.
+     */
+    template<typename M>
+    class SolverPrecision<M, M>
+    {
+    public:
+
+      static void solve(
+                        Solver<M> const & solver
+                        , typename M::compressed4x6_type const & J
+                        , typename M::compressed6x4_type const & WJT
+                        , typename M::vector4_type const & b
+                        , typename M::vector4_type const & mu
+                        , typename M::vector4_type & lambda
+                        , RStrategy<M> const & strategy
+                        , NormalSubSolver<typename M::real_type> const & normal_solver
+                        , FrictionSubSolver<typename M::real_type> const & friction_solver
+                        , SolverParams<M> const & params
+                        , SolverWorkspace<M> & workspace
+                        )
+      {
+        solver( J, WJT, b, mu, lambda, strategy, normal_solver, friction_solver, params, workspace, M() );
+      }
+
+    };
+
+  } // namespace detail
+
+  /**
+   * Solve the contact problem of a time stepper with a solver bound in the
+   * solver precision of the math policy M (M::solver_policy).
+   *
+   * @param solver      The solver, strategy and sub solvers must be bound for M::solver_policy.
+   * @param lambda      On entry the initial iterate and on exit the contact impulses.
+   * @param workspace   Work buffers of the solver, also holds the converted contact problem.
+   */
+  template<typename M>
+  inline void solve_in_solver_precision(
+                                        Solver<typename M::solver_policy> const & solver
+                                        , typename M::compressed4x6_type const & J
+                                        , typename M::compressed6x4_type const & WJT
+                                        , typename M::vector4_type const & b
+                                        , typename M::vector4_type const & mu
+                                        , typename M::vector4_type & lambda
+                                        , RStrategy<typename M::solver_policy> const & strategy
+                                        , NormalSubSolver<typename M::solver_policy::real_type> const & normal_solver
+                                        , FrictionSubSolver<typename M::solver_policy::real_type> const & friction_solver
+                                        , SolverParams<M> const & params
+                                        , SolverWorkspace<typename M::solver_policy> & workspace
+                                        , M const & /*tag*/
+                                        )
+  {
+    detail::SolverPrecision<M, typename M::solver_policy>::solve(
+                                                                 solver
+                                                                 , J
+                                                                 , WJT
+                                                                 , b
+                                                                 , mu
+                                                                 , lambda
+                                                                 , strategy
+                                                                 , normal_solver
+                                                                 , friction_solver
+                                                                 , params
+                                                                 , workspace
+                                                                 );
+  }
+
+} //namespace prox
+
+// PROX_SOLVER_PRECISION_H
+#endif
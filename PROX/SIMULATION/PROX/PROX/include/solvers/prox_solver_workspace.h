@@ -0,0 +1,69 @@
+#ifndef PROX_SOLVER_WORKSPACE_H
+#define PROX_SOLVER_WORKSPACE_H
+
+#include <solvers/prox_flat_block_matrix.h>
+#include <solvers/prox_contact_coloring.h>
+
+#include <vector>
+
+namespace prox
+{
+
+  /**
+   * Work buffers of the solvers.
+   *
+   * A solver resizes the buffers it needs on every call, but as long as the
+   * workspace is kept alive between calls the underlying storage is reused
+   * and nothing is allocated unless the number of contacts grows. The
+   * contents of the buffers carry no meaning between calls.
+   *
+   * @tparam M   Math types policy of the solver.
+   */
+  template<typename M>
+  class SolverWorkspace
+  {
+  public:
+
+    typedef typename M::real_type            T;
+    typedef typename M::vector4_type         V4;
+    typedef typename M::vector6_type         V6;
+    typedef typename M::diagonal4x4_type     D4x4;
+    typedef typename M::compressed4x6_type   CSR4x6;
+    typedef typename M::compressed6x4_type   CSR6x4;
+
+  public:
+
+    V4                 m_x;          ///< Solution iterates.
+    V4                 m_y;          ///< Second solution iterate, used by the flip-flopping Jacobi schemes.
+    V4                 m_z;          ///< Proximal points, z = x - R (A x + b).
+    V4                 m_residual;   ///< Change in the iterates over one iteration.
+    D4x4               m_R;          ///< R-factors.
+    D4x4               m_nu;         ///< R-factor reduction parameters.
+    V6                 m_w;          ///< Contact impulses in body space, w = W J^T x.
+    std::vector<bool>  m_dynamic;    ///< Tells for each body whether it can be moved by the contact impulses.
+    detail::ContactColoring m_coloring;  ///< Contacts grouped by color, used by the parallel Gauss-Seidel solver.
+    std::vector<size_t> m_WJT_index; ///< Position in W J^T of the block used by the w update, one per block of J.
+
+    std::vector<T>     m_JN;         ///< Normal rows of the blocks of J, 6 values per block, used by the stabilization solver.
+    std::vector<T>     m_WJNT;       ///< Normal columns of the matching blocks of W J^T, 6 values per block.
+    std::vector<T>     m_r;          ///< Inverse diagonal of J_n W J_n^T, one value per contact.
+
+    detail::FlatBlockMatrix<T,4,6> m_flat_J;    ///< Flat copy of J, used by the parallel Jacobi solver.
+    detail::FlatBlockMatrix<T,6,4> m_flat_WJT;  ///< Flat copy of W J^T, used by the parallel Jacobi solver.
+    std::vector<T>     m_flat_x;        ///< Solution iterate of the parallel Jacobi solver, 4 values per contact.
+    std::vector<T>     m_flat_y;        ///< Second solution iterate of the parallel Jacobi solver.
+    std::vector<T>     m_flat_w;        ///< w = W J^T x of the parallel Jacobi solver, 6 values per body.
+    std::vector<T>     m_flat_residual; ///< Change in the iterate of each contact over one parallel Jacobi iteration.
+
+    CSR4x6             m_J;          ///< Jacobian, converted from the precision of the caller.
+    CSR6x4             m_WJT;        ///< W J^T, converted from the precision of the caller.
+    V4                 m_b;          ///< Right hand side, converted from the precision of the caller.
+    V4                 m_mu;         ///< Friction coefficients, converted from the precision of the caller.
+    V4                 m_lambda;     ///< Contact impulses, converted from the precision of the caller.
+
+  };
+
+} //namespace prox
+
+// PROX_SOLVER_WORKSPACE_H
+#endif
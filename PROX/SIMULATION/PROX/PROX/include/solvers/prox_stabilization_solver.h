@@ -0,0 +1,219 @@
+#ifndef PROX_STABILIZATION_SOLVER_H
+#define PROX_STABILIZATION_SOLVER_H
+
+#include <solvers/prox_solver_params.h>
+#include <solvers/prox_solver_workspace.h>
+
+#include <util_profiling.h>
+#include <util_log.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+
+namespace prox
+{
+
+  /**
+   * Solver for the post stabilization problem.
+   *
+   * The position correction only has non-penetration constraints, so the
+   * three friction rows of J and the three friction columns of W J^T are
+   * dropped and the remaining problem in the normal impulses is solved by a
+   * projected Gauss-Seidel scheme,
+   *
+   *   x_k = max( 0, x_k - r_k (J_n W J_n^T x + g)_k ),  r_k = 1 / (J_n W J_n^T)_kk.
+   *
+   * With this choice of r_k every update minimizes along one coordinate,
+   * so the scheme can not diverge and no R-factor strategy is needed.
+   *
+   * @param J          The Jacobian matrix, only the normal rows are used.
+   * @param WJT        The product of the inverse mass matrix and the transposed Jacobian.
+   * @param g          The stabilization vector, only the normal entries are used.
+   * @param lambda     On entry the initial iterate if warm starting is used and lambda has one
+   *                   block per contact. On exit the normal impulses, the friction entries are zero.
+   * @param params     The iteration and tolerance limits and whether warm starting is used.
+   * @param workspace  Work buffers.
+   */
+  template< typename M >
+  inline void stabilization_solver(
+                                   typename M::compressed4x6_type const & J
+                                   , typename M::compressed6x4_type const & WJT
+                                   , typename M::vector4_type const & g
+                                   , typename M::vector4_type & lambda
+                                   , SolverParams<M> const & params
+                                   , SolverWorkspace<M> & workspace
+                                   , M const & /*tag*/
+                                   )
+  {
+    RECORD_VECTOR_NEW("convergence");
+
+    typedef typename M::real_type                  T;
+    typedef typename M::value_traits               VT;
+    typedef typename M::vector6_type               V6;
+    typedef typename M::block4x6_type              B4x6;
+    typedef typename M::block6x4_type              B6x4;
+    typedef typename M::block6x1_type              B6x1;
+    typedef typename M::compressed4x6_type         CSR4x6;
+    typedef typename CSR4x6::accessor              A;
+
+    using std::fabs;
+    using std::max;
+
+    START_TIMER("solver");
+
+    size_t const K = J.nrows( ); // Number of contacts
+    size_t const N = J.ncols( ); // Number of bodies
+
+    size_t abs_conv_in_iteration = 0u; //used for profiling, to record in what iteration we found absolute convergence
+    size_t rel_conv_in_iteration = 0u; //used for profiling, to record in what iteration we found relative convergence
+
+    bool const warm_start = params.use_warm_starting() && (lambda.size() == K);
+
+    if( !warm_start )
+    {
+      lambda.resize( K );
+      lambda.clear_data();
+    }
+
+    if( K == 0u )
+      return;
+
+    typename A::row_ptrs_container_type const & row_ptrs = A::row_ptrs( J );
+    typename A::cols_container_type     const & cols     = A::cols( J );
+    typename A::data_container_type     const & data     = A::data( J );
+
+    assert( row_ptrs.size() == K+1u || !"stabilization_solver(): every contact must have a row in J");
+
+    std::vector<T> & JN   = workspace.m_JN;
+    std::vector<T> & WJNT = workspace.m_WJNT;
+    std::vector<T> & r    = workspace.m_r;
+    V6             & w    = workspace.m_w;
+
+    JN.resize( 6u*data.size() );
+    WJNT.resize( 6u*data.size() );
+    r.resize( K );
+    w.resize( N );
+    w.clear_data();
+
+    //--- Extract the normal-only problem and set up w = W J_n^T x
+    for(size_t k = 0u; k < K; ++k)
+    {
+      T A_kk = VT::zero();
+
+      lambda(k)(1) = VT::zero();
+      lambda(k)(2) = VT::zero();
+      lambda(k)(3) = VT::zero();
+
+      T const x_k = lambda(k)(0);
+
+      for(size_t p = row_ptrs[k]; p < row_ptrs[k+1]; ++p)
+      {
+        size_t const   i     = cols[p];
+        B4x6   const & J_ki  = data[p];
+        B6x4   const & WJT_ik = WJT(i,k);
+        B6x1         & w_i   = w(i);
+
+        for(size_t c = 0u; c < 6u; ++c)
+        {
+          JN[6u*p + c]   = J_ki(0,c);
+          WJNT[6u*p + c] = WJT_ik(c,0);
+
+          A_kk   += J_ki(0,c)*WJT_ik(c,0);
+          w_i(c) += WJT_ik(c,0)*x_k;
+        }
+      }
+
+      // Contacts between bodies that can not move have A_kk = 0, their
+      // impulses have no effect and are left at zero.
+      r[k] = A_kk > VT::zero() ? VT::one() / A_kk : VT::zero();
+
+      if( r[k] == VT::zero() )
+        lambda(k)(0) = VT::zero();
+    }
+
+    T last_residual_norm = VT::infinity();
+
+    //--- Projected Gauss--Seidel loops
+    for(size_t iteration = 0u; iteration < params.max_iterations(); ++iteration )
+    {
+      T residual_norm = VT::zero();   // Infinity norm of the change in the iterate over one sweep
+
+      for(size_t k = 0u; k < K; ++k)
+      {
+        if( r[k] == VT::zero() )
+          continue;
+
+        T v_k = g(k)(0);
+
+        for(size_t p = row_ptrs[k]; p < row_ptrs[k+1]; ++p)
+        {
+          B6x1 const & w_i = w( cols[p] );
+
+          for(size_t c = 0u; c < 6u; ++c)
+            v_k += JN[6u*p + c]*w_i(c);
+        }
+
+        T const x_old = lambda(k)(0);
+        T const x_new = max( VT::zero(), x_old - r[k]*v_k );
+        T const delta = x_new - x_old;
+
+        if( delta == VT::zero() )
+          continue;
+
+        lambda(k)(0) = x_new;
+
+        for(size_t p = row_ptrs[k]; p < row_ptrs[k+1]; ++p)
+        {
+          B6x1 & w_i = w( cols[p] );
+
+          for(size_t c = 0u; c < 6u; ++c)
+            w_i(c) += WJNT[6u*p + c]*delta;
+        }
+
+        residual_norm = max( residual_norm, fabs(delta) );
+      }
+
+      RECORD_VECTOR_PUSH("convergence", residual_norm );
+
+      if( residual_norm <= params.absolute_tolerance() )
+      {
+        util::Log logging;
+
+        logging << "stabilization_solver(): absolute convergence in "
+                << iteration
+                << " iterations |residual| = "
+                << residual_norm
+                << util::Log::newline();
+
+        abs_conv_in_iteration = iteration;
+
+        break;
+      }
+
+      if( fabs(residual_norm-last_residual_norm) < params.relative_tolerance()*last_residual_norm )
+      {
+        util::Log logging;
+
+        logging << "stabilization_solver(): relative convergence in "
+                << iteration
+                << " iterations"
+                << util::Log::newline();
+
+        rel_conv_in_iteration = iteration;
+
+        break;
+      }
+
+      last_residual_norm = residual_norm;
+    }
+
+    RECORD("abs_conv",   abs_conv_in_iteration);
+    RECORD("rel_conv",   rel_conv_in_iteration);
+    STOP_TIMER("solver");
+  }
+
+} //namespace prox
+
+// PROX_STABILIZATION_SOLVER_H
+#endif
@@ -0,0 +1,181 @@
+#ifndef PROX_SUB_SOLVER_OPS_H
+#define PROX_SUB_SOLVER_OPS_H
+
+#include <solvers/sub/prox_nonnegative.h>
+#include <solvers/sub/prox_analytical_sphere.h>
+#include <solvers/sub/prox_analytical_ellipsoid.h>
+#include <solvers/sub/prox_numerical_ellipsoid.h>
+#include <solvers/sub/prox_gjk_ellipsoid.h>
+#include <solvers/sub/prox_box_model.h>
+#include <solvers/sub/prox_origin.h>
+#include <solvers/sub/prox_infinity.h>
+
+namespace prox
+{
+
+  /**
+   * Sub solver functors that call the projections directly. Unlike the
+   * binders these are not derived from the abstract sub solvers, so a
+   * solver kernel instantiated with one of them has the projection inlined
+   * instead of calling it through a function pointer for every contact.
+   * The functor types are chosen when the solver is bound, see bind_solver.
+   */
+  template<typename T>
+  class NonnegativeOp
+  {
+  public:
+
+    void operator()(T const & z_n, T & lambda_n) const
+    {
+      detail::nonnegative<T>(z_n, lambda_n);
+    }
+
+  };
+
+  template<typename T>
+  class NormalOriginOp
+  {
+  public:
+
+    void operator()(T const & z_n, T & lambda_n) const
+    {
+      detail::origin1D<T>(z_n, lambda_n);
+    }
+
+  };
+
+  template<typename T>
+  class NormalInfinityOp
+  {
+  public:
+
+    void operator()(T const & z_n, T & lambda_n) const
+    {
+      detail::infinity1D<T>(z_n, lambda_n);
+    }
+
+  };
+
+  template<typename T>
+  class AnalyticalSphereOp
+  {
+  public:
+
+    void operator()(
+                    T const & z_s, T const & z_t, T const & z_tau
+                    , T const & mu_s, T const & mu_t, T const & mu_tau
+                    , T const & lambda_n
+                    , T & lambda_s, T & lambda_t, T & lambda_tau
+                    ) const
+    {
+      detail::analytical_sphere<T>(z_s, z_t, z_tau, mu_s, mu_t, mu_tau, lambda_n, lambda_s, lambda_t, lambda_tau);
+    }
+
+  };
+
+  template<typename T>
+  class AnalyticalEllipsoidOp
+  {
+  public:
+
+    void operator()(
+                    T const & z_s, T const & z_t, T const & z_tau
+                    , T const & mu_s, T const & mu_t, T const & mu_tau
+                    , T const & lambda_n
+                    , T & lambda_s, T & lambda_t, T & lambda_tau
+                    ) const
+    {
+      detail::analytical_ellipsoid<T>(z_s, z_t, z_tau, mu_s, mu_t, mu_tau, lambda_n, lambda_s, lambda_t, lambda_tau);
+    }
+
+  };
+
+  template<typename T>
+  class NumericalEllipsoidOp
+  {
+  public:
+
+    void operator()(
+                    T const & z_s, T const & z_t, T const & z_tau
+                    , T const & mu_s, T const & mu_t, T const & mu_tau
+                    , T const & lambda_n
+                    , T & lambda_s, T & lambda_t, T & lambda_tau
+                    ) const
+    {
+      detail::numerical_ellipsoid<T>(z_s, z_t, z_tau, mu_s, mu_t, mu_tau, lambda_n, lambda_s, lambda_t, lambda_tau);
+    }
+
+  };
+
+  template<typename T>
+  class GJKEllipsoidOp
+  {
+  public:
+
+    void operator()(
+                    T const & z_s, T const & z_t, T const & z_tau
+                    , T const & mu_s, T const & mu_t, T const & mu_tau
+                    , T const & lambda_n
+                    , T & lambda_s, T & lambda_t, T & lambda_tau
+                    ) const
+    {
+      detail::gjk_ellipsoid<T>(z_s, z_t, z_tau, mu_s, mu_t, mu_tau, lambda_n, lambda_s, lambda_t, lambda_tau);
+    }
+
+  };
+
+  template<typename T>
+  class BoxModelOp
+  {
+  public:
+
+    void operator()(
+                    T const & z_s, T const & z_t, T const & z_tau
+                    , T const & mu_s, T const & mu_t, T const & mu_tau
+                    , T const & lambda_n
+                    , T & lambda_s, T & lambda_t, T & lambda_tau
+                    ) const
+    {
+      detail::box_model<T>(z_s, z_t, z_tau, mu_s, mu_t, mu_tau, lambda_n, lambda_s, lambda_t, lambda_tau);
+    }
+
+  };
+
+  template<typename T>
+  class FrictionOriginOp
+  {
+  public:
+
+    void operator()(
+                    T const & z_s, T const & z_t, T const & z_tau
+                    , T const & mu_s, T const & mu_t, T const & mu_tau
+                    , T const & lambda_n
+                    , T & lambda_s, T & lambda_t, T & lambda_tau
+                    ) const
+    {
+      detail::origin3D<T>(z_s, z_t, z_tau, mu_s, mu_t, mu_tau, lambda_n, lambda_s, lambda_t, lambda_tau);
+    }
+
+  };
+
+  template<typename T>
+  class FrictionInfinityOp
+  {
+  public:
+
+    void operator()(
+                    T const & z_s, T const & z_t, T const & z_tau
+                    , T const & mu_s, T const & mu_t, T const & mu_tau
+                    , T const & lambda_n
+                    , T & lambda_s, T & lambda_t, T & lambda_tau
+                    ) const
+    {
+      detail::infinity3D<T>(z_s, z_t, z_tau, mu_s, mu_t, mu_tau, lambda_n, lambda_s, lambda_t, lambda_tau);
+    }
+
+  };
+
+} //namespace prox
+
+// PROX_SUB_SOLVER_OPS_H
+#endif
@@ -39,6 +39,7 @@ namespace prox
                            , broad::System<typename M::real_type> & broad_system
                            , narrow::System<typename M::tiny_types> & narrow_system
                            , std::vector< ContactPoint< M > > & contacts
+                           , StepperWorkspace< M > & workspace
                            , M const & tag
                            );
     
@@ -68,12 +69,13 @@ namespace prox
                     , broad::System<typename M::real_type> & broad_system
                     , narrow::System<typename M::tiny_types> & narrow_system
                     , std::vector< ContactPoint< M > > & contacts
+                    , StepperWorkspace< M > & workspace
                     , M const & tag
                     ) const
     {
       assert( this->m_stepper || !"StepperBinder(): stepper was null");
       
-      this->m_stepper( dt, bodies, properties, gravity, damping, params, broad_system, narrow_system, contacts, tag );
+      this->m_stepper( dt, bodies, properties, gravity, damping, params, broad_system, narrow_system, contacts, workspace, tag );
     }
     
   };
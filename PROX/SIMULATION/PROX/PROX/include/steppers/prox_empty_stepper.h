@@ -6,6 +6,8 @@
 
 #include <prox_collision_detection.h>
 
+#include <steppers/prox_stepper_workspace.h>
+
 #include <prox_params.h>
 #include <prox_math_policy.h>
 
@@ -32,6 +34,7 @@ namespace prox
                             , broad::System<typename M::real_type> & broad_system
                             , narrow::System<typename M::tiny_types> & narrow_system
                             , std::vector< ContactPoint<M> > & contacts
+                            , StepperWorkspace<M> & workspace
                             , M const & tag
                             )
   {
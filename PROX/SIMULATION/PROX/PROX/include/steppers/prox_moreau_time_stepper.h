@@ -4,6 +4,8 @@
 #include <prox_rigid_body.h>
 #include <prox_contact_point.h>
 
+#include <prox_body_state.h>
+#include <steppers/prox_stepper_workspace.h>
 #include <prox_get_mass_matrix.h>
 #include <prox_get_inverse_mass_matrix.h>
 #include <prox_get_jacobian_matrix.h>
@@ -14,9 +16,13 @@
 #include <prox_get_post_stabilization_vector.h>
 #include <prox_get_restitution_vector.h>
 #include <prox_get_friction_coefficient_vector.h>
+#include <prox_get_impulse_vector.h>
+#include <prox_get_stabilization_impulse_vector.h>
 
 #include <prox_set_position_vector.h>
 #include <prox_set_velocity_vector.h>
+#include <prox_set_impulse_vector.h>
+#include <prox_set_stabilization_impulse_vector.h>
 
 #include <prox_position_update.h>
 #include <prox_velocity_update.h>
@@ -27,6 +33,8 @@
 #include <prox_math_policy.h>
 
 #include <solvers/prox_bind_solver.h>
+#include <solvers/prox_solver_precision.h>
+#include <solvers/prox_stabilization_solver.h>
 #include <solvers/sub/prox_bind_normal_sub_solver.h>
 #include <solvers/sub/prox_bind_friction_sub_solver.h>
 #include <solvers/strategies/prox_bind_R_strategy.h>
@@ -54,6 +62,7 @@ namespace prox
                                   , broad::System<typename M::real_type> & broad_system
                                   , narrow::System<typename M::tiny_types> & narrow_system
                                   , std::vector< ContactPoint<M> > & contacts
+                                  , StepperWorkspace<M> & workspace
                                   , M const & tag
                                   )
   {
@@ -65,33 +74,41 @@ namespace prox
     typedef typename M::diagonal6x6_type           D6x6;
     typedef typename M::compressed4x6_type         CSR4x6;
     typedef typename M::compressed6x4_type         CSR6x4;
+    typedef typename M::solver_policy              S;   // Math policy of the solver blocks
+    typedef typename S::real_type                  TS;
     
     util::Log logging;
     
     START_TIMER("stepper");
     
-    SolverBinder<M>            prox_solver     = bind_solver<M>( params.solver_params().solver() );
-    RStrategyBinder<M>         strategy        = bind_strategy<M>( params.solver_params().r_factor_strategy() );
-    NormalSubSolverBinder<T>   normal_solver   = bind_normal_solver<T>( params.solver_params().normal_sub_solver() );
-    FrictionSubSolverBinder<T> friction_solver = bind_friction_solver<T>( params.solver_params().friction_sub_solver() );
-
-    V7        q;      // position vector
-    V7        qM;     // position half step update
-    V6        u;      // velocity vector
-    D6x6      W;      // inverse mass matrix.
-                      // 2009-08-13 Kenny code review: Optimization replace diagonal6x6_type
-                      // with diagonal_mass_type, maybe wait to optimize until all it working
-    V6        h;      // external forces
-    V6        Wdth;   // the product of inverse mass matrix, time step and external forces, W*dt*h
-    V6        fc;     // contact forces
-    CSR4x6    J;      // Jacobian
-    V4        g;      // correction/stabilization term
-    V4        e;      // restitution coefficients
-    V4        mu;     // friction coefficients
-    CSR6x4    WJT;    // the product of the inverse mass matrix and the transposed Jacobian
-    V4        lambda; // resulting forces
-    V4        b;      // right hand side vector.
-    V4        w;      // Current contact velocities
+    SolverBinder<S>             prox_solver     = bind_solver<S>(
+                                                                 params.solver_params().solver()
+                                                                 , params.solver_params().normal_sub_solver()
+                                                                 , params.solver_params().friction_sub_solver()
+                                                                 );
+    RStrategyBinder<S>          strategy        = bind_strategy<S>( params.solver_params().r_factor_strategy() );
+    NormalSubSolverBinder<TS>   normal_solver   = bind_normal_solver<TS>( params.solver_params().normal_sub_solver() );
+    FrictionSubSolverBinder<TS> friction_solver = bind_friction_solver<TS>( params.solver_params().friction_sub_solver() );
+
+    BodyState<M> & state  = workspace.m_state;  // struct-of-arrays store of the body states
+    V7 &      q      = state.m_q;            // position vector
+    V7 &      qM     = workspace.m_qM;       // position half step update
+    V6 &      u      = state.m_u;            // velocity vector
+    D6x6 &    W      = workspace.m_W;        // inverse mass matrix.
+                                             // 2009-08-13 Kenny code review: Optimization replace diagonal6x6_type
+                                             // with diagonal_mass_type, maybe wait to optimize until all it working
+    V6 &      h      = workspace.m_h;        // external forces
+    V6 &      Wdth   = workspace.m_Wdth;     // the product of inverse mass matrix, time step and external forces, W*dt*h
+    V6 &      fc     = workspace.m_fc;       // contact forces
+    CSR4x6 &  J      = workspace.m_J;        // Jacobian
+    CSR6x4 &  JT     = workspace.m_JT;       // transpose of the Jacobian
+    V4 &      g      = workspace.m_g;        // correction/stabilization term
+    V4 &      e      = workspace.m_e;        // restitution coefficients
+    V4 &      mu     = workspace.m_mu;       // friction coefficients
+    CSR6x4 &  WJT    = workspace.m_WJT;      // the product of the inverse mass matrix and the transposed Jacobian
+    V4 &      lambda = workspace.m_lambda;   // resulting forces
+    V4 &      b      = workspace.m_b;        // right hand side vector.
+    V4 &      w      = workspace.m_w;        // Current contact velocities
 
     T const half_dt = dt*VT::half();
     
@@ -100,12 +117,11 @@ namespace prox
                                 , bodies.end()
                                 );
 
-    get_position_vector( bodies.begin(), bodies.end(), q, tag );
-    get_velocity_vector( bodies.begin(), bodies.end(), u, tag );
+    get_body_state( bodies.begin(), bodies.end(), state, tag );
     
     position_update( q, u, half_dt, qM, tag );
     
-    set_position_vector( bodies.begin(), bodies.end(), qM, tag );
+    set_body_positions( bodies.begin(), bodies.end(), qM, state, tag );
     
     collision_detection(
                         bodies
@@ -120,12 +136,7 @@ namespace prox
 
     logging << "moreau_time_stepper(): Number of contacts = " << number_of_contacts << util::Log::newline();
     
-    get_inverse_mass_matrix(
-                            bodies.begin()
-                            , bodies.end()
-                            , W
-                            , tag
-                            );
+    get_inverse_mass_matrix( state, qM, W, tag );
     
     get_external_forces_vector(
                                bodies.begin()
@@ -137,7 +148,8 @@ namespace prox
                                );
 
     sparse::prod(dt, h);
-    sparse::prod(W, h, Wdth);        // Wdth = dt M^{-1} f_ext
+    Wdth.resize( W.nrows() );
+    sparse::prod(W, h, Wdth, true);  // Wdth = dt M^{-1} f_ext
 
     if( number_of_contacts > 0u )
     {
@@ -153,7 +165,8 @@ namespace prox
 
       if(params.stepper_params().pre_stabilization())
       {
-        sparse::prod(J, u, w);
+        w.resize( J.nrows() );
+        sparse::prod(J, u, w, true);
 
         get_pre_stabilization_vector(
                                      contacts.begin()
@@ -196,27 +209,46 @@ namespace prox
                                       , number_of_contacts
                                       );
       
-      M::compute_WJT( W, J, WJT );            // WJT = M^{-1} J^T
+      M::compute_WJT( W, J, JT, WJT );        // WJT = M^{-1} J^T
 
       M::compute_b( J, Wdth, u, e, g, b );    // b   = (I+E)J u + J W (dt h)
 
-      prox_solver(
-                  J
-                  , WJT
-                  , b
-                  , mu
-                  , lambda
-                  , strategy
-                  , normal_solver
-                  , friction_solver
-                  , params.solver_params()
-                  , tag
-                  );
+      if(params.solver_params().use_warm_starting())
+      {
+        get_impulse_vector(
+                           contacts.begin()
+                           , contacts.end()
+                           , lambda
+                           , tag
+                           , number_of_contacts
+                           );
+      }
+      else
+      {
+        lambda.clear();  // The solver starts from zero impulses
+      }
+
+      solve_in_solver_precision(
+                                prox_solver
+                                , J
+                                , WJT
+                                , b
+                                , mu
+                                , lambda
+                                , strategy
+                                , normal_solver
+                                , friction_solver
+                                , params.solver_params()
+                                , workspace.m_solver
+                                , tag
+                                );
       
       fc.resize( WJT.nrows() );
       
       sparse::prod(WJT, lambda, fc, true);     // fc = M^{-1}*J^T*lambda
 
+      set_impulse_vector( contacts.begin(), contacts.end(), lambda, tag );
+
       velocity_update( u, Wdth, fc, u, tag );  // u = u + dt M^{-1} h + fc
     }
     else
@@ -226,8 +258,7 @@ namespace prox
     
     position_update( qM, u, half_dt, q, tag );
     
-    set_position_vector( bodies.begin(), bodies.end(), q, tag );
-    set_velocity_vector( bodies.begin(), bodies.end(), u, tag );
+    set_body_state( bodies.begin(), bodies.end(), state, tag );
     
     STOP_TIMER("stepper");
 
@@ -235,9 +266,6 @@ namespace prox
     {
       START_TIMER("stabilization");
 
-      normal_solver   = bind_normal_solver<T>( nonnegative );
-      friction_solver = bind_friction_solver<T>( friction_origin );
-
       if( number_of_contacts > 0u )
       {
         get_post_stabilization_vector(
@@ -249,26 +277,47 @@ namespace prox
                                       , number_of_contacts
                                       );
 
+        SolverParams<M> stabilization_params;
+
+        stabilization_params.set_max_iterations( params.stepper_params().stabilization_max_iterations() );
+        stabilization_params.set_absolute_tolerance( params.stepper_params().stabilization_absolute_tolerance() );
+        stabilization_params.set_relative_tolerance( params.stepper_params().stabilization_relative_tolerance() );
+        stabilization_params.set_use_warm_starting( params.solver_params().use_warm_starting() );
+
+        if(stabilization_params.use_warm_starting())
+        {
+          get_stabilization_impulse_vector(
+                                           contacts.begin()
+                                           , contacts.end()
+                                           , lambda
+                                           , tag
+                                           , number_of_contacts
+                                           );
+        }
+        else
+        {
+          lambda.clear();  // Velocity impulses are not a good initial iterate for the position correction
+        }
+
         PREFIX("post_");
-        prox_solver(
-                    J
-                    , WJT
-                    , g
-                    , mu
-                    , lambda
-                    , strategy
-                    , normal_solver
-                    , friction_solver
-                    , params.solver_params()
-                    , tag
-                    );
+        stabilization_solver(
+                             J
+                             , WJT
+                             , g
+                             , lambda
+                             , stabilization_params
+                             , workspace.m_stabilization
+                             , tag
+                             );
         PREFIX("");
 
+        set_stabilization_impulse_vector( contacts.begin(), contacts.end(), lambda, tag );
+
         sparse::prod(WJT, lambda, fc, true);
 
         position_update( q, fc, VT::one(), q, tag );
         
-        set_position_vector( bodies.begin(), bodies.end(), q, tag );
+        set_body_positions( bodies.begin(), bodies.end(), q, state, tag );
       }
       
       STOP_TIMER("stabilization");
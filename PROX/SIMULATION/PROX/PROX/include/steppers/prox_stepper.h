@@ -7,6 +7,8 @@
 #include <prox_force_callbacks.h>
 #include <prox_property.h>
 
+#include <steppers/prox_stepper_workspace.h>
+
 #include <broad.h>
 #include <narrow.h>
 
@@ -33,6 +35,7 @@ namespace prox
                             , broad::System<typename M::real_type> &
                             , narrow::System<typename M::tiny_types> &
                             , std::vector< ContactPoint<M> > &
+                            , StepperWorkspace<M> &
                             , M const &
                             ) const = 0;
 
@@ -6,6 +6,9 @@
 #include <tiny_is_number.h>
 #include <tiny_is_finite.h>
 
+#include <cassert>
+#include <cstdlib>
+
 namespace prox
 {    
   
@@ -28,6 +31,10 @@ namespace prox
     bool            m_contact_reduction;    ///< Flat to turn on contact filter reduction, post-filter that removed redundant contacts.
     bool            m_bounce_on;            ///< Flag to turn bouncing completely off, default bounce is on.
 
+    size_t          m_stabilization_max_iterations;      ///< The maximum number of iterations of the post stabilization solver.
+    T               m_stabilization_absolute_tolerance;  ///< The absolute tolerance of the post stabilization solver.
+    T               m_stabilization_relative_tolerance;  ///< The relative tolerance of the post stabilization solver.
+
   public:
 
     stepper_type const & stepper()       const { return this->m_stepper; }
@@ -41,6 +48,10 @@ namespace prox
     bool const & contact_reduction() const { return this->m_contact_reduction; }
     bool const & bounce_on() const { return this->m_bounce_on; }
 
+    size_t const & stabilization_max_iterations()     const { return this->m_stabilization_max_iterations;     }
+    T      const & stabilization_absolute_tolerance() const { return this->m_stabilization_absolute_tolerance; }
+    T      const & stabilization_relative_tolerance() const { return this->m_stabilization_relative_tolerance; }
+
     void set_min_gap(T const & value)
     {
       assert(value >= VT::zero() || !"set_min_gap(): value must be nonnegative");
@@ -94,6 +105,34 @@ namespace prox
       this->m_bounce_on = value;
     }
 
+    void set_stabilization_max_iterations(size_t const & iterations)
+    {
+      assert(iterations > 0u || !"set_stabilization_max_iterations(): number of iterations must be positive");
+
+      this->m_stabilization_max_iterations = iterations;
+    }
+
+    void set_stabilization_absolute_tolerance(T const & value)
+    {
+      assert(value >= VT::zero() || !"set_stabilization_absolute_tolerance(): value must be non-negative");
+      assert(is_number(value)    || !"set_stabilization_absolute_tolerance(): value must be a number");
+      assert(is_finite(value)    || !"set_stabilization_absolute_tolerance(): value must be a finite value");
+
+      this->m_stabilization_absolute_tolerance = value;
+    }
+
+    /**
+     * @note     Does not accepting relative convergence when set to VT::zero()
+     */
+    void set_stabilization_relative_tolerance(T const & value)
+    {
+      assert(value >= VT::zero() || !"set_stabilization_relative_tolerance(): value must be non-negative");
+      assert(is_number(value)    || !"set_stabilization_relative_tolerance(): value must be a number");
+      assert(is_finite(value)    || !"set_stabilization_relative_tolerance(): value must be a finite value");
+
+      this->m_stabilization_relative_tolerance = value;
+    }
+
   public:
     
     StepperParams()
@@ -105,6 +144,9 @@ namespace prox
     , m_post_stabilization( true )
     , m_contact_reduction( true )
     , m_bounce_on(true)
+    , m_stabilization_max_iterations(100u)
+    , m_stabilization_absolute_tolerance(VT::numeric_cast(10e-5f) )
+    , m_stabilization_relative_tolerance(VT::zero() )
     {}
     
   };
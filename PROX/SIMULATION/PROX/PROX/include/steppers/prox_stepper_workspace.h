@@ -0,0 +1,61 @@
+#ifndef PROX_STEPPER_WORKSPACE_H
+#define PROX_STEPPER_WORKSPACE_H
+
+#include <prox_body_state.h>
+
+#include <solvers/prox_solver_workspace.h>
+
+namespace prox
+{
+
+  /**
+   * Work buffers of the time steppers.
+   *
+   * The owner of the simulation keeps one workspace alive for as long as
+   * it keeps stepping, so all vectors and sparse matrices of a time step
+   * keep their storage from one step to the next and are only grown when
+   * the number of bodies or contacts grows. Nothing stored in the
+   * workspace carries over from one step to the next, the steppers
+   * overwrite all of it.
+   *
+   * @tparam M   Math types policy.
+   */
+  template<typename M>
+  class StepperWorkspace
+  {
+  public:
+
+    typedef typename M::vector4_type         V4;
+    typedef typename M::vector6_type         V6;
+    typedef typename M::vector7_type         V7;
+    typedef typename M::diagonal6x6_type     D6x6;
+    typedef typename M::compressed4x6_type   CSR4x6;
+    typedef typename M::compressed6x4_type   CSR6x4;
+    typedef typename M::solver_policy        S;
+
+  public:
+
+    BodyState<M>         m_state;    ///< Struct-of-arrays store of the body states, holds the position and velocity vectors.
+    V7                   m_qM;       ///< Position half step update.
+    D6x6                 m_W;        ///< Inverse mass matrix.
+    V6                   m_h;        ///< External forces.
+    V6                   m_Wdth;     ///< The product of inverse mass matrix, time step and external forces, W*dt*h.
+    V6                   m_fc;       ///< Contact forces.
+    CSR4x6               m_J;        ///< Jacobian.
+    CSR6x4               m_JT;       ///< Transpose of the Jacobian.
+    CSR6x4               m_WJT;      ///< The product of the inverse mass matrix and the transposed Jacobian.
+    V4                   m_g;        ///< Correction/stabilization term.
+    V4                   m_e;        ///< Restitution coefficients.
+    V4                   m_mu;       ///< Friction coefficients.
+    V4                   m_lambda;   ///< Resulting forces.
+    V4                   m_b;        ///< Right hand side vector.
+    V4                   m_w;        ///< Current contact velocities.
+    SolverWorkspace<S>   m_solver;   ///< Work buffers of the solver.
+    SolverWorkspace<M>   m_stabilization;   ///< Work buffers of the post stabilization solver, runs in the precision of the bodies.
+
+  };
+
+} //namespace prox
+
+// PROX_STEPPER_WORKSPACE_H
+#endif
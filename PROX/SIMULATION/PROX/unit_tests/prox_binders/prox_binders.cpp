@@ -37,6 +37,9 @@ BOOST_AUTO_TEST_CASE(compile_testing)
   
   prox::SolverBinder<M>            prox_solver1     = prox::bind_solver<M>( prox::jacobi );
   prox::SolverBinder<M>            prox_solver2     = prox::bind_solver<M>( prox::gauss_seidel );
+  prox::SolverBinder<M>            prox_solver3     = prox::bind_solver<M>( prox::parallel_gauss_seidel );
+  prox::SolverBinder<M>            prox_solver4     = prox::bind_solver<M>( prox::parallel_jacobi );
+  prox::SolverBinder<M>            prox_solver5     = prox::bind_solver<M>( prox::parallel_jacobi, prox::nonnegative, prox::box_model );
 
   prox::StepperBinder<M>            prox_stepper1     = prox::bind_stepper<M>( prox::moreau );
   prox::StepperBinder<M>            prox_stepper2     = prox::bind_stepper<M>( prox::semi_implicit );
@@ -60,6 +63,9 @@ BOOST_AUTO_TEST_CASE(compile_testing)
 
   SHUT_UP_COMPILER_WARNING( prox_solver1 );
   SHUT_UP_COMPILER_WARNING( prox_solver2 );
+  SHUT_UP_COMPILER_WARNING( prox_solver3 );
+  SHUT_UP_COMPILER_WARNING( prox_solver4 );
+  SHUT_UP_COMPILER_WARNING( prox_solver5 );
 
   SHUT_UP_COMPILER_WARNING( prox_stepper1 );
   SHUT_UP_COMPILER_WARNING( prox_stepper2 );
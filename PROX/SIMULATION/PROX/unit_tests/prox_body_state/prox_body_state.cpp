@@ -0,0 +1,161 @@
+#include <sparse.h>
+
+#include <narrow.h>
+
+#include <prox_rigid_body.h>
+#include <prox_body_state.h>
+#include <prox_get_position_vector.h>
+#include <prox_get_velocity_vector.h>
+#include <prox_get_inverse_mass_matrix.h>
+
+#include <prox_math_policy.h>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/test_tools.hpp>
+
+typedef prox::MathPolicy<float>          math_policy;
+typedef math_policy::real_type           real_type;
+typedef math_policy::vector3_type        vector3_type;
+typedef math_policy::quaternion_type     quaternion_type;
+typedef math_policy::matrix3x3_type      matrix3x3_type;
+typedef math_policy::vector6_type        vector6_type;
+typedef math_policy::vector7_type        vector7_type;
+typedef math_policy::diagonal6x6_type    diagonal6x6_type;
+
+typedef prox::RigidBody< math_policy >   body_type;
+
+static void make_bodies( std::vector< body_type > & bodies )
+{
+  bodies.resize( 4u );
+
+  for(size_t i = 0u; i < bodies.size(); ++i)
+  {
+    real_type const s = static_cast<real_type>( i + 1u );
+
+    bodies[i].set_position( vector3_type::make( s, 2.0f*s, -s ) );
+    bodies[i].set_orientation( quaternion_type( 1.0f, 0.1f*s, -0.2f*s, 0.3f ) );
+    bodies[i].set_velocity( vector3_type::make( -s, 0.5f, s ) );
+    bodies[i].set_spin( vector3_type::make( 0.1f, s, 0.2f ) );
+    bodies[i].set_mass( 2.0f*s );
+    bodies[i].set_inertia_bf( matrix3x3_type::make_diag( s, 2.0f*s, 3.0f*s ) );
+  }
+
+  bodies[1].set_fixed( true );
+  bodies[3].set_scripted( true );
+}
+
+BOOST_AUTO_TEST_SUITE(body_state);
+
+BOOST_AUTO_TEST_CASE(get_body_state_test)
+{
+  std::vector< body_type > bodies;
+
+  make_bodies( bodies );
+
+  prox::BodyState< math_policy > state;
+
+  prox::get_body_state( bodies.begin(), bodies.end(), state, math_policy() );
+
+  vector7_type q;
+  vector6_type u;
+
+  prox::get_position_vector( bodies.begin(), bodies.end(), q, math_policy() );
+  prox::get_velocity_vector( bodies.begin(), bodies.end(), u, math_policy() );
+
+  BOOST_CHECK( state.size() == bodies.size() );
+
+  for(size_t k = 0u; k < bodies.size(); ++k)
+  {
+    for(size_t i = 0u; i < 7u; ++i)
+      BOOST_CHECK_EQUAL( state.m_q(k)(i), q(k)(i) );
+
+    for(size_t i = 0u; i < 6u; ++i)
+      BOOST_CHECK_EQUAL( state.m_u(k)(i), u(k)(i) );
+  }
+
+  BOOST_CHECK(  state.m_active[0] );
+  BOOST_CHECK( !state.m_active[1] );
+  BOOST_CHECK(  state.m_active[2] );
+  BOOST_CHECK( !state.m_active[3] );
+
+  BOOST_CHECK_EQUAL( state.m_inv_mass[0], 0.5f );
+  BOOST_CHECK_EQUAL( state.m_inv_mass[1], 0.0f );
+  BOOST_CHECK_EQUAL( state.m_inv_mass[3], 0.0f );
+}
+
+BOOST_AUTO_TEST_CASE(inverse_mass_matrix_test)
+{
+  std::vector< body_type > bodies;
+
+  make_bodies( bodies );
+
+  prox::BodyState< math_policy > state;
+
+  prox::get_body_state( bodies.begin(), bodies.end(), state, math_policy() );
+
+  diagonal6x6_type W_bodies;
+  diagonal6x6_type W_state;
+
+  prox::get_inverse_mass_matrix( bodies.begin(), bodies.end(), W_bodies, math_policy() );
+  prox::get_inverse_mass_matrix( state, state.m_q, W_state, math_policy() );
+
+  BOOST_CHECK( W_state.size() == W_bodies.size() );
+
+  for(size_t k = 0u; k < bodies.size(); ++k)
+    for(size_t i = 0u; i < 6u; ++i)
+      for(size_t j = 0u; j < 6u; ++j)
+      {
+        if( W_bodies(k)(i,j) == 0.0f )
+          BOOST_CHECK_SMALL( W_state(k)(i,j), 1e-6f );
+        else
+          BOOST_CHECK_CLOSE( W_state(k)(i,j), W_bodies(k)(i,j), 0.01f );
+      }
+}
+
+BOOST_AUTO_TEST_CASE(set_body_state_test)
+{
+  std::vector< body_type > bodies;
+
+  make_bodies( bodies );
+
+  prox::BodyState< math_policy > state;
+
+  prox::get_body_state( bodies.begin(), bodies.end(), state, math_policy() );
+
+  for(size_t k = 0u; k < bodies.size(); ++k)
+  {
+    state.m_q(k)(0) += 1.0f;
+    state.m_u(k)(1) += 1.0f;
+  }
+
+  vector7_type qM = state.m_q;
+
+  for(size_t k = 0u; k < bodies.size(); ++k)
+    qM(k)(2) += 10.0f;
+
+  // Only positions are written, and only to bodies that are neither fixed nor scripted
+  prox::set_body_positions( bodies.begin(), bodies.end(), qM, state, math_policy() );
+
+  BOOST_CHECK_EQUAL( bodies[0].get_position()(2), -1.0f + 10.0f );
+  BOOST_CHECK_EQUAL( bodies[1].get_position()(2), -2.0f );
+  BOOST_CHECK_EQUAL( bodies[2].get_position()(2), -3.0f + 10.0f );
+  BOOST_CHECK_EQUAL( bodies[3].get_position()(2), -4.0f );
+  BOOST_CHECK_EQUAL( bodies[0].get_velocity()(1), 0.5f );
+
+  prox::set_body_state( bodies.begin(), bodies.end(), state, math_policy() );
+
+  BOOST_CHECK_EQUAL( bodies[0].get_position()(0), 2.0f );
+  BOOST_CHECK_EQUAL( bodies[0].get_position()(2), -1.0f );
+  BOOST_CHECK_EQUAL( bodies[0].get_velocity()(1), 1.5f );
+  BOOST_CHECK_EQUAL( bodies[1].get_position()(0), 2.0f );
+  BOOST_CHECK_EQUAL( bodies[1].get_velocity()(1), 0.5f );
+  BOOST_CHECK_EQUAL( bodies[2].get_position()(0), 4.0f );
+  BOOST_CHECK_EQUAL( bodies[2].get_velocity()(1), 1.5f );
+  BOOST_CHECK_EQUAL( bodies[3].get_position()(0), 4.0f );
+  BOOST_CHECK_EQUAL( bodies[3].get_velocity()(1), 0.5f );
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -0,0 +1,152 @@
+#include <prox_rigid_body.h>
+#include <prox_contact_point.h>
+#include <prox_contact_cache.h>
+
+#include <prox_math_policy.h>
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/test/unit_test_suite.hpp>
+#include <boost/test/test_tools.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+typedef prox::MathPolicy<float>      math_policy;
+typedef math_policy::real_type       real_type;
+typedef math_policy::vector3_type    vector3_type;
+typedef math_policy::block4x1_type   block4x1_type;
+typedef prox::RigidBody<math_policy> body_type;
+typedef prox::ContactPoint<math_policy> contact_type;
+
+namespace
+{
+  contact_type make_contact(
+                            body_type const * A
+                            , body_type const * B
+                            , vector3_type const & n
+                            , size_t const & fa
+                            , size_t const & fb
+                            , size_t const & point
+                            )
+  {
+    contact_type contact;
+    contact.set_body_i( A );
+    contact.set_body_j( B );
+    contact.set_normal( n );
+    contact.set_features( fa, fb, point );
+    return contact;
+  }
+
+  block4x1_type make_impulse(real_type const & a, real_type const & b, real_type const & c, real_type const & d)
+  {
+    block4x1_type impulse;
+    impulse(0) = a;
+    impulse(1) = b;
+    impulse(2) = c;
+    impulse(3) = d;
+    return impulse;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(contact_cache);
+
+BOOST_AUTO_TEST_CASE(restore_matching_contacts)
+{
+  std::vector<body_type> bodies(3u);
+  bodies[0].set_idx(0u);
+  bodies[1].set_idx(1u);
+  bodies[2].set_idx(2u);
+
+  vector3_type const up = vector3_type::make(0.0f, 1.0f, 0.0f);
+
+  std::vector<contact_type> old_contacts;
+  old_contacts.push_back( make_contact( &bodies[0], &bodies[1], up, 3u, 4u, 0u ) );
+  old_contacts.push_back( make_contact( &bodies[0], &bodies[1], up, 3u, 4u, 1u ) );
+  old_contacts.push_back( make_contact( &bodies[1], &bodies[2], up, 0u, 0u, 0u ) );
+
+  old_contacts[0].set_impulse( make_impulse(1.0f, 0.5f, 0.25f, 0.1f) );
+  old_contacts[1].set_impulse( make_impulse(2.0f, 0.0f, 0.0f, 0.0f) );
+  old_contacts[2].set_impulse( make_impulse(3.0f, 0.0f, 0.0f, 0.0f) );
+
+  old_contacts[0].set_stabilization_impulse( 0.3f );
+  old_contacts[1].set_stabilization_impulse( 0.6f );
+
+  prox::ContactCache<math_policy> cache;
+  cache.store( old_contacts.begin(), old_contacts.end() );
+  BOOST_CHECK_EQUAL( cache.size(), 3u );
+
+  std::vector<contact_type> new_contacts;
+  new_contacts.push_back( make_contact( &bodies[0], &bodies[1], up, 3u, 4u, 1u ) ); // same key, other order
+  new_contacts.push_back( make_contact( &bodies[0], &bodies[1], up, 3u, 4u, 0u ) );
+  new_contacts.push_back( make_contact( &bodies[0], &bodies[2], up, 0u, 0u, 0u ) ); // unknown body pair
+  new_contacts.push_back( make_contact( &bodies[1], &bodies[2], -up, 0u, 0u, 0u ) ); // normal flipped
+
+  new_contacts[2].set_impulse( make_impulse(9.0f, 9.0f, 9.0f, 9.0f) );
+  new_contacts[2].set_stabilization_impulse( 9.0f );
+
+  size_t const matches = cache.restore( new_contacts.begin(), new_contacts.end() );
+
+  BOOST_CHECK_EQUAL( matches, 2u );
+
+  BOOST_CHECK_CLOSE( new_contacts[0].get_impulse()(0), 2.0f, 0.01f );
+
+  BOOST_CHECK_CLOSE( new_contacts[1].get_impulse()(0), 1.0f,  0.01f );
+  BOOST_CHECK_CLOSE( new_contacts[1].get_impulse()(1), 0.5f,  0.01f );
+  BOOST_CHECK_CLOSE( new_contacts[1].get_impulse()(2), 0.25f, 0.01f );
+  BOOST_CHECK_CLOSE( new_contacts[1].get_impulse()(3), 0.1f,  0.01f );
+
+  BOOST_CHECK_EQUAL( new_contacts[2].get_impulse()(0), 0.0f );
+  BOOST_CHECK_EQUAL( new_contacts[2].get_impulse()(1), 0.0f );
+
+  BOOST_CHECK_EQUAL( new_contacts[3].get_impulse()(0), 0.0f );
+
+  BOOST_CHECK_CLOSE( new_contacts[0].get_stabilization_impulse(), 0.6f, 0.01f );
+  BOOST_CHECK_CLOSE( new_contacts[1].get_stabilization_impulse(), 0.3f, 0.01f );
+  BOOST_CHECK_EQUAL( new_contacts[2].get_stabilization_impulse(), 0.0f );
+  BOOST_CHECK_EQUAL( new_contacts[3].get_stabilization_impulse(), 0.0f );
+}
+
+BOOST_AUTO_TEST_CASE(restore_swapped_bodies)
+{
+  std::vector<body_type> bodies(2u);
+  bodies[0].set_idx(0u);
+  bodies[1].set_idx(1u);
+
+  vector3_type const n = tiny::unit( vector3_type::make(0.0f, 1.0f, 0.2f) );
+
+  std::vector<contact_type> old_contacts;
+  old_contacts.push_back( make_contact( &bodies[0], &bodies[1], n, 7u, 2u, 0u ) );
+  old_contacts[0].set_impulse( make_impulse(1.0f, 0.5f, -0.25f, 0.1f) );
+
+  prox::ContactCache<math_policy> cache;
+  cache.store( old_contacts.begin(), old_contacts.end() );
+
+  std::vector<contact_type> new_contacts;
+  new_contacts.push_back( make_contact( &bodies[1], &bodies[0], -n, 2u, 7u, 0u ) );
+
+  size_t const matches = cache.restore( new_contacts.begin(), new_contacts.end() );
+
+  BOOST_CHECK_EQUAL( matches, 1u );
+
+  vector3_type s_old;
+  vector3_type t_old;
+  tiny::orthonormal_vectors( s_old, t_old, n );
+
+  vector3_type s_new;
+  vector3_type t_new;
+  tiny::orthonormal_vectors( s_new, t_new, -n );
+
+  // The friction impulse acting on the old body j must equal minus the
+  // friction impulse acting on the new body i.
+  block4x1_type const & impulse = new_contacts[0].get_impulse();
+
+  vector3_type const F_old = t_old*0.5f + s_old*(-0.25f);
+  vector3_type const F_new = t_new*impulse(1) + s_new*impulse(2);
+
+  BOOST_CHECK_CLOSE( impulse(0), 1.0f, 0.01f );
+  BOOST_CHECK_CLOSE( impulse(3), 0.1f, 0.01f );
+  BOOST_CHECK_SMALL( F_old(0) + F_new(0), 1e-5f );
+  BOOST_CHECK_SMALL( F_old(1) + F_new(1), 1e-5f );
+  BOOST_CHECK_SMALL( F_old(2) + F_new(2), 1e-5f );
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -3,6 +3,13 @@
 #include <prox_math_policy.h>
 #include <solvers/prox_jacobi_solver.h>
 #include <solvers/prox_gauss_seidel_solver.h>
+#include <solvers/prox_parallel_gauss_seidel_solver.h>
+#include <solvers/prox_parallel_jacobi_solver.h>
+#include <solvers/prox_stabilization_solver.h>
+#include <solvers/prox_bind_solver.h>
+#include <solvers/strategies/prox_bind_R_strategy.h>
+#include <solvers/sub/prox_bind_normal_sub_solver.h>
+#include <solvers/sub/prox_bind_friction_sub_solver.h>
 
 #define BOOST_AUTO_TEST_MAIN
 #include <boost/test/auto_unit_test.hpp>
@@ -275,76 +282,28 @@ void run_3_body_prox_solver_test(prox_solver_functor const & prox_solver )
 }
 
 /**
- * This function build a 4 body test setup for use with a solver for the contact problem, 
- * and performs a number of tests. It takes the math policy as template arguments, and 
- * the solver and number of cores to use as function arguments.
- * 
- * The setup has a unit sphere b_1 placed at (0,2,0), resting
- * on top of a 2x2x2 fixed box b_0 with its center at the origin. Another unit 
- * sphere b_2 is present at (1.4142,3.4142,0) and is in contact with b_1. A 3rd
- * unit sphere is placed at ( -0.517638,3.93185,0.0), which places it in contact
- * with b_1 and b_2. All bodies are at rest.
- *
- * The sphere b_2 is expected to experience a normal velocity of magnitude 
- * v = 0.5gt = 0.5*9.81*0.01 = 0.04905, with the impulse P = mv 
- * = 20*0.04905 = 0.981. In the friction direction, the velocity is
- * expected to be similar, but the bound on the friction impulse is
- * mu*lambda_n = 0.5*0.981 = 0.4905.
- *
- * The sphere b_1 is affected by two contact points, with b_0 and b_1. 
- * The speed of the sphere is g*t = -9.81*0.01 = -0.0981, and the impulse is
- * P = m*v = 20*-0.0981 = -1.962, so the magnitude of the normal impulse must
- * be close to 1.962.
- *
- * However, as the two contact points affect the same body, b_1, they will
- * affect each other. The upper sphere b_2 will push b_1 to the side, causing 
- * a friction impulse between b_0 and b_1, equal in magnitude to the friction
- * between b_1 and b_2, as it is this impulse that causes the movement of b_1.
- * As the lower sphere will move out of the way, the actual normal impulse 
- * between b_1 and b_2 is likely to be smaller than computed above.
- *
- * The 3rd sphere is expected to push b_2 in the x direction and add normal 
- * impulse to b_1.
- *
- * The solution is exected to be (5.327,0.3471,0,0), (1.410,-0.6658,0,0),
- *(1.887,0.2860,0,0) and (0,0,0,0)
+ * This function fills in the contact problem of the 4 body test setup
+ * described below, such that several solvers can be run on the same problem.
  */
-template<typename math_policy, typename prox_solver_functor>
-void run_4_body_prox_solver_test(prox_solver_functor const & prox_solver)
-{  
-  typename math_policy::vector7_type q(4);
-  typename math_policy::vector6_type Wdth(4), u(4);
-  typename math_policy::vector4_type lambda(4), g(4), e(4), mu(4);
-  typename math_policy::compressed4x6_type J(4,4,8);
-  typename math_policy::compressed6x4_type WJT(4,4,8);
-  prox::SolverParams<math_policy> params;
+template<typename math_policy>
+void make_4_body_contact_problem(
+                                 typename math_policy::compressed4x6_type & J
+                                 , typename math_policy::compressed6x4_type & WJT
+                                 , typename math_policy::vector6_type & Wdth
+                                 , typename math_policy::vector4_type & mu
+                                 )
+{
+  J.resize(4,4,8);
+  WJT.resize(4,4,8);
+  Wdth.resize(4);
+  mu.resize(4);
   
   //filling the vectors
-  q(0)[0] = 0;      q(0)[1] = 0;      q(0)[2] = 0;  q(0)[3] = 1.0; q(0)[4] = 0;  q(0)[5] = 0;  q(0)[6] = 0;
-  q(1)[0] = 0;      q(1)[1] = 2.0;    q(1)[2] = 0;  q(1)[3] = 1.0; q(1)[4] = 0;  q(1)[5] = 0;  q(1)[6] = 0;
-  q(2)[0] = 1.4142; q(2)[1] = 3.4142; q(1)[2] = 0;  q(2)[3] = 1.0; q(2)[4] = 0;  q(2)[5] = 0;  q(2)[6] = 0;
-  q(3)[0] = -0.51764; q(3)[1] = 3.9319;  q(3)[2] = 0;  q(3)[3] = 1.0; q(3)[4] = 0;  q(3)[5] = 0;  q(3)[6] = 0;
-  
-  u(0)[0] = 0;  u(0)[1] = 0;  u(0)[2] = 0;  u(0)[3] = 0; u(0)[4] = 0;  u(0)[5] = 0;
-  u(1)[0] = 0;  u(1)[1] = 0;  u(1)[2] = 0;  u(1)[3] = 0; u(1)[4] = 0;  u(1)[5] = 0;
-  u(2)[0] = 0;  u(2)[1] = 0;  u(2)[2] = 0;  u(2)[3] = 0; u(2)[4] = 0;  u(2)[5] = 0;
-  u(3)[0] = 0;  u(3)[1] = 0;  u(3)[2] = 0;  u(3)[3] = 0; u(3)[4] = 0;  u(3)[5] = 0;
-  
   Wdth(0)[0] = 0;  Wdth(0)[1] = 0;       Wdth(0)[2] = 0;  Wdth(0)[3] = 0; Wdth(0)[4] = 0;  Wdth(0)[5] = 0;
   Wdth(1)[0] = 0;  Wdth(1)[1] = -0.0981; Wdth(1)[2] = 0;  Wdth(1)[3] = 0; Wdth(1)[4] = 0;  Wdth(1)[5] = 0;
-  Wdth(2)[0] = 0;  Wdth(2)[1] = -0.0981; Wdth(1)[2] = 0;  Wdth(2)[3] = 0; Wdth(2)[4] = 0;  Wdth(2)[5] = 0;
+  Wdth(2)[0] = 0;  Wdth(2)[1] = -0.0981; Wdth(2)[2] = 0;  Wdth(2)[3] = 0; Wdth(2)[4] = 0;  Wdth(2)[5] = 0;
   Wdth(3)[0] = 0;  Wdth(3)[1] = -0.0981; Wdth(3)[2] = 0;  Wdth(3)[3] = 0; Wdth(3)[4] = 0;  Wdth(3)[5] = 0;
   
-  g(0)[0]  = 0;  g(0)[1]  = 0;   g(0)[2]  = 0;   g(0)[3]  = 0;
-  g(1)[0]  = 0;  g(1)[1]  = 0;   g(1)[2]  = 0;   g(1)[3]  = 0;
-  g(2)[0]  = 0;  g(2)[1]  = 0;   g(2)[2]  = 0;   g(2)[3]  = 0;
-  g(3)[0]  = 0;  g(3)[1]  = 0;   g(3)[2]  = 0;   g(3)[3]  = 0;
-  
-  e(0)[0]  = 1;  e(0)[1]  = 0;   e(0)[2]  = 0;   e(0)[3]  = 0;
-  e(1)[0]  = 1;  e(1)[1]  = 0;   e(1)[2]  = 0;   e(1)[3]  = 0;
-  e(2)[0]  = 1;  e(2)[1]  = 0;   e(2)[2]  = 0;   e(2)[3]  = 0;
-  e(3)[0]  = 1;  e(3)[1]  = 0;   e(3)[2]  = 0;   e(3)[3]  = 0;
-  
   mu(0)[0] = 0;  mu(0)[1] = 0.5; mu(0)[2] = 0.5; mu(0)[3] = 0.5;
   mu(1)[0] = 0;  mu(1)[1] = 0.5; mu(1)[2] = 0.5; mu(1)[3] = 0.5;
   mu(2)[0] = 0;  mu(2)[1] = 0.5; mu(2)[2] = 0.5; mu(2)[3] = 0.5;
@@ -468,6 +427,75 @@ void run_4_body_prox_solver_test(prox_solver_functor const & prox_solver)
   WJT(3,3)[12] = 0;    WJT(3,3)[13] = c30;   WJT(3,3)[14] = 0;    WJT(3,3)[15] = -c31;
   WJT(3,3)[16] = 0;    WJT(3,3)[17] = c31;   WJT(3,3)[18] = 0;    WJT(3,3)[19] = c30;
   WJT(3,3)[20] = 0;    WJT(3,3)[21] = 0;     WJT(3,3)[22] = 0.05; WJT(3,3)[23] = 0;
+}
+
+/**
+ * This function build a 4 body test setup for use with a solver for the contact problem, 
+ * and performs a number of tests. It takes the math policy as template arguments, and 
+ * the solver and number of cores to use as function arguments.
+ * 
+ * The setup has a unit sphere b_1 placed at (0,2,0), resting
+ * on top of a 2x2x2 fixed box b_0 with its center at the origin. Another unit 
+ * sphere b_2 is present at (1.4142,3.4142,0) and is in contact with b_1. A 3rd
+ * unit sphere is placed at ( -0.517638,3.93185,0.0), which places it in contact
+ * with b_1 and b_2. All bodies are at rest.
+ *
+ * The sphere b_2 is expected to experience a normal velocity of magnitude 
+ * v = 0.5gt = 0.5*9.81*0.01 = 0.04905, with the impulse P = mv 
+ * = 20*0.04905 = 0.981. In the friction direction, the velocity is
+ * expected to be similar, but the bound on the friction impulse is
+ * mu*lambda_n = 0.5*0.981 = 0.4905.
+ *
+ * The sphere b_1 is affected by two contact points, with b_0 and b_1. 
+ * The speed of the sphere is g*t = -9.81*0.01 = -0.0981, and the impulse is
+ * P = m*v = 20*-0.0981 = -1.962, so the magnitude of the normal impulse must
+ * be close to 1.962.
+ *
+ * However, as the two contact points affect the same body, b_1, they will
+ * affect each other. The upper sphere b_2 will push b_1 to the side, causing 
+ * a friction impulse between b_0 and b_1, equal in magnitude to the friction
+ * between b_1 and b_2, as it is this impulse that causes the movement of b_1.
+ * As the lower sphere will move out of the way, the actual normal impulse 
+ * between b_1 and b_2 is likely to be smaller than computed above.
+ *
+ * The 3rd sphere is expected to push b_2 in the x direction and add normal 
+ * impulse to b_1.
+ *
+ * The solution is exected to be (5.327,0.3471,0,0), (1.410,-0.6658,0,0),
+ *(1.887,0.2860,0,0) and (0,0,0,0)
+ */
+template<typename math_policy, typename prox_solver_functor>
+void run_4_body_prox_solver_test(prox_solver_functor const & prox_solver)
+{  
+  typename math_policy::vector7_type q(4);
+  typename math_policy::vector6_type Wdth(4), u(4);
+  typename math_policy::vector4_type lambda(4), g(4), e(4), mu(4);
+  typename math_policy::compressed4x6_type J(4,4,8);
+  typename math_policy::compressed6x4_type WJT(4,4,8);
+  prox::SolverParams<math_policy> params;
+  
+  //filling the vectors
+  q(0)[0] = 0;      q(0)[1] = 0;      q(0)[2] = 0;  q(0)[3] = 1.0; q(0)[4] = 0;  q(0)[5] = 0;  q(0)[6] = 0;
+  q(1)[0] = 0;      q(1)[1] = 2.0;    q(1)[2] = 0;  q(1)[3] = 1.0; q(1)[4] = 0;  q(1)[5] = 0;  q(1)[6] = 0;
+  q(2)[0] = 1.4142; q(2)[1] = 3.4142; q(1)[2] = 0;  q(2)[3] = 1.0; q(2)[4] = 0;  q(2)[5] = 0;  q(2)[6] = 0;
+  q(3)[0] = -0.51764; q(3)[1] = 3.9319;  q(3)[2] = 0;  q(3)[3] = 1.0; q(3)[4] = 0;  q(3)[5] = 0;  q(3)[6] = 0;
+  
+  u(0)[0] = 0;  u(0)[1] = 0;  u(0)[2] = 0;  u(0)[3] = 0; u(0)[4] = 0;  u(0)[5] = 0;
+  u(1)[0] = 0;  u(1)[1] = 0;  u(1)[2] = 0;  u(1)[3] = 0; u(1)[4] = 0;  u(1)[5] = 0;
+  u(2)[0] = 0;  u(2)[1] = 0;  u(2)[2] = 0;  u(2)[3] = 0; u(2)[4] = 0;  u(2)[5] = 0;
+  u(3)[0] = 0;  u(3)[1] = 0;  u(3)[2] = 0;  u(3)[3] = 0; u(3)[4] = 0;  u(3)[5] = 0;
+  
+  g(0)[0]  = 0;  g(0)[1]  = 0;   g(0)[2]  = 0;   g(0)[3]  = 0;
+  g(1)[0]  = 0;  g(1)[1]  = 0;   g(1)[2]  = 0;   g(1)[3]  = 0;
+  g(2)[0]  = 0;  g(2)[1]  = 0;   g(2)[2]  = 0;   g(2)[3]  = 0;
+  g(3)[0]  = 0;  g(3)[1]  = 0;   g(3)[2]  = 0;   g(3)[3]  = 0;
+  
+  e(0)[0]  = 1;  e(0)[1]  = 0;   e(0)[2]  = 0;   e(0)[3]  = 0;
+  e(1)[0]  = 1;  e(1)[1]  = 0;   e(1)[2]  = 0;   e(1)[3]  = 0;
+  e(2)[0]  = 1;  e(2)[1]  = 0;   e(2)[2]  = 0;   e(2)[3]  = 0;
+  e(3)[0]  = 1;  e(3)[1]  = 0;   e(3)[2]  = 0;   e(3)[3]  = 0;
+  
+  make_4_body_contact_problem<math_policy>( J, WJT, Wdth, mu );
   
   BOOST_CHECK(false);
   //  prox_solver( ... fix me .... );
@@ -495,6 +523,103 @@ void run_4_body_prox_solver_test(prox_solver_functor const & prox_solver)
 }
 
 
+/**
+ * Checks the flat copy of a block matrix and its block kernels against the
+ * block products of the sparse library.
+ */
+template<typename math_policy>
+void run_flat_block_matrix_test()
+{
+  typedef typename math_policy::real_type T;
+
+  size_t const K = 3u;
+  size_t const N = 4u;
+
+  typename math_policy::compressed4x6_type J(K,N,2*K);
+  typename math_policy::compressed6x4_type JT;
+
+  for(size_t k = 0u; k < K; ++k)
+  {
+    typename math_policy::block4x6_type A;
+
+    for(size_t e = 0u; e < 24u; ++e)
+      A[e] = ( (k*7u + e*3u) % 11u ) / T(5.0) - T(1.0);
+
+    J(k,k)    = A;
+    J(k,k+1u) = A;
+  }
+
+  typename math_policy::diagonal6x6_type W;
+  W.resize( N );
+  for(size_t i = 0u; i < N; ++i)
+  {
+    typename math_policy::block6x6_type D( T(0.0) );
+    for(size_t r = 0u; r < 6u; ++r)
+      D(r,r) = T(1.0);
+    W(i) = D;
+  }
+
+  math_policy::compute_WJT( W, J, JT );
+
+  prox::detail::FlatBlockMatrix<T,4,6> flat_J;
+  prox::detail::FlatBlockMatrix<T,6,4> flat_JT;
+
+  flat_J.assign( J );
+  flat_JT.assign( JT );
+
+  BOOST_CHECK_EQUAL( flat_J.m_row_ptr.size(), K + 1u );
+  BOOST_CHECK_EQUAL( flat_J.m_row_ptr[K], 2u*K );
+  BOOST_CHECK_EQUAL( flat_JT.m_row_ptr.size(), N + 1u );
+  BOOST_CHECK_EQUAL( flat_JT.m_row_ptr[N], 2u*K );
+
+  std::vector<T> w( 6u*N );
+  std::vector<T> x( 4u*K );
+
+  for(size_t i = 0u; i < w.size(); ++i)
+    w[i] = ( (i*5u) % 7u ) / T(3.0) - T(1.0);
+
+  for(size_t i = 0u; i < x.size(); ++i)
+    x[i] = ( (i*3u) % 5u ) / T(2.0) - T(1.0);
+
+  for(size_t k = 0u; k < K; ++k)
+  {
+    T y[4] = { T(1.0), T(2.0), T(3.0), T(4.0) };
+
+    for(size_t p = flat_J.m_row_ptr[k]; p < flat_J.m_row_ptr[k+1]; ++p)
+      prox::detail::prod_add_4x6( &flat_J.m_data[p*24u], &w[6u*flat_J.m_cols[p]], y );
+
+    for(size_t r = 0u; r < 4u; ++r)
+    {
+      T expected = T(r + 1u);
+
+      for(size_t i = 0u; i < N; ++i)
+        for(size_t c = 0u; c < 6u; ++c)
+          expected += ( (i == k || i == k+1u) ? J(k,i)(r,c) : T(0.0) ) * w[6u*i + c];
+
+      BOOST_CHECK_CLOSE( y[r], expected, 1e-4 );
+    }
+  }
+
+  for(size_t i = 0u; i < N; ++i)
+  {
+    T y[6] = { T(0.0), T(0.0), T(0.0), T(0.0), T(0.0), T(0.0) };
+
+    for(size_t p = flat_JT.m_row_ptr[i]; p < flat_JT.m_row_ptr[i+1]; ++p)
+      prox::detail::prod_add_6x4( &flat_JT.m_data[p*24u], &x[4u*flat_JT.m_cols[p]], y );
+
+    for(size_t r = 0u; r < 6u; ++r)
+    {
+      T expected = T(0.0);
+
+      for(size_t k = 0u; k < K; ++k)
+        for(size_t c = 0u; c < 4u; ++c)
+          expected += ( (i == k || i == k+1u) ? J(k,i)(c,r) : T(0.0) ) * x[4u*k + c];
+
+      BOOST_CHECK_SMALL( y[r] - expected, T(1e-4) );
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE(prox_solver);
 
 BOOST_AUTO_TEST_CASE(jacobi_2_body)
@@ -533,4 +658,381 @@ BOOST_AUTO_TEST_CASE(gauss_seidel_4_body)
   run_4_body_prox_solver_test<math_policy>( prox::gauss_seidel_solver<math_policy> );
 }
 
+BOOST_AUTO_TEST_CASE(parallel_gauss_seidel_coloring)
+{
+  typedef prox::MathPolicy<float> math_policy;
+
+  // Body 0 is fixed, bodies 1, 2 and 3 are dynamic. Contacts 0, 1 and 2 all
+  // touch the fixed body, contacts 3 and 4 form a chain 1-2-3.
+  size_t const N = 4u;
+  size_t const K = 5u;
+  size_t const pairs[K][2] = { {0u,1u}, {0u,2u}, {0u,3u}, {1u,2u}, {2u,3u} };
+
+  math_policy::compressed4x6_type J(K,N,2*K);
+  math_policy::compressed6x4_type WJT;
+
+  for(size_t k = 0u; k < K; ++k)
+  {
+    J(k,pairs[k][0]) = math_policy::block4x6_type( 1.0f );
+    J(k,pairs[k][1]) = math_policy::block4x6_type( 1.0f );
+  }
+
+  math_policy::diagonal6x6_type W;
+  W.resize( N );
+  for(size_t i = 1u; i < N; ++i)
+    W(i) = math_policy::block6x6_type( 1.0f );
+
+  math_policy::compute_WJT( W, J, WJT );
+
+  std::vector<bool> dynamic;
+  prox::detail::find_dynamic_bodies<math_policy>( WJT, dynamic );
+
+  BOOST_CHECK( !dynamic[0] );
+  BOOST_CHECK(  dynamic[1] );
+  BOOST_CHECK(  dynamic[2] );
+  BOOST_CHECK(  dynamic[3] );
+
+  prox::detail::ContactColoring coloring;
+  prox::detail::color_contacts<math_policy>( J, dynamic, coloring );
+
+  std::vector<size_t> color_of( K, K );
+  size_t count = 0u;
+  for(size_t c = 0u; c < coloring.size(); ++c)
+    for(size_t p = coloring.m_color_ptr[c]; p < coloring.m_color_ptr[c+1]; ++p, ++count)
+      color_of[ coloring.m_contacts[p] ] = c;
+
+  BOOST_CHECK_EQUAL( count, K );
+
+  // Contacts only sharing the fixed body may be solved concurrently
+  BOOST_CHECK_EQUAL( color_of[0], color_of[1] );
+  BOOST_CHECK_EQUAL( color_of[1], color_of[2] );
+
+  // Contacts sharing a dynamic body must never be solved concurrently
+  for(size_t a = 0u; a < K; ++a)
+    for(size_t b = a+1u; b < K; ++b)
+      for(size_t i = 0u; i < 2u; ++i)
+        for(size_t j = 0u; j < 2u; ++j)
+          if( pairs[a][i] == pairs[b][j] && dynamic[ pairs[a][i] ] )
+            BOOST_CHECK( color_of[a] != color_of[b] );
+}
+
+BOOST_AUTO_TEST_CASE(parallel_gauss_seidel_same_as_gauss_seidel_4_body)
+{
+  typedef prox::MathPolicy<float> math_policy;
+
+  math_policy::compressed4x6_type J;
+  math_policy::compressed6x4_type WJT;
+  math_policy::vector6_type       Wdth;
+  math_policy::vector4_type       mu;
+
+  make_4_body_contact_problem<math_policy>( J, WJT, Wdth, mu );
+
+  // The bodies start at rest, so b = J W dt h
+  math_policy::vector4_type b;
+  b.resize( J.nrows() );
+  for(size_t k = 0u; k < J.nrows(); ++k)
+    b(k) = math_policy::block4x1_type( 0.0f );
+  sparse::prod( J, Wdth, b );
+
+  prox::SolverParams<math_policy> params;
+  params.set_max_iterations( 1000u );
+  params.set_absolute_tolerance( 1e-6f );
+  params.set_relative_tolerance( 0.0f );
+
+  prox::RStrategyBinder<math_policy>     strategy        = prox::bind_strategy<math_policy>( prox::local_strategy );
+  prox::NormalSubSolverBinder<float>     normal_solver   = prox::bind_normal_solver<float>( prox::nonnegative );
+  prox::FrictionSubSolverBinder<float>   friction_solver = prox::bind_friction_solver<float>( prox::analytical_sphere );
+
+  math_policy::vector4_type lambda_gauss_seidel;
+  math_policy::vector4_type lambda_parallel;
+
+  prox::SolverWorkspace<math_policy> workspace;
+
+  prox::gauss_seidel_solver<math_policy>(J, WJT, b, mu, lambda_gauss_seidel, strategy, normal_solver, friction_solver, params, workspace, math_policy() );
+  prox::parallel_gauss_seidel_solver<math_policy>(J, WJT, b, mu, lambda_parallel, strategy, normal_solver, friction_solver, params, workspace, math_policy() );
+
+  BOOST_CHECK_EQUAL( lambda_parallel.size(), J.nrows() );
+
+  for(size_t k = 0u; k < J.nrows(); ++k)
+    for(size_t i = 0u; i < 4u; ++i)
+      BOOST_CHECK_CLOSE( lambda_parallel(k)(i) + 1.0f, lambda_gauss_seidel(k)(i) + 1.0f, 0.01f );
+}
+
+BOOST_AUTO_TEST_CASE(parallel_jacobi_same_as_jacobi)
+{
+  typedef prox::MathPolicy<float> math_policy;
+
+  math_policy::compressed4x6_type J;
+  math_policy::compressed6x4_type WJT;
+  math_policy::vector6_type       Wdth;
+  math_policy::vector4_type       mu;
+
+  make_4_body_contact_problem<math_policy>( J, WJT, Wdth, mu );
+
+  size_t const K = J.nrows();
+
+  // The bodies start at rest, so b = J W dt h
+  math_policy::vector4_type b;
+  b.resize( K );
+  for(size_t k = 0u; k < K; ++k)
+    b(k) = math_policy::block4x1_type( 0.0f );
+  sparse::prod( J, Wdth, b );
+
+  prox::SolverParams<math_policy> params;
+  params.set_max_iterations( 1000u );
+  params.set_absolute_tolerance( 1e-6f );
+  params.set_relative_tolerance( 0.0f );
+
+  prox::RStrategyBinder<math_policy>     strategy        = prox::bind_strategy<math_policy>( prox::local_strategy );
+  prox::NormalSubSolverBinder<float>     normal_solver   = prox::bind_normal_solver<float>( prox::nonnegative );
+  prox::FrictionSubSolverBinder<float>   friction_solver = prox::bind_friction_solver<float>( prox::analytical_sphere );
+
+  math_policy::vector4_type lambda_jacobi;
+  math_policy::vector4_type lambda_parallel;
+  math_policy::vector4_type lambda_bound;
+
+  prox::SolverWorkspace<math_policy> workspace;
+
+  prox::jacobi_solver<math_policy>(J, WJT, b, mu, lambda_jacobi, strategy, normal_solver, friction_solver, params, workspace, math_policy() );
+  prox::parallel_jacobi_solver<math_policy>(J, WJT, b, mu, lambda_parallel, strategy, normal_solver, friction_solver, params, workspace, math_policy() );
+
+  // Bound with the sub solver types the projections are called directly
+  prox::SolverBinder<math_policy> bound_solver = prox::bind_solver<math_policy>( prox::parallel_jacobi, prox::nonnegative, prox::analytical_sphere );
+
+  bound_solver(J, WJT, b, mu, lambda_bound, strategy, normal_solver, friction_solver, params, workspace, math_policy() );
+
+  BOOST_CHECK_EQUAL( lambda_parallel.size(), K );
+  BOOST_CHECK_EQUAL( lambda_bound.size(), K );
+
+  for(size_t k = 0u; k < K; ++k)
+  {
+    for(size_t i = 0u; i < 4u; ++i)
+    {
+      BOOST_CHECK_CLOSE( lambda_parallel(k)(i) + 1.0f, lambda_jacobi(k)(i) + 1.0f, 0.01f );
+      BOOST_CHECK_EQUAL( lambda_bound(k)(i), lambda_parallel(k)(i) );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(flat_block_matrix)
+{
+  run_flat_block_matrix_test< prox::MathPolicy<float> >();
+  run_flat_block_matrix_test< prox::MathPolicy<double> >();
+}
+
+BOOST_AUTO_TEST_CASE(reused_workspace_same_as_fresh_workspace)
+{
+  typedef prox::MathPolicy<float> math_policy;
+
+  // Body 0 is fixed, bodies 1, 2 and 3 are dynamic.
+  size_t const N = 4u;
+  size_t const K = 5u;
+  size_t const pairs[K][2] = { {0u,1u}, {0u,2u}, {0u,3u}, {1u,2u}, {2u,3u} };
+
+  math_policy::compressed4x6_type J(K,N,2*K);
+  math_policy::compressed6x4_type WJT;
+
+  for(size_t k = 0u; k < K; ++k)
+  {
+    math_policy::block4x6_type A;
+    math_policy::block4x6_type B;
+
+    for(size_t e = 0u; e < 24u; ++e)
+    {
+      A[e] = ( (k*7u + e*3u) % 11u ) / 5.0f - 1.0f;
+      B[e] = ( (k*5u + e*7u) % 13u ) / 6.0f - 1.0f;
+    }
+
+    J(k,pairs[k][0]) = A;
+    J(k,pairs[k][1]) = B;
+  }
+
+  math_policy::diagonal6x6_type W;
+  W.resize( N );
+  for(size_t i = 1u; i < N; ++i)
+  {
+    math_policy::block6x6_type D( 0.0f );
+    for(size_t r = 0u; r < 6u; ++r)
+      D(r,r) = 1.0f;
+    W(i) = D;
+  }
+
+  math_policy::compute_WJT( W, J, WJT );
+
+  math_policy::vector4_type b;
+  math_policy::vector4_type mu;
+  b.resize( K );
+  mu.resize( K );
+
+  for(size_t k = 0u; k < K; ++k)
+  {
+    b(k)(0) = -1.0f + 0.1f*k;
+    b(k)(1) =  0.5f - 0.2f*k;
+    b(k)(2) =  0.3f;
+    b(k)(3) =  0.0f;
+
+    mu(k) = math_policy::block4x1_type( 0.5f );
+  }
+
+  prox::SolverParams<math_policy> params;
+  params.set_max_iterations( 1000u );
+  params.set_absolute_tolerance( 1e-6f );
+  params.set_relative_tolerance( 0.0f );
+
+  prox::RStrategyBinder<math_policy>     strategy        = prox::bind_strategy<math_policy>( prox::local_strategy );
+  prox::NormalSubSolverBinder<float>     normal_solver   = prox::bind_normal_solver<float>( prox::nonnegative );
+  prox::FrictionSubSolverBinder<float>   friction_solver = prox::bind_friction_solver<float>( prox::analytical_sphere );
+
+  math_policy::vector4_type lambda_fresh;
+  math_policy::vector4_type lambda_reused;
+
+  prox::SolverWorkspace<math_policy> fresh;
+
+  prox::gauss_seidel_solver<math_policy>(J, WJT, b, mu, lambda_fresh, strategy, normal_solver, friction_solver, params, fresh, math_policy() );
+
+  // Leave garbage from another solver and a larger problem in the workspace
+  prox::SolverWorkspace<math_policy> reused;
+
+  reused.m_x.resize( 2u*K );
+  reused.m_w.resize( 2u*N );
+  reused.m_R.resize( 2u*K );
+  reused.m_nu.resize( 2u*K );
+
+  for(size_t k = 0u; k < 2u*K; ++k)
+  {
+    reused.m_x(k)  = math_policy::block4x1_type( 3.0f );
+    reused.m_R(k)  = math_policy::block4x4_type( 2.0f );
+    reused.m_nu(k) = math_policy::block4x4_type( 2.0f );
+  }
+
+  for(size_t i = 0u; i < 2u*N; ++i)
+    reused.m_w(i) = math_policy::block6x1_type( 7.0f );
+
+  math_policy::vector4_type lambda_jacobi;
+
+  prox::jacobi_solver<math_policy>(J, WJT, b, mu, lambda_jacobi, strategy, normal_solver, friction_solver, params, reused, math_policy() );
+
+  prox::gauss_seidel_solver<math_policy>(J, WJT, b, mu, lambda_reused, strategy, normal_solver, friction_solver, params, reused, math_policy() );
+
+  BOOST_CHECK_EQUAL( lambda_reused.size(), K );
+
+  for(size_t k = 0u; k < K; ++k)
+    for(size_t i = 0u; i < 4u; ++i)
+      BOOST_CHECK_EQUAL( lambda_reused(k)(i), lambda_fresh(k)(i) );
+
+  // The parallel solvers keep their coloring and flat buffers in the workspace too
+  math_policy::vector4_type lambda_parallel_fresh;
+  math_policy::vector4_type lambda_parallel_reused;
+
+  prox::SolverWorkspace<math_policy> parallel_fresh;
+
+  prox::parallel_gauss_seidel_solver<math_policy>(J, WJT, b, mu, lambda_parallel_fresh, strategy, normal_solver, friction_solver, params, parallel_fresh, math_policy() );
+  prox::parallel_gauss_seidel_solver<math_policy>(J, WJT, b, mu, lambda_parallel_reused, strategy, normal_solver, friction_solver, params, reused, math_policy() );
+
+  for(size_t k = 0u; k < K; ++k)
+    for(size_t i = 0u; i < 4u; ++i)
+      BOOST_CHECK_EQUAL( lambda_parallel_reused(k)(i), lambda_parallel_fresh(k)(i) );
+
+  lambda_parallel_fresh.clear();
+  lambda_parallel_reused.clear();
+
+  prox::parallel_jacobi_solver<math_policy>(J, WJT, b, mu, lambda_parallel_fresh, strategy, normal_solver, friction_solver, params, parallel_fresh, math_policy() );
+  prox::parallel_jacobi_solver<math_policy>(J, WJT, b, mu, lambda_parallel_reused, strategy, normal_solver, friction_solver, params, reused, math_policy() );
+
+  for(size_t k = 0u; k < K; ++k)
+    for(size_t i = 0u; i < 4u; ++i)
+      BOOST_CHECK_EQUAL( lambda_parallel_reused(k)(i), lambda_parallel_fresh(k)(i) );
+}
+
+BOOST_AUTO_TEST_CASE(stabilization_same_as_frictionless_gauss_seidel)
+{
+  typedef prox::MathPolicy<float> math_policy;
+
+  // Body 0 is fixed, bodies 1, 2 and 3 are dynamic.
+  size_t const N = 4u;
+  size_t const K = 5u;
+  size_t const pairs[K][2] = { {0u,1u}, {0u,2u}, {0u,3u}, {1u,2u}, {2u,3u} };
+
+  math_policy::compressed4x6_type J(K,N,2*K);
+  math_policy::compressed6x4_type WJT;
+
+  for(size_t k = 0u; k < K; ++k)
+  {
+    math_policy::block4x6_type A;
+    math_policy::block4x6_type B;
+
+    for(size_t e = 0u; e < 24u; ++e)
+    {
+      A[e] = ( (k*7u + e*3u) % 11u ) / 5.0f - 1.0f;
+      B[e] = ( (k*5u + e*7u) % 13u ) / 6.0f - 1.0f;
+    }
+
+    J(k,pairs[k][0]) = A;
+    J(k,pairs[k][1]) = B;
+  }
+
+  math_policy::diagonal6x6_type W;
+  W.resize( N );
+  for(size_t i = 1u; i < N; ++i)
+  {
+    math_policy::block6x6_type D( 0.0f );
+    for(size_t r = 0u; r < 6u; ++r)
+      D(r,r) = 1.0f;
+    W(i) = D;
+  }
+
+  math_policy::compute_WJT( W, J, WJT );
+
+  math_policy::vector4_type g;
+  math_policy::vector4_type mu;
+  g.resize( K );
+  mu.resize( K );
+
+  for(size_t k = 0u; k < K; ++k)
+  {
+    g(k)(0) = -1.0f + 0.3f*k;
+    g(k)(1) =  0.5f - 0.2f*k;
+    g(k)(2) =  0.3f;
+    g(k)(3) =  0.0f;
+
+    mu(k) = math_policy::block4x1_type( 0.5f );
+  }
+
+  prox::SolverParams<math_policy> params;
+  params.set_max_iterations( 1000u );
+  params.set_absolute_tolerance( 1e-7f );
+  params.set_relative_tolerance( 0.0f );
+
+  prox::RStrategyBinder<math_policy>     strategy        = prox::bind_strategy<math_policy>( prox::local_strategy );
+  prox::NormalSubSolverBinder<float>     normal_solver   = prox::bind_normal_solver<float>( prox::nonnegative );
+  prox::FrictionSubSolverBinder<float>   friction_solver = prox::bind_friction_solver<float>( prox::friction_origin );
+
+  math_policy::vector4_type lambda_gauss_seidel;
+  math_policy::vector4_type lambda_stabilization;
+
+  prox::SolverWorkspace<math_policy> workspace;
+
+  prox::gauss_seidel_solver<math_policy>(J, WJT, g, mu, lambda_gauss_seidel, strategy, normal_solver, friction_solver, params, workspace, math_policy() );
+
+  // Warm starting from garbage friction impulses must not matter
+  params.set_use_warm_starting( true );
+
+  lambda_stabilization.resize( K );
+  for(size_t k = 0u; k < K; ++k)
+    lambda_stabilization(k) = math_policy::block4x1_type( 5.0f );
+
+  prox::stabilization_solver<math_policy>(J, WJT, g, lambda_stabilization, params, workspace, math_policy() );
+
+  BOOST_CHECK_EQUAL( lambda_stabilization.size(), K );
+
+  for(size_t k = 0u; k < K; ++k)
+  {
+    BOOST_CHECK( lambda_stabilization(k)(0) >= 0.0f );
+    BOOST_CHECK_CLOSE( lambda_stabilization(k)(0) + 1.0f, lambda_gauss_seidel(k)(0) + 1.0f, 0.01f );
+    BOOST_CHECK_EQUAL( lambda_stabilization(k)(1), 0.0f );
+    BOOST_CHECK_EQUAL( lambda_stabilization(k)(2), 0.0f );
+    BOOST_CHECK_EQUAL( lambda_stabilization(k)(3), 0.0f );
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
\ No newline at end of file
@@ -21,6 +21,8 @@ namespace simulators
     static std::string const PARAM_SOLVER;
     static std::string const VALUE_JACOBI;
     static std::string const VALUE_GAUSS_SEIDEL;
+    static std::string const VALUE_PARALLEL_GAUSS_SEIDEL;
+    static std::string const VALUE_PARALLEL_JACOBI;
     static std::string const PARAM_NORMAL_SOLVER;
     static std::string const VALUE_NONNEGATIVE;
     static std::string const VALUE_ORIGIN;
@@ -52,18 +54,25 @@ namespace simulators
     static std::string const PARAM_POST_STABILIZATION;
     static std::string const PARAM_COTNACT_REDUCTION;
     static std::string const PARAM_BOUNCE_ON;
+    static std::string const PARAM_WARM_STARTING;
     static std::string const PARAM_TETGEN_QUIET;
     static std::string const PARAM_TETGEN_SUPPRESS_SPLITTING;
     static std::string const PARAM_NARROW_USE_OPEN_CL;
     static std::string const PARAM_NARROW_USE_GPROXIMITY;
     static std::string const PARAM_NARROW_USE_BATCHING;
+    static std::string const PARAM_NARROW_USE_PARALLEL;
+    static std::string const PARAM_NARROW_USE_SDF;
     static std::string const PARAM_USE_ONLY_TETRAMESHES;
     static std::string const PARAM_MAX_ITERATION;
     static std::string const PARAM_NARROW_OPEN_CL_PLATFORM;
     static std::string const PARAM_NARROW_OPEN_CL_DEVICE;
     static std::string const PARAM_NARROW_CHUNK_BYTES;
+    static std::string const PARAM_NARROW_SDF_RESOLUTION;
     static std::string const PARAM_ABSOLUTE_TOLERANCE;
     static std::string const PARAM_RELATIVE_TOLERANCE;
+    static std::string const PARAM_STABILIZATION_MAX_ITERATION;
+    static std::string const PARAM_STABILIZATION_ABSOLUTE_TOLERANCE;
+    static std::string const PARAM_STABILIZATION_RELATIVE_TOLERANCE;
     static std::string const PARAM_GAP_REDUCTION;
     static std::string const PARAM_MAX_GAP;
     static std::string const PARAM_MIN_GAP;
@@ -75,6 +84,8 @@ namespace simulators
     static std::string const PARAM_BROAD_PHASE_ALGORITHM;
     static std::string const VALUE_ALL_PAIR;
     static std::string const VALUE_GRID;
+    static std::string const VALUE_SWEEP_AND_PRUNE;
+    static std::string const VALUE_PARALLEL_GRID;
 
     void set_parameter(std::string const & name, bool         const & value );
 
@@ -7,6 +7,7 @@
 #include <prox_property.h>
 #include <prox_params.h>
 #include <prox_force_callbacks.h>
+#include <steppers/prox_stepper_workspace.h>
 #include <narrow.h>
 #include <broad.h>
 
@@ -26,7 +27,13 @@ namespace simulators
 	{
   public:
     
+#if defined(PROX_USE_DOUBLE_PRECISION)
+    typedef prox::MathPolicy< double >         MT;
+#elif defined(PROX_USE_MIXED_PRECISION)
+    typedef prox::MathPolicy< double, float >  MT;   ///< Double precision bodies and float solver blocks
+#else
     typedef prox::MathPolicy< float >          MT;
+#endif
     typedef MT::tiny_types                     TT;
     typedef TT::vector3_type                   V;
     typedef TT::quaternion_type                Q;
@@ -59,8 +66,8 @@ namespace simulators
     std::vector< std::vector< property_type > > m_properties;
 
     bool                             m_exist_property[m_number_of_materials][m_number_of_materials];
-    float                            m_time_step;
-    float                            m_time;      ///< Simulated time
+    T                                m_time_step;
+    T                                m_time;      ///< Simulated time
     
     params_type                      m_params;
     bool                             m_use_only_tetrameshes;
@@ -68,6 +75,9 @@ namespace simulators
     prox::Gravity<MT>       m_gravity;
     prox::Damping<MT>       m_damping;
 
+    prox::StepperWorkspace<MT>  m_workspace;   ///< Work buffers of the time steppers, kept alive so their
+                                               ///< storage is reused from one time step to the next.
+
 
     std::vector< force_callback * >    m_force_callbacks;
     std::map< size_t, prox::Pin<MT> >  m_pin_forces;        ///< Container of pin forces. We on
@@ -343,7 +353,7 @@ namespace simulators
 		    
 		void clear();
     
-    void step_simulation(float const & dt);
+    void step_simulation(T const & dt);
 
     bool compute_raycast(
                          float const & p_x
@@ -367,7 +377,7 @@ namespace simulators
                                  );
 
 
-    void get_total_energy( float & kinetic, float & potential);
+    void get_total_energy( T & kinetic, T & potential);
 
 	};
 
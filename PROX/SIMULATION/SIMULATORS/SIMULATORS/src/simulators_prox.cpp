@@ -10,7 +10,7 @@
 namespace simulators
 {
 
-  typedef tiny::MathTypes<float> MT;
+  typedef ProxData::TT           MT;
   typedef MT::vector3_type       V;
   typedef MT::quaternion_type    Q;
   typedef MT::value_traits       VT;
@@ -58,12 +58,14 @@ namespace simulators
     assert( dt > 0.0f || !"simulate(): it does not make sense to take zero time step");
     
     
-    float dt_left     = dt;
-    float script_time = m_data->m_time;
+    typedef ProxData::T T;
+
+    T dt_left     = dt;
+    T script_time = m_data->m_time;
     
     while(dt_left > 0.0f)
     {
-      float const ddt = min( m_data->m_time_step, dt_left );
+      T const ddt = min( m_data->m_time_step, dt_left );
       
       script_time += ddt;
       for (size_t i = 0u; i < m_data->m_all_scripted_bodies.size(); ++i)
@@ -1100,7 +1102,13 @@ namespace simulators
     assert( first_index  < m_number_of_materials || !"internal error: index excedes allocated space for in material table");
     assert( second_index < m_number_of_materials || !"internal error: index excedes allocated space for in material table");
     
-    m_data->m_properties[first_index][second_index].get_friction_coefficients( x, y, z );
+    T mu_x, mu_y, mu_z;
+
+    m_data->m_properties[first_index][second_index].get_friction_coefficients( mu_x, mu_y, mu_z );
+
+    x = mu_x;
+    y = mu_y;
+    z = mu_z;
   }
   
   void ProxEngine::get_master_direction( size_t const & first_index
@@ -1114,7 +1122,13 @@ namespace simulators
     assert( first_index  < m_number_of_materials || !"internal error: index excedes allocated space for in material table");
     assert( second_index < m_number_of_materials || !"internal error: index excedes allocated space for in material table");
     
-    m_data->m_properties[first_index][second_index].get_s_vector( x, y, z );
+    T s_x, s_y, s_z;
+
+    m_data->m_properties[first_index][second_index].get_s_vector( s_x, s_y, s_z );
+
+    x = s_x;
+    y = s_y;
+    z = s_z;
   }
   
   float ProxEngine::get_restitution( size_t const & first_index
@@ -1734,7 +1748,16 @@ namespace simulators
     assert( m_data || !"internal error: null pointer");
     assert( body_index < m_data->m_bodies.size() || !"internal error: no such rigid body");
     
-    return m_data->m_bodies[ body_index ].get_box(min_x, min_y, min_z, max_x, max_y, max_z);
+    T box[6];
+
+    m_data->m_bodies[ body_index ].get_box( box[0], box[1], box[2], box[3], box[4], box[5] );
+
+    min_x = box[0];
+    min_y = box[1];
+    min_z = box[2];
+    max_x = box[3];
+    max_y = box[4];
+    max_z = box[5];
   }
   
   void ProxEngine::set_gravity_up(
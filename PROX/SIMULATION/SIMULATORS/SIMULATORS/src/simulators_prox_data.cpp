@@ -26,6 +26,7 @@ namespace simulators
   , m_time(0.0f)
   , m_params()
   , m_use_only_tetrameshes(false)
+  , m_workspace()
   , m_tetgen_settings(mesh_array::tetgen_quality_settings())
   , m_all_scripted_bodies()
 	{
@@ -77,7 +78,7 @@ namespace simulators
     util::Profiling::reset();
 	}
 	
-  void ProxData::step_simulation(float const & dt)
+  void ProxData::step_simulation(T const & dt)
   {
     typedef prox::StepperBinder< MT > stepper_binder_type;
     
@@ -86,7 +87,7 @@ namespace simulators
     
     stepper_binder_type stepper = prox::bind_stepper< MT >( m_params.stepper_params().stepper() );
     
-    stepper( dt, m_bodies, m_properties, m_gravity, m_damping, m_params, m_broad, m_narrow, m_contacts, MT() );
+    stepper( dt, m_bodies, m_properties, m_gravity, m_damping, m_params, m_broad, m_narrow, m_contacts, m_workspace, MT() );
 
     T E_kinetic;
     T E_potential;
@@ -197,7 +198,7 @@ namespace simulators
 
   }
 
-  void ProxData::get_total_energy( float & kinetic, float & potential)
+  void ProxData::get_total_energy( T & kinetic, T & potential)
   {
     kinetic   = 0.0f;
     potential = 0.0f;
@@ -216,9 +217,9 @@ namespace simulators
       if(body.is_scripted())
         continue;
 
-      float const m  = body.get_mass();
-      float const h  = tiny::inner_prod( m_gravity.up(), body.get_position());
-      float const v  = tiny::norm( body.get_velocity());
+      T const m      = body.get_mass();
+      T const h      = tiny::inner_prod( m_gravity.up(), body.get_position());
+      T const v      = tiny::norm( body.get_velocity());
 
       V const & w    = body.get_spin();
       M const & I_bf = body.get_inertia_bf();
@@ -11,6 +11,8 @@ namespace simulators
   std::string const ProxEngine::PARAM_SOLVER                     = "solver";
   std::string const ProxEngine::VALUE_JACOBI                     = "jacobi";
   std::string const ProxEngine::VALUE_GAUSS_SEIDEL               = "gauss_seidel";
+  std::string const ProxEngine::VALUE_PARALLEL_GAUSS_SEIDEL      = "parallel_gauss_seidel";
+  std::string const ProxEngine::VALUE_PARALLEL_JACOBI            = "parallel_jacobi";
   std::string const ProxEngine::PARAM_NORMAL_SOLVER              = "normal_sub_solver";
   std::string const ProxEngine::VALUE_NONNEGATIVE                = "nonnegative";
   std::string const ProxEngine::VALUE_ORIGIN                     = "origin";
@@ -42,18 +44,25 @@ namespace simulators
   std::string const ProxEngine::PARAM_POST_STABILIZATION         = "post_stabilization";
   std::string const ProxEngine::PARAM_COTNACT_REDUCTION          = "contact_reduction";
   std::string const ProxEngine::PARAM_BOUNCE_ON                  = "bounce_on";
+  std::string const ProxEngine::PARAM_WARM_STARTING              = "warm_starting";
   std::string const ProxEngine::PARAM_TETGEN_QUIET               = "tetgen_quiet_output";
   std::string const ProxEngine::PARAM_TETGEN_SUPPRESS_SPLITTING  = "tetgen_suppress_splitting";
   std::string const ProxEngine::PARAM_NARROW_USE_OPEN_CL         = "narrow_use_open_cl";
   std::string const ProxEngine::PARAM_NARROW_USE_GPROXIMITY      = "narrow_use_gproximity";
   std::string const ProxEngine::PARAM_NARROW_USE_BATCHING        = "narrow_use_batching";
+  std::string const ProxEngine::PARAM_NARROW_USE_PARALLEL        = "narrow_use_parallel";
+  std::string const ProxEngine::PARAM_NARROW_USE_SDF             = "narrow_use_sdf";
   std::string const ProxEngine::PARAM_USE_ONLY_TETRAMESHES       = "use_only_tetrameshes";
   std::string const ProxEngine::PARAM_MAX_ITERATION              = "max_iteration";
   std::string const ProxEngine::PARAM_NARROW_OPEN_CL_PLATFORM    = "narrow_open_cl_platform";
   std::string const ProxEngine::PARAM_NARROW_OPEN_CL_DEVICE      = "narrow_open_cl_device";
   std::string const ProxEngine::PARAM_NARROW_CHUNK_BYTES         = "narrow_chunk_bytes";
+  std::string const ProxEngine::PARAM_NARROW_SDF_RESOLUTION      = "narrow_sdf_resolution";
   std::string const ProxEngine::PARAM_ABSOLUTE_TOLERANCE         = "absolute_tolerance";
   std::string const ProxEngine::PARAM_RELATIVE_TOLERANCE         = "relative_tolerance";
+  std::string const ProxEngine::PARAM_STABILIZATION_MAX_ITERATION      = "stabilization_max_iteration";
+  std::string const ProxEngine::PARAM_STABILIZATION_ABSOLUTE_TOLERANCE = "stabilization_absolute_tolerance";
+  std::string const ProxEngine::PARAM_STABILIZATION_RELATIVE_TOLERANCE = "stabilization_relative_tolerance";
   std::string const ProxEngine::PARAM_GAP_REDUCTION              = "gap_reduction";
   std::string const ProxEngine::PARAM_MAX_GAP                    = "max_gap";
   std::string const ProxEngine::PARAM_MIN_GAP                    = "min_gap";
@@ -66,6 +75,8 @@ namespace simulators
   std::string const ProxEngine::PARAM_BROAD_PHASE_ALGORITHM      = "broad_phase_algorithm";
   std::string const ProxEngine::VALUE_ALL_PAIR                   = "all_pair";
   std::string const ProxEngine::VALUE_GRID                       = "grid";
+  std::string const ProxEngine::VALUE_SWEEP_AND_PRUNE            = "sweep_and_prune";
+  std::string const ProxEngine::VALUE_PARALLEL_GRID              = "parallel_grid";
 
 
   void ProxEngine::set_parameter(std::string const & name, std::string const & value )
@@ -82,6 +93,14 @@ namespace simulators
       {
         m_data->m_params.solver_params().set_solver(prox::gauss_seidel);
       }
+      else if (value == VALUE_PARALLEL_GAUSS_SEIDEL)
+      {
+        m_data->m_params.solver_params().set_solver(prox::parallel_gauss_seidel);
+      }
+      else if (value == VALUE_PARALLEL_JACOBI)
+      {
+        m_data->m_params.solver_params().set_solver(prox::parallel_jacobi);
+      }
       else
       {
         util::Log logging;
@@ -209,11 +228,19 @@ namespace simulators
     {
       if (value == VALUE_ALL_PAIR)
       {
-        m_data->m_params.use_all_pair() = true;
+        m_data->m_params.broad_phase() = prox::all_pair_broad_phase;
       }
       else if (value == VALUE_GRID)
       {
-        m_data->m_params.use_all_pair() = false;
+        m_data->m_params.broad_phase() = prox::grid_broad_phase;
+      }
+      else if (value == VALUE_SWEEP_AND_PRUNE)
+      {
+        m_data->m_params.broad_phase() = prox::sweep_and_prune_broad_phase;
+      }
+      else if (value == VALUE_PARALLEL_GRID)
+      {
+        m_data->m_params.broad_phase() = prox::parallel_grid_broad_phase;
       }
       else
       {
@@ -250,6 +277,10 @@ namespace simulators
     {
       m_data->m_params.stepper_params().set_bounce_on(value);
     }
+    else if (name == PARAM_WARM_STARTING)
+    {
+      m_data->m_params.solver_params().set_use_warm_starting(value);
+    }
     else if (name == PARAM_TETGEN_QUIET)
     {
       m_data->m_tetgen_settings.m_quiet_output = value;
@@ -270,6 +301,14 @@ namespace simulators
     {
       m_data->m_narrow.params().set_use_batching( value );
     }
+    else if (name == PARAM_NARROW_USE_PARALLEL)
+    {
+      m_data->m_narrow.params().set_use_parallel( value );
+    }
+    else if (name == PARAM_NARROW_USE_SDF)
+    {
+      m_data->m_narrow.params().set_use_sdf( value );
+    }
     else if (name == PARAM_USE_ONLY_TETRAMESHES)
     {
       m_data->m_use_only_tetrameshes = value;
@@ -290,6 +329,10 @@ namespace simulators
     {
       m_data->m_params.solver_params().set_max_iterations(value);
     }
+    else if (name == PARAM_STABILIZATION_MAX_ITERATION)
+    {
+      m_data->m_params.stepper_params().set_stabilization_max_iterations(value);
+    }
     else if (name == PARAM_NARROW_OPEN_CL_PLATFORM)
     {
       m_data->m_narrow.params().set_open_cl_platform(value);
@@ -302,6 +345,10 @@ namespace simulators
     {
       m_data->m_narrow.params().set_chunk_bytes( value );
     }
+    else if (name == PARAM_NARROW_SDF_RESOLUTION)
+    {
+      m_data->m_narrow.params().set_sdf_resolution( value );
+    }
     else
     {
       util::Log logging;
@@ -322,6 +369,14 @@ namespace simulators
     {
       m_data->m_params.solver_params().set_relative_tolerance(value);
     }
+    else if (name == PARAM_STABILIZATION_ABSOLUTE_TOLERANCE)
+    {
+      m_data->m_params.stepper_params().set_stabilization_absolute_tolerance(value);
+    }
+    else if (name == PARAM_STABILIZATION_RELATIVE_TOLERANCE)
+    {
+      m_data->m_params.stepper_params().set_stabilization_relative_tolerance(value);
+    }
     else if (name == PARAM_GAP_REDUCTION)
     {
       m_data->m_params.stepper_params().set_gap_reduction(value);
@@ -374,8 +429,11 @@ namespace simulators
     bool         const narrow_use_open_cl          = util::to_value<bool>(         settings.get_value(PARAM_NARROW_USE_OPEN_CL,        "false"  ) );
     bool         const narrow_use_gproximity       = util::to_value<bool>(         settings.get_value(PARAM_NARROW_USE_GPROXIMITY,     "false"  ) );
     bool         const narrow_use_batching         = util::to_value<bool>(         settings.get_value(PARAM_NARROW_USE_BATCHING,       "true"   ) );
+    bool         const narrow_use_parallel         = util::to_value<bool>(         settings.get_value(PARAM_NARROW_USE_PARALLEL,       "false"  ) );
+    bool         const narrow_use_sdf              = util::to_value<bool>(         settings.get_value(PARAM_NARROW_USE_SDF,            "false"  ) );
     bool         const use_only_tetrameshes        = util::to_value<bool>(         settings.get_value(PARAM_USE_ONLY_TETRAMESHES,      "false"  ) );
     bool         const bounce_on_value             = util::to_value<bool>(         settings.get_value(PARAM_BOUNCE_ON,                 "true"  ) );
+    bool         const warm_starting_value         = util::to_value<bool>(         settings.get_value(PARAM_WARM_STARTING,             "false"  ) );
 
     set_parameter(PARAM_PRE_STABILIZATION,           pre_stabilization_value   );
     set_parameter(PARAM_POST_STABILIZATION,          post_stabilization_value  );
@@ -385,21 +443,30 @@ namespace simulators
     set_parameter(PARAM_NARROW_USE_OPEN_CL,          narrow_use_open_cl        );
     set_parameter(PARAM_NARROW_USE_GPROXIMITY,       narrow_use_gproximity     );
     set_parameter(PARAM_NARROW_USE_BATCHING,         narrow_use_batching       );
+    set_parameter(PARAM_NARROW_USE_PARALLEL,         narrow_use_parallel       );
+    set_parameter(PARAM_NARROW_USE_SDF,              narrow_use_sdf            );
     set_parameter(PARAM_USE_ONLY_TETRAMESHES,        use_only_tetrameshes      );
     set_parameter(PARAM_BOUNCE_ON,                   bounce_on_value           );
+    set_parameter(PARAM_WARM_STARTING,               warm_starting_value       );
 
     unsigned int const max_iteration_value         = util::to_value<unsigned int>( settings.get_value(PARAM_MAX_ITERATION,             "1000"   ) );
+    unsigned int const stabilization_max_iteration = util::to_value<unsigned int>( settings.get_value(PARAM_STABILIZATION_MAX_ITERATION, "100"  ) );
     unsigned int const narrow_open_cl_platform     = util::to_value<unsigned int>( settings.get_value(PARAM_NARROW_OPEN_CL_PLATFORM,   "0"      ) );
     unsigned int const narrow_open_cl_device       = util::to_value<unsigned int>( settings.get_value(PARAM_NARROW_OPEN_CL_DEVICE,     "0"      ) );
     unsigned int const narrow_chunk_bytes          = util::to_value<unsigned int>( settings.get_value(PARAM_NARROW_CHUNK_BYTES,        "8000"   ) );
+    unsigned int const narrow_sdf_resolution       = util::to_value<unsigned int>( settings.get_value(PARAM_NARROW_SDF_RESOLUTION,     "32"     ) );
 
     set_parameter(PARAM_MAX_ITERATION,               max_iteration_value       );
+    set_parameter(PARAM_STABILIZATION_MAX_ITERATION, stabilization_max_iteration );
     set_parameter(PARAM_NARROW_OPEN_CL_PLATFORM,     narrow_open_cl_platform   );
     set_parameter(PARAM_NARROW_OPEN_CL_DEVICE,       narrow_open_cl_device     );
     set_parameter(PARAM_NARROW_CHUNK_BYTES,          narrow_chunk_bytes        );
+    set_parameter(PARAM_NARROW_SDF_RESOLUTION,       narrow_sdf_resolution     );
 
     float        const absolute_tolerance_value    = util::to_value<float>(        settings.get_value(PARAM_ABSOLUTE_TOLERANCE,        "0.0"    ) );
     float        const relative_tolerance_value    = util::to_value<float>(        settings.get_value(PARAM_RELATIVE_TOLERANCE,        "0.0"    ) );
+    float        const stabilization_absolute_tolerance = util::to_value<float>(   settings.get_value(PARAM_STABILIZATION_ABSOLUTE_TOLERANCE, "0.0001" ) );
+    float        const stabilization_relative_tolerance = util::to_value<float>(   settings.get_value(PARAM_STABILIZATION_RELATIVE_TOLERANCE, "0.0"    ) );
     float        const gap_reduction_value         = util::to_value<float>(        settings.get_value(PARAM_GAP_REDUCTION,             "0.5"    ) );
     float        const min_gap_value               = util::to_value<float>(        settings.get_value(PARAM_MIN_GAP,                   "0.001"  ) );
     float        const max_gap_value               = util::to_value<float>(        settings.get_value(PARAM_MAX_GAP,                   "0.01"   ) );
@@ -410,6 +477,8 @@ namespace simulators
 
     set_parameter(PARAM_ABSOLUTE_TOLERANCE,          absolute_tolerance_value  );
     set_parameter(PARAM_RELATIVE_TOLERANCE,          relative_tolerance_value  );
+    set_parameter(PARAM_STABILIZATION_ABSOLUTE_TOLERANCE, stabilization_absolute_tolerance );
+    set_parameter(PARAM_STABILIZATION_RELATIVE_TOLERANCE, stabilization_relative_tolerance );
     set_parameter(PARAM_GAP_REDUCTION,               gap_reduction_value       );
     set_parameter(PARAM_MIN_GAP,                     min_gap_value             );
     set_parameter(PARAM_MAX_GAP,                     max_gap_value             );